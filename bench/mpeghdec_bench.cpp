@@ -0,0 +1,1211 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2018 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+// system includes
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// project includes
+#include "aacdecoder.h"
+#include "FDK_core.h"
+#include "FDK_bitstream.h"
+#include "FDK_tools_rom.h"
+#include "FDK_cicp2geometry.h"
+#include "fft.h"
+#include "dct.h"
+#include "mdct.h"
+#include "ac_arith_coder.h"
+#include "channelinfo.h"
+#include "stereo.h"
+#include "mct.h"
+#include "FDK_formatConverterLib.h"
+#include "gVBAPRenderer.h"
+#include "vbap_core.h"
+#include "limiter.h"
+#include "FDK_drcDecLib.h"
+
+#if defined(__x86__)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define BENCH_HAVE_TSC
+#endif
+
+/*
+ * Micro-benchmarks of the DSP kernels of the decoder. Every kernel is driven with synthetic but
+ * representative input, so the numbers do not depend on test bitstreams. The cycle count is read
+ * from the time stamp counter on x86 and therefore counts reference cycles, not core cycles.
+ *
+ * In FDK_X86_DISPATCH builds each kernel is measured once for every instruction set extension
+ * supported by the executing CPU. Otherwise the single variant the library has been compiled for
+ * is reported.
+ */
+
+#define BENCH_ROUNDS 5
+#define BENCH_FRAME_SIZE 1024
+#define BENCH_SAMPLE_RATE 48000
+#define BENCH_SAMPLE_RATE_INDEX 3
+
+typedef void (*BENCH_FUNC)(void* state);
+
+typedef struct {
+  const char* name;
+  UINT cpuFeatures;
+} BENCH_ISA;
+
+#if defined(FDK_X86_DISPATCH)
+static const BENCH_ISA benchIsa[] = {
+    {"C", 0}, {"SSE4.1", FDK_CPU_X86_SSE4_1}, {"AVX2", FDK_CPU_X86_SSE4_1 | FDK_CPU_X86_AVX2}};
+#elif defined(__x86_AVX2__)
+static const BENCH_ISA benchIsa[] = {{"AVX2", 0}};
+#elif defined(__x86_SSE4_1__)
+static const BENCH_ISA benchIsa[] = {{"SSE4.1", 0}};
+#else
+static const BENCH_ISA benchIsa[] = {{"C", 0}};
+#endif
+
+static double benchMinTime = 0.1; /* seconds spent per kernel, configuration and variant */
+static const char* benchFilter = NULL;
+static double benchTimerOverhead = 0.0;
+static double benchTscOverhead = 0.0;
+
+/********************* helpers **********************/
+
+static double benchSeconds(void) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static UINT64 benchTsc(void) {
+#if defined(BENCH_HAVE_TSC)
+  return (UINT64)__rdtsc();
+#else
+  return 0;
+#endif
+}
+
+/* Pseudo random generator, keeps the input identical across runs and platforms. */
+static UINT benchRandState = 0x12345678;
+
+static UINT benchRand(void) {
+  benchRandState = benchRandState * 1664525 + 1013904223;
+  return benchRandState;
+}
+
+/* Fill with random values of the given amplitude (power of two exponent below full scale). */
+static void benchFillRandom(FIXP_DBL* p, int n, int headroom) {
+  for (int i = 0; i < n; i++) {
+    p[i] = (FIXP_DBL)((INT)benchRand() >> headroom);
+  }
+}
+
+static void* benchAlloc(size_t size) {
+  void* p = FDKaalloc((UINT)size, ALIGNMENT_DEFAULT);
+  if (p == NULL) {
+    fprintf(stderr, "Error: out of memory\n");
+    exit(1);
+  }
+  FDKmemclear(p, (UINT)size);
+  return p;
+}
+
+static void benchFree(void* p) {
+  if (p != NULL) {
+    FDKafree(p);
+  }
+}
+
+/* Measure the overhead of a single timed interval, it is subtracted from kernels which need an
+ * untimed reset before each call. */
+static void benchCalibrateTimer(void) {
+  double best = 1.0, bestTsc = 1e18;
+  for (int r = 0; r < 1000; r++) {
+    double t0 = benchSeconds();
+    UINT64 c0 = benchTsc();
+    UINT64 c1 = benchTsc();
+    double t1 = benchSeconds();
+    if (t1 - t0 < best) best = t1 - t0;
+    if ((double)(c1 - c0) < bestTsc) bestTsc = (double)(c1 - c0);
+  }
+  benchTimerOverhead = best;
+  benchTscOverhead = bestTsc;
+}
+
+/* Run the kernel for the given number of iterations and return the net time and TSC cycles. */
+static void benchMeasure(void* state, BENCH_FUNC reset, BENCH_FUNC run, INT64 iterations,
+                         double* pSeconds, double* pCycles) {
+  double seconds = 0.0, cycles = 0.0;
+
+  if (reset == NULL) {
+    double t0 = benchSeconds();
+    UINT64 c0 = benchTsc();
+    for (INT64 i = 0; i < iterations; i++) {
+      run(state);
+    }
+    UINT64 c1 = benchTsc();
+    seconds = benchSeconds() - t0;
+    cycles = (double)(c1 - c0);
+  } else {
+    for (INT64 i = 0; i < iterations; i++) {
+      reset(state);
+      double t0 = benchSeconds();
+      UINT64 c0 = benchTsc();
+      run(state);
+      UINT64 c1 = benchTsc();
+      double t1 = benchSeconds();
+      seconds += t1 - t0 - benchTimerOverhead;
+      cycles += (double)(c1 - c0) - benchTscOverhead;
+    }
+  }
+
+  *pSeconds = (seconds > 0.0) ? seconds : 0.0;
+  *pCycles = (cycles > 0.0) ? cycles : 0.0;
+}
+
+/**
+ * \brief Time one kernel configuration for all available instruction set variants and print one
+ *        result line per variant.
+ * \param kernel         Name of the kernel.
+ * \param config         Description of the configuration.
+ * \param samplesPerCall Number of samples produced or consumed by one call of run().
+ * \param state          Kernel state handed over to reset() and run().
+ * \param reset          Restores the kernel input before each call, not timed. May be NULL.
+ * \param run            Calls the kernel once.
+ */
+static void benchRun(const char* kernel, const char* config, int samplesPerCall, void* state,
+                     BENCH_FUNC reset, BENCH_FUNC run) {
+  char name[128];
+  snprintf(name, sizeof(name), "%s %s", kernel, config);
+  if (benchFilter != NULL && strstr(name, benchFilter) == NULL) {
+    return;
+  }
+
+  const UINT cpuFeatures = FDK_getCpuFeatures();
+
+  for (size_t v = 0; v < sizeof(benchIsa) / sizeof(benchIsa[0]); v++) {
+    if ((benchIsa[v].cpuFeatures & ~cpuFeatures) != 0) {
+      continue;
+    }
+#if defined(FDK_X86_DISPATCH)
+    /* The kernels test the feature flags on every call, restrict them to select a variant. */
+    FDK_cpuFeatures = benchIsa[v].cpuFeatures;
+#endif
+
+    double seconds, cycles;
+    INT64 iterations = 1;
+
+    /* warm up caches and branch predictors, then scale the iterations to the minimum time */
+    benchMeasure(state, reset, run, 4, &seconds, &cycles);
+    for (;;) {
+      benchMeasure(state, reset, run, iterations, &seconds, &cycles);
+      if (seconds >= benchMinTime / BENCH_ROUNDS || iterations >= ((INT64)1 << 40)) break;
+      iterations *= 2;
+    }
+
+    double bestSeconds = seconds, bestCycles = cycles;
+    for (int r = 1; r < BENCH_ROUNDS; r++) {
+      benchMeasure(state, reset, run, iterations, &seconds, &cycles);
+      if (seconds < bestSeconds) {
+        bestSeconds = seconds;
+        bestCycles = cycles;
+      }
+    }
+
+#if defined(FDK_X86_DISPATCH)
+    FDK_cpuFeatures = cpuFeatures;
+#endif
+
+    double samples = (double)iterations * samplesPerCall;
+    char cyclesStr[32] = "-";
+#if defined(BENCH_HAVE_TSC)
+    snprintf(cyclesStr, sizeof(cyclesStr), "%.2f", bestCycles / samples);
+#else
+    (void)bestCycles;
+#endif
+    printf("%-16s %-32s %-7s %12s %12.2f\n", kernel, config, benchIsa[v].name, cyclesStr,
+           (bestSeconds > 0.0) ? samples / bestSeconds * 1e-6 : 0.0);
+    fflush(stdout);
+  }
+}
+
+/* Minimal MSB first bit writer to compose the DRC payloads. */
+static void benchPutBits(UCHAR* buf, UINT* pBitPos, UINT value, int nBits) {
+  for (int i = nBits - 1; i >= 0; i--) {
+    UINT pos = (*pBitPos)++;
+    if ((value >> i) & 1) {
+      buf[pos >> 3] |= (UCHAR)(0x80 >> (pos & 7));
+    }
+  }
+}
+
+/********************* FFT, DCT-IV, DST-IV **********************/
+
+typedef struct {
+  int length;
+  int isDst;
+  FIXP_DBL* data;
+  FIXP_DBL* input;
+} BENCH_TRANSFORM;
+
+static void benchTransformReset(void* state) {
+  BENCH_TRANSFORM* t = (BENCH_TRANSFORM*)state;
+  FDKmemcpy(t->data, t->input, t->length * sizeof(FIXP_DBL));
+}
+
+static void benchFftRun(void* state) {
+  BENCH_TRANSFORM* t = (BENCH_TRANSFORM*)state;
+  INT scalefactor = 0;
+  fft(t->length / 2, t->data, &scalefactor);
+}
+
+static void benchDctRun(void* state) {
+  BENCH_TRANSFORM* t = (BENCH_TRANSFORM*)state;
+  int exponent = 0;
+  if (t->isDst) {
+    dst_IV(t->data, t->length, &exponent);
+  } else {
+    dct_IV(t->data, t->length, &exponent);
+  }
+}
+
+static void benchTransforms(void) {
+  BENCH_TRANSFORM t;
+  char config[64];
+
+  t.data = (FIXP_DBL*)benchAlloc(2 * 1024 * sizeof(FIXP_DBL));
+  t.input = (FIXP_DBL*)benchAlloc(2 * 1024 * sizeof(FIXP_DBL));
+  benchFillRandom(t.input, 2 * 1024, 4);
+
+  /* complex FFT, interleaved real and imaginary parts */
+  for (int length = 64; length <= 512; length *= 2) {
+    t.length = 2 * length;
+    t.isDst = 0;
+    snprintf(config, sizeof(config), "complex %d", length);
+    benchRun("fft", config, length, &t, benchTransformReset, benchFftRun);
+  }
+
+  for (int isDst = 0; isDst <= 1; isDst++) {
+    for (int length = 128; length <= 1024; length *= 2) {
+      t.length = length;
+      t.isDst = isDst;
+      snprintf(config, sizeof(config), "%d", length);
+      benchRun(isDst ? "dst_IV" : "dct_IV", config, length, &t, benchTransformReset, benchDctRun);
+    }
+  }
+
+  benchFree(t.input);
+  benchFree(t.data);
+}
+
+/********************* IMDCT with windowing and overlap-add **********************/
+
+typedef struct {
+  mdct_t mdct;
+  FIXP_DBL* overlap;
+  FIXP_DBL* spectrum;
+  FIXP_DBL* input;
+  FIXP_DBL* output;
+  SHORT specScale[8];
+  int nSpec;
+  int tl;
+  const FIXP_WTP* window;
+} BENCH_IMLT;
+
+static void benchImltReset(void* state) {
+  BENCH_IMLT* t = (BENCH_IMLT*)state;
+  FDKmemcpy(t->spectrum, t->input, BENCH_FRAME_SIZE * sizeof(FIXP_DBL));
+}
+
+static void benchImltRun(void* state) {
+  BENCH_IMLT* t = (BENCH_IMLT*)state;
+  imlt_block(&t->mdct, t->output, t->spectrum, t->specScale, t->nSpec, BENCH_FRAME_SIZE, t->tl,
+             t->window, t->tl, t->window, t->tl, (FIXP_DBL)0, 0);
+}
+
+static void benchImlt(void) {
+  BENCH_IMLT t;
+
+  FDKmemclear(&t, sizeof(t));
+  t.overlap = (FIXP_DBL*)benchAlloc(512 * sizeof(FIXP_DBL));
+  t.spectrum = (FIXP_DBL*)benchAlloc(BENCH_FRAME_SIZE * sizeof(FIXP_DBL));
+  t.input = (FIXP_DBL*)benchAlloc(BENCH_FRAME_SIZE * sizeof(FIXP_DBL));
+  t.output = (FIXP_DBL*)benchAlloc(BENCH_FRAME_SIZE * sizeof(FIXP_DBL));
+  benchFillRandom(t.input, BENCH_FRAME_SIZE, 4);
+  mdct_init(&t.mdct, t.overlap, 512);
+
+  for (int isShort = 0; isShort <= 1; isShort++) {
+    t.nSpec = isShort ? 8 : 1;
+    t.tl = BENCH_FRAME_SIZE / t.nSpec;
+    t.window = FDKgetWindowSlope(t.tl, 0);
+    benchRun("imlt_block", isShort ? "short 8x128" : "long 1024", BENCH_FRAME_SIZE, &t,
+             benchImltReset, benchImltRun);
+  }
+
+  benchFree(t.output);
+  benchFree(t.input);
+  benchFree(t.spectrum);
+  benchFree(t.overlap);
+}
+
+/********************* arithmetic spectral decoder **********************/
+
+#define BENCH_ARITH_BUFSIZE (1 << 16)
+#define BENCH_ARITH_OFFSETS 64
+
+typedef struct {
+  CArcoData* hArco;
+  FDK_BITSTREAM bs;
+  UCHAR* payload;
+  FIXP_DBL* spectrum;
+  int lg;
+  int nWindows;
+  UINT offsets[BENCH_ARITH_OFFSETS];
+  int numOffsets;
+  int next;
+} BENCH_ARITH;
+
+static void benchArithSeek(BENCH_ARITH* t, UINT offset) {
+  FDKinitBitStream(&t->bs, t->payload, BENCH_ARITH_BUFSIZE, BENCH_ARITH_BUFSIZE * 8);
+  FDKpushFor(&t->bs, offset * 8);
+}
+
+static int benchArithDecode(BENCH_ARITH* t) {
+  int err = 0;
+  for (int w = 0; w < t->nWindows; w++) {
+    err |= CArco_DecodeArithData(t->hArco, &t->bs, t->spectrum + w * t->lg, t->lg, t->lg, w == 0);
+  }
+  return err;
+}
+
+/* Random bits are decoded like a spectrum sampled from the context model. Some start positions
+ * run into invalid escape sequences, only keep the ones which decode without error. */
+static void benchArithFindOffsets(BENCH_ARITH* t) {
+  t->numOffsets = 0;
+  t->next = 0;
+  for (UINT offset = 0; offset < BENCH_ARITH_BUFSIZE / 2 && t->numOffsets < BENCH_ARITH_OFFSETS;
+       offset += 509) {
+    benchArithSeek(t, offset);
+    if (benchArithDecode(t) == ARITH_CODER_OK) {
+      t->offsets[t->numOffsets++] = offset;
+    }
+  }
+}
+
+static void benchArithReset(void* state) {
+  BENCH_ARITH* t = (BENCH_ARITH*)state;
+  benchArithSeek(t, t->offsets[t->next]);
+  t->next = (t->next + 1) % t->numOffsets;
+}
+
+static void benchArithRun(void* state) {
+  benchArithDecode((BENCH_ARITH*)state);
+}
+
+static void benchArith(void) {
+  BENCH_ARITH t;
+
+  FDKmemclear(&t, sizeof(t));
+  t.hArco = CArco_Create();
+  t.payload = (UCHAR*)benchAlloc(BENCH_ARITH_BUFSIZE);
+  t.spectrum = (FIXP_DBL*)benchAlloc(BENCH_FRAME_SIZE * sizeof(FIXP_DBL));
+  if (t.hArco == NULL) {
+    fprintf(stderr, "Error: out of memory\n");
+    exit(1);
+  }
+  for (int i = 0; i < BENCH_ARITH_BUFSIZE; i++) {
+    t.payload[i] = (UCHAR)(benchRand() >> 24);
+  }
+
+  for (int isShort = 0; isShort <= 1; isShort++) {
+    t.nWindows = isShort ? 8 : 1;
+    t.lg = BENCH_FRAME_SIZE / t.nWindows;
+    benchArithFindOffsets(&t);
+    if (t.numOffsets == 0) {
+      fprintf(stderr, "Error: no decodable arith_decode payload\n");
+      exit(1);
+    }
+    benchRun("arith_decode", isShort ? "short 8x128" : "long 1024", BENCH_FRAME_SIZE, &t,
+             benchArithReset, benchArithRun);
+  }
+
+  benchFree(t.spectrum);
+  benchFree(t.payload);
+  CArco_Destroy(t.hArco);
+}
+
+/********************* M/S and complex prediction stereo **********************/
+
+typedef struct {
+  SamplingRateInfo sri;
+  CAacDecoderChannelInfo channelInfo[2];
+  CAacDecoderStaticChannelInfo staticChannelInfo[2];
+  CAacDecoderChannelInfo* pChannelInfo[2];
+  CAacDecoderStaticChannelInfo* pStaticChannelInfo[2];
+  CAacDecoderDynamicData dynData[2];
+  CAacDecoderCommonStaticData comStaticData;
+  CpePersistentData cpeStaticData;
+  CJointStereoData* jointStereoData;
+  CCplxPredictionData* cplxPredictionData;
+  FIXP_DBL* spectrum[2];
+  FIXP_DBL* input;
+  FIXP_DBL* scratch;
+  SHORT aSfbScale[8 * 16];
+  UINT64 mctMask;
+  CMct* hMct;
+  UINT mctElFlags[2];
+  CStreamInfo streamInfo;
+} BENCH_STEREO;
+
+static void benchStereoInit(BENCH_STEREO* t) {
+  FDKmemclear(t, sizeof(*t));
+  getSamplingRateInfo(&t->sri, BENCH_FRAME_SIZE, BENCH_SAMPLE_RATE_INDEX, BENCH_SAMPLE_RATE);
+
+  t->input = (FIXP_DBL*)benchAlloc(2 * BENCH_FRAME_SIZE * sizeof(FIXP_DBL));
+  t->scratch = (FIXP_DBL*)benchAlloc(3 * BENCH_FRAME_SIZE * sizeof(FIXP_DBL));
+  t->jointStereoData = (CJointStereoData*)benchAlloc(sizeof(CJointStereoData));
+  t->cplxPredictionData = (CCplxPredictionData*)benchAlloc(sizeof(CCplxPredictionData));
+  benchFillRandom(t->input, 2 * BENCH_FRAME_SIZE, 8);
+
+  t->comStaticData.cplxPredictionData = t->cplxPredictionData;
+  t->comStaticData.pJointStereoData = t->jointStereoData;
+  t->cpeStaticData.jointStereoPersistentData.scratchBuffer = t->scratch;
+  t->cpeStaticData.jointStereoPersistentData.scratchBuffer2 = t->scratch + 2 * BENCH_FRAME_SIZE;
+
+  for (int ch = 0; ch < 2; ch++) {
+    CAacDecoderChannelInfo* ci = &t->channelInfo[ch];
+    CIcsInfo* ics = &ci->icsInfo;
+
+    t->spectrum[ch] = (FIXP_DBL*)benchAlloc(BENCH_FRAME_SIZE * sizeof(FIXP_DBL));
+    ci->pSpectralCoefficient = t->spectrum[ch];
+    ci->pDynData = &t->dynData[ch];
+    ci->pComStaticData = &t->comStaticData;
+    ci->granuleLength = BENCH_FRAME_SIZE / 8;
+
+    ics->WindowSequence = BLOCK_LONG;
+    ics->WindowShape = 0;
+    ics->WindowGroups = 1;
+    ics->WindowGroupLength[0] = 1;
+    ics->TotalSfBands = t->sri.NumberOfScaleFactorBands_Long;
+    ics->MaxSfBands = ics->TotalSfBands;
+    ics->max_sfb_ste = ics->TotalSfBands;
+    ics->Valid = 1;
+
+    t->staticChannelInfo[ch].pCpeStaticData = &t->cpeStaticData;
+    t->cpeStaticData.jointStereoPersistentData.spectralCoeffs[ch] = t->spectrum[ch];
+    t->cpeStaticData.jointStereoPersistentData.specScale[ch] = ci->specScale;
+
+    t->pChannelInfo[ch] = ci;
+    t->pStaticChannelInfo[ch] = &t->staticChannelInfo[ch];
+  }
+
+  for (int sfb = 0; sfb < 8 * 16; sfb++) {
+    t->aSfbScale[sfb] = 2;
+  }
+  t->streamInfo.aacSamplesPerFrame = BENCH_FRAME_SIZE;
+}
+
+static void benchStereoFree(BENCH_STEREO* t) {
+  if (t->hMct != NULL) {
+    CMct_Destroy(t->hMct);
+  }
+  for (int ch = 0; ch < 2; ch++) {
+    benchFree(t->spectrum[ch]);
+  }
+  benchFree(t->cplxPredictionData);
+  benchFree(t->jointStereoData);
+  benchFree(t->scratch);
+  benchFree(t->input);
+}
+
+static void benchStereoReset(void* state) {
+  BENCH_STEREO* t = (BENCH_STEREO*)state;
+  for (int ch = 0; ch < 2; ch++) {
+    CAacDecoderChannelInfo* ci = &t->channelInfo[ch];
+    FDKmemcpy(t->spectrum[ch], t->input + ch * BENCH_FRAME_SIZE,
+              BENCH_FRAME_SIZE * sizeof(FIXP_DBL));
+    FDKmemcpy(ci->pDynData->aSfbScale, t->aSfbScale, sizeof(t->aSfbScale));
+    for (int w = 0; w < 8; w++) {
+      ci->specScale[w] = 2;
+    }
+    /* noise filled bands for the stereo filling */
+    FDKmemclear(ci->pDynData->band_is_noise, sizeof(ci->pDynData->band_is_noise));
+    for (int sfb = ci->icsInfo.TotalSfBands / 2; sfb < ci->icsInfo.TotalSfBands; sfb += 3) {
+      ci->pDynData->band_is_noise[sfb] = 1;
+    }
+  }
+}
+
+static void benchStereoMsRun(void* state) {
+  BENCH_STEREO* t = (BENCH_STEREO*)state;
+  CAacDecoderChannelInfo* L = t->pChannelInfo[0];
+  CAacDecoderChannelInfo* R = t->pChannelInfo[1];
+  CIcsInfo* ics = &L->icsInfo;
+
+  CJointStereo_ApplyMS(t->pChannelInfo, t->pStaticChannelInfo, L->pSpectralCoefficient,
+                       R->pSpectralCoefficient, L->pDynData->aSfbScale, R->pDynData->aSfbScale,
+                       L->specScale, R->specScale, GetScaleFactorBandOffsets(ics, &t->sri),
+                       GetWindowGroupLengthTable(ics), GetWindowGroups(ics), ics->max_sfb_ste,
+                       ics->MaxSfBands, R->icsInfo.MaxSfBands,
+                       t->jointStereoData->store_dmx_re_prev,
+                       &t->jointStereoData->store_dmx_re_prev_e, 1);
+}
+
+static void benchStereoMctRun(void* state) {
+  BENCH_STEREO* t = (BENCH_STEREO*)state;
+  CMct_MCT_StereoFilling(t->hMct, &t->streamInfo, t->pChannelInfo, t->pStaticChannelInfo, &t->sri,
+                         t->mctElFlags, 0);
+}
+
+static void benchStereo(void) {
+  BENCH_STEREO t;
+  CJointStereoData* js;
+
+  benchStereoInit(&t);
+  js = t.jointStereoData;
+
+  /* M/S in all bands */
+  js->MsMaskPresent = 2;
+  js->cplx_pred_flag = 0;
+  FDKmemset(js->MsUsed, 1, sizeof(js->MsUsed));
+  benchRun("stereo_ms", "M/S long 1024", BENCH_FRAME_SIZE, &t, benchStereoReset, benchStereoMsRun);
+
+  /* complex prediction with MDST estimation from the current frame */
+  js->MsMaskPresent = 3;
+  js->cplx_pred_flag = 1;
+  t.cplxPredictionData->pred_dir = 0;
+  t.cplxPredictionData->complex_coef = 1;
+  t.cplxPredictionData->use_prev_frame = 0;
+  for (int band = 0; band < JointStereoMaximumBands; band++) {
+    t.cplxPredictionData->alpha_q_re[0][band] = (SHORT)((band % 7) - 3);
+    t.cplxPredictionData->alpha_q_im[0][band] = (SHORT)((band % 5) - 2);
+  }
+  benchRun("stereo_ms", "cplx pred long 1024", BENCH_FRAME_SIZE, &t, benchStereoReset,
+           benchStereoMsRun);
+
+  /* multichannel coding tool on one channel pair */
+  if (CMct_Initialize(&t.hMct, 0xC0000000, 0, 2) != 0) {
+    fprintf(stderr, "Error: CMct_Initialize() failed\n");
+    exit(1);
+  }
+  CMctWork* work = t.hMct->mctWork;
+  int numMctBands = (t.sri.NumberOfScaleFactorBands_Long + 1) / 2;
+
+  work->numPairs = 1;
+  work->codePairs[0][0] = 0;
+  work->codePairs[0][1] = 1;
+  work->numMctMaskBands[0] = (UCHAR)numMctBands;
+  work->mctMask[0] = ~(UINT64)0;
+  for (int band = 0; band < numMctBands; band++) {
+    work->pairCoeffDeltaSfb[0][band] = (UCHAR)(band % 4);
+  }
+
+  t.hMct->MCCSignalingType = 1;
+  work->pairCoeffDeltaFb[0] = 8;
+  benchRun("mct", "rotation fullband", BENCH_FRAME_SIZE, &t, benchStereoReset, benchStereoMctRun);
+
+  t.hMct->MCCSignalingType = 0;
+  work->bHasBandwiseCoeffs[0] = 1;
+  work->bHasMctMask[0] = 1;
+  benchRun("mct", "prediction bandwise", BENCH_FRAME_SIZE, &t, benchStereoReset,
+           benchStereoMctRun);
+
+  t.hMct->MCCSignalingType = 1;
+  work->bHasBandwiseCoeffs[0] = 0;
+  work->bHasMctMask[0] = 0;
+  work->hasStereoFilling[0] = 1;
+  benchFillRandom(t.hMct->prevOutSpec, 2 * BENCH_FRAME_SIZE, 8);
+  FDKmemclear(t.hMct->prevOutSpec_exp, 2 * 8 * 16 * sizeof(SHORT));
+  benchRun("mct", "rotation stereo filling", BENCH_FRAME_SIZE, &t, benchStereoReset,
+           benchStereoMctRun);
+
+  benchStereoFree(&t);
+}
+
+/********************* format converter **********************/
+
+typedef struct {
+  IIS_FORMATCONVERTER_HANDLE hFc;
+  FIXP_DBL* input;
+  FIXP_DBL* inputCopy;
+  FIXP_DBL* inPtrs[32];
+  FIXP_DBL* output;
+  int numIn;
+} BENCH_FC;
+
+static void benchFcReset(void* state) {
+  BENCH_FC* t = (BENCH_FC*)state;
+  FDKmemcpy(t->inputCopy, t->input, t->numIn * BENCH_FRAME_SIZE * sizeof(FIXP_DBL));
+}
+
+static void benchFcRun(void* state) {
+  BENCH_FC* t = (BENCH_FC*)state;
+  IIS_FormatConverter_Process(t->hFc, NULL, t->inPtrs, t->output, BENCH_FRAME_SIZE);
+}
+
+static void benchFormatConverterCase(int cicpIn, int cicpOut, IIS_FORMATCONVERTER_MODE mode,
+                                     int active, INT* fcBuffer) {
+  CICP2GEOMETRY_CHANNEL_GEOMETRY inGeo[32], outGeo[32];
+  int inChannels, inLfe, outChannels, outLfe;
+  BENCH_FC t;
+  char config[64];
+
+  FDKmemclear(&t, sizeof(t));
+  FDKmemclear(inGeo, sizeof(inGeo));
+  FDKmemclear(outGeo, sizeof(outGeo));
+  if (cicp2geometry_get_geometry_from_cicp(cicpIn, inGeo, &inChannels, &inLfe) ||
+      cicp2geometry_get_geometry_from_cicp(cicpOut, outGeo, &outChannels, &outLfe)) {
+    fprintf(stderr, "Error: unknown CICP layout\n");
+    exit(1);
+  }
+  t.numIn = inChannels + inLfe;
+
+  if (IIS_FormatConverter_Create(&t.hFc, mode, outGeo, outChannels + outLfe, BENCH_SAMPLE_RATE,
+                                 BENCH_FRAME_SIZE)) {
+    fprintf(stderr, "Error: IIS_FormatConverter_Create() failed\n");
+    exit(1);
+  }
+  t.hFc->numSignalsTotal += t.numIn;
+  if (IIS_FormatConverter_Config_AddInputSetup(t.hFc, inGeo, t.numIn, 0, 0)) {
+    fprintf(stderr, "Error: IIS_FormatConverter_Config_AddInputSetup() failed\n");
+    exit(1);
+  }
+  IIS_FormatConverter_Config_SetAES(t.hFc, active ? 7 : 0);
+  IIS_FormatConverter_Config_SetPAS(t.hFc, active ? 3 : 0);
+  if (IIS_FormatConverter_Open(t.hFc, fcBuffer, sizeof(INT) * (24) * (1024 * 3))) {
+    fprintf(stderr, "Error: IIS_FormatConverter_Open() failed\n");
+    exit(1);
+  }
+
+  t.input = (FIXP_DBL*)benchAlloc(t.numIn * BENCH_FRAME_SIZE * sizeof(FIXP_DBL));
+  t.inputCopy = (FIXP_DBL*)benchAlloc(t.numIn * BENCH_FRAME_SIZE * sizeof(FIXP_DBL));
+  t.output = (FIXP_DBL*)benchAlloc((outChannels + outLfe) * BENCH_FRAME_SIZE * sizeof(FIXP_DBL));
+  benchFillRandom(t.input, t.numIn * BENCH_FRAME_SIZE, 8);
+  for (int ch = 0; ch < t.numIn; ch++) {
+    t.inPtrs[ch] = t.inputCopy + ch * BENCH_FRAME_SIZE;
+  }
+
+  snprintf(config, sizeof(config), "%s CICP %d -> %d",
+           (mode == IIS_FORMATCONVERTER_MODE_PASSIVE_TIME_DOMAIN) ? "time passive"
+           : active                                               ? "stft active"
+                                                                  : "stft passive",
+           cicpIn, cicpOut);
+  benchRun("format_conv", config, BENCH_FRAME_SIZE * t.numIn, &t, benchFcReset, benchFcRun);
+
+  IIS_FormatConverter_Close(&t.hFc);
+  benchFree(t.output);
+  benchFree(t.inputCopy);
+  benchFree(t.input);
+}
+
+typedef struct {
+  CICP2GEOMETRY_CHANNEL_GEOMETRY inGeo[32];
+  CICP2GEOMETRY_CHANNEL_GEOMETRY outGeo[32];
+  int numIn;
+  int numOut;
+  INT* fcBuffer;
+} BENCH_FC_SETUP;
+
+/* Format converter setup as done by the decoder for a new configuration: downmix matrix, EQs and
+ * the STFT active downmix state. */
+static void benchFcSetupRun(void* state) {
+  BENCH_FC_SETUP* t = (BENCH_FC_SETUP*)state;
+  IIS_FORMATCONVERTER_HANDLE hFc = NULL;
+
+  if (IIS_FormatConverter_Create(&hFc, IIS_FORMATCONVERTER_MODE_CUSTOM_FREQ_DOMAIN_STFT, t->outGeo,
+                                 t->numOut, BENCH_SAMPLE_RATE, BENCH_FRAME_SIZE)) {
+    fprintf(stderr, "Error: IIS_FormatConverter_Create() failed\n");
+    exit(1);
+  }
+  hFc->numSignalsTotal += t->numIn;
+  IIS_FormatConverter_Config_AddInputSetup(hFc, t->inGeo, t->numIn, 0, 0);
+  IIS_FormatConverter_Config_SetAES(hFc, 7);
+  IIS_FormatConverter_Config_SetPAS(hFc, 3);
+  if (IIS_FormatConverter_Open(hFc, t->fcBuffer, sizeof(INT) * (24) * (1024 * 3))) {
+    fprintf(stderr, "Error: IIS_FormatConverter_Open() failed\n");
+    exit(1);
+  }
+  IIS_FormatConverter_Close(&hFc);
+}
+
+/* The setup is counted in samples of one frame of the same configuration, the ratio to the
+ * processing line is the setup time in frames. */
+static void benchFormatConverterSetup(int cicpIn, int cicpOut, INT* fcBuffer) {
+  BENCH_FC_SETUP t;
+  int inChannels, inLfe, outChannels, outLfe;
+  char config[64];
+
+  FDKmemclear(&t, sizeof(t));
+  cicp2geometry_get_geometry_from_cicp(cicpIn, t.inGeo, &inChannels, &inLfe);
+  cicp2geometry_get_geometry_from_cicp(cicpOut, t.outGeo, &outChannels, &outLfe);
+  t.numIn = inChannels + inLfe;
+  t.numOut = outChannels + outLfe;
+  t.fcBuffer = fcBuffer;
+
+  snprintf(config, sizeof(config), "setup stft active CICP %d -> %d", cicpIn, cicpOut);
+  benchRun("format_conv", config, BENCH_FRAME_SIZE * t.numIn, &t, NULL, benchFcSetupRun);
+}
+
+static void benchFormatConverter(void) {
+  INT* fcBuffer = (INT*)benchAlloc(sizeof(INT) * (24) * (1024 * 3));
+
+  benchFormatConverterCase(13, 6, IIS_FORMATCONVERTER_MODE_CUSTOM_FREQ_DOMAIN_STFT, 1, fcBuffer);
+  benchFormatConverterCase(13, 6, IIS_FORMATCONVERTER_MODE_CUSTOM_FREQ_DOMAIN_STFT, 0, fcBuffer);
+  benchFormatConverterCase(19, 2, IIS_FORMATCONVERTER_MODE_CUSTOM_FREQ_DOMAIN_STFT, 1, fcBuffer);
+  benchFormatConverterCase(13, 6, IIS_FORMATCONVERTER_MODE_PASSIVE_TIME_DOMAIN, 0, fcBuffer);
+  benchFormatConverterCase(13, 2, IIS_FORMATCONVERTER_MODE_PASSIVE_TIME_DOMAIN, 0, fcBuffer);
+
+  benchFormatConverterSetup(13, 6, fcBuffer);
+  benchFormatConverterSetup(19, 2, fcBuffer);
+
+  benchFree(fcBuffer);
+}
+
+/********************* object renderer **********************/
+
+#define BENCH_VBAP_DELAY 256
+
+typedef struct {
+  HANDLE_GVBAPRENDERER hRenderer;
+  FIXP_DBL* input;
+  FIXP_DBL* output;
+  int numObjects;
+  int numOutChannels;
+  int frame;
+} BENCH_VBAP;
+
+static void benchVbapReset(void* state) {
+  BENCH_VBAP* t = (BENCH_VBAP*)state;
+  GVBAPRENDERER* r = t->hRenderer;
+
+  /* slowly moving objects, forces the gain interpolation */
+  t->frame++;
+  for (int f = 0; f < r->numOamFrames; f++) {
+    for (int o = 0; o < t->numObjects; o++) {
+      OAM_SAMPLE* s = &r->oamSamples[f][o];
+      INT azi = ((o * 2 * 97 + t->frame * 3) % 256) - 128;
+      INT ele = (o * 37 % 64) - 16;
+      s->sph.azi = (FIXP_DBL)(azi << (DFRACT_BITS - 1 - 7));
+      s->sph.ele = (FIXP_DBL)(ele << (DFRACT_BITS - 1 - 7));
+      s->sph.rad = FL2FXCONST_DBL(1.0 / 16);
+      s->gain = FL2FX_DBL(1.00f / 8.0f);
+      s->spreadAngle = (FIXP_DBL)0;
+      s->spreadHeight = (FIXP_DBL)0;
+      s->spreadDepth = (FIXP_DBL)0;
+    }
+    r->metadataPresent[f] = 1;
+  }
+  r->oamDataValid = 1;
+  FDKmemclear(t->output, t->numOutChannels * BENCH_FRAME_SIZE * sizeof(FIXP_DBL));
+}
+
+static void benchVbapRun(void* state) {
+  BENCH_VBAP* t = (BENCH_VBAP*)state;
+  gVBAPRenderer_RenderFrame_Time(t->hRenderer, t->input, t->output, BENCH_VBAP_DELAY,
+                                 BENCH_FRAME_SIZE + BENCH_VBAP_DELAY, NULL);
+}
+
+typedef struct {
+  CICP2GEOMETRY_CHANNEL_GEOMETRY outGeo[32];
+  int numOutChannels;
+  int cicpOut;
+  int useGainGrid;
+  UCHAR* setupCache;
+  UINT setupCacheSize;
+} BENCH_VBAP_SETUP;
+
+static void benchVbapSetupRun(void* state) {
+  BENCH_VBAP_SETUP* t = (BENCH_VBAP_SETUP*)state;
+  HANDLE_GVBAPRENDERER hRenderer = NULL;
+
+  if (gVBAPRenderer_Open(&hRenderer, 16, BENCH_FRAME_SIZE, BENCH_FRAME_SIZE, t->outGeo,
+                         t->numOutChannels, t->cicpOut, 1, GVBAP_ENHANCED, t->useGainGrid,
+                         t->setupCache, t->setupCacheSize) != 0) {
+    fprintf(stderr, "Error: gVBAPRenderer_Open() failed\n");
+    exit(1);
+  }
+  gVBAPRenderer_Close(hRenderer);
+}
+
+/* Renderer setup with and without the setup cache, counted like the format converter setup in
+ * samples of one frame with 16 objects (vbap_render 16 obj). */
+static void benchVbapSetup(int cicpOut) {
+  BENCH_VBAP_SETUP t;
+  int outChannels, outLfe;
+  char config[64];
+
+  FDKmemclear(&t, sizeof(t));
+  cicp2geometry_get_geometry_from_cicp(cicpOut, t.outGeo, &outChannels, &outLfe);
+  t.numOutChannels = outChannels + outLfe;
+  t.cicpOut = cicpOut;
+
+  for (t.useGainGrid = 0; t.useGainGrid <= 1; t.useGainGrid++) {
+    HANDLE_GVBAPRENDERER hRenderer = NULL;
+    UINT used = 0;
+
+    t.setupCache = NULL;
+    t.setupCacheSize = 0;
+    snprintf(config, sizeof(config), "setup%s CICP %d", t.useGainGrid ? " grid" : "", cicpOut);
+    benchRun("vbap_render", config, BENCH_FRAME_SIZE * 16, &t, NULL, benchVbapSetupRun);
+
+    if (gVBAPRenderer_Open(&hRenderer, 16, BENCH_FRAME_SIZE, BENCH_FRAME_SIZE, t.outGeo,
+                           t.numOutChannels, cicpOut, 1, GVBAP_ENHANCED, t.useGainGrid, NULL,
+                           0) != 0) {
+      fprintf(stderr, "Error: gVBAPRenderer_Open() failed\n");
+      exit(1);
+    }
+    gVBAPRenderer_AppendSetup(hRenderer, NULL, 0, &used);
+    t.setupCacheSize = used;
+    t.setupCache = (UCHAR*)benchAlloc(t.setupCacheSize);
+    used = 0;
+    gVBAPRenderer_AppendSetup(hRenderer, t.setupCache, t.setupCacheSize, &used);
+    gVBAPRenderer_Close(hRenderer);
+
+    snprintf(config, sizeof(config), "setup%s cached CICP %d", t.useGainGrid ? " grid" : "",
+             cicpOut);
+    benchRun("vbap_render", config, BENCH_FRAME_SIZE * 16, &t, NULL, benchVbapSetupRun);
+    benchFree(t.setupCache);
+  }
+}
+
+static void benchVbap(void) {
+  static const int numObjects[] = {1, 4, 16};
+  static const int cicpOut[] = {6, 19, 13};
+  char config[64];
+
+  for (size_t l = 0; l < sizeof(cicpOut) / sizeof(cicpOut[0]); l++) {
+    for (size_t n = 0; n < sizeof(numObjects) / sizeof(numObjects[0]); n++) {
+      CICP2GEOMETRY_CHANNEL_GEOMETRY outGeo[32];
+      int outChannels, outLfe;
+      BENCH_VBAP t;
+
+      FDKmemclear(&t, sizeof(t));
+      FDKmemclear(outGeo, sizeof(outGeo));
+      cicp2geometry_get_geometry_from_cicp(cicpOut[l], outGeo, &outChannels, &outLfe);
+      t.numObjects = numObjects[n];
+      t.numOutChannels = outChannels + outLfe;
+
+      if (gVBAPRenderer_Open(&t.hRenderer, t.numObjects, BENCH_FRAME_SIZE, BENCH_FRAME_SIZE, outGeo,
+                             t.numOutChannels, cicpOut[l], 1, GVBAP_LEGACY, 0, NULL, 0) != 0) {
+        fprintf(stderr, "Error: gVBAPRenderer_Open() failed\n");
+        exit(1);
+      }
+
+      t.input = (FIXP_DBL*)benchAlloc(t.numObjects * (BENCH_FRAME_SIZE + BENCH_VBAP_DELAY) *
+                                      sizeof(FIXP_DBL));
+      t.output = (FIXP_DBL*)benchAlloc(t.numOutChannels * BENCH_FRAME_SIZE * sizeof(FIXP_DBL));
+      benchFillRandom(t.input, t.numObjects * (BENCH_FRAME_SIZE + BENCH_VBAP_DELAY), 8);
+
+      snprintf(config, sizeof(config), "%d obj -> CICP %d", t.numObjects, cicpOut[l]);
+      benchRun("vbap_render", config, BENCH_FRAME_SIZE * t.numObjects, &t, benchVbapReset,
+               benchVbapRun);
+
+      gVBAPRenderer_Close(t.hRenderer);
+      benchFree(t.output);
+      benchFree(t.input);
+    }
+  }
+
+  benchVbapSetup(6);
+  benchVbapSetup(19);
+}
+
+/********************* peak limiter **********************/
+
+typedef struct {
+  TDLimiterPtr hLimiter;
+  PCM_LIM* input;
+  PCM_LIM* inputCopy;
+  INT_PCM* output;
+  PCM_LIM* workBuf;
+  int numChannels;
+} BENCH_LIMITER;
+
+static void benchLimiterReset(void* state) {
+  BENCH_LIMITER* t = (BENCH_LIMITER*)state;
+  FDKmemcpy(t->inputCopy, t->input, t->numChannels * BENCH_FRAME_SIZE * sizeof(PCM_LIM));
+}
+
+static void benchLimiterRun(void* state) {
+  BENCH_LIMITER* t = (BENCH_LIMITER*)state;
+  pcmLimiter_Apply(t->hLimiter, t->inputCopy, t->output, t->workBuf, NULL, PCM_OUT_HEADROOM,
+                   BENCH_FRAME_SIZE);
+}
+
+static void benchLimiter(void) {
+  static const int numChannels[] = {2, 6, 24};
+  char config[64];
+  BENCH_LIMITER t;
+
+  FDKmemclear(&t, sizeof(t));
+  t.hLimiter = pcmLimiter_Create(TDL_MPEGH3DA_DEFAULT_ATTACK, TDL_RELEASE_DEFAULT_MS,
+                                 (FIXP_DBL)MAXVAL_DBL, (24), BENCH_SAMPLE_RATE);
+  if (t.hLimiter == NULL) {
+    fprintf(stderr, "Error: pcmLimiter_Create() failed\n");
+    exit(1);
+  }
+  t.input = (PCM_LIM*)benchAlloc(24 * BENCH_FRAME_SIZE * sizeof(PCM_LIM));
+  t.inputCopy = (PCM_LIM*)benchAlloc(24 * BENCH_FRAME_SIZE * sizeof(PCM_LIM));
+  t.output = (INT_PCM*)benchAlloc(24 * BENCH_FRAME_SIZE * sizeof(INT_PCM));
+  t.workBuf = (PCM_LIM*)benchAlloc(BENCH_FRAME_SIZE * sizeof(PCM_LIM));
+
+  for (int clipping = 0; clipping <= 1; clipping++) {
+    /* The limiter input carries PCM_OUT_HEADROOM bits of headroom. Clean input stays 12 dB below
+       full scale, clipping input peaks up to 12 dB above. */
+    benchFillRandom((FIXP_DBL*)t.input, 24 * BENCH_FRAME_SIZE,
+                    clipping ? PCM_OUT_HEADROOM - 2 : PCM_OUT_HEADROOM + 2);
+    for (size_t c = 0; c < sizeof(numChannels) / sizeof(numChannels[0]); c++) {
+      t.numChannels = numChannels[c];
+      pcmLimiter_SetNChannels(t.hLimiter, t.numChannels);
+      pcmLimiter_SetSampleRate(t.hLimiter, BENCH_SAMPLE_RATE);
+      pcmLimiter_Reset(t.hLimiter);
+      snprintf(config, sizeof(config), "%s %dch", clipping ? "clipping" : "clean", t.numChannels);
+      benchRun("limiter", config, BENCH_FRAME_SIZE * t.numChannels, &t, benchLimiterReset,
+               benchLimiterRun);
+    }
+  }
+
+  benchFree(t.workBuf);
+  benchFree(t.output);
+  benchFree(t.inputCopy);
+  benchFree(t.input);
+  pcmLimiter_Destroy(t.hLimiter);
+}
+
+/********************* DRC gain decoding and application **********************/
+
+typedef struct {
+  HANDLE_DRC_DECODER hDrc;
+  FDK_BITSTREAM bs;
+  UCHAR gainPayload[2][64];
+  FIXP_DBL* input;
+  FIXP_DBL* audio;
+  int numChannels;
+  int frame;
+} BENCH_DRC;
+
+/* One gain set with a single band, applied to all channels by a night mode DRC set. */
+static UINT benchDrcWriteConfig(UCHAR* buf, int numChannels) {
+  UINT pos = 0;
+  benchPutBits(buf, &pos, 1, 3);           /* drcCoefficientsUniDrcCount */
+  benchPutBits(buf, &pos, 1, 6);           /* drcInstructionsUniDrcCount */
+  benchPutBits(buf, &pos, numChannels, 7); /* baseChannelCount */
+  /* drcCoefficientsUniDrc() */
+  benchPutBits(buf, &pos, 1, 4); /* drcLocation */
+  benchPutBits(buf, &pos, 0, 1); /* drcFrameSizePresent */
+  benchPutBits(buf, &pos, 1, 6); /* gainSetCount */
+  benchPutBits(buf, &pos, 0, 2); /* gainCodingProfile: regular */
+  benchPutBits(buf, &pos, 1, 1); /* gainInterpolationType: linear */
+  benchPutBits(buf, &pos, 0, 1); /* fullFrame */
+  benchPutBits(buf, &pos, 0, 1); /* timeAlignment */
+  benchPutBits(buf, &pos, 0, 1); /* timeDeltaMinPresent */
+  benchPutBits(buf, &pos, 1, 4); /* bandCount */
+  benchPutBits(buf, &pos, 0, 7); /* drcCharacteristic */
+  /* drcInstructionsUniDrc() */
+  benchPutBits(buf, &pos, 0, 1);  /* drcInstructionsType */
+  benchPutBits(buf, &pos, 1, 6);  /* drcSetId */
+  benchPutBits(buf, &pos, 1, 4);  /* drcLocation */
+  benchPutBits(buf, &pos, 0, 7);  /* downmixId */
+  benchPutBits(buf, &pos, 0, 1);  /* additionalDownmixIdPresent */
+  benchPutBits(buf, &pos, 1, 16); /* drcSetEffect: night */
+  benchPutBits(buf, &pos, 0, 1);  /* limiterPeakTargetPresent */
+  benchPutBits(buf, &pos, 0, 1);  /* drcSetTargetLoudnessPresent */
+  benchPutBits(buf, &pos, 0, 1);  /* dependsOnDrcSetPresent */
+  benchPutBits(buf, &pos, 0, 1);  /* noIndependentUse */
+  benchPutBits(buf, &pos, 1, 6);  /* bsGainSetIndex */
+  benchPutBits(buf, &pos, (numChannels > 1) ? 1 : 0, 1); /* repeatSequenceIndex */
+  if (numChannels > 1) {
+    benchPutBits(buf, &pos, numChannels - 2, 5); /* bsRepeatSequenceCount */
+  }
+  benchPutBits(buf, &pos, 0, 1); /* gainScalingPresent */
+  benchPutBits(buf, &pos, 0, 1); /* gainOffsetPresent */
+  benchPutBits(buf, &pos, 0, 1); /* uniDrcConfigExtPresent */
+  benchPutBits(buf, &pos, 0, 1); /* loudnessInfoSetPresent */
+  return pos;
+}
+
+static void benchDrcWriteGain(UCHAR* buf, int gainMagnitude) {
+  UINT pos = 0;
+  benchPutBits(buf, &pos, 0, 1);             /* drcGainCodingMode: simple */
+  benchPutBits(buf, &pos, 1, 1);             /* sign */
+  benchPutBits(buf, &pos, gainMagnitude, 8); /* gain in steps of 0.125 dB */
+  benchPutBits(buf, &pos, 0, 1);             /* uniDrcGainExtPresent */
+}
+
+static void benchDrcReset(void* state) {
+  BENCH_DRC* t = (BENCH_DRC*)state;
+
+  /* alternate between two gains, the gain curve is interpolated in every frame */
+  t->frame ^= 1;
+  FDKinitBitStream(&t->bs, t->gainPayload[t->frame], 64, 64 * 8);
+  FDK_drcDec_ReadUniDrcGain(t->hDrc, &t->bs, 0);
+  FDK_drcDec_Preprocess(t->hDrc);
+  FDKmemcpy(t->audio, t->input, t->numChannels * BENCH_FRAME_SIZE * sizeof(FIXP_DBL));
+}
+
+static void benchDrcRun(void* state) {
+  BENCH_DRC* t = (BENCH_DRC*)state;
+  FDK_drcDec_ProcessTime(t->hDrc, 0, DRC_DEC_DRC1, 0, 0, t->numChannels, t->audio,
+                         BENCH_FRAME_SIZE);
+}
+
+static void benchDrc(void) {
+  static const int numChannels[] = {2, 6, 24};
+  char config[64];
+
+  for (size_t c = 0; c < sizeof(numChannels) / sizeof(numChannels[0]); c++) {
+    UCHAR configPayload[64];
+    BENCH_DRC t;
+
+    FDKmemclear(&t, sizeof(t));
+    FDKmemclear(configPayload, sizeof(configPayload));
+    t.numChannels = numChannels[c];
+
+    if (FDK_drcDec_Open(&t.hDrc, DRC_DEC_ALL) ||
+        FDK_drcDec_SetCodecMode(t.hDrc, DRC_DEC_MPEG_H_3DA) ||
+        FDK_drcDec_Init(t.hDrc, BENCH_FRAME_SIZE, BENCH_SAMPLE_RATE, t.numChannels)) {
+      fprintf(stderr, "Error: DRC decoder initialization failed\n");
+      exit(1);
+    }
+    FDK_drcDec_SetParam(t.hDrc, DRC_DEC_EFFECT_TYPE, (FIXP_DBL)1); /* night mode */
+
+    benchDrcWriteConfig(configPayload, t.numChannels);
+    FDKinitBitStream(&t.bs, configPayload, 64, 64 * 8);
+    if (FDK_drcDec_ReadUniDrcConfig(t.hDrc, &t.bs, 0)) {
+      fprintf(stderr, "Error: FDK_drcDec_ReadUniDrcConfig() failed\n");
+      exit(1);
+    }
+    benchDrcWriteGain(t.gainPayload[0], 24); /* -3 dB */
+    benchDrcWriteGain(t.gainPayload[1], 48); /* -6 dB */
+
+    t.input = (FIXP_DBL*)benchAlloc(t.numChannels * BENCH_FRAME_SIZE * sizeof(FIXP_DBL));
+    t.audio = (FIXP_DBL*)benchAlloc(t.numChannels * BENCH_FRAME_SIZE * sizeof(FIXP_DBL));
+    benchFillRandom(t.input, t.numChannels * BENCH_FRAME_SIZE, 4);
+
+    snprintf(config, sizeof(config), "time domain %dch", t.numChannels);
+    benchRun("drc_gain", config, BENCH_FRAME_SIZE * t.numChannels, &t, benchDrcReset,
+             benchDrcRun);
+
+    benchFree(t.audio);
+    benchFree(t.input);
+    FDK_drcDec_Close(&t.hDrc);
+  }
+}
+
+/********************* main **********************/
+
+static void benchUsage(const char* name) {
+  fprintf(stderr, "Usage: %s [-t <ms>] [filter]\n\n", name);
+  fprintf(stderr, "  -t <ms>   minimum measurement time per kernel and variant (default: 100)\n");
+  fprintf(stderr, "  filter    only run kernels whose name and configuration contain <filter>\n");
+}
+
+int main(int argc, char** argv) {
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-t") && i + 1 < argc) {
+      benchMinTime = atof(argv[++i]) * 1e-3;
+    } else if (argv[i][0] == '-') {
+      benchUsage(argv[0]);
+      return 1;
+    } else {
+      benchFilter = argv[i];
+    }
+  }
+
+  benchCalibrateTimer();
+
+  printf("%-16s %-32s %-7s %12s %12s\n", "kernel", "configuration", "isa", "cycles/smp",
+         "Msmp/s");
+
+  benchTransforms();
+  benchImlt();
+  benchArith();
+  benchStereo();
+  benchFormatConverter();
+  benchVbap();
+  benchLimiter();
+  benchDrc();
+
+  return 0;
+}
@@ -81,8 +81,11 @@ amm-info@iis.fraunhofer.de
 -----------------------------------------------------------------------------*/
 
 // system includes
+#include <fstream>
 #include <functional>
 #include <iomanip>
+#include <iterator>
+#include <vector>
 
 // external includes
 #include "ilo/memory.h"
@@ -136,6 +139,9 @@ static PARAMETER_ASSIGNMENT_TAB paramList[] = {
      "(-dc %d)"},
     {MPEGH_DEC_PARAM_ALBUM_MODE, "MPEG-D DRC: album mode, 0: disabled (default), 1: enabled",
      "-dam", "(-dam %d)"},
+    {MPEGH_DEC_PARAM_VBAP_GAIN_GRID,
+     "Object panning with a precomputed gain grid, 0: disabled (default), 1: enabled", "-vgg",
+     "(-vgg %d)"},
 };
 
 static constexpr int32_t defaultCicpSetup = 6;
@@ -188,6 +194,37 @@ class CProcessor {
     }
   }
 
+  void loadRendererSetup(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+      // not saved yet
+      return;
+    }
+    std::vector<uint8_t> setup((std::istreambuf_iterator<char>(file)),
+                               std::istreambuf_iterator<char>());
+    if (setup.empty() ||
+        mpeghdecoder_setRendererSetup(m_decoder, setup.data(), (uint32_t)setup.size()) !=
+            MPEGH_DEC_OK) {
+      std::cout << "Warning: Failed to load renderer setup file " << filename << std::endl;
+    }
+  }
+
+  void saveRendererSetup(const std::string& filename) {
+    uint32_t setupSize = 0;
+    if (mpeghdecoder_getRendererSetup(m_decoder, nullptr, 0, &setupSize) != MPEGH_DEC_OK ||
+        setupSize == 0) {
+      // no object renderer in the current configuration
+      return;
+    }
+    std::vector<uint8_t> setup(setupSize);
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (mpeghdecoder_getRendererSetup(m_decoder, setup.data(), setupSize, &setupSize) !=
+            MPEGH_DEC_OK ||
+        !file.write(reinterpret_cast<const char*>(setup.data()), setupSize)) {
+      std::cout << "Warning: Failed to save renderer setup file " << filename << std::endl;
+    }
+  }
+
   void process(int32_t startSample, int32_t stopSample, int32_t seekFromSample,
                int32_t seekToSample, UiManagerCallback&& processUiManager) {
     uint32_t frameSize = 0;       // Current audio frame size
@@ -329,7 +366,7 @@ class CProcessor {
         if (!seekPerformed && sampleCounter == static_cast<uint32_t>(seekFromSample)) {
           std::cout << "Performing seek from ISOBMFF/MP4 Sample " << seekFromSample
                     << " to ISOBMFF/MP4 Sample " << seekToSample << std::endl;
-          err = mpeghdecoder_flush(m_decoder);
+          err = mpeghdecoder_softFlush(m_decoder);
           if (err != MPEGH_DEC_OK) {
             throw std::runtime_error("[" + std::to_string(sampleCounter) +
                                      "] Error: Unable to flush decoder");
@@ -464,6 +501,7 @@ int main(int argc, char* argv[]) {
   int32_t cicpSetup = defaultCicpSetup;
   char inputFilename[CMDL_MAX_STRLEN] = {0};  /*!< Name of input bitstream file */
   char outputFilename[CMDL_MAX_STRLEN] = {0}; /*!< Name of audio output file */
+  char rendererSetupFilename[CMDL_MAX_STRLEN] = {0}; /*!< Name of renderer setup file */
 #ifdef BUILD_UIMANAGER
   char scriptFilename[CMDL_MAX_STRLEN] = "";
   char xmlSceneStateFilename[CMDL_MAX_STRLEN] = "";
@@ -492,6 +530,7 @@ int main(int argc, char* argv[]) {
   // Parse optional command line parameters,
   IIS_ScanCmdl(argc, argv, "(-tl %d) (-y %d) (-z %d) (-sf %d) (-st %d)", &cicpSetup, &startSample,
                &stopSample, &seekFromSample, &seekToSample);
+  IIS_ScanCmdl(argc, argv, "(-rsf %s)", rendererSetupFilename);
 #ifdef BUILD_UIMANAGER
   IIS_ScanCmdl(argc, argv, "(-script %s)", scriptFilename);
   IIS_ScanCmdl(argc, argv, "(-xmlSceneState %s)", xmlSceneStateFilename);
@@ -533,9 +572,15 @@ int main(int argc, char* argv[]) {
     CProcessor processor(inputFilename, outputFilename, cicpSetup);
     // configure decoder
     processor.configureDecoder(argc, argv);
+    if (rendererSetupFilename[0] != '\0') {
+      processor.loadRendererSetup(rendererSetupFilename);
+    }
     // process
     processor.process(startSample, stopSample, seekFromSample, seekToSample,
                       std::move(processUiManager));
+    if (rendererSetupFilename[0] != '\0') {
+      processor.saveRendererSetup(rendererSetupFilename);
+    }
   } catch (const std::exception& e) {
     std::cout << std::endl << "Error: " << e.what() << std::endl << std::endl;
     return FDK_EXITCODE_SOFTWARE;
@@ -573,6 +618,8 @@ static void cmdlHelp(const char* progname) {
          "          \t  to the provided ISOBMFF/MP4 sample number\n"
          "          \t  NOTE: The decoding will resume at the nearest ISOBMFF/MP4 sync sample!\n"
          "          \t  NOTE: '-sf' must be set!\n"
+         "       -rsf\tRenderer setup file. Loaded at start-up if it exists to skip the object\n"
+         "          \t  renderer setup and written after decoding.\n"
          "\n"
          "         \tSeeking example:\n"
          "         \t  '"
@@ -80,6 +80,7 @@ www.iis.fraunhofer.de/amm
 amm-info@iis.fraunhofer.de
 -----------------------------------------------------------------------------*/
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -153,18 +154,120 @@ typedef enum {
       0x0003, /*!< MPEG-D DRC: Scaling factor for attenuating gain values.\n
                    Same as ::MPEGH_DEC_PARAM_BOOST_FACTOR but for attenuating DRC gains. */
   MPEGH_DEC_PARAM_ALBUM_MODE =
-      0x0004 /*!< MPEG-D DRC: Enable album mode.\n
+      0x0004, /*!< MPEG-D DRC: Enable album mode.\n
                   0: Disabled (default),\n
                   1: Enabled.\n
                   Disabled album mode leads to application of gain sequences for fading in and out,
                   if provided in the bitstream.\n
                   Enabled album mode makes use of dedicated album loudness information, if provided
                   in the bitstream. */
+  MPEGH_DEC_PARAM_DECODER_THREADS =
+      0x0005, /*!< Number of threads used for core decoding including the calling thread.\n
+                  0 or 1: Single-threaded decoding (default),\n
+                  2..28: The per-channel inverse transforms are distributed on an internal worker
+                  pool.\n
+                  The decoded output is identical for all values. Returns
+                  ::MPEGH_DEC_UNSUPPORTED_PARAM if the platform provides no thread support. */
+  MPEGH_DEC_PARAM_OUTPUT_FORMAT =
+      0x0006, /*!< Sample format and layout of mpeghdecoder_getSamplesFormatted().\n
+                  One of ::MPEGH_DECODER_OUTPUT_FORMAT, optionally combined with
+                  ::MPEGH_DEC_OUTPUT_FORMAT_PLANAR.\n
+                  Default: ::MPEGH_DEC_OUTPUT_FORMAT_INT32 (interleaved). */
+  MPEGH_DEC_PARAM_THREADED_MODE =
+      0x0007, /*!< Decouple decoding from the output side. One of ::MPEGH_DECODER_THREADED_MODE.\n
+                  In threaded mode mpeghdecoder_process() and mpeghdecoder_flushAndGet() only queue
+                  the input data, the decoding runs on a worker and the decoded frames are placed in
+                  a lock-free single-producer/single-consumer frame ring. The getSamples functions
+                  and mpeghdecoder_releaseSamples() take the frames from this ring and never wait on
+                  the worker, so they can be called from a real-time audio callback.\n
+                  One thread may feed the decoder and another thread may fetch the frames
+                  concurrently. mpeghdecoder_processBatch(), mpeghdecoder_flush(),
+                  mpeghdecoder_softFlush(), mpeghdecoder_setMhaConfig(),
+                  mpeghdecoder_setScratchPool() and mpeghdecoder_setParam() for other parameters
+                  return ::MPEGH_DEC_UNSUPPORTED_PARAM until the threaded mode is switched off
+                  again.\n
+                  Errors of the asynchronous decoding are returned by the next call to
+                  mpeghdecoder_process(). Input data is queued in chunks of 16 KiB; an access unit
+                  which does not fit into the free chunks is rejected with
+                  ::MPEGH_DEC_BUFFER_ERROR.\n
+                  Switching the threaded mode off stops the worker and restarts the decoder, i.e.
+                  all pending input data and frames are discarded.\n
+                  ::MPEGH_DEC_THREADED_MODE_INTERNAL returns ::MPEGH_DEC_UNSUPPORTED_PARAM if the
+                  platform provides no thread support. */
+  MPEGH_DEC_PARAM_DISCONTINUITY_THRESHOLD =
+      0x0008, /*!< Maximum time difference in milliseconds between the timestamps of two
+                   consecutive access units. A larger difference restarts the decoder, i.e. the
+                   decoder is reset to its initial start-up state.\n
+                   The valid values range from 1 to 60000. Default value is 200. */
+  MPEGH_DEC_PARAM_TIMING_TOLERANCE =
+      0x0009, /*!< Maximum difference in samples per channel between the decoded length of an
+                   access unit and the length derived from the timestamps which is accepted
+                   without inserting or removing samples.\n
+                   The valid values range from 0 to 3072. Default value is 5. */
+  MPEGH_DEC_PARAM_GAP_FILL_MODE =
+      0x000A, /*!< Signal used to fill a gap between the timestamps of two consecutive access
+                   units which does not exceed ::MPEGH_DEC_PARAM_DISCONTINUITY_THRESHOLD.
+                   One of ::MPEGH_DECODER_GAP_FILL_MODE.\n
+                   Default: ::MPEGH_DEC_GAP_FILL_ZEROS. */
+  MPEGH_DEC_PARAM_VBAP_GAIN_GRID =
+      0x000B /*!< Panning of point source objects.\n
+                  0: Exact VBAP panning for each object position (default),\n
+                  1: Bilinear interpolation of a gain grid with 2 degrees resolution which is
+                  precomputed for the target layout. This reduces the object rendering load
+                  considerably, the panning gains deviate slightly from the exact ones.\n
+                  Applies to streams with production metadata only. Takes effect at the next
+                  configuration of the decoder, e.g. after mpeghdecoder_flush(). */
 } MPEGH_DECODER_PARAMETER;
 
+/**
+ * @brief  Values of ::MPEGH_DEC_PARAM_GAP_FILL_MODE.
+ */
+typedef enum {
+  MPEGH_DEC_GAP_FILL_ZEROS = 0,  /*!< Fade out, insert zero samples and fade in again. */
+  MPEGH_DEC_GAP_FILL_CONCEAL = 1 /*!< Insert concealed frames of the core decoder for each missing
+                                      access unit. The remainder of the gap, and gaps before the
+                                      first decoded frame, are filled with zero samples. */
+} MPEGH_DECODER_GAP_FILL_MODE;
+
+/**
+ * @brief  Values of ::MPEGH_DEC_PARAM_THREADED_MODE.
+ */
+typedef enum {
+  MPEGH_DEC_THREADED_MODE_OFF = 0,      /*!< Decode within mpeghdecoder_process() (default). */
+  MPEGH_DEC_THREADED_MODE_INTERNAL = 1, /*!< Decode on a worker thread owned by the decoder. */
+  MPEGH_DEC_THREADED_MODE_EXTERNAL = 2  /*!< Decode on a worker thread owned by the caller, which
+                                             calls mpeghdecoder_runWorker(). */
+} MPEGH_DECODER_THREADED_MODE;
+
+/**
+ * @brief  Output sample formats of mpeghdecoder_getSamplesFormatted().
+ */
+typedef enum {
+  MPEGH_DEC_OUTPUT_FORMAT_INT32 = 0x00,   /*!< Full scale signed 32 bit integer (int32_t). */
+  MPEGH_DEC_OUTPUT_FORMAT_INT24 = 0x01,   /*!< Signed 24 bit integer, right-aligned in int32_t. */
+  MPEGH_DEC_OUTPUT_FORMAT_INT16 = 0x02,   /*!< Signed 16 bit integer (int16_t). */
+  MPEGH_DEC_OUTPUT_FORMAT_FLOAT32 = 0x03, /*!< 32 bit float in the range [-1.0, 1.0). */
+  MPEGH_DEC_OUTPUT_FORMAT_PLANAR = 0x10   /*!< Flag: Output each channel as a contiguous block of
+                                               numSamplesPerChannel samples instead of
+                                               interleaved samples. */
+} MPEGH_DECODER_OUTPUT_FORMAT;
+
 typedef struct MPEGH_DECODER_CONTEXT*
     HANDLE_MPEGH_DECODER_CONTEXT; /*!< Pointer to a MPEG-H decoder instance. */
 
+typedef struct MPEGH_DECODER_SCRATCH_POOL*
+    HANDLE_MPEGH_DECODER_SCRATCH_POOL; /*!< Pointer to scratch memory shared by MPEG-H decoder
+                                            instances. */
+
+/**
+ * @brief  One MPEG-H access unit (MHAS frame) passed to mpeghdecoder_processBatch().
+ */
+typedef struct MPEGH_DECODER_ACCESS_UNIT {
+  const uint8_t* data; /*!< Pointer to the bitstream data of the access unit. */
+  uint32_t length;     /*!< Size of the bitstream data in bytes. */
+  uint64_t timestamp;  /*!< Presentation timestamp of the access unit (in nano seconds). */
+} MPEGH_DECODER_ACCESS_UNIT;
+
 /**
  * @brief  This structure gives information about the currently decoded audio data. All fields are
  *         read-only.
@@ -187,6 +290,26 @@ typedef struct MPEGH_DECODER_OUTPUT_INFO {
   bool isConcealed;         /*!< Flag to signal if the decoded PCM audio signal is concealed. */
 } MPEGH_DECODER_OUTPUT_INFO;
 
+/**
+ * @brief  Memory allocator used for all memory of the MPEG-H decoder instances.
+ */
+typedef struct MPEGH_DECODER_ALLOCATOR {
+  void* (*alloc)(void* userData, size_t size); /*!< Allocate size bytes. The memory must be
+                                                    aligned for any fundamental type. */
+  void (*free)(void* userData, void* ptr);     /*!< Release memory returned by alloc. */
+  void* userData;                              /*!< Passed to alloc and free. */
+} MPEGH_DECODER_ALLOCATOR;
+
+/**
+ * @brief  Install a custom memory allocator. The allocator is process-wide and must be installed
+ *         while no MPEG-H decoder instance exists.
+ *
+ * @param[in] allocator  Allocator to be used, or NULL to restore the C library heap.
+ * @return               Error code.
+ */
+MPEGHDEC_EXPORT MPEGH_DECODER_ERROR
+mpeghdecoder_setAllocator(const MPEGH_DECODER_ALLOCATOR* allocator);
+
 /**
  * @brief  Open an MPEG-H decoder instance.
  *
@@ -195,6 +318,63 @@ typedef struct MPEGH_DECODER_OUTPUT_INFO {
  */
 MPEGHDEC_EXPORT HANDLE_MPEGH_DECODER_CONTEXT mpeghdecoder_init(int32_t cicpSetup);
 
+/**
+ * @brief  Open an MPEG-H decoder instance which places all of its memory in one contiguous,
+ *         caller-provided memory block. Memory which is needed later on, e.g. when a new
+ *         configuration is received, is taken from the same block. If the block is exhausted, the
+ *         installed allocator is used instead. The block must stay valid until
+ *         mpeghdecoder_destroy() was called and can be reused for a new instance afterwards.
+ *
+ * @param[in] cicpSetup  The CICP index of the desired target layout.
+ * @param[in] arena      Memory block, aligned for any fundamental type.
+ * @param[in] arenaSize  Size of the memory block in bytes.
+ * @return               MPEG-H decoder handle.
+ */
+MPEGHDEC_EXPORT HANDLE_MPEGH_DECODER_CONTEXT mpeghdecoder_initWithArena(int32_t cicpSetup,
+                                                                        void* arena,
+                                                                        size_t arenaSize);
+
+/**
+ * @brief  Get the highest number of bytes used so far in the memory block of an instance opened
+ *         with mpeghdecoder_initWithArena(). Can be used to find the required block size.
+ *
+ * @param[in] hCtx  MPEG-H decoder handle.
+ * @return          Number of bytes, or 0 if the instance does not use a memory block.
+ */
+MPEGHDEC_EXPORT size_t mpeghdecoder_getArenaUsage(HANDLE_MPEGH_DECODER_CONTEXT hCtx);
+
+/**
+ * @brief  Allocate a scratch pool. Decoder instances which are attached to the same scratch pool
+ *         with mpeghdecoder_setScratchPool() share their temporary core decoder memory instead of
+ *         allocating an own copy. Instances sharing a scratch pool must not be called
+ *         concurrently, e.g. they must be driven by the same thread.
+ *
+ * @return  Scratch pool handle, or NULL on failure.
+ */
+MPEGHDEC_EXPORT HANDLE_MPEGH_DECODER_SCRATCH_POOL mpeghdecoder_initScratchPool(void);
+
+/**
+ * @brief  De-allocate a scratch pool. All decoder instances attached to the scratch pool must
+ *         have been destroyed or detached before.
+ *
+ * @param[in] hPool  Scratch pool handle.
+ * @return           void.
+ */
+MPEGHDEC_EXPORT void mpeghdecoder_destroyScratchPool(HANDLE_MPEGH_DECODER_SCRATCH_POOL hPool);
+
+/**
+ * @brief  Attach a decoder instance to a scratch pool or detach it by passing NULL. Should be
+ *         called right after mpeghdecoder_init(). Once the decoder has been configured, changing
+ *         the scratch pool restarts the decoder, i.e. all internally buffered data is discarded.
+ *
+ * @param[in] hCtx   MPEG-H decoder handle.
+ * @param[in] hPool  Scratch pool handle, or NULL.
+ * @return           Error code.
+ */
+MPEGHDEC_EXPORT MPEGH_DECODER_ERROR
+mpeghdecoder_setScratchPool(HANDLE_MPEGH_DECODER_CONTEXT hCtx,
+                            HANDLE_MPEGH_DECODER_SCRATCH_POOL hPool);
+
 /**
  * @brief  Explicitly configure the decoder by passing the MHA config contained in a binary buffer.
  *         This is required for MPEG-H MHA format bitstreams which have no in-band config.
@@ -209,6 +389,42 @@ MPEGHDEC_EXPORT MPEGH_DECODER_ERROR mpeghdecoder_setMhaConfig(HANDLE_MPEGH_DECOD
                                                               const uint8_t* config,
                                                               uint32_t configSize);
 
+/**
+ * @brief  Provide renderer setup data saved with mpeghdecoder_getRendererSetup(), e.g. from a file
+ *         written by a previous session. Object renderers opened for an output layout contained in
+ *         the data skip the speaker triangulation and the computation of the spread gains and of
+ *         the gain grid (see ::MPEGH_DEC_PARAM_VBAP_GAIN_GRID). The data is copied. Should be
+ *         called right after mpeghdecoder_init(); otherwise it applies from the next configuration
+ *         of the decoder. Data written by a different library build is ignored. The format
+ *         converter setup is always derived from the configuration, it takes a fraction of the
+ *         time of decoding one frame.
+ *
+ * @param[in] hCtx       MPEG-H decoder handle.
+ * @param[in] setup      Pointer to the renderer setup data.
+ * @param[in] setupSize  Size of the renderer setup data in bytes.
+ * @return               Error code.
+ */
+MPEGHDEC_EXPORT MPEGH_DECODER_ERROR
+mpeghdecoder_setRendererSetup(HANDLE_MPEGH_DECODER_CONTEXT hCtx, const uint8_t* setup,
+                              uint32_t setupSize);
+
+/**
+ * @brief  Save the derived setup of the object renderers of the current configuration, keyed by
+ *         the output layout, so that it can be passed to mpeghdecoder_setRendererSetup() at the
+ *         next start-up. Call it after the first decoded frame. The output sample rate does not
+ *         affect the data.
+ *
+ * @param[in]  hCtx       MPEG-H decoder handle.
+ * @param[out] setup      Pointer to the destination buffer, or NULL to query the required size.
+ * @param[in]  setupSize  Size of the destination buffer in bytes.
+ * @param[out] setupUsed  Number of bytes written, or the required size if setup is NULL. 0 if the
+ *                        current configuration contains no objects.
+ * @return                Error code. ::MPEGH_DEC_BUFFER_ERROR if the buffer is too small.
+ */
+MPEGHDEC_EXPORT MPEGH_DECODER_ERROR
+mpeghdecoder_getRendererSetup(HANDLE_MPEGH_DECODER_CONTEXT hCtx, uint8_t* setup,
+                              uint32_t setupSize, uint32_t* setupUsed);
+
 /**
  * @brief  De-allocate all resources of an MPEG-H decoder instance.
  *
@@ -255,6 +471,34 @@ MPEGHDEC_EXPORT MPEGH_DECODER_ERROR mpeghdecoder_processTimescale(HANDLE_MPEGH_D
                                                                   uint64_t timestamp,
                                                                   uint32_t timescale);
 
+/**
+ * @brief  Decode a batch of access units and write all resulting output frames consecutively into
+ *         an arena provided by the caller. Equivalent to calling mpeghdecoder_process() for each
+ *         access unit followed by mpeghdecoder_getSamples() until ::MPEGH_DEC_FEED_DATA is
+ *         returned, but without returning to the caller in between.\n
+ *         The function stops early if the arena cannot hold another frame (3072 samples per
+ *         rendered output channel) or all frame infos are used. The remaining access units can be
+ *         passed in the next call; pending frames are returned first.
+ *
+ * @param[in]  hCtx            MPEG-H decoder handle.
+ * @param[in]  accessUnits     Array of access units to be decoded.
+ * @param[in]  numAccessUnits  Number of entries in accessUnits.
+ * @param[out] outData         Arena receiving the interleaved PCM samples of all output frames.
+ *                             Frame n starts directly after frame n-1.
+ * @param[in]  outLength       Size of the arena in samples.
+ * @param[out] outInfo         Array receiving one OUTPUT_INFO structure per output frame.
+ * @param[in]  maxNumFrames    Number of entries in outInfo.
+ * @param[out] numProcessed    Number of consumed access units.
+ * @param[out] numFrames       Number of output frames written into the arena.
+ * @return                     Error code of the first failing access unit, which is not counted
+ *                             in numProcessed, or ::MPEGH_DEC_OK.
+ */
+MPEGHDEC_EXPORT MPEGH_DECODER_ERROR mpeghdecoder_processBatch(
+    HANDLE_MPEGH_DECODER_CONTEXT hCtx, const MPEGH_DECODER_ACCESS_UNIT* accessUnits,
+    uint32_t numAccessUnits, int32_t* outData, uint32_t outLength,
+    MPEGH_DECODER_OUTPUT_INFO* outInfo, uint32_t maxNumFrames, uint32_t* numProcessed,
+    uint32_t* numFrames);
+
 /**
  * @brief  Get a decoded audio frame
  *
@@ -273,6 +517,55 @@ MPEGHDEC_EXPORT MPEGH_DECODER_ERROR mpeghdecoder_getSamples(HANDLE_MPEGH_DECODER
                                                             int32_t* outData, uint32_t outLength,
                                                             MPEGH_DECODER_OUTPUT_INFO* outInfo);
 
+/**
+ * @brief  Get a decoded audio frame in the sample format and layout selected with
+ *         ::MPEGH_DEC_PARAM_OUTPUT_FORMAT. The conversion is done while copying the samples out of
+ *         the internal sample queue.
+ *
+ * @param[in]  hCtx       MPEG-H decoder handle.
+ * @param[out] outData    Pointer to external output buffer of the selected sample type. Needs
+ *                        space to hold up to 3072 samples per rendered output channel.
+ * @param[in]  outLength  Size of external output buffer in samples (not bytes).
+ * @param[out] outInfo    Pointer to an OUTPUT_INFO structure holding information about the current
+ *                        output frame. In planar layout, channel n starts at sample
+ *                        n * outInfo->numSamplesPerChannel.
+ * @return                Error code.
+ */
+MPEGHDEC_EXPORT MPEGH_DECODER_ERROR
+mpeghdecoder_getSamplesFormatted(HANDLE_MPEGH_DECODER_CONTEXT hCtx, void* outData,
+                                 uint32_t outLength, MPEGH_DECODER_OUTPUT_INFO* outInfo);
+
+/**
+ * @brief  Get a decoded audio frame without copying it. Same as mpeghdecoder_getSamples(), but
+ *         instead of copying the PCM samples into an external buffer, a pointer to the decoder's
+ *         internal sample queue is returned. The frame has to be returned with
+ *         mpeghdecoder_releaseSamples() before the next frame can be obtained. The samples are
+ *         always interleaved int32_t, independent of ::MPEGH_DEC_PARAM_OUTPUT_FORMAT.\n
+ *         The samples stay valid until mpeghdecoder_releaseSamples(), mpeghdecoder_flush(),
+ *         mpeghdecoder_setMhaConfig() or mpeghdecoder_destroy() is called.
+ *         mpeghdecoder_process() may be called while a frame is borrowed.
+ *
+ * @param[in]  hCtx     MPEG-H decoder handle.
+ * @param[out] outData  Pointer receiving the address of the interleaved PCM samples of the
+ *                      current output frame, or NULL if no frame is available.
+ * @param[out] outInfo  Pointer to an OUTPUT_INFO structure holding information about the current
+ *                      output frame.
+ * @return              Error code. ::MPEGH_DEC_BUFFER_ERROR if the previous frame has not been
+ *                      released.
+ */
+MPEGHDEC_EXPORT MPEGH_DECODER_ERROR mpeghdecoder_getSamplesView(HANDLE_MPEGH_DECODER_CONTEXT hCtx,
+                                                                const int32_t** outData,
+                                                                MPEGH_DECODER_OUTPUT_INFO* outInfo);
+
+/**
+ * @brief  Release the audio frame obtained by mpeghdecoder_getSamplesView(). Does nothing if no
+ *         frame is borrowed.
+ *
+ * @param[in] hCtx  MPEG-H decoder handle.
+ * @return          Error code.
+ */
+MPEGHDEC_EXPORT MPEGH_DECODER_ERROR mpeghdecoder_releaseSamples(HANDLE_MPEGH_DECODER_CONTEXT hCtx);
+
 /**
  * @brief  Flush the decoder and push the flushed PCM samples into a samples queue. The decoded PCM
  *         samples can then be obtained by calling the mpeghdecoder_getSamples() function. This
@@ -293,6 +586,32 @@ MPEGHDEC_EXPORT MPEGH_DECODER_ERROR mpeghdecoder_flushAndGet(HANDLE_MPEGH_DECODE
  */
 MPEGHDEC_EXPORT MPEGH_DECODER_ERROR mpeghdecoder_flush(HANDLE_MPEGH_DECODER_CONTEXT hCtx);
 
+/**
+ * @brief  Discard all pending input data and samples while keeping the parsed configuration and
+ *         all state derived from it (renderer, format converter, DRC selection). Only the overlap,
+ *         concealment and delay line history is cleared, so seeking within a stream does not pay
+ *         for a full decoder re-initialization. The first frame after the next random access
+ *         point is faded in. A configuration change at the new position is handled as usual.
+ *
+ * @param[in] hCtx  MPEG-H decoder handle.
+ * @return          Error code. ::MPEGH_DEC_UNSUPPORTED_PARAM in threaded mode.
+ */
+MPEGHDEC_EXPORT MPEGH_DECODER_ERROR mpeghdecoder_softFlush(HANDLE_MPEGH_DECODER_CONTEXT hCtx);
+
+/**
+ * @brief  Decode the queued input data of a decoder in ::MPEGH_DEC_THREADED_MODE_EXTERNAL and move
+ *         the decoded frames into the frame ring. Has to be called from a single worker thread
+ *         owned by the caller, e.g. after each mpeghdecoder_process() call and whenever frames
+ *         were taken from the frame ring. Returns once no further progress is possible because the
+ *         input is exhausted or the frame ring is full.
+ *
+ * @param[in] hCtx  MPEG-H decoder handle.
+ * @return          Error code. ::MPEGH_DEC_FEED_DATA if nothing could be done.
+ *                  ::MPEGH_DEC_UNSUPPORTED_PARAM if the decoder is not in
+ *                  ::MPEGH_DEC_THREADED_MODE_EXTERNAL.
+ */
+MPEGHDEC_EXPORT MPEGH_DECODER_ERROR mpeghdecoder_runWorker(HANDLE_MPEGH_DECODER_CONTEXT hCtx);
+
 /**
  * @brief  Set decoder parameter.
  *
@@ -380,6 +380,59 @@ void* FDKcalloc(const UINT n, const UINT size);
 void* FDKmalloc(const UINT size);
 void FDKfree(void* ptr);
 
+/**
+ * Heap allocator used by FDKcalloc(), FDKmalloc() and FDKfree().
+ */
+typedef struct FDK_ALLOCATOR {
+  void* (*pAlloc)(void* pUserData, size_t size); /*!< Allocate size bytes. The memory must be
+                                                      aligned for any fundamental type. */
+  void (*pFree)(void* pUserData, void* ptr);     /*!< Release memory returned by pAlloc. */
+  void* pUserData;                               /*!< Passed to pAlloc and pFree. */
+} FDK_ALLOCATOR;
+
+/**
+ *  Install a heap allocator for all subsequent FDKcalloc(), FDKmalloc() and FDKfree() calls. The
+ * allocator is process-wide and must not be changed while any memory obtained from the previous
+ * allocator is still in use.
+ *
+ * \param pAllocator  Allocator to be installed, or NULL to restore the C library heap.
+ */
+void FDKsetAllocator(const FDK_ALLOCATOR* pAllocator);
+
+typedef struct FDK_MEM_ARENA FDK_MEM_ARENA;
+
+/**
+ *  Create a memory arena inside a caller-provided memory block. Memory is taken from the arena by
+ * bumping a pointer; FDKfree() of arena memory puts the block on a free list which is searched
+ * first by subsequent allocations, adjacent free blocks are merged and blocks at the top of the
+ * arena are given back to the bump pointer. Requests that do not fit into the arena fall back to
+ * the heap allocator. The arena
+ * itself needs no deinitialization; the memory block can be reused once all memory taken from the
+ * arena is no longer needed.
+ *
+ * \param pMem  Memory block holding the arena. Must be aligned for any fundamental type.
+ * \param size  Size of the memory block in bytes.
+ * \return      Arena handle, or NULL if the memory block is too small.
+ */
+FDK_MEM_ARENA* FDKinitArena(void* pMem, const UINT size);
+
+/**
+ *  Route all subsequent FDKcalloc() and FDKmalloc() calls of the calling thread into a memory
+ * arena.
+ *
+ * \param pArena  Arena to be used, or NULL to allocate from the heap.
+ * \return        The arena that was active before.
+ */
+FDK_MEM_ARENA* FDKsetThreadArena(FDK_MEM_ARENA* pArena);
+
+/**
+ *  Query the arena usage.
+ *
+ * \param pArena  Arena handle.
+ * \return        Highest number of arena bytes in use so far, including the arena bookkeeping.
+ */
+UINT FDKgetArenaPeak(const FDK_MEM_ARENA* pArena);
+
 /**
  *  Allocate and clear an aligned memory area. Use FDKafree() instead of FDKfree() for these memory
  * areas.
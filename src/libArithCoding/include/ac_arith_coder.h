@@ -99,9 +99,13 @@ amm-info@iis.fraunhofer.de
 
 typedef enum { ARITH_CODER_OK = 0, ARITH_CODER_ERROR = 5 } ARITH_CODING_ERROR;
 
+#define ARITH_PK_CACHE_SIZE 512 /* Number of entries of the context to pk index cache */
+
 typedef struct {
   SHORT m_numberLinesPrev;
   UCHAR c_prev[(1024 / 2) + 4]; /* 2-tuple context of previous frame, 4 bit */
+  UINT pkCache[ARITH_PK_CACHE_SIZE]; /* Direct-mapped cache of (context << 6) | pk index, 0 if
+                                        unused. Only depends on the static tables. */
 } CArcoData;
 
 typedef struct {
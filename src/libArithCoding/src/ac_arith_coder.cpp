@@ -459,6 +459,113 @@ INT ari_decode_14bits(HANDLE_FDK_BITSTREAM hBs, Tastat* s, const SHORT* RESTRICT
   return symbol;
 }
 
+/* Bit cache of decode2(). The bits are prefetched from the bit stream in words of 32 bits and
+   kept MSB aligned, so that the renormalization can consume several bits at once. */
+typedef struct {
+  UINT64 cache;
+  INT bits;
+} ARI_BITCACHE;
+
+static inline UINT ari_read_bits(HANDLE_FDK_BITSTREAM hBs, ARI_BITCACHE* bc, INT nBits) {
+  /* 1 <= nBits <= 16 */
+  if (bc->bits < nBits) {
+    bc->cache |= (UINT64)FDKreadBits(hBs, 32) << (32 - bc->bits);
+    bc->bits += 32;
+  }
+  UINT bits = (UINT)(bc->cache >> (64 - nBits));
+  bc->cache <<= nBits;
+  bc->bits -= nBits;
+
+  return bits;
+}
+
+/* Same as ari_decode_14bits() for cfl == VAL_ESC + 1 and cfl == 4, but reading the bits from the
+   bit cache. The renormalization shifts out all leading bits which are equal in low and high and
+   all following underflow bits in one step each instead of bit by bit. */
+static inline INT ari_decode_14bits_cached(HANDLE_FDK_BITSTREAM hBs, ARI_BITCACHE* bc, Tastat* s,
+                                           const SHORT* RESTRICT c_freq, int cfl) {
+  INT symbol;
+  INT low, high, range;
+  UINT value;
+  INT c;
+  const SHORT* p;
+
+  low = s->low;
+  high = s->high;
+  value = (UINT)s->vobf;
+
+  range = high - low + 1;
+  c = (((int)(value - low + 1)) << stat_bitsnew) - ((int)1);
+  p = (const SHORT*)(c_freq - 1);
+
+  if (cfl == (VAL_ESC + 1)) {
+    /* In 50% of all cases, the first entry is the right one, so we check it prior to all others */
+    if ((p[1] * range) > c) {
+      p += 1;
+      if ((p[8] * range) > c) {
+        p += 8;
+      }
+      if ((p[4] * range) > c) {
+        p += 4;
+      }
+      if ((p[2] * range) > c) {
+        p += 2;
+      }
+      if ((p[1] * range) > c) {
+        p += 1;
+      }
+    }
+  } else {
+    if ((p[2] * range) > c) {
+      p += 2;
+    }
+    if ((p[1] * range) > c) {
+      p += 1;
+    }
+  }
+
+  symbol = (INT)(p - (const SHORT*)(c_freq - 1));
+
+  if (symbol) {
+    high = low + mul_sbc_14bits(range, c_freq[symbol - 1]) - 1;
+  }
+
+  low += mul_sbc_14bits(range, c_freq[symbol]);
+
+  UINT us_high = (UINT)high & 0xFFFF;
+  UINT us_low = (UINT)low & 0xFFFF;
+  while (1) {
+    UINT diff = us_low ^ us_high;
+    if (!(diff & 0x8000)) {
+      /* Shift out the leading bits which are equal in low and high. */
+      INT n = fixnormz_D((LONG)((diff << 16) | 0x8000));
+      us_low = (us_low << n) & 0xFFFF;
+      us_high = ((us_high << n) | ((1 << n) - 1)) & 0xFFFF;
+      value = (value << n) | ari_read_bits(hBs, bc, n);
+    } else if (!(us_high & 0x8000)) {
+      /* Empty interval, can only be reached with corrupt input. */
+      us_low = (us_low << 1) & 0xFFFF;
+      us_high = ((us_high << 1) | 1) & 0xFFFF;
+      value = (value << 1) | ari_read_bits(hBs, bc, 1);
+    } else {
+      /* Number of underflow bits: low = 01..1x, high = 10..0x */
+      INT n = fixnormz_D((LONG) ~((us_low & ~us_high) << 17));
+      if (n == 0) {
+        break;
+      }
+      /* Subtracting 0x4000 before each of the n shifts leaves -0x8000 in the lower 16 bits. */
+      us_low = (us_low << n) & 0x7FFF;
+      us_high = ((us_high << n) | ((1 << n) - 1) | 0x8000) & 0xFFFF;
+      value = ((value << n) | ari_read_bits(hBs, bc, n)) ^ 0x8000;
+    }
+  }
+  s->low = (int)us_low;
+  s->high = (int)us_high;
+  s->vobf = (int)(value & 0xFFFF);
+
+  return symbol;
+}
+
 static inline void copyTableAmrwbArith2(UCHAR tab[], int sizeIn, int sizeOut) {
   int i;
   int j;
@@ -590,9 +697,23 @@ static inline ULONG get_pk_v2(ULONG s) {
 #endif
 }
 
-static ARITH_CODING_ERROR decode2(HANDLE_FDK_BITSTREAM bbuf, UCHAR* RESTRICT c_prev,
-                                  FIXP_DBL* RESTRICT pSpectralCoefficient, INT n, INT nt) {
+/* Look up the context in the direct-mapped cache before searching the hash table. */
+static inline ULONG get_pk_cached(UINT* RESTRICT pkCache, ULONG s) {
+  if (s <= (ULONG)0xF) return ((const UCHAR*)ari_merged_hash_ps_ext)[s];
+
+  UINT* entry = &pkCache[(s ^ (s >> 9)) & (ARITH_PK_CACHE_SIZE - 1)];
+  if ((*entry >> 6) != (UINT)s) {
+    *entry = ((UINT)s << 6) | (UINT)get_pk_v2(s);
+  }
+
+  return *entry & 0x3F;
+}
+
+static ARITH_CODING_ERROR decode2(HANDLE_FDK_BITSTREAM bbuf, UINT* RESTRICT pkCache,
+                                  UCHAR* RESTRICT c_prev, FIXP_DBL* RESTRICT pSpectralCoefficient,
+                                  INT n, INT nt) {
   Tastat as;
+  ARI_BITCACHE bc;
   int i, l, r;
   INT lev, esc_nb, pki;
   USHORT state_inc;
@@ -608,6 +729,8 @@ static ARITH_CODING_ERROR decode2(HANDLE_FDK_BITSTREAM bbuf, UCHAR* RESTRICT c_p
   as.low = 0;
   as.high = ari_q4new;
   as.vobf = FDKreadBits(bbuf, cbitsnew);
+  bc.cache = 0;
+  bc.bits = 0;
 
   /* arith_map_context */
   state_inc = c_prev[0] << 12;
@@ -629,15 +752,18 @@ static ARITH_CODING_ERROR decode2(HANDLE_FDK_BITSTREAM bbuf, UCHAR* RESTRICT c_p
 
     /* MSBs decoding */
     for (lev = esc_nb = 0;;) {
-      pki = get_pk_v2(s + (esc_nb << (VAL_ESC + 1)));
-      r = ari_decode_14bits(bbuf, &as, ari_pk[pki], VAL_ESC + 1);
+      pki = get_pk_cached(pkCache, s + (esc_nb << (VAL_ESC + 1)));
+      r = ari_decode_14bits_cached(bbuf, &bc, &as, ari_pk[pki], VAL_ESC + 1);
       if (r < VAL_ESC) {
         break;
       }
 
       lev++;
 
-      if (lev > 23) return ARITH_CODER_ERROR;
+      if (lev > 23) {
+        FDKpushBack(bbuf, bc.bits);
+        return ARITH_CODER_ERROR;
+      }
 
       if (esc_nb < 7) {
         esc_nb++;
@@ -659,7 +785,7 @@ static ARITH_CODING_ERROR decode2(HANDLE_FDK_BITSTREAM bbuf, UCHAR* RESTRICT c_p
       for (l = 0; l < lev; l++) {
         {
           int pidx = (a == 0) ? 1 : ((b == 0) ? 0 : 2);
-          r = ari_decode_14bits(bbuf, &as, ari_lsb2[pidx], 4);
+          r = ari_decode_14bits_cached(bbuf, &bc, &as, ari_lsb2[pidx], 4);
         }
         a = (a << 1) | (r & 1);
         b = (b << 1) | (r >> 1);
@@ -683,7 +809,8 @@ static ARITH_CODING_ERROR decode2(HANDLE_FDK_BITSTREAM bbuf, UCHAR* RESTRICT c_p
 
   } /* for (i=0; i<n; i++) */
 
-  FDKpushBack(bbuf, cbitsnew - 2);
+  /* Return the prefetched bits to the bit stream. */
+  FDKpushBack(bbuf, bc.bits + cbitsnew - 2);
 
   /* We need to run only from 0 to i-1 since all other q[i][1].a,b will be cleared later */
   int j = i;
@@ -747,7 +874,8 @@ ARITH_CODING_ERROR CArco_DecodeArithData(CArcoData* pArcoData, HANDLE_FDK_BITSTR
   pArcoData->m_numberLinesPrev = lg_max;
 
   if (lg > 0) {
-    ErrorStatus = decode2(hBs, pArcoData->c_prev + 2, mdctSpectrum, lg >> 1, lg_max >> 1);
+    ErrorStatus = decode2(hBs, pArcoData->pkCache, pArcoData->c_prev + 2, mdctSpectrum, lg >> 1,
+                          lg_max >> 1);
   } else {
     FDKmemset(&pArcoData->c_prev[2], 1, sizeof(pArcoData->c_prev[2]) * (lg_max >> 1));
   }
@@ -557,6 +557,10 @@ FDK_drcDec_SetDownmixInstructions(HANDLE_DRC_DECODER hDrcDec, const int numDownm
 
   if (numDownmixId > 32) return DRC_DEC_NOT_OK;
 
+  if (hDrcDec->functionalRange & DRC_DEC_SELECTION) {
+    drcDec_SelectionProcess_SetConfigModified(hDrcDec->hSelectionProc);
+  }
+
   diff |= _compAssign(&hDrcDec->uniDrcConfig.downmixInstructionsCount, numDownmixId);
 
   for (i = 0; i < numDownmixId; i++) {
@@ -631,6 +635,10 @@ FDK_drcDec_ReadUniDrcConfig(HANDLE_DRC_DECODER hDrcDec, HANDLE_FDK_BITSTREAM hBi
 
   if (hDrcDec == NULL) return DRC_DEC_NOT_OPENED;
 
+  if (hDrcDec->functionalRange & DRC_DEC_SELECTION) {
+    drcDec_SelectionProcess_SetConfigModified(hDrcDec->hSelectionProc);
+  }
+
   hDrcDec->uniDrcConfig.loudnessInfoSetPresent = 0; /* set to zero for error handling */
   if (hDrcDec->codecMode == DRC_DEC_MPEG_H_3DA) {
     dErr = drcDec_readMpegh3daUniDrcConfig(hBitstream, &(hDrcDec->uniDrcConfig),
@@ -652,6 +660,10 @@ FDK_drcDec_ReadLoudnessInfoSet(HANDLE_DRC_DECODER hDrcDec, HANDLE_FDK_BITSTREAM
 
   if (hDrcDec == NULL) return DRC_DEC_NOT_OPENED;
 
+  if (hDrcDec->functionalRange & DRC_DEC_SELECTION) {
+    drcDec_SelectionProcess_SetConfigModified(hDrcDec->hSelectionProc);
+  }
+
   if (hDrcDec->codecMode == DRC_DEC_MPEG_H_3DA) {
     dErr =
         drcDec_readMpegh3daLoudnessInfoSet(hBitstream, &(hDrcDec->loudnessInfoSet), subStreamIndex);
@@ -222,6 +222,18 @@ typedef struct {
 
 } DRCDEC_SELECTION;
 
+/*******************************************/
+#define SEL_PROC_CACHE_SIZE 8 /* number of selection results kept for repeated requests */
+
+typedef struct {
+  UCHAR valid;
+  SEL_PROC_CODEC_MODE codecMode;
+  UINT64 configHash;                 /* hash of uniDrcConfig and loudnessInfoSet */
+  SEL_PROC_INPUT selProcInput;       /* request when the selection process was started */
+  SEL_PROC_INPUT selProcInputResult; /* request after the downmixId mapping */
+  SEL_PROC_OUTPUT selProcOutput;
+} SEL_PROC_CACHE_ENTRY;
+
 /*******************************************/
 /* helper functions                        */
 /*******************************************/
@@ -374,6 +386,14 @@ static int _findMethodDefinition(LOUDNESS_INFO* pLoudnessInfo, int methodDefinit
 static DRCDEC_SELECTION_PROCESS_RETURN _getGroupLoudness(HANDLE_LOUDNESS_INFO_SET hLoudnessInfoSet,
                                                          HANDLE_SEL_PROC_OUTPUT hSelProcOutput);
 
+static DRCDEC_SELECTION_PROCESS_RETURN _selectionProcess(HANDLE_DRC_SELECTION_PROCESS hInstance,
+                                                         HANDLE_UNI_DRC_CONFIG hUniDrcConfig,
+                                                         HANDLE_LOUDNESS_INFO_SET hLoudnessInfoSet,
+                                                         HANDLE_SEL_PROC_OUTPUT hSelProcOutput);
+
+static UINT64 _getConfigHash(HANDLE_UNI_DRC_CONFIG hUniDrcConfig,
+                             HANDLE_LOUDNESS_INFO_SET hLoudnessInfoSet);
+
 /*******************************************/
 /* public functions                        */
 /*******************************************/
@@ -382,6 +402,10 @@ struct s_drcdec_selection_process {
   SEL_PROC_CODEC_MODE codecMode;
   SEL_PROC_INPUT selProcInput;
   DRCDEC_SELECTION selectionData[2]; /* 2 instances, one before and one after selection */
+  SEL_PROC_CACHE_ENTRY cache[SEL_PROC_CACHE_SIZE];
+  UCHAR cacheNext;       /* cache entry to be replaced next */
+  UCHAR configHashValid; /* configHash is up to date with uniDrcConfig and loudnessInfoSet */
+  UINT64 configHash;
 };
 
 DRCDEC_SELECTION_PROCESS_RETURN
@@ -631,6 +655,14 @@ drcDec_SelectionProcess_SetMpeghParams(HANDLE_DRC_SELECTION_PROCESS hInstance,
   return DRCDEC_SELECTION_PROCESS_NO_ERROR;
 }
 
+DRCDEC_SELECTION_PROCESS_RETURN
+drcDec_SelectionProcess_SetConfigModified(HANDLE_DRC_SELECTION_PROCESS hInstance) {
+  if (hInstance == NULL) return DRCDEC_SELECTION_PROCESS_INVALID_HANDLE;
+
+  hInstance->configHashValid = 0;
+  return DRCDEC_SELECTION_PROCESS_NO_ERROR;
+}
+
 DRCDEC_SELECTION_PROCESS_RETURN
 drcDec_SelectionProcess_Delete(HANDLE_DRC_SELECTION_PROCESS* phInstance) {
   if (phInstance == NULL || *phInstance == NULL) return DRCDEC_SELECTION_PROCESS_INVALID_HANDLE;
@@ -646,11 +678,65 @@ drcDec_SelectionProcess_Process(HANDLE_DRC_SELECTION_PROCESS hInstance,
                                 HANDLE_LOUDNESS_INFO_SET hLoudnessInfoSet,
                                 HANDLE_SEL_PROC_OUTPUT hSelProcOutput) {
   DRCDEC_SELECTION_PROCESS_RETURN retVal = DRCDEC_SELECTION_PROCESS_NO_ERROR;
-  DRCDEC_SELECTION* pCandidatesSelected;
-  DRCDEC_SELECTION* pCandidatesPotential;
+  SEL_PROC_CACHE_ENTRY* pEntry;
+  int i;
 
   if (hInstance == NULL) return DRCDEC_SELECTION_PROCESS_INVALID_HANDLE;
 
+  /* The result of the selection process only depends on the request, the codec mode and the
+     contents of uniDrcConfig and loudnessInfoSet. Repeated requests are answered from the cache. */
+  if (!hInstance->configHashValid) {
+    hInstance->configHash = _getConfigHash(hUniDrcConfig, hLoudnessInfoSet);
+    hInstance->configHashValid = 1;
+  }
+
+  for (i = 0; i < SEL_PROC_CACHE_SIZE; i++) {
+    pEntry = &(hInstance->cache[i]);
+    if (pEntry->valid && (pEntry->configHash == hInstance->configHash) &&
+        (pEntry->codecMode == hInstance->codecMode) &&
+        !FDKmemcmp(&(pEntry->selProcInput), &(hInstance->selProcInput), sizeof(SEL_PROC_INPUT))) {
+      /* the virtual DRC sets are part of uniDrcConfig and have to be restored */
+      retVal =
+          _generateVirtualDrcSets(&(hInstance->selProcInput), hUniDrcConfig, hInstance->codecMode);
+      if (retVal) return (retVal);
+
+      FDKmemcpy(&(hInstance->selProcInput), &(pEntry->selProcInputResult), sizeof(SEL_PROC_INPUT));
+      FDKmemcpy(hSelProcOutput, &(pEntry->selProcOutput), sizeof(SEL_PROC_OUTPUT));
+      return DRCDEC_SELECTION_PROCESS_NO_ERROR;
+    }
+  }
+
+  pEntry = &(hInstance->cache[hInstance->cacheNext]);
+  pEntry->valid = 0;
+  FDKmemcpy(&(pEntry->selProcInput), &(hInstance->selProcInput), sizeof(SEL_PROC_INPUT));
+
+  retVal = _selectionProcess(hInstance, hUniDrcConfig, hLoudnessInfoSet, hSelProcOutput);
+
+  /* only complete selections are stored */
+  if (retVal == DRCDEC_SELECTION_PROCESS_NO_ERROR) {
+    pEntry->valid = 1;
+    pEntry->codecMode = hInstance->codecMode;
+    pEntry->configHash = hInstance->configHash;
+    FDKmemcpy(&(pEntry->selProcInputResult), &(hInstance->selProcInput), sizeof(SEL_PROC_INPUT));
+    FDKmemcpy(&(pEntry->selProcOutput), hSelProcOutput, sizeof(SEL_PROC_OUTPUT));
+    hInstance->cacheNext = (hInstance->cacheNext + 1) % SEL_PROC_CACHE_SIZE;
+  }
+
+  return retVal;
+}
+
+/*******************************************/
+/* static functions                        */
+/*******************************************/
+
+static DRCDEC_SELECTION_PROCESS_RETURN _selectionProcess(HANDLE_DRC_SELECTION_PROCESS hInstance,
+                                                         HANDLE_UNI_DRC_CONFIG hUniDrcConfig,
+                                                         HANDLE_LOUDNESS_INFO_SET hLoudnessInfoSet,
+                                                         HANDLE_SEL_PROC_OUTPUT hSelProcOutput) {
+  DRCDEC_SELECTION_PROCESS_RETURN retVal = DRCDEC_SELECTION_PROCESS_NO_ERROR;
+  DRCDEC_SELECTION* pCandidatesSelected;
+  DRCDEC_SELECTION* pCandidatesPotential;
+
   pCandidatesSelected = &(hInstance->selectionData[0]);
   pCandidatesPotential = &(hInstance->selectionData[1]);
   _drcdec_selection_setNumber(pCandidatesSelected, 0);
@@ -707,9 +793,66 @@ drcDec_SelectionProcess_Process(HANDLE_DRC_SELECTION_PROCESS hInstance,
   return DRCDEC_SELECTION_PROCESS_NO_ERROR;
 }
 
-/*******************************************/
-/* static functions                        */
-/*******************************************/
+#define SEL_PROC_HASH_PRIME ((UINT64)0x100000001B3) /* 64-bit FNV prime */
+
+static inline UINT64 _load64(const UCHAR* p) {
+  return (UINT64)p[0] | ((UINT64)p[1] << 8) | ((UINT64)p[2] << 16) | ((UINT64)p[3] << 24) |
+         ((UINT64)p[4] << 32) | ((UINT64)p[5] << 40) | ((UINT64)p[6] << 48) | ((UINT64)p[7] << 56);
+}
+
+/* Continue hash over the bytes from pStart up to pEnd. Four independent lanes of 64-bit words keep
+   the hash cheap compared to the selection process. */
+static UINT64 _hashRange(UINT64 hash, const void* pStart, const void* pEnd) {
+  const UCHAR* p = (const UCHAR*)pStart;
+  const UCHAR* pStop = (const UCHAR*)pEnd;
+  UINT64 h0 = hash, h1 = ~hash, h2 = hash + 1, h3 = hash - 1;
+
+  for (; p + 32 <= pStop; p += 32) {
+    h0 = (h0 ^ _load64(p)) * SEL_PROC_HASH_PRIME;
+    h1 = (h1 ^ _load64(p + 8)) * SEL_PROC_HASH_PRIME;
+    h2 = (h2 ^ _load64(p + 16)) * SEL_PROC_HASH_PRIME;
+    h3 = (h3 ^ _load64(p + 24)) * SEL_PROC_HASH_PRIME;
+  }
+  for (; p < pStop; p++) {
+    h0 = (h0 ^ *p) * SEL_PROC_HASH_PRIME;
+  }
+
+  hash = (h0 ^ (h1 >> 29)) * SEL_PROC_HASH_PRIME;
+  hash = (hash ^ h1 ^ (h2 >> 29)) * SEL_PROC_HASH_PRIME;
+  hash = (hash ^ h2 ^ (h3 >> 29)) * SEL_PROC_HASH_PRIME;
+  hash = (hash ^ h3) * SEL_PROC_HASH_PRIME;
+  return hash ^ (hash >> 32);
+}
+
+/* Hash of all uniDrcConfig and loudnessInfoSet elements which are in use, excluding the virtual DRC
+   sets and derived data, which are written by the selection process. */
+static UINT64 _getConfigHash(HANDLE_UNI_DRC_CONFIG hUniDrcConfig,
+                             HANDLE_LOUDNESS_INFO_SET hLoudnessInfoSet) {
+  UINT64 hash = (UINT64)0xCBF29CE484222325; /* 64-bit FNV offset basis */
+
+  hash = _hashRange(hash, hUniDrcConfig, hUniDrcConfig->downmixInstructions);
+  hash = _hashRange(hash, hUniDrcConfig->downmixInstructions,
+                    &(hUniDrcConfig->downmixInstructions[hUniDrcConfig->downmixInstructionsCount]));
+  hash = _hashRange(
+      hash, hUniDrcConfig->drcCoefficientsUniDrc,
+      &(hUniDrcConfig->drcCoefficientsUniDrc[hUniDrcConfig->drcCoefficientsUniDrcCount]));
+  hash = _hashRange(
+      hash, hUniDrcConfig->drcInstructionsUniDrc,
+      &(hUniDrcConfig->drcInstructionsUniDrc[hUniDrcConfig->drcInstructionsUniDrcCount]));
+  hash = _hashRange(hash, &(hUniDrcConfig->loudnessInfoSetPresent),
+                    &(hUniDrcConfig->drcInstructionsCountInclVirtual));
+
+  hash = _hashRange(hash, hLoudnessInfoSet, hLoudnessInfoSet->loudnessInfoAlbum);
+  hash = _hashRange(
+      hash, hLoudnessInfoSet->loudnessInfoAlbum,
+      &(hLoudnessInfoSet->loudnessInfoAlbum[hLoudnessInfoSet->loudnessInfoAlbumCount]));
+  hash = _hashRange(hash, hLoudnessInfoSet->loudnessInfo,
+                    &(hLoudnessInfoSet->loudnessInfo[hLoudnessInfoSet->loudnessInfoCount]));
+  hash = _hashRange(hash, &(hLoudnessInfoSet->loudnessInfoSetExtPresent),
+                    &(hLoudnessInfoSet->diff));
+
+  return hash;
+}
 
 static DRCDEC_SELECTION_PROCESS_RETURN _initDefaultParams(HANDLE_SEL_PROC_INPUT hSelProcInput) {
   DRCDEC_SELECTION_PROCESS_RETURN retVal = DRCDEC_SELECTION_PROCESS_NO_ERROR;
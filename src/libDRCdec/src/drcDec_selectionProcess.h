@@ -206,6 +206,11 @@ drcDec_SelectionProcess_SetMpeghParams(HANDLE_DRC_SELECTION_PROCESS hInstance,
                                        const int* numMembersGroupPresetIdsRequested,
                                        const int groupPresetIdRequestedPreference, int* pDiff);
 
+/* Signal that uniDrcConfig or loudnessInfoSet may have been modified since the last call of
+   drcDec_SelectionProcess_Process(). Selection results are cached per content of both. */
+DRCDEC_SELECTION_PROCESS_RETURN
+drcDec_SelectionProcess_SetConfigModified(HANDLE_DRC_SELECTION_PROCESS hInstance);
+
 DRCDEC_SELECTION_PROCESS_RETURN
 drcDec_SelectionProcess_Process(HANDLE_DRC_SELECTION_PROCESS hInstance,
                                 HANDLE_UNI_DRC_CONFIG hUniDrcConfig,
@@ -95,6 +95,27 @@ amm-info@iis.fraunhofer.de
 
 #define E_TGAINSTEP 12
 
+#if defined(__x86__)
+#include "x86/drcGainDec_process_x86.cpp"
+#endif
+
+/* Linear interpolation segment of a DRC gain: buffer[offset + i] is multiplied with the gain
+   (gain + i * gainStep) for i < runs. The gain has a headroom of n_min bits. */
+typedef struct {
+  INT offset;
+  INT runs;
+  INT n_min;
+  LONG gain;
+  LONG gainStep;
+} DRC_GAIN_SEGMENT;
+
+/* All interpolation segments of a DRC gain within one frame. They are collected once per DRC
+   gain and then applied to every channel sharing that gain. */
+typedef struct {
+  int nSegments;
+  DRC_GAIN_SEGMENT segment[(NUM_LNB_FRAMES - 1) * 32];
+} DRC_GAIN_RAMP;
+
 static DRC_ERROR _prepareLnbIndex(ACTIVE_DRC* pActiveDrc, const int channelOffset,
                                   const int drcChannelOffset, const int numChannelsProcessed,
                                   const int lnbPointer) {
@@ -143,7 +164,7 @@ static DRC_ERROR _interpolateDrcGain(const GAIN_INTERPOLATION_TYPE gainInterpola
                                      const FIXP_DBL gainRight,  /* gain at time1, e = 7 */
                                      const FIXP_DBL slopeLeft,  /* slope at time0, e = 7 */
                                      const FIXP_DBL slopeRight, /* slope at time1, e = 7 */
-                                     FIXP_DBL* buffer) {
+                                     DRC_GAIN_RAMP* pGainRamp) {
   int n, n_buf;
   int start_modulo, start_offset;
 
@@ -169,8 +190,8 @@ static DRC_ERROR _interpolateDrcGain(const GAIN_INTERPOLATION_TYPE gainInterpola
   n_buf = (start + timePrev + start_offset) >> (15 - fixnormz_S(stepsize));
 
   { /* gainInterpolationType == GIT_LINEAR */
-    LONG a, a_step;
-    int i;
+    LONG a, a_step = 0;
+    DRC_GAIN_SEGMENT* pSegment;
     /* runs: Number of gain applications on buffer.
        runs = ceil((stop - start - start_offset)/stepsize). This works for stepsize = 2^N only. */
     INT runs =
@@ -188,22 +209,42 @@ static DRC_ERROR _interpolateDrcGain(const GAIN_INTERPOLATION_TYPE gainInterpola
     n = start + start_offset;
     /* a: linear interpolation gain of first gain application */
     a = a * n + (LONG)(gainLeft << n_min);
-    buffer += n_buf;
+
+    if (pGainRamp->nSegments >= (NUM_LNB_FRAMES - 1) * 32) return DE_NOT_OK;
+    pSegment = &(pGainRamp->segment[pGainRamp->nSegments++]);
+    pSegment->offset = n_buf;
+    pSegment->runs = runs;
+    pSegment->n_min = n_min;
+    pSegment->gain = a;
+    pSegment->gainStep = a_step;
+  }
+  return DE_OK;
+}
+
+/* Apply all interpolation segments of a DRC gain to buffer. */
+static void _applyDrcGainRamp(const DRC_GAIN_RAMP* pGainRamp, FIXP_DBL* buffer) {
+  int s;
+
+  for (s = 0; s < pGainRamp->nSegments; s++) {
+    const DRC_GAIN_SEGMENT* pSegment = &(pGainRamp->segment[s]);
 #if defined(FUNCTION_interpolateDrcGain_func1)
-    interpolateDrcGain_func1(buffer, a, a_step, n_min, runs);
+    interpolateDrcGain_func1(buffer + pSegment->offset, pSegment->gain, pSegment->gainStep,
+                             pSegment->n_min, pSegment->runs);
 #else
+    FIXP_DBL* pBuffer = buffer + pSegment->offset;
+    LONG a = pSegment->gain;
     /* n_min: scaling value to compensate for e = 7 of the gain, and for fMultDiv2 */
-    n_min = 8 - n_min;
-    for (i = 0; i < runs - 1; i++) {
-      buffer[i] = fMultDiv2(buffer[i], (FIXP_DBL)a) << n_min;
-      a += a_step;
+    INT n_min = 8 - pSegment->n_min;
+    int i;
+    for (i = 0; i < pSegment->runs - 1; i++) {
+      pBuffer[i] = fMultDiv2(pBuffer[i], (FIXP_DBL)a) << n_min;
+      a += pSegment->gainStep;
     }
-    for (; i < runs; i++) {
-      buffer[i] = fMultDiv2(buffer[i], (FIXP_DBL)a) << n_min;
+    for (; i < pSegment->runs; i++) {
+      pBuffer[i] = fMultDiv2(pBuffer[i], (FIXP_DBL)a) << n_min;
     }
 #endif /* defined(FUNCTION_interpolateDrcGain_func1) */
   }
-  return DE_OK;
 }
 
 static DRC_ERROR _processNodeSegments(
@@ -213,7 +254,7 @@ static DRC_ERROR _processNodeSegments(
     const SHORT nodeLinTimePrevious,    /* the last node time of the previous frame */
     const FIXP_DBL channelGain,         /* e = 8 */
     FIXP_DBL* pChannelGainPrevious,     /* e = 8 */
-    FIXP_DBL* buffer) {
+    DRC_GAIN_RAMP* pGainRamp) {
   DRC_ERROR err = DE_OK;
   SHORT timePrev; /* The last sample of the last interpolation segment. */
   SHORT time;     /* The last sample of the current interpolation segment. */
@@ -257,7 +298,7 @@ static DRC_ERROR _processNodeSegments(
     }
 
     err = _interpolateDrcGain(gainInterpolationType, timePrev, duration, start, stop, stepsize,
-                              gainLinChanPrev, gainLinChan, slopeLinPrev, slopeLin, buffer);
+                              gainLinChanPrev, gainLinChan, slopeLinPrev, slopeLin, pGainRamp);
     if (err) return err;
 
     timePrev = time;
@@ -273,13 +314,17 @@ processDrcTime(HANDLE_DRC_GAIN_DECODER hGainDec, const int activeDrcIndex,
                const int drcChannelOffset, const int numChannelsProcessed,
                const int timeDataChannelOffset, FIXP_DBL* deinterleavedAudio) {
   DRC_ERROR err = DE_OK;
-  int c, b, i;
+  int c, cc, b, i;
   ACTIVE_DRC* pActiveDrc = &(hGainDec->activeDrc[activeDrcLocation][activeDrcIndex]);
   DRC_GAIN_BUFFERS* pDrcGainBuffers = &(hGainDec->drcGainBuffers);
   int lnbPointer = pDrcGainBuffers->lnbPointer, lnbIx;
   LINEAR_NODE_BUFFER* pLinearNodeBuffer = pDrcGainBuffers->linearNodeBuffer;
   LINEAR_NODE_BUFFER* pDummyLnb = &(pDrcGainBuffers->dummyLnb);
   int offset = 0;
+  int applyChannelGain =
+      (activeDrcLocation == 0 && activeDrcIndex == hGainDec->channelGainActiveDrcIndex);
+  UCHAR channelDone[28];
+  DRC_GAIN_RAMP gainRamp;
 
   if (hGainDec->delayMode == DM_REGULAR_DELAY) {
     offset = hGainDec->frameSize;
@@ -294,21 +339,26 @@ processDrcTime(HANDLE_DRC_GAIN_DECODER hGainDec, const int activeDrcIndex,
                          lnbPointer);
   if (err) return err;
 
-  deinterleavedAudio += channelOffset * timeDataChannelOffset; /* apply channelOffset */
+  FDKmemclear(channelDone, sizeof(channelDone));
 
   /* signal processing loop */
   for (c = channelOffset; c < channelOffset + numChannelsProcessed; c++) {
-    FIXP_DBL channelGain, *pChannelGainPrev;
+    FIXP_DBL channelGain, *pChannelGainPrev, channelGainPrevStart;
     FIXP_DBL gainOne = FL2FXCONST_DBL(1.0f / (float)(1 << 8));
-    if (activeDrcLocation == 0 && activeDrcIndex == hGainDec->channelGainActiveDrcIndex) {
+
+    if (channelDone[c]) continue;
+
+    if (applyChannelGain) {
       channelGain = hGainDec->channelGain[c];
       pChannelGainPrev = &(hGainDec->channelGainPrev[c]);
     } else {
       channelGain = gainOne;
       pChannelGainPrev = &gainOne;
     }
+    channelGainPrevStart = *pChannelGainPrev;
 
     b = 0;
+    gainRamp.nSegments = 0;
     {
       LINEAR_NODE_BUFFER *pLnb, *pLnbPrevious;
       FIXP_DBL nodeGainPrevious;
@@ -350,10 +400,25 @@ processDrcTime(HANDLE_DRC_GAIN_DECODER hGainDec, const int activeDrcIndex,
             hGainDec->frameSize, pLnb->gainInterpolationType, pLnb->nNodes[lnbIx],
             pLnb->linearNodeGain[lnbIx], pLnb->linearNodeTime[lnbIx],
             lnbPointerDiff * hGainDec->frameSize + delaySamples + offset, 1, nodeGainPrevious,
-            nodeTimePrevious, channelGain, pChannelGainPrev, deinterleavedAudio);
+            nodeTimePrevious, channelGain, pChannelGainPrev, &gainRamp);
         if (err) return err;
       }
-      deinterleavedAudio += timeDataChannelOffset; /* proceed to next channel */
+    }
+
+    /* The DRC gain only depends on the linearNodeBuffer instances and the channel gain. Apply it
+       to all remaining channels of the same DRC channel group in the same pass. */
+    _applyDrcGainRamp(&gainRamp, deinterleavedAudio + c * timeDataChannelOffset);
+    for (cc = c + 1; cc < channelOffset + numChannelsProcessed; cc++) {
+      if (FDKmemcmp(pActiveDrc->lnbIndexForChannel[cc], pActiveDrc->lnbIndexForChannel[c],
+                    sizeof(pActiveDrc->lnbIndexForChannel[c])))
+        continue;
+      if (applyChannelGain && ((hGainDec->channelGain[cc] != channelGain) ||
+                               (hGainDec->channelGainPrev[cc] != channelGainPrevStart)))
+        continue;
+
+      _applyDrcGainRamp(&gainRamp, deinterleavedAudio + cc * timeDataChannelOffset);
+      if (applyChannelGain) hGainDec->channelGainPrev[cc] = *pChannelGainPrev;
+      channelDone[cc] = 1;
     }
   }
   return DE_OK;
@@ -429,6 +494,7 @@ processDrcSubband(HANDLE_DRC_GAIN_DECODER hGainDec, const int activeDrcIndex,
                                          called */
   {
     FIXP_DBL gainOne = FL2FXCONST_DBL(1.0f / (float)(1 << 8));
+    DRC_GAIN_RAMP gainRamp;
     UCHAR g;
     /* write subbandGains */
     for (g = 0; g < pInst->nDrcChannelGroups; g++) {
@@ -443,6 +509,7 @@ processDrcSubband(HANDLE_DRC_GAIN_DECODER hGainDec, const int activeDrcIndex,
           subbandGains[activeDrcOffset + g][b * frameSizeSb + m] =
               FL2FXCONST_DBL(1.0f / (float)(1 << 7));
         }
+        gainRamp.nSegments = 0;
 
         lnbIx = lnbPointer - (NUM_LNB_FRAMES - 1);
         while (lnbIx < 0) lnbIx += NUM_LNB_FRAMES;
@@ -466,10 +533,10 @@ processDrcSubband(HANDLE_DRC_GAIN_DECODER hGainDec, const int activeDrcIndex,
               hGainDec->frameSize, pLnb->gainInterpolationType, pLnb->nNodes[lnbIx],
               pLnb->linearNodeGain[lnbIx], pLnb->linearNodeTime[lnbIx],
               lnbPointerDiff * hGainDec->frameSize + delaySamples + offset - (L - 1) / 2, L,
-              nodeGainPrevious, nodeTimePrevious, gainOne, &gainOne,
-              &(subbandGains[activeDrcOffset + g][b * frameSizeSb]));
+              nodeGainPrevious, nodeTimePrevious, gainOne, &gainOne, &gainRamp);
           if (err) return err;
         }
+        _applyDrcGainRamp(&gainRamp, &(subbandGains[activeDrcOffset + g][b * frameSizeSb]));
       }
     }
     pActiveDrc->subbandGainsReady = 1;
@@ -0,0 +1,162 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2018 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+/************************* MPEG-D DRC decoder library **************************
+
+   Author(s):
+
+   Description: (x86 SSE4.1/AVX2 optimized) DRC gain application
+
+*******************************************************************************/
+
+#if defined(__x86_SSE4_1__)
+#include "x86/FDK_x86_funcs.h"
+
+#define FUNCTION_interpolateDrcGain_func1
+#endif
+
+#if defined(FUNCTION_interpolateDrcGain_func1)
+/* Multiply buffer[i] with the linearly interpolated gain (a + i * a_step) for i < runs. The gain
+   has a headroom of n_min bits, which is compensated together with the one of fMultDiv2. */
+static FDK_X86_TARGET_SSE4_1 void interpolateDrcGain_func1_SSE4_1(FIXP_DBL* buffer, LONG a,
+                                                                  LONG a_step, INT n_min,
+                                                                  INT runs) {
+  const __m128i shift = _mm_cvtsi32_si128(8 - n_min);
+  const __m128i step = _mm_set1_epi32((INT)((UINT)a_step << 2));
+  __m128i gain = _mm_mullo_epi32(_mm_set1_epi32(a_step), _mm_setr_epi32(0, 1, 2, 3));
+  INT i = 0;
+
+  gain = _mm_add_epi32(gain, _mm_set1_epi32(a));
+  for (; i + 4 <= runs; i += 4) {
+    __m128i x = _mm_loadu_si128((__m128i*)&buffer[i]);
+    _mm_storeu_si128((__m128i*)&buffer[i], _mm_sll_epi32(FDK_mm_fMultDiv2_epi32(x, gain), shift));
+    gain = _mm_add_epi32(gain, step);
+  }
+  a = (LONG)((UINT)a + (UINT)a_step * (UINT)i);
+  for (; i < runs; i++) {
+    buffer[i] = fMultDiv2(buffer[i], (FIXP_DBL)a) << (8 - n_min);
+    a = (LONG)((UINT)a + (UINT)a_step);
+  }
+}
+
+#if defined(__x86_AVX2__)
+static FDK_X86_TARGET_AVX2 void interpolateDrcGain_func1_AVX2(FIXP_DBL* buffer, LONG a,
+                                                              LONG a_step, INT n_min, INT runs) {
+  const __m128i shift = _mm_cvtsi32_si128(8 - n_min);
+  const __m256i step = _mm256_set1_epi32((INT)((UINT)a_step << 3));
+  __m256i gain =
+      _mm256_mullo_epi32(_mm256_set1_epi32(a_step), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+  INT i = 0;
+
+  gain = _mm256_add_epi32(gain, _mm256_set1_epi32(a));
+
+  for (; i + 8 <= runs; i += 8) {
+    __m256i x = _mm256_loadu_si256((__m256i*)&buffer[i]);
+    _mm256_storeu_si256((__m256i*)&buffer[i],
+                        _mm256_sll_epi32(FDK_mm256_fMultDiv2_epi32(x, gain), shift));
+    gain = _mm256_add_epi32(gain, step);
+  }
+  interpolateDrcGain_func1_SSE4_1(&buffer[i], (LONG)((UINT)a + (UINT)a_step * (UINT)i), a_step,
+                                  n_min, runs - i);
+}
+#endif /* defined(__x86_AVX2__) */
+
+static inline void interpolateDrcGain_func1(FIXP_DBL* buffer, LONG a, LONG a_step, INT n_min,
+                                            INT runs) {
+  INT i;
+#if defined(__x86_AVX2__)
+  if (FDK_X86_HAS_AVX2) {
+    interpolateDrcGain_func1_AVX2(buffer, a, a_step, n_min, runs);
+    return;
+  }
+#endif
+  if (FDK_X86_HAS_SSE4_1) {
+    interpolateDrcGain_func1_SSE4_1(buffer, a, a_step, n_min, runs);
+    return;
+  }
+  /* n_min: scaling value to compensate for e = 7 of the gain, and for fMultDiv2 */
+  n_min = 8 - n_min;
+  for (i = 0; i < runs; i++) {
+    buffer[i] = fMultDiv2(buffer[i], (FIXP_DBL)a) << n_min;
+    a = (LONG)((UINT)a + (UINT)a_step);
+  }
+}
+#endif /* defined(FUNCTION_interpolateDrcGain_func1) */
@@ -168,6 +168,21 @@ amm-info@iis.fraunhofer.de
 #define __ARM_ARCH_7EM__
 #endif
 
+#if defined(__x86__)
+/* Detect and unify macros for the x86 SIMD extensions (see mpeghdec_X86_SIMD in CMakeLists.txt).
+ * MSVC only announces AVX2, which implies SSE4.1. With FDK_X86_DISPATCH all kernels are built and
+ * selected at runtime according to FDK_getCpuFeatures(). */
+#if defined(FDK_X86_DISPATCH)
+#define __x86_AVX2__
+#define __x86_SSE4_1__
+#elif defined(__AVX2__)
+#define __x86_AVX2__
+#define __x86_SSE4_1__
+#elif defined(__SSE4_1__)
+#define __x86_SSE4_1__
+#endif
+#endif
+
 #if defined(__APPLE__)
 #undef __ARM_NEON__         /* disable use of ARMv7 legacy NEON */
 #undef __ARM_AARCH64_NEON__ /* disable use of ARMv8 NEON */
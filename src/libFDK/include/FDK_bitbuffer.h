@@ -106,6 +106,7 @@ typedef struct {
   UCHAR* Buffer; /* struct member offset:  5 */
   UINT bufSize;  /* struct member offset:  6 */
   UINT bufBits;  /* struct member offset:  7 */
+  UINT bufLimit; /* Readable bytes of Buffer; less than bufSize while bound to external data. */
 } FDK_BITBUF;
 
 typedef FDK_BITBUF* HANDLE_FDK_BITBUF;
@@ -191,6 +192,8 @@ FDK_INLINE INT FDK_get32(HANDLE_FDK_BITBUF hBitBuf) {
 INT FDK_get32(HANDLE_FDK_BITBUF hBitBuf);
 #endif
 
+INT FDK_getBound32(HANDLE_FDK_BITBUF hBitBuf);
+
 void FDK_put(HANDLE_FDK_BITBUF hBitBuffer, UINT value, const UINT numberOfBits);
 
 INT FDK_getBwd(HANDLE_FDK_BITBUF hBitBuffer, const UINT numberOfBits);
@@ -238,6 +241,11 @@ INT FDK_getFreeBits(HANDLE_FDK_BITBUF hBitBuffer);
 void FDK_Feed(HANDLE_FDK_BITBUF hBitBuffer, const UCHAR inputBuffer[], const UINT bufferSize,
               UINT* bytesValid);
 
+void FDK_Bind(HANDLE_FDK_BITBUF hBitBuffer, const UCHAR inputBuffer[], const UINT bufSize,
+              const UINT numBytes);
+
+void FDK_Unbind(HANDLE_FDK_BITBUF hBitBuffer, UCHAR* pBuffer, const UINT bufSize);
+
 void FDK_Copy(HANDLE_FDK_BITBUF hBitBufDst, HANDLE_FDK_BITBUF hBitBufSrc, UINT* bytesValid);
 
 void FDK_Fetch(HANDLE_FDK_BITBUF hBitBuffer, UCHAR outBuf[], UINT* writeBytes);
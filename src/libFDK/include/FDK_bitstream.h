@@ -97,13 +97,14 @@ amm-info@iis.fraunhofer.de
 #include "genericStds.h"
 
 #define CACHE_BITS 32
+#define READ_CACHE_BITS 64 /* Capacity of the cache of a BS_READER. */
 
 #define BUFSIZE_DUMMY_VALUE MAX_BUFSIZE_BYTES
 
 typedef enum { BS_READER, BS_WRITER } FDK_BS_CFG;
 
 typedef struct {
-  UINT CacheWord;
+  UINT64 CacheWord; /* The valid bits are the BitsInCache LSBs, upper bits are don't care. */
   UINT BitsInCache;
   FDK_BITBUF hBitBuf;
   UINT ConfigCache;
@@ -178,6 +179,41 @@ FDK_INLINE void FDKdeleteBitStream(HANDLE_FDK_BITSTREAM hBitStream) {
   FDKfree(hBitStream);
 }
 
+/**
+ * \brief FillCache Function. Appends at least 32 bits of the bit buffer to the read cache, which
+ *        has to hold less than 32 bits. If the next 8 bytes are contiguous in memory, as many whole
+ *        bytes as fit into the cache are taken from a single 64 bit load. Otherwise the ring
+ *        buffer is read with FDK_get32(), or with FDK_getBound32() at the end of bound data.
+ *
+ * \param hBitStream HANDLE_FDK_BITSTREAM handle
+ * \return void
+ */
+FDK_INLINE void FDKfillCache(HANDLE_FDK_BITSTREAM hBitStream) {
+  HANDLE_FDK_BITBUF hBitBuf = &hBitStream->hBitBuf;
+  UINT byteOffset = hBitBuf->BitNdx >> 3;
+
+  FDK_ASSERT(hBitStream->BitsInCache < 32);
+  if (byteOffset + 8 <= hBitBuf->bufLimit) {
+    const UCHAR* pBuf = &hBitBuf->Buffer[byteOffset];
+    UINT64 word = ((UINT64)pBuf[0] << 56) | ((UINT64)pBuf[1] << 48) | ((UINT64)pBuf[2] << 40) |
+                  ((UINT64)pBuf[3] << 32) | ((UINT64)pBuf[4] << 24) | ((UINT64)pBuf[5] << 16) |
+                  ((UINT64)pBuf[6] << 8) | (UINT64)pBuf[7];
+    UINT numBits = (READ_CACHE_BITS - 1 - hBitStream->BitsInCache) & ~7u; /* 32..56 */
+
+    word = (word << (hBitBuf->BitNdx & 7)) >> (64 - numBits);
+    hBitStream->CacheWord = (hBitStream->CacheWord << numBits) | word;
+    hBitStream->BitsInCache += numBits;
+    hBitBuf->BitNdx = (hBitBuf->BitNdx + numBits) & (hBitBuf->bufBits - 1);
+    hBitBuf->ValidBits -= (INT)numBits;
+  } else if (hBitBuf->bufLimit == hBitBuf->bufSize) {
+    hBitStream->CacheWord = (hBitStream->CacheWord << 32) | (UINT)FDK_get32(hBitBuf);
+    hBitStream->BitsInCache += CACHE_BITS;
+  } else {
+    hBitStream->CacheWord = (hBitStream->CacheWord << 32) | (UINT)FDK_getBound32(hBitBuf);
+    hBitStream->BitsInCache += CACHE_BITS;
+  }
+}
+
 /**
  * \brief ReadBits Function (forward). This function returns a number of sequential
  *        bits from the input bitstream.
@@ -187,35 +223,59 @@ FDK_INLINE void FDKdeleteBitStream(HANDLE_FDK_BITSTREAM hBitStream) {
  * \return the requested bits, right aligned
  * \return
  */
-#if defined(__clang__) && (__clang_major__ >= 12)
-__attribute__((no_sanitize("unsigned-shift-base")))
-#endif
-FDK_INLINE UINT
-FDKreadBits(HANDLE_FDK_BITSTREAM hBitStream, const UINT numberOfBits) {
-  UINT bits = 0;
-  INT missingBits = (INT)numberOfBits - (INT)hBitStream->BitsInCache;
-
+FDK_INLINE UINT FDKreadBits(HANDLE_FDK_BITSTREAM hBitStream, const UINT numberOfBits) {
   FDK_ASSERT(numberOfBits <= 32);
-  if (missingBits > 0) {
-    if (missingBits != 32) bits = hBitStream->CacheWord << missingBits;
-    hBitStream->CacheWord = FDK_get32(&hBitStream->hBitBuf);
-    hBitStream->BitsInCache += CACHE_BITS;
+  if (hBitStream->BitsInCache < numberOfBits) {
+    FDKfillCache(hBitStream);
   }
 
   hBitStream->BitsInCache -= numberOfBits;
 
-  return (bits | (hBitStream->CacheWord >> hBitStream->BitsInCache)) & BitMask[numberOfBits];
+  return (UINT)(hBitStream->CacheWord >> hBitStream->BitsInCache) & BitMask[numberOfBits];
 }
 
 FDK_INLINE UINT FDKreadBit(HANDLE_FDK_BITSTREAM hBitStream) {
   if (!hBitStream->BitsInCache) {
-    hBitStream->CacheWord = FDK_get32(&hBitStream->hBitBuf);
-    hBitStream->BitsInCache = CACHE_BITS - 1;
-    return hBitStream->CacheWord >> 31;
+    FDKfillCache(hBitStream);
   }
   hBitStream->BitsInCache--;
 
-  return (hBitStream->CacheWord >> hBitStream->BitsInCache) & 1;
+  return (UINT)(hBitStream->CacheWord >> hBitStream->BitsInCache) & 1;
+}
+
+/**
+ * \brief PeekBits Function (forward). This function returns a number of sequential bits from the
+ *        input bitstream without consuming them. The bits can be consumed with FDKskipBits().
+ *
+ * \param hBitStream HANDLE_FDK_BITSTREAM handle
+ * \param numberOfBits  The number of bits to be retrieved. ( (0),1 <= numberOfBits <= 32)
+ * \return the requested bits, right aligned
+ */
+FDK_INLINE UINT FDKpeekBits(HANDLE_FDK_BITSTREAM hBitStream, const UINT numberOfBits) {
+  FDK_ASSERT(numberOfBits <= 32);
+  if (hBitStream->BitsInCache < numberOfBits) {
+    FDKfillCache(hBitStream);
+  }
+
+  return (UINT)(hBitStream->CacheWord >> (hBitStream->BitsInCache - numberOfBits)) &
+         BitMask[numberOfBits];
+}
+
+/**
+ * \brief SkipBits Function (forward). This function discards a number of sequential bits of the
+ *        input bitstream.
+ *
+ * \param hBitStream HANDLE_FDK_BITSTREAM handle
+ * \param numberOfBits  The number of bits to be skipped. ( (0),1 <= numberOfBits <= 32)
+ * \return void
+ */
+FDK_INLINE void FDKskipBits(HANDLE_FDK_BITSTREAM hBitStream, const UINT numberOfBits) {
+  FDK_ASSERT(numberOfBits <= 32);
+  if (hBitStream->BitsInCache < numberOfBits) {
+    FDKfillCache(hBitStream);
+  }
+
+  hBitStream->BitsInCache -= numberOfBits;
 }
 
 /**
@@ -227,26 +287,14 @@ FDK_INLINE UINT FDKreadBit(HANDLE_FDK_BITSTREAM hBitStream) {
  * \return the requested bits, right aligned
  * \return
  */
-#if defined(__clang__) && (__clang_major__ >= 12)
-__attribute__((no_sanitize("unsigned-shift-base")))
-#endif
-FDK_INLINE UINT
-FDKread2Bits(HANDLE_FDK_BITSTREAM hBitStream) {
-  /*
-  ** Version corresponds to optimized FDKreadBits implementation
-  ** calling FDK_get32, that keeps read pointer aligned.
-  */
-  UINT bits = 0;
-  INT missingBits = (INT)2 - (INT)hBitStream->BitsInCache;
-  if (missingBits > 0) {
-    bits = hBitStream->CacheWord << missingBits;
-    hBitStream->CacheWord = FDK_get32(&hBitStream->hBitBuf);
-    hBitStream->BitsInCache += CACHE_BITS;
+FDK_INLINE UINT FDKread2Bits(HANDLE_FDK_BITSTREAM hBitStream) {
+  if (hBitStream->BitsInCache < 2) {
+    FDKfillCache(hBitStream);
   }
 
   hBitStream->BitsInCache -= 2;
 
-  return (bits | (hBitStream->CacheWord >> hBitStream->BitsInCache)) & 0x3;
+  return (UINT)(hBitStream->CacheWord >> hBitStream->BitsInCache) & 0x3;
 }
 
 /**
@@ -270,7 +318,7 @@ FDK_INLINE UINT FDKreadBitsBwd(HANDLE_FDK_BITSTREAM hBitStream, const UINT numbe
 
   hBitStream->BitsInCache -= numberOfBits;
 
-  return (hBitStream->CacheWord >> hBitStream->BitsInCache) & validMask;
+  return (UINT)(hBitStream->CacheWord >> hBitStream->BitsInCache) & validMask;
 }
 
 /**
@@ -347,7 +395,7 @@ FDK_INLINE UCHAR FDKwriteBits(HANDLE_FDK_BITSTREAM hBitStream, UINT value,
     int remaining_bits = numberOfBits - missing_bits;
     value = value & validMask;
     /* Avoid shift left by 32 positions */
-    UINT CacheWord = (missing_bits == 32) ? 0 : (hBitStream->CacheWord << missing_bits);
+    UINT CacheWord = (missing_bits == 32) ? 0 : (UINT)(hBitStream->CacheWord << missing_bits);
     CacheWord |= (value >> (remaining_bits));
     FDK_put(&hBitStream->hBitBuf, CacheWord, 32);
 
@@ -374,7 +422,7 @@ FDK_INLINE UCHAR FDKwriteBitsBwd(HANDLE_FDK_BITSTREAM hBitStream, UINT value,
     hBitStream->BitsInCache += numberOfBits;
     hBitStream->CacheWord = (hBitStream->CacheWord << numberOfBits) | (value & validMask);
   } else {
-    FDK_putBwd(&hBitStream->hBitBuf, hBitStream->CacheWord, hBitStream->BitsInCache);
+    FDK_putBwd(&hBitStream->hBitBuf, (UINT)hBitStream->CacheWord, hBitStream->BitsInCache);
     hBitStream->BitsInCache = numberOfBits;
     hBitStream->CacheWord = (value & validMask);
   }
@@ -433,7 +481,7 @@ FDK_INLINE void FDKsyncCache(HANDLE_FDK_BITSTREAM hBitStream) {
     FDK_pushBack(&hBitStream->hBitBuf, hBitStream->BitsInCache, hBitStream->ConfigCache);
 #endif
   else if (hBitStream->BitsInCache) /* BS_WRITER */
-    FDK_put(&hBitStream->hBitBuf, hBitStream->CacheWord, hBitStream->BitsInCache);
+    FDK_put(&hBitStream->hBitBuf, (UINT)hBitStream->CacheWord, hBitStream->BitsInCache);
 
   hBitStream->BitsInCache = 0;
   hBitStream->CacheWord = 0;
@@ -449,7 +497,7 @@ FDK_INLINE void FDKsyncCacheBwd(HANDLE_FDK_BITSTREAM hBitStream) {
   if (hBitStream->ConfigCache == BS_READER) {
     FDK_pushForward(&hBitStream->hBitBuf, hBitStream->BitsInCache, hBitStream->ConfigCache);
   } else { /* BS_WRITER */
-    FDK_putBwd(&hBitStream->hBitBuf, hBitStream->CacheWord, hBitStream->BitsInCache);
+    FDK_putBwd(&hBitStream->hBitBuf, (UINT)hBitStream->CacheWord, hBitStream->BitsInCache);
   }
 
   hBitStream->BitsInCache = 0;
@@ -496,7 +544,7 @@ FDK_INLINE void FDKbyteAlign(HANDLE_FDK_BITSTREAM hBitStream, UINT alignmentAnch
  * \return void
  */
 FDK_INLINE void FDKpushBackCache(HANDLE_FDK_BITSTREAM hBitStream, const UINT numberOfBits) {
-  FDK_ASSERT((hBitStream->BitsInCache + numberOfBits) <= CACHE_BITS);
+  FDK_ASSERT((hBitStream->BitsInCache + numberOfBits) <= READ_CACHE_BITS);
   hBitStream->BitsInCache += numberOfBits;
 }
 
@@ -565,6 +613,42 @@ FDK_INLINE void FDKfeedBuffer(HANDLE_FDK_BITSTREAM hBitStream, const UCHAR input
   FDK_Feed(&hBitStream->hBitBuf, inputBuffer, bufferSize, bytesValid);
 }
 
+/**
+ * \brief Read the bitstream directly from external data instead of copying it into the BitBuffer.
+ *        The data is addressed like a BitBuffer of bufSize bytes, but only its numBytes bytes are
+ *        accessed; reads beyond them return zero bits. The data must stay valid until
+ *        FDKunbindBuffer() is called. Only forward reading is supported while bound.
+ *
+ * \param hBitStream  HANDLE_FDK_BITSTREAM handle
+ * \param inputBuffer Pointer to the external bitstream data.
+ * \param bufSize     Addressing size in bytes. (awaits size 2^n and <= MAX_BUFSIZE_BYTES)
+ * \param numBytes    Number of valid bytes in inputBuffer, at most bufSize.
+ * \return void
+ */
+FDK_INLINE void FDKbindBuffer(HANDLE_FDK_BITSTREAM hBitStream, const UCHAR inputBuffer[],
+                              const UINT bufSize, const UINT numBytes) {
+  FDK_Bind(&hBitStream->hBitBuf, inputBuffer, bufSize, numBytes);
+
+  /* init cache */
+  hBitStream->CacheWord = hBitStream->BitsInCache = 0;
+  hBitStream->ConfigCache = BS_READER;
+}
+
+/**
+ * \brief Detach the bitstream from external data bound with FDKbindBuffer(). The unread bytes are
+ *        copied into the given BitBuffer array, which is used for all further reading and feeding.
+ *
+ * \param hBitStream HANDLE_FDK_BITSTREAM handle
+ * \param pBuffer    Pointer to BitBuffer array.
+ * \param bufSize    Length of BitBuffer array in bytes. (awaits size 2^n and <= MAX_BUFSIZE_BYTES)
+ * \return void
+ */
+FDK_INLINE void FDKunbindBuffer(HANDLE_FDK_BITSTREAM hBitStream, UCHAR* pBuffer,
+                                const UINT bufSize) {
+  FDKsyncCache(hBitStream);
+  FDK_Unbind(&hBitStream->hBitBuf, pBuffer, bufSize);
+}
+
 /**
  * \brief fill destination BitBuffer with a number of bytes from source BitBuffer. The
  *        bytesValid variable returns the number of ramaining valid bytes in source BitBuffer.
@@ -84,7 +84,7 @@ amm-info@iis.fraunhofer.de
 
    Author(s):   Manuel Jander
 
-   Description: FDK tools versioning support
+   Description: FDK tools versioning support, CPU feature detection
 
 *******************************************************************************/
 
@@ -97,6 +97,22 @@ amm-info@iis.fraunhofer.de
 extern "C" {
 #endif
 
+/* Instruction set extensions reported by FDK_getCpuFeatures() */
+#define FDK_CPU_X86_SSE4_1 (1 << 0)
+#define FDK_CPU_X86_AVX2 (1 << 1)
+
+/* Feature flags of the executing CPU, detected once at library load. Do not access directly, use
+ * FDK_getCpuFeatures(). */
+extern UINT FDK_cpuFeatures;
+
+/**
+ * \brief  Get the instruction set extensions of the executing CPU which are relevant for the
+ *         platform specific DSP kernels. AVX2 is only reported if the operating system saves the
+ *         extended register state.
+ * \return Bit field of FDK_CPU_* flags.
+ */
+static inline UINT FDK_getCpuFeatures(void) { return FDK_cpuFeatures; }
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,271 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2018 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+/******************* Library for basic calculation routines ********************
+
+   Author(s):
+
+   Description: Helper functions for the x86 SSE4.1/AVX2 kernels
+
+*******************************************************************************/
+
+#ifndef FDK_X86_FUNCS_H
+#define FDK_X86_FUNCS_H
+
+#if defined(__x86_SSE4_1__)
+
+#include <smmintrin.h>
+#if defined(__x86_AVX2__)
+#include <immintrin.h>
+#endif
+
+/* Every x86 kernel exists in up to three tiers: C, SSE4.1 and AVX2. FDK_X86_HAS_SSE4_1 and
+ * FDK_X86_HAS_AVX2 select between them. They are constant if the instruction set is enabled for
+ * the whole build, otherwise (FDK_X86_DISPATCH) they test the CPU features detected at library
+ * load and every kernel variant is compiled for its own target, leaving the remaining code
+ * runnable on any x86 CPU.
+ *
+ * There is no AVX-512 tier. The kernels work on short fixed-point vectors (at most 512 FFT
+ * points, 1024 samples per frame) whose loop tails and setup would eat most of the gain of the
+ * wider registers, and many CPUs lower their clock while executing 512 bit instructions. CPUs
+ * supporting AVX-512 run the AVX2 kernels.
+ *
+ * The scalar cplxMult() family is not dispatched per call, a feature test per complex
+ * multiplication would cost more than the multiplication itself. The dispatched kernels
+ * vectorize it instead: FDK_mm_cplxMult_epi32() and FDK_mm_cplxMultDiv2_epi32() in the DCT-IV/
+ * DST-IV twiddling, interleaved butterflies in dit_fft(), which fft() uses for 64 ... 512
+ * points. */
+#if defined(FDK_X86_DISPATCH)
+#include "FDK_core.h"
+#define FDK_X86_HAS_SSE4_1 (FDK_getCpuFeatures() & FDK_CPU_X86_SSE4_1)
+#define FDK_X86_HAS_AVX2 (FDK_getCpuFeatures() & FDK_CPU_X86_AVX2)
+#if defined(__GNUC__)
+#define FDK_X86_TARGET_SSE4_1 __attribute__((target("sse4.1")))
+#define FDK_X86_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define FDK_X86_TARGET_SSE4_1
+#define FDK_X86_TARGET_AVX2
+#endif
+#else
+#define FDK_X86_HAS_SSE4_1 1
+#define FDK_X86_HAS_AVX2 1
+#define FDK_X86_TARGET_SSE4_1
+#define FDK_X86_TARGET_AVX2
+#endif
+
+/* Four times fMultDiv2(FIXP_DBL, FIXP_DBL): upper 32 bit of the signed 64 bit products. */
+static inline FDK_X86_TARGET_SSE4_1 __m128i FDK_mm_fMultDiv2_epi32(__m128i a, __m128i b) {
+  __m128i even = _mm_mul_epi32(a, b);
+  __m128i odd = _mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+  return _mm_blend_epi16(_mm_srli_epi64(even, 32), odd, 0xCC);
+}
+
+/* Four times fMult(FIXP_DBL, FIXP_DBL), identical to fixmul_DD(). */
+static inline FDK_X86_TARGET_SSE4_1 __m128i FDK_mm_fMult_epi32(__m128i a, __m128i b) {
+  return _mm_slli_epi32(FDK_mm_fMultDiv2_epi32(a, b), 1);
+}
+
+/* Split four packed FIXP_SPK values into their real and imaginary parts, each converted to
+ * FIXP_DBL (FX_SGL2FX_DBL). Multiplying with these yields the same result as fMultDiv2(FIXP_DBL,
+ * FIXP_SGL). */
+static inline FDK_X86_TARGET_SSE4_1 __m128i FDK_mm_spk_re_epi32(__m128i w) {
+  return _mm_slli_epi32(w, 16);
+}
+static inline FDK_X86_TARGET_SSE4_1 __m128i FDK_mm_spk_im_epi32(__m128i w) {
+  return _mm_and_si128(w, _mm_set1_epi32((INT)0xFFFF0000));
+}
+
+/* Four complex multiplications with packed FIXP_SPK twiddles w, see cplxMultDiv2(). a_Re and a_Im
+ * hold the real and imaginary parts of four values. */
+static inline FDK_X86_TARGET_SSE4_1 void FDK_mm_cplxMultDiv2_epi32(__m128i* c_Re, __m128i* c_Im,
+                                                                   __m128i a_Re, __m128i a_Im,
+                                                                   __m128i w) {
+  __m128i w_Re = FDK_mm_spk_re_epi32(w);
+  __m128i w_Im = FDK_mm_spk_im_epi32(w);
+
+  *c_Re = _mm_sub_epi32(FDK_mm_fMultDiv2_epi32(a_Re, w_Re), FDK_mm_fMultDiv2_epi32(a_Im, w_Im));
+  *c_Im = _mm_add_epi32(FDK_mm_fMultDiv2_epi32(a_Re, w_Im), FDK_mm_fMultDiv2_epi32(a_Im, w_Re));
+}
+
+/* Four complex multiplications with packed FIXP_SPK twiddles w, see cplxMult(). */
+static inline FDK_X86_TARGET_SSE4_1 void FDK_mm_cplxMult_epi32(__m128i* c_Re, __m128i* c_Im,
+                                                               __m128i a_Re, __m128i a_Im,
+                                                               __m128i w) {
+  __m128i w_Re = FDK_mm_spk_re_epi32(w);
+  __m128i w_Im = FDK_mm_spk_im_epi32(w);
+
+  *c_Re = _mm_sub_epi32(FDK_mm_fMult_epi32(a_Re, w_Re), FDK_mm_fMult_epi32(a_Im, w_Im));
+  *c_Im = _mm_add_epi32(FDK_mm_fMult_epi32(a_Re, w_Im), FDK_mm_fMult_epi32(a_Im, w_Re));
+}
+
+/* Four times (x ^ (x >> 31)), the value getScalefactor() collects the headroom from. */
+static inline FDK_X86_TARGET_SSE4_1 __m128i FDK_mm_headroom_epi32(__m128i x) {
+  return _mm_xor_si128(x, _mm_srai_epi32(x, 31));
+}
+
+/* Horizontal OR of four 32 bit lanes. */
+static inline FDK_X86_TARGET_SSE4_1 INT FDK_mm_hor_epi32(__m128i x) {
+  x = _mm_or_si128(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+  x = _mm_or_si128(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(x);
+}
+
+/* Horizontal maximum of four signed 32 bit lanes. */
+static inline FDK_X86_TARGET_SSE4_1 INT FDK_mm_hmax_epi32(__m128i x) {
+  x = _mm_max_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+  x = _mm_max_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(x);
+}
+
+/* Four times scaleValueSaturate(x, scalefactor) for a scalefactor in the range 0 ... 31. */
+static inline FDK_X86_TARGET_SSE4_1 __m128i
+FDK_mm_scaleValueSaturateLeft_epi32(__m128i x, __m128i shift, __m128i headroomShift) {
+  const __m128i minVal = _mm_set1_epi32((INT)MINVAL_DBL + 1);
+  __m128i sat = _mm_srl_epi32(FDK_mm_headroom_epi32(x), headroomShift);
+  __m128i satVal =
+      _mm_blendv_epi8(_mm_set1_epi32((INT)MAXVAL_DBL), minVal, _mm_srai_epi32(x, 31));
+  __m128i res = _mm_max_epi32(_mm_sll_epi32(x, shift), minVal);
+  return _mm_blendv_epi8(satVal, res, _mm_cmpeq_epi32(sat, _mm_setzero_si128()));
+}
+
+/* Four times scaleValueSaturate(x, -scalefactor) for a scalefactor in the range 1 ... 31. */
+static inline FDK_X86_TARGET_SSE4_1 __m128i
+FDK_mm_scaleValueSaturateRight_epi32(__m128i x, __m128i shift, __m128i headroomShift) {
+  __m128i keep = _mm_srl_epi32(FDK_mm_headroom_epi32(x), headroomShift);
+  __m128i res = _mm_max_epi32(_mm_sra_epi32(x, shift), _mm_set1_epi32((INT)MINVAL_DBL + 1));
+  return _mm_andnot_si128(_mm_cmpeq_epi32(keep, _mm_setzero_si128()), res);
+}
+
+/* Four times fAddSaturate(a, b). */
+static inline FDK_X86_TARGET_SSE4_1 __m128i FDK_mm_addSaturate_epi32(__m128i a, __m128i b) {
+  __m128i sum = _mm_add_epi32(a, b);
+  __m128i ovf = _mm_andnot_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, sum));
+  __m128i sat = _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32((INT)MAXVAL_DBL));
+  return _mm_blendv_epi8(sum, sat, _mm_srai_epi32(ovf, 31));
+}
+
+/* Four times SATURATE_LEFT_SHIFT(x, shift, DFRACT_BITS), limit is (MAXVAL_DBL >> shift). */
+static inline FDK_X86_TARGET_SSE4_1 __m128i FDK_mm_saturateLeftShift_epi32(__m128i x,
+                                                                          __m128i shift,
+                                                                          __m128i limit) {
+  __m128i res = _mm_sll_epi32(x, shift);
+  res = _mm_blendv_epi8(res, _mm_set1_epi32((INT)MAXVAL_DBL), _mm_cmpgt_epi32(x, limit));
+  return _mm_blendv_epi8(res, _mm_set1_epi32((INT)MINVAL_DBL),
+                         _mm_cmplt_epi32(x, _mm_xor_si128(limit, _mm_set1_epi32(-1))));
+}
+
+#if defined(__x86_AVX2__)
+/* Eight times fMultDiv2(FIXP_DBL, FIXP_DBL). */
+static inline FDK_X86_TARGET_AVX2 __m256i FDK_mm256_fMultDiv2_epi32(__m256i a, __m256i b) {
+  __m256i even = _mm256_mul_epi32(a, b);
+  __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+  return _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+}
+
+/* Eight times (x ^ (x >> 31)). */
+static inline FDK_X86_TARGET_AVX2 __m256i FDK_mm256_headroom_epi32(__m256i x) {
+  return _mm256_xor_si256(x, _mm256_srai_epi32(x, 31));
+}
+
+/* Eight times fAddSaturate(a, b). */
+static inline FDK_X86_TARGET_AVX2 __m256i FDK_mm256_addSaturate_epi32(__m256i a, __m256i b) {
+  __m256i sum = _mm256_add_epi32(a, b);
+  __m256i ovf = _mm256_andnot_si256(_mm256_xor_si256(a, b), _mm256_xor_si256(a, sum));
+  __m256i sat = _mm256_xor_si256(_mm256_srai_epi32(a, 31), _mm256_set1_epi32((INT)MAXVAL_DBL));
+  return _mm256_blendv_epi8(sum, sat, _mm256_srai_epi32(ovf, 31));
+}
+
+/* Eight times SATURATE_LEFT_SHIFT(x, shift, DFRACT_BITS), limit is (MAXVAL_DBL >> shift). */
+static inline FDK_X86_TARGET_AVX2 __m256i FDK_mm256_saturateLeftShift_epi32(__m256i x,
+                                                                           __m128i shift,
+                                                                           __m256i limit) {
+  __m256i res = _mm256_sll_epi32(x, shift);
+  res = _mm256_blendv_epi8(res, _mm256_set1_epi32((INT)MAXVAL_DBL), _mm256_cmpgt_epi32(x, limit));
+  return _mm256_blendv_epi8(
+      res, _mm256_set1_epi32((INT)MINVAL_DBL),
+      _mm256_cmpgt_epi32(_mm256_xor_si256(limit, _mm256_set1_epi32(-1)), x));
+}
+#endif /* defined(__x86_AVX2__) */
+
+#endif /* defined(__x86_SSE4_1__) */
+
+#endif /* FDK_X86_FUNCS_H */
@@ -120,6 +120,7 @@ void FDK_InitBitBuffer(HANDLE_FDK_BITBUF hBitBuf, UCHAR* pBuffer, UINT bufSize,
   hBitBuf->Buffer = pBuffer;
   hBitBuf->bufSize = bufSize;
   hBitBuf->bufBits = (bufSize << 3);
+  hBitBuf->bufLimit = bufSize;
   /*assure bufsize (2^n) */
   FDK_ASSERT(hBitBuf->ValidBits <= (INT)hBitBuf->bufBits);
   FDK_ASSERT((bufSize > 0) && (bufSize <= MAX_BUFSIZE_BYTES));
@@ -200,6 +201,24 @@ INT FDK_get32 (HANDLE_FDK_BITBUF hBitBuf)
 }
 #endif
 
+INT FDK_getBound32(HANDLE_FDK_BITBUF hBitBuf) {
+  UINT byteOffset = hBitBuf->BitNdx >> 3;
+  UINT bitOffset = hBitBuf->BitNdx & 0x07;
+  UINT byteMask = hBitBuf->bufSize - 1;
+
+  hBitBuf->BitNdx = (hBitBuf->BitNdx + 32) & (hBitBuf->bufBits - 1);
+  hBitBuf->ValidBits -= 32;
+
+  /* bytes beyond the bound data are read as zero */
+  UINT64 tx = 0;
+  for (UINT i = 0; i < 5; i++) {
+    UINT idx = (byteOffset + i) & byteMask;
+    tx = (tx << 8) | ((idx < hBitBuf->bufLimit) ? hBitBuf->Buffer[idx] : 0);
+  }
+
+  return (INT)(UINT)(tx >> (8 - bitOffset));
+}
+
 INT FDK_getBwd(HANDLE_FDK_BITBUF hBitBuf, const UINT numberOfBits) {
   UINT byteOffset = hBitBuf->BitNdx >> 3;
   UINT bitOffset = hBitBuf->BitNdx & 0x07;
@@ -371,6 +390,41 @@ void FDK_Feed(HANDLE_FDK_BITBUF hBitBuf, const UCHAR* RESTRICT inputBuffer, cons
   *bytesValid -= bTotal;
 }
 
+void FDK_Bind(HANDLE_FDK_BITBUF hBitBuf, const UCHAR* inputBuffer, const UINT bufSize,
+              const UINT numBytes) {
+  FDK_ASSERT(numBytes <= bufSize);
+
+  FDK_InitBitBuffer(hBitBuf, (UCHAR*)inputBuffer, bufSize, numBytes << 3);
+  hBitBuf->ReadOffset = numBytes & (bufSize - 1);
+  hBitBuf->bufLimit = numBytes;
+}
+
+void FDK_Unbind(HANDLE_FDK_BITBUF hBitBuf, UCHAR* pBuffer, const UINT bufSize) {
+  const UCHAR* pBound = hBitBuf->Buffer;
+  const UINT boundMask = hBitBuf->bufSize - 1;
+  const UINT boundLimit = hBitBuf->bufLimit;
+  UINT byteOffset = hBitBuf->BitNdx >> 3;
+  UINT bitOffset = hBitBuf->BitNdx & 0x07;
+  INT validBits = hBitBuf->ValidBits;
+
+  FDK_InitBitBuffer(hBitBuf, pBuffer, bufSize, 0);
+  hBitBuf->ValidBits = validBits;
+
+  if (validBits > 0) {
+    /* copy the unread bytes, starting with the byte holding the read position */
+    UINT numBytes = fMin((UINT)(validBits + bitOffset + 7) >> 3, bufSize);
+    for (UINT i = 0; i < numBytes; i++) {
+      UINT idx = (byteOffset + i) & boundMask;
+      pBuffer[i] = (idx < boundLimit) ? pBound[idx] : 0;
+    }
+    hBitBuf->BitNdx = bitOffset;
+    hBitBuf->ReadOffset = numBytes & (bufSize - 1);
+  } else {
+    /* new data is appended behind the read position, as for a drained ring */
+    hBitBuf->BitNdx = (UINT)(-validBits) & (hBitBuf->bufBits - 1);
+  }
+}
+
 void CopyAlignedBlock(HANDLE_FDK_BITBUF h_BitBufSrc, UCHAR* RESTRICT dstBuffer, UINT bToRead) {
   UINT byteOffset = h_BitBufSrc->BitNdx >> 3;
   const UINT byteMask = h_BitBufSrc->bufSize - 1;
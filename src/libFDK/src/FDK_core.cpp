@@ -84,11 +84,71 @@ amm-info@iis.fraunhofer.de
 
    Author(s):   Manuel Jander
 
-   Description: FDK tools versioning support
+   Description: FDK tools versioning support, CPU feature detection
 
 *******************************************************************************/
 
 #include "FDK_core.h"
+#include "FDK_archdef.h"
+
+#if defined(__x86__)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+static void FDK_cpuid(UINT regs[4], UINT leaf, UINT subleaf) {
+#if defined(_MSC_VER)
+  __cpuidex((int*)regs, (int)leaf, (int)subleaf);
+#else
+  __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+/* Lower half of XCR0, the register state enabled by the operating system */
+static UINT FDK_xgetbv0(void) {
+#if defined(_MSC_VER)
+  return (UINT)_xgetbv(0);
+#else
+  UINT eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return eax;
+#endif
+}
+#endif /* defined(__x86__) */
+
+static UINT FDK_detectCpuFeatures(void) {
+  UINT features = 0;
+
+#if defined(__x86__)
+  UINT regs[4]; /* eax, ebx, ecx, edx */
+
+  FDK_cpuid(regs, 0, 0);
+  const UINT maxLeaf = regs[0];
+  if (maxLeaf < 1) {
+    return features;
+  }
+
+  FDK_cpuid(regs, 1, 0);
+  if (regs[2] & (1 << 19)) {
+    features |= FDK_CPU_X86_SSE4_1;
+  }
+
+  /* AVX2 needs OSXSAVE, AVX and the XMM/YMM state being enabled in XCR0 */
+  const UINT avxMask = (1 << 27) | (1 << 28);
+  if (((regs[2] & avxMask) == avxMask) && ((FDK_xgetbv0() & 0x6) == 0x6) && (maxLeaf >= 7)) {
+    FDK_cpuid(regs, 7, 0);
+    if ((regs[1] & (1 << 5)) && (features & FDK_CPU_X86_SSE4_1)) {
+      features |= FDK_CPU_X86_AVX2;
+    }
+  }
+#endif /* defined(__x86__) */
+
+  return features;
+}
+
+UINT FDK_cpuFeatures = FDK_detectCpuFeatures();
 
 /* FDK tools library info */
 #define FDK_TOOLS_LIB_VL0 4
@@ -108,6 +108,14 @@ amm-info@iis.fraunhofer.de
 
 #if defined(__arm__)
 #include "arm/dct_arm.cpp"
+
+#elif defined(__x86__)
+#include "x86/dct_x86.cpp"
+#endif
+
+#ifndef dct_func_enabled
+/* Platform specific functions may depend on CPU features detected at runtime */
+#define dct_func_enabled() 1
 #endif
 
 void dct_getTables(const FIXP_WTP** ptwiddle, const FIXP_STP** sin_twiddle, int* sin_step,
@@ -383,7 +391,7 @@ void dct_IV(FIXP_DBL* pDat, int L, int* pDat_e) {
 #endif
 
 #ifdef FUNCTION_dct_IV_func1
-  if (M >= 4 && (M & 3) == 0) {
+  if (M >= 4 && (M & 3) == 0 && dct_func_enabled()) {
     /* ARM926: 44 cycles for 2 iterations = 22 cycles/iteration */
     dct_IV_func1(M >> 2, twiddle, &pDat[0], &pDat[L - 1]);
   } else
@@ -426,7 +434,7 @@ void dct_IV(FIXP_DBL* pDat, int L, int* pDat_e) {
   fft(M, pDat, pDat_e);
 
 #ifdef FUNCTION_dct_IV_func2
-  if (M >= 4 && (M & 3) == 0) {
+  if (M >= 4 && (M & 3) == 0 && dct_func_enabled()) {
     /* ARM926: 42 cycles for 2 iterations = 21 cycles/iteration */
     dct_IV_func2(M >> 2, sin_twiddle, &pDat[0], &pDat[L], sin_step);
   } else
@@ -506,7 +514,7 @@ void dst_IV(FIXP_DBL* pDat, int L, int* pDat_e) {
 #endif
 
 #ifdef FUNCTION_dst_IV_func1
-  if ((M >= 4) && ((M & 3) == 0)) {
+  if ((M >= 4) && ((M & 3) == 0) && dct_func_enabled()) {
     dst_IV_func1(M, twiddle, &pDat[0], &pDat[L]);
   } else
 #endif
@@ -548,7 +556,7 @@ void dst_IV(FIXP_DBL* pDat, int L, int* pDat_e) {
   fft(M, pDat, pDat_e);
 
 #ifdef FUNCTION_dst_IV_func2
-  if ((M >= 4) && ((M & 3) == 0)) {
+  if ((M >= 4) && ((M & 3) == 0) && dct_func_enabled()) {
     dst_IV_func2(M >> 2, sin_twiddle + sin_step, &pDat[0], &pDat[L - 1], sin_step);
   } else
 #endif /* FUNCTION_dst_IV_func2 */
@@ -97,6 +97,8 @@ amm-info@iis.fraunhofer.de
 #if defined(__arm__)
 #include "arm/fft_rad2_arm.cpp"
 
+#elif defined(__x86__)
+#include "x86/fft_rad2_x86.cpp"
 #endif
 
 /*****************************************************************************
@@ -111,9 +113,14 @@ amm-info@iis.fraunhofer.de
 
 *****************************************************************************/
 
-#ifndef FUNCTION_dit_fft
+#if !defined(FUNCTION_dit_fft) || defined(FUNCTION_dit_fft_C)
 
+#if defined(FUNCTION_dit_fft_C)
+static void dit_fft_C(FIXP_DBL* x, const INT ldn, const FIXP_STP* trigdata,
+                      const INT trigDataSize) {
+#else
 void dit_fft(FIXP_DBL* x, const INT ldn, const FIXP_STP* trigdata, const INT trigDataSize) {
+#endif
   const INT n = 1 << ldn;
   INT trigstep, i, ldm;
 
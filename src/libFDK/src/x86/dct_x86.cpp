@@ -0,0 +1,329 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2018 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+/******************* Library for basic calculation routines ********************
+
+   Author(s):
+
+   Description: DCT-IV/DST-IV pre- and post-twiddling, x86 SSE4.1 implementation
+
+*******************************************************************************/
+
+#if defined(__x86_SSE4_1__) && defined(SINETABLE_16BIT) && defined(WINDOWTABLE_16BIT)
+#include "x86/FDK_x86_funcs.h"
+
+#define FUNCTION_dct_IV_func1
+#define FUNCTION_dct_IV_func2
+#define FUNCTION_dst_IV_func1
+#define FUNCTION_dst_IV_func2
+
+/* The twiddle functions require SSE4.1 */
+#define dct_func_enabled() FDK_X86_HAS_SSE4_1
+#endif
+
+#if defined(FUNCTION_dct_IV_func1) || defined(FUNCTION_dst_IV_func1)
+/* Complex multiplication of four values (re, im) with the four twiddles at twiddle[0..3], see
+ * cplxMultDiv2(). */
+static inline FDK_X86_TARGET_SSE4_1 void dct_x86_cplxMultDiv2(__m128i* c_Re, __m128i* c_Im,
+                                                              __m128i a_Re, __m128i a_Im,
+                                                              const FIXP_WTP* twiddle) {
+  FDK_mm_cplxMultDiv2_epi32(c_Re, c_Im, a_Re, a_Im, _mm_loadu_si128((const __m128i*)twiddle));
+}
+#endif
+
+#if defined(FUNCTION_dct_IV_func2) || defined(FUNCTION_dst_IV_func2)
+/* Complex multiplication of four values (re, im) with the twiddles w0, w1, w0, w1, see
+ * cplxMult(). */
+static inline FDK_X86_TARGET_SSE4_1 void dct_x86_cplxMult(__m128i* c_Re, __m128i* c_Im,
+                                                          __m128i a_Re, __m128i a_Im, FIXP_STP w0,
+                                                          FIXP_STP w1) {
+  FDK_mm_cplxMult_epi32(c_Re, c_Im, a_Re, a_Im, _mm_set_epi32(w1.w, w0.w, w1.w, w0.w));
+}
+
+/* Gather the input of two consecutive post-twiddle iterations i, i+1:
+     hi = pDat[L-2i-2 .. L-2i+1] with lane 3 already replaced by its original value
+     lo = pDat[2i .. 2i+3]
+   into a_Re = { A_i.re, A_i+1.re, B_i.re, B_i+1.re }, a_Im likewise. */
+static inline FDK_X86_TARGET_SSE4_1 void dct_x86_gatherPost(__m128i* a_Re, __m128i* a_Im,
+                                                            __m128i hi, __m128i lo) {
+  *a_Re = _mm_castps_si128(
+      _mm_shuffle_ps(_mm_castsi128_ps(hi), _mm_castsi128_ps(lo), _MM_SHUFFLE(3, 1, 0, 2)));
+  *a_Im = _mm_castps_si128(
+      _mm_shuffle_ps(_mm_castsi128_ps(hi), _mm_castsi128_ps(lo), _MM_SHUFFLE(2, 0, 1, 3)));
+}
+#endif
+
+#ifdef FUNCTION_dct_IV_func1
+static FDK_X86_TARGET_SSE4_1 void dct_IV_func1(int i, const FIXP_WTP* twiddle,
+                                               FIXP_DBL* RESTRICT pDat_0,
+                                               FIXP_DBL* RESTRICT pDat_1) {
+  /* pDat_1 points to pDat[L-1], each iteration processes pDat_1[-3 ... 0] */
+  pDat_1 -= 3;
+
+  do {
+    __m128i re, im, nre;
+    __m128i a_Im = _mm_loadu_si128((const __m128i*)pDat_0);
+    __m128i a_Re = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)pDat_1),
+                                     _MM_SHUFFLE(0, 1, 2, 3));
+
+    dct_x86_cplxMultDiv2(&re, &im, a_Re, a_Im, twiddle);
+
+    re = _mm_srai_epi32(re, 1);
+    im = _mm_srai_epi32(im, 1);
+    nre = _mm_sub_epi32(_mm_setzero_si128(), re);
+
+    /* pDat_0[0..3] = { im0, re0, im2, re2 } */
+    im = _mm_shuffle_epi32(im, _MM_SHUFFLE(3, 1, 2, 0));
+    re = _mm_shuffle_epi32(re, _MM_SHUFFLE(3, 1, 2, 0));
+    nre = _mm_shuffle_epi32(nre, _MM_SHUFFLE(3, 1, 2, 0));
+    _mm_storeu_si128((__m128i*)pDat_0, _mm_unpacklo_epi32(im, re));
+    /* pDat_1[0..3] = { im3, -re3, im1, -re1 } */
+    _mm_storeu_si128((__m128i*)pDat_1, _mm_shuffle_epi32(_mm_unpackhi_epi32(im, nre),
+                                                         _MM_SHUFFLE(1, 0, 3, 2)));
+
+    pDat_0 += 4;
+    pDat_1 -= 4;
+    twiddle += 4;
+  } while (--i != 0);
+}
+#endif /* FUNCTION_dct_IV_func1 */
+
+#ifdef FUNCTION_dct_IV_func2
+static FDK_X86_TARGET_SSE4_1 void dct_IV_func2(int M4, const FIXP_STP* sin_twiddle,
+                                               FIXP_DBL* RESTRICT pDat, FIXP_DBL* RESTRICT pDatEnd,
+                                               int sin_step) {
+  const int M = M4 << 2;
+  const int L = (int)(pDatEnd - pDat);
+  FIXP_DBL accu1, accu2, accu3, accu4;
+  FIXP_DBL carry; /* original value of pDat[L-2i+1], already overwritten in memory */
+  int i;
+
+  /* Sin and Cos values are 0.0f and 1.0f */
+  carry = pDat[L - 1];
+  pDat[L - 1] = -pDat[1];
+
+  for (i = 1; i < (M >> 1) - 1; i += 2) {
+    __m128i a_Re, a_Im, re, im;
+    __m128i hi = _mm_loadu_si128((const __m128i*)&pDat[L - 2 * i - 2]);
+    __m128i lo = _mm_loadu_si128((const __m128i*)&pDat[2 * i]);
+
+    hi = _mm_insert_epi32(hi, carry, 3);
+    carry = pDat[L - 2 * i - 3];
+
+    dct_x86_gatherPost(&a_Re, &a_Im, hi, lo);
+    dct_x86_cplxMult(&re, &im, a_Re, a_Im, sin_twiddle[i * sin_step],
+                     sin_twiddle[(i + 1) * sin_step]);
+
+    /* pDat[2i-1 .. 2i+2] = { re0, im2, re1, im3 } */
+    _mm_storeu_si128((__m128i*)&pDat[2 * i - 1],
+                     _mm_unpacklo_epi32(re, _mm_shuffle_epi32(im, _MM_SHUFFLE(1, 0, 3, 2))));
+    /* pDat[L-2i-3 .. L-2i] = { -re3, im1, -re2, im0 } */
+    re = _mm_sub_epi32(_mm_setzero_si128(), re);
+    _mm_storeu_si128((__m128i*)&pDat[L - 2 * i - 3],
+                     _mm_unpacklo_epi32(_mm_shuffle_epi32(re, _MM_SHUFFLE(1, 0, 2, 3)),
+                                        _mm_shuffle_epi32(im, _MM_SHUFFLE(3, 2, 0, 1))));
+  }
+
+  for (; i < (M >> 1); i++) {
+    FIXP_STP twd = sin_twiddle[i * sin_step];
+
+    cplxMult(&accu3, &accu4, pDat[L - 2 * i], carry, twd);
+    pDat[2 * i - 1] = accu3;
+    pDat[L - 2 * i] = accu4;
+
+    cplxMult(&accu3, &accu4, pDat[2 * i + 1], pDat[2 * i], twd);
+    carry = pDat[L - 2 * i - 1];
+    pDat[L - 2 * i - 1] = -accu3;
+    pDat[2 * i] = accu4;
+  }
+
+  /* Last Sin and Cos value pair are the same */
+  accu1 = fMult(pDat[M], WTC(0x5a82799a));
+  accu2 = fMult(carry, WTC(0x5a82799a));
+
+  pDat[M] = accu1 + accu2;
+  pDat[M - 1] = accu1 - accu2;
+}
+#endif /* FUNCTION_dct_IV_func2 */
+
+#ifdef FUNCTION_dst_IV_func1
+static FDK_X86_TARGET_SSE4_1 void dst_IV_func1(int M, const FIXP_WTP* twiddle,
+                                               FIXP_DBL* RESTRICT pDat_0,
+                                               FIXP_DBL* RESTRICT pDat_1) {
+  /* pDat_1 points to pDat[L], each iteration processes pDat_1[-4 ... -1] */
+  const __m128i signRe = _mm_set_epi32(-1, 1, -1, 1);
+  const __m128i signIm = _mm_set_epi32(1, -1, 1, -1);
+  int i;
+
+  pDat_1 -= 4;
+
+  for (i = M >> 2; i != 0; i--) {
+    __m128i re, im, nre;
+    __m128i a_Im = _mm_loadu_si128((const __m128i*)pDat_0);
+    __m128i a_Re = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)pDat_1),
+                                     _MM_SHUFFLE(0, 1, 2, 3));
+
+    a_Re = _mm_sign_epi32(_mm_srai_epi32(a_Re, 1), signRe);
+    a_Im = _mm_sign_epi32(_mm_srai_epi32(a_Im, 1), signIm);
+
+    dct_x86_cplxMultDiv2(&re, &im, a_Re, a_Im, twiddle);
+
+    nre = _mm_sub_epi32(_mm_setzero_si128(), re);
+
+    /* pDat_0[0..3] = { im0, re0, im2, re2 } */
+    im = _mm_shuffle_epi32(im, _MM_SHUFFLE(3, 1, 2, 0));
+    re = _mm_shuffle_epi32(re, _MM_SHUFFLE(3, 1, 2, 0));
+    nre = _mm_shuffle_epi32(nre, _MM_SHUFFLE(3, 1, 2, 0));
+    _mm_storeu_si128((__m128i*)pDat_0, _mm_unpacklo_epi32(im, re));
+    /* pDat_1[0..3] = { im3, -re3, im1, -re1 } */
+    _mm_storeu_si128((__m128i*)pDat_1, _mm_shuffle_epi32(_mm_unpackhi_epi32(im, nre),
+                                                         _MM_SHUFFLE(1, 0, 3, 2)));
+
+    pDat_0 += 4;
+    pDat_1 -= 4;
+    twiddle += 4;
+  }
+}
+#endif /* FUNCTION_dst_IV_func1 */
+
+#ifdef FUNCTION_dst_IV_func2
+static FDK_X86_TARGET_SSE4_1 void dst_IV_func2(int M4, const FIXP_STP* sin_twiddle,
+                                               FIXP_DBL* RESTRICT pDat, FIXP_DBL* RESTRICT pDatLast,
+                                               int sin_step) {
+  const int M = M4 << 2;
+  const int L = (int)(pDatLast - pDat) + 1;
+  FIXP_DBL accu1, accu2, accu3, accu4;
+  FIXP_DBL carry; /* original value of pDat[L-2i+1], already overwritten in memory */
+  int i;
+
+  /* sin_twiddle points to the twiddle of iteration i = 1 */
+  sin_twiddle -= sin_step;
+
+  /* Sin and Cos values are 0.0f and 1.0f */
+  carry = pDat[L - 1];
+  pDat[L - 1] = -pDat[0];
+  pDat[0] = pDat[1];
+
+  for (i = 1; i < (M >> 1) - 1; i += 2) {
+    __m128i a_Re, a_Im, re, im;
+    __m128i hi = _mm_loadu_si128((const __m128i*)&pDat[L - 2 * i - 2]);
+    __m128i lo = _mm_loadu_si128((const __m128i*)&pDat[2 * i]);
+
+    hi = _mm_insert_epi32(hi, carry, 3);
+    carry = pDat[L - 2 * i - 3];
+
+    dct_x86_gatherPost(&a_Re, &a_Im, hi, lo);
+    dct_x86_cplxMult(&re, &im, a_Re, a_Im, sin_twiddle[i * sin_step],
+                     sin_twiddle[(i + 1) * sin_step]);
+
+    /* pDat[2i-1 .. 2i+2] = { -im0, re2, -im1, re3 } */
+    __m128i nim = _mm_sub_epi32(_mm_setzero_si128(), im);
+    _mm_storeu_si128((__m128i*)&pDat[2 * i - 1],
+                     _mm_unpacklo_epi32(nim, _mm_shuffle_epi32(re, _MM_SHUFFLE(1, 0, 3, 2))));
+    /* pDat[L-2i-3 .. L-2i] = { -im3, -re1, -im2, -re0 } */
+    __m128i nre = _mm_sub_epi32(_mm_setzero_si128(), re);
+    _mm_storeu_si128((__m128i*)&pDat[L - 2 * i - 3],
+                     _mm_unpacklo_epi32(_mm_shuffle_epi32(nim, _MM_SHUFFLE(1, 0, 2, 3)),
+                                        _mm_shuffle_epi32(nre, _MM_SHUFFLE(3, 2, 0, 1))));
+  }
+
+  for (; i < (M >> 1); i++) {
+    FIXP_STP twd = sin_twiddle[i * sin_step];
+
+    cplxMult(&accu3, &accu4, pDat[L - 2 * i], carry, twd);
+    pDat[L - 2 * i] = -accu3;
+    pDat[2 * i - 1] = -accu4;
+
+    cplxMult(&accu3, &accu4, pDat[2 * i + 1], pDat[2 * i], twd);
+    carry = pDat[L - 2 * i - 1];
+    pDat[2 * i] = accu3;
+    pDat[L - 2 * i - 1] = -accu4;
+  }
+
+  /* Last Sin and Cos value pair are the same */
+  accu1 = fMult(pDat[M], WTC(0x5a82799a));
+  accu2 = fMult(carry, WTC(0x5a82799a));
+
+  pDat[M - 1] = -accu1 - accu2;
+  pDat[M] = accu2 - accu1;
+}
+#endif /* FUNCTION_dst_IV_func2 */
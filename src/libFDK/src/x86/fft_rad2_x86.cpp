@@ -0,0 +1,443 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2018 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+/******************* Library for basic calculation routines ********************
+
+   Author(s):
+
+   Description: dit_fft, x86 SSE4.1/AVX2 implementation
+
+*******************************************************************************/
+
+#if defined(__x86_SSE4_1__) && defined(SINETABLE_16BIT)
+#include "x86/FDK_x86_funcs.h"
+
+#define FUNCTION_dit_fft
+/* The portable implementation remains available as dit_fft_C() */
+#define FUNCTION_dit_fft_C
+#endif
+
+#ifdef FUNCTION_dit_fft
+static void dit_fft_C(FIXP_DBL* x, const INT ldn, const FIXP_STP* trigdata, const INT trigDataSize);
+
+/* Largest FFT length handled by the SIMD variants, bounds the twiddle table of one stage */
+#define DIT_FFT_X86_MAX_LDN 9
+
+static const FIXP_STP dit_fft_x86_w45 = STCP(0x5a82799a, 0x5a82799a);
+
+/*
+ * The radix-2 stages combine x[k] and x[k + mh] for 0 <= k < mh within every block of 2 * mh
+ * complex values. dit_fft_C() evaluates the four quarters of k with the twiddle
+ * trigdata[j * trigstep] in four different ways. All of them are reproduced to stay bit-exact:
+ *   q = 0: k = j           0 <= j <= mh/4
+ *   q = 1: k = mh/2 - j    0 <  j <  mh/4
+ *   q = 2: k = mh/2 + j    0 <= j <= mh/4
+ *   q = 3: k = mh - j      0 <  j <  mh/4
+ * j = 0 multiplies by 1.0 with a plain shift, j = mh/4 uses the twiddle dit_fft_x86_w45.
+ * a points to x[k], b to x[k + mh].
+ */
+static inline void dit_fft_x86_bfly1(FIXP_DBL* a, FIXP_DBL* b, const FIXP_STP w, const int q) {
+  FIXP_DBL vr, vi, ur, ui;
+
+  if (q == 0) {
+    cplxMultDiv2(&vi, &vr, b[1], b[0], w);
+  } else if (q == 1) {
+    cplxMultDiv2(&vi, &vr, b[0], b[1], w);
+  } else if (q == 2) {
+    cplxMultDiv2(&vr, &vi, b[1], b[0], w);
+  } else {
+    cplxMultDiv2(&vr, &vi, b[0], b[1], w);
+  }
+
+  ur = a[0] >> 1;
+  ui = a[1] >> 1;
+
+  if (q == 0) {
+    a[0] = ur + vr;
+    a[1] = ui + vi;
+    b[0] = ur - vr;
+    b[1] = ui - vi;
+  } else if (q == 3) {
+    a[0] = ur - vr;
+    a[1] = ui - vi;
+    b[0] = ur + vr;
+    b[1] = ui + vi;
+  } else {
+    a[0] = ur + vr;
+    a[1] = ui - vi;
+    b[0] = ur - vr;
+    b[1] = ui + vi;
+  }
+}
+
+/* Two butterflies of quarter q on a[0..3] and b[0..3], w holds the twiddle of each butterfly
+ * twice. With j0 the first butterfly is the one with j = 0, its twiddle must be zero. */
+static inline FDK_X86_TARGET_SSE4_1 void dit_fft_x86_bfly2(FIXP_DBL* a, FIXP_DBL* b, __m128i w,
+                                                           const int q, const int j0) {
+  const __m128i signIm = _mm_set_epi32(-1, 1, -1, 1);
+  __m128i vb = _mm_loadu_si128((const __m128i*)b);
+  __m128i u = _mm_srai_epi32(_mm_loadu_si128((const __m128i*)a), 1);
+  __m128i p, s, v;
+
+  /* p = { re * c, im * c }, s = { im * s, re * s } */
+  p = FDK_mm_fMultDiv2_epi32(vb, FDK_mm_spk_re_epi32(w));
+  s = FDK_mm_fMultDiv2_epi32(_mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 3, 0, 1)),
+                             FDK_mm_spk_im_epi32(w));
+  if (j0) {
+    p = _mm_blend_epi16(p, _mm_srai_epi32(vb, 1), 0x0F);
+  }
+
+  /* q = 0, 2: v = { re * c + im * s, im * c - re * s }
+     q = 1, 3: v = { re * c - im * s, im * c + re * s } */
+  if ((q == 0) || (q == 2)) {
+    v = _mm_add_epi32(p, _mm_sign_epi32(s, signIm));
+  } else {
+    v = _mm_sub_epi32(p, _mm_sign_epi32(s, signIm));
+  }
+  /* q = 1, 2: v = { v.im, -v.re } */
+  if ((q == 1) || (q == 2)) {
+    v = _mm_sign_epi32(_mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), signIm);
+  }
+
+  if (q == 3) {
+    _mm_storeu_si128((__m128i*)a, _mm_sub_epi32(u, v));
+    _mm_storeu_si128((__m128i*)b, _mm_add_epi32(u, v));
+  } else {
+    _mm_storeu_si128((__m128i*)a, _mm_add_epi32(u, v));
+    _mm_storeu_si128((__m128i*)b, _mm_sub_epi32(u, v));
+  }
+}
+
+/* Butterflies k0 ... k0 + len - 1 of quarter q, tw[0] is the twiddle of k0. The twiddles of the
+ * following butterflies are found in ascending (q = 0, 2) or descending (q = 1, 3) order. */
+static inline FDK_X86_TARGET_SSE4_1 void dit_fft_x86_quarter_SSE4_1(FIXP_DBL* a, FIXP_DBL* b,
+                                                                    const FIXP_STP* tw, INT len,
+                                                                    const int q, int j0) {
+  for (; len >= 2; len -= 2) {
+    __m128i w;
+    if (q & 1) {
+      w = _mm_shuffle_epi32(_mm_loadl_epi64((const __m128i*)&tw[-1]), _MM_SHUFFLE(0, 0, 1, 1));
+      tw -= 2;
+    } else {
+      w = _mm_shuffle_epi32(_mm_loadl_epi64((const __m128i*)&tw[0]), _MM_SHUFFLE(1, 1, 0, 0));
+      tw += 2;
+    }
+    dit_fft_x86_bfly2(a, b, w, q, j0);
+    j0 = 0;
+    a += 4;
+    b += 4;
+  }
+  if (len != 0) {
+    dit_fft_x86_bfly1(a, b, tw[0], q);
+  }
+}
+
+/* First two stages (radix 4) of four complex values x[0..7]. */
+static inline FDK_X86_TARGET_SSE4_1 void dit_fft_x86_radix4(__m128i* out0, __m128i* out1,
+                                                            __m128i v0, __m128i v1) {
+  const __m128i sign = _mm_set_epi32(-1, 1, 1, 1);
+  __m128i s, ab, cd;
+
+  /* ab = { (A + B) >> 1, ((A + B) >> 1) - B }, cd likewise */
+  v0 = _mm_shuffle_epi32(v0, _MM_SHUFFLE(1, 0, 3, 2));
+  s = _mm_srai_epi32(_mm_add_epi32(v0, _mm_shuffle_epi32(v0, _MM_SHUFFLE(1, 0, 3, 2))), 1);
+  ab = _mm_unpacklo_epi64(s, _mm_sub_epi32(s, v0));
+  v1 = _mm_shuffle_epi32(v1, _MM_SHUFFLE(1, 0, 3, 2));
+  s = _mm_srai_epi32(_mm_add_epi32(v1, _mm_shuffle_epi32(v1, _MM_SHUFFLE(1, 0, 3, 2))), 1);
+  cd = _mm_unpacklo_epi64(s, _mm_sub_epi32(s, v1));
+
+  /* cd = { Re C', Im C', Im D', -Re D' } */
+  cd = _mm_sign_epi32(_mm_shuffle_epi32(cd, _MM_SHUFFLE(2, 3, 1, 0)), sign);
+
+  *out0 = _mm_add_epi32(ab, cd);
+  *out1 = _mm_sub_epi32(ab, cd);
+}
+
+/* Twiddles tw[j] = trigdata[j * trigstep] of one radix-2 stage for 0 < j < mh/4, tw[0] is zero
+ * for the butterflies with j = 0 which do not multiply. */
+static inline void dit_fft_x86_twiddles(FIXP_STP* tw, const INT mh, const FIXP_STP* trigdata,
+                                        const INT trigstep) {
+  tw[0].w = 0;
+  for (INT j = 1; j < mh / 4; j++) {
+    tw[j] = trigdata[j * trigstep];
+  }
+}
+
+static FDK_X86_TARGET_SSE4_1 void dit_fft_SSE4_1(FIXP_DBL* x, const INT ldn,
+                                                 const FIXP_STP* trigdata,
+                                                 const INT trigDataSize) {
+  const INT n = 1 << ldn;
+  FIXP_STP tw[1 << (DIT_FFT_X86_MAX_LDN - 3)];
+  INT i, ldm;
+
+  C_ALLOC_ALIGNED_CHECK(x);
+
+  scramble(x, n);
+
+  /* 1+2 stage radix 4 */
+  for (i = 0; i < n * 2; i += 8) {
+    __m128i out0, out1;
+    dit_fft_x86_radix4(&out0, &out1, _mm_loadu_si128((const __m128i*)&x[i]),
+                       _mm_loadu_si128((const __m128i*)&x[i + 4]));
+    _mm_storeu_si128((__m128i*)&x[i], out0);
+    _mm_storeu_si128((__m128i*)&x[i + 4], out1);
+  }
+
+  /* 3rd stage, mh = 4: the twiddles are 1.0 and w45 */
+  {
+    const __m128i w = _mm_set_epi32(dit_fft_x86_w45.w, dit_fft_x86_w45.w, 0, 0);
+
+    for (i = 0; i < n * 2; i += 16) {
+      dit_fft_x86_bfly2(&x[i], &x[i + 8], w, 0, 1);
+      dit_fft_x86_bfly2(&x[i + 4], &x[i + 12], w, 2, 1);
+    }
+  }
+
+  for (ldm = 4; ldm <= ldn; ++ldm) {
+    const INT m = (1 << ldm);
+    const INT mh = (m >> 1);
+    const INT trigstep = ((trigDataSize << 2) >> ldm);
+
+    FDK_ASSERT(trigstep > 0);
+
+    dit_fft_x86_twiddles(tw, mh, trigdata, trigstep);
+
+    for (i = 0; i < n * 2; i += 2 * m) {
+      FIXP_DBL* a = &x[i];
+      FIXP_DBL* b = &x[i + m];
+
+      dit_fft_x86_quarter_SSE4_1(a, b, &tw[0], mh / 4, 0, 1);
+      dit_fft_x86_bfly1(&a[mh / 2], &b[mh / 2], dit_fft_x86_w45, 0);
+      dit_fft_x86_quarter_SSE4_1(&a[mh / 2 + 2], &b[mh / 2 + 2], &tw[mh / 4 - 1], mh / 4 - 1, 1, 0);
+      dit_fft_x86_quarter_SSE4_1(&a[mh], &b[mh], &tw[0], mh / 4, 2, 1);
+      dit_fft_x86_bfly1(&a[mh + mh / 2], &b[mh + mh / 2], dit_fft_x86_w45, 2);
+      dit_fft_x86_quarter_SSE4_1(&a[mh + mh / 2 + 2], &b[mh + mh / 2 + 2], &tw[mh / 4 - 1],
+                                 mh / 4 - 1, 3, 0);
+    }
+  }
+}
+
+#if defined(__x86_AVX2__)
+/* Four butterflies of quarter q on a[0..7] and b[0..7], see dit_fft_x86_bfly2(). */
+static inline FDK_X86_TARGET_AVX2 void dit_fft_x86_bfly4(FIXP_DBL* a, FIXP_DBL* b, __m256i w,
+                                                         const int q, const int j0) {
+  const __m256i signIm = _mm256_set_epi32(-1, 1, -1, 1, -1, 1, -1, 1);
+  __m256i vb = _mm256_loadu_si256((const __m256i*)b);
+  __m256i u = _mm256_srai_epi32(_mm256_loadu_si256((const __m256i*)a), 1);
+  __m256i p, s, v;
+
+  p = FDK_mm256_fMultDiv2_epi32(vb, _mm256_slli_epi32(w, 16));
+  s = FDK_mm256_fMultDiv2_epi32(_mm256_shuffle_epi32(vb, _MM_SHUFFLE(2, 3, 0, 1)),
+                                _mm256_and_si256(w, _mm256_set1_epi32((INT)0xFFFF0000)));
+  if (j0) {
+    p = _mm256_blend_epi32(p, _mm256_srai_epi32(vb, 1), 0x03);
+  }
+
+  if ((q == 0) || (q == 2)) {
+    v = _mm256_add_epi32(p, _mm256_sign_epi32(s, signIm));
+  } else {
+    v = _mm256_sub_epi32(p, _mm256_sign_epi32(s, signIm));
+  }
+  if ((q == 1) || (q == 2)) {
+    v = _mm256_sign_epi32(_mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), signIm);
+  }
+
+  if (q == 3) {
+    _mm256_storeu_si256((__m256i*)a, _mm256_sub_epi32(u, v));
+    _mm256_storeu_si256((__m256i*)b, _mm256_add_epi32(u, v));
+  } else {
+    _mm256_storeu_si256((__m256i*)a, _mm256_add_epi32(u, v));
+    _mm256_storeu_si256((__m256i*)b, _mm256_sub_epi32(u, v));
+  }
+}
+
+/* See dit_fft_x86_quarter_SSE4_1(). */
+static inline FDK_X86_TARGET_AVX2 void dit_fft_x86_quarter_AVX2(FIXP_DBL* a, FIXP_DBL* b,
+                                                                const FIXP_STP* tw, INT len,
+                                                                const int q, int j0) {
+  for (; len >= 4; len -= 4) {
+    __m256i w;
+    if (q & 1) {
+      w = _mm256_permutevar8x32_epi32(
+          _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)&tw[-3])),
+          _mm256_set_epi32(0, 0, 1, 1, 2, 2, 3, 3));
+      tw -= 4;
+    } else {
+      w = _mm256_permutevar8x32_epi32(
+          _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)&tw[0])),
+          _mm256_set_epi32(3, 3, 2, 2, 1, 1, 0, 0));
+      tw += 4;
+    }
+    dit_fft_x86_bfly4(a, b, w, q, j0);
+    j0 = 0;
+    a += 8;
+    b += 8;
+  }
+  dit_fft_x86_quarter_SSE4_1(a, b, tw, len, q, j0);
+}
+
+static FDK_X86_TARGET_AVX2 void dit_fft_AVX2(FIXP_DBL* x, const INT ldn, const FIXP_STP* trigdata,
+                                             const INT trigDataSize) {
+  const INT n = 1 << ldn;
+  FIXP_STP tw[1 << (DIT_FFT_X86_MAX_LDN - 3)];
+  INT i, ldm;
+
+  C_ALLOC_ALIGNED_CHECK(x);
+
+  scramble(x, n);
+
+  /* 1+2 stage radix 4, two blocks at once */
+  for (i = 0; i < n * 2; i += 16) {
+    __m256i lo = _mm256_loadu_si256((const __m256i*)&x[i]);
+    __m256i hi = _mm256_loadu_si256((const __m256i*)&x[i + 8]);
+    __m256i v0 = _mm256_permute2x128_si256(lo, hi, 0x20);
+    __m256i v1 = _mm256_permute2x128_si256(lo, hi, 0x31);
+    const __m256i sign = _mm256_set_epi32(-1, 1, 1, 1, -1, 1, 1, 1);
+    __m256i s, ab, cd, out0, out1;
+
+    v0 = _mm256_shuffle_epi32(v0, _MM_SHUFFLE(1, 0, 3, 2));
+    s = _mm256_srai_epi32(
+        _mm256_add_epi32(v0, _mm256_shuffle_epi32(v0, _MM_SHUFFLE(1, 0, 3, 2))), 1);
+    ab = _mm256_unpacklo_epi64(s, _mm256_sub_epi32(s, v0));
+    v1 = _mm256_shuffle_epi32(v1, _MM_SHUFFLE(1, 0, 3, 2));
+    s = _mm256_srai_epi32(
+        _mm256_add_epi32(v1, _mm256_shuffle_epi32(v1, _MM_SHUFFLE(1, 0, 3, 2))), 1);
+    cd = _mm256_unpacklo_epi64(s, _mm256_sub_epi32(s, v1));
+    cd = _mm256_sign_epi32(_mm256_shuffle_epi32(cd, _MM_SHUFFLE(2, 3, 1, 0)), sign);
+
+    out0 = _mm256_add_epi32(ab, cd);
+    out1 = _mm256_sub_epi32(ab, cd);
+    _mm256_storeu_si256((__m256i*)&x[i], _mm256_permute2x128_si256(out0, out1, 0x20));
+    _mm256_storeu_si256((__m256i*)&x[i + 8], _mm256_permute2x128_si256(out0, out1, 0x31));
+  }
+
+  /* 3rd stage, mh = 4: the twiddles are 1.0 and w45 */
+  {
+    const __m128i w = _mm_set_epi32(dit_fft_x86_w45.w, dit_fft_x86_w45.w, 0, 0);
+
+    for (i = 0; i < n * 2; i += 16) {
+      dit_fft_x86_bfly2(&x[i], &x[i + 8], w, 0, 1);
+      dit_fft_x86_bfly2(&x[i + 4], &x[i + 12], w, 2, 1);
+    }
+  }
+
+  for (ldm = 4; ldm <= ldn; ++ldm) {
+    const INT m = (1 << ldm);
+    const INT mh = (m >> 1);
+    const INT trigstep = ((trigDataSize << 2) >> ldm);
+
+    FDK_ASSERT(trigstep > 0);
+
+    dit_fft_x86_twiddles(tw, mh, trigdata, trigstep);
+
+    for (i = 0; i < n * 2; i += 2 * m) {
+      FIXP_DBL* a = &x[i];
+      FIXP_DBL* b = &x[i + m];
+
+      dit_fft_x86_quarter_AVX2(a, b, &tw[0], mh / 4, 0, 1);
+      dit_fft_x86_bfly1(&a[mh / 2], &b[mh / 2], dit_fft_x86_w45, 0);
+      dit_fft_x86_quarter_AVX2(&a[mh / 2 + 2], &b[mh / 2 + 2], &tw[mh / 4 - 1], mh / 4 - 1, 1, 0);
+      dit_fft_x86_quarter_AVX2(&a[mh], &b[mh], &tw[0], mh / 4, 2, 1);
+      dit_fft_x86_bfly1(&a[mh + mh / 2], &b[mh + mh / 2], dit_fft_x86_w45, 2);
+      dit_fft_x86_quarter_AVX2(&a[mh + mh / 2 + 2], &b[mh + mh / 2 + 2], &tw[mh / 4 - 1],
+                               mh / 4 - 1, 3, 0);
+    }
+  }
+}
+#endif /* defined(__x86_AVX2__) */
+
+void dit_fft(FIXP_DBL* x, const INT ldn, const FIXP_STP* trigdata, const INT trigDataSize) {
+  if ((ldn >= 3) && (ldn <= DIT_FFT_X86_MAX_LDN)) {
+#if defined(__x86_AVX2__)
+    if (FDK_X86_HAS_AVX2) {
+      dit_fft_AVX2(x, ldn, trigdata, trigDataSize);
+      return;
+    }
+#endif
+    if (FDK_X86_HAS_SSE4_1) {
+      dit_fft_SSE4_1(x, ldn, trigdata, trigDataSize);
+      return;
+    }
+  }
+  dit_fft_C(x, ldn, trigdata, trigDataSize);
+}
+#endif /* FUNCTION_dit_fft */
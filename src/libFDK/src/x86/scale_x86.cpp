@@ -0,0 +1,308 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2018 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+/******************* Library for basic calculation routines ********************
+
+   Author(s):
+
+   Description: Scaling operations, x86 SSE4.1/AVX2 implementation
+
+*******************************************************************************/
+
+#if defined(__x86_SSE4_1__)
+#include "x86/FDK_x86_funcs.h"
+
+#define FUNCTION_scaleValues_DBL
+#define FUNCTION_scaleValues_DBLDBL
+#define FUNCTION_scaleValuesSaturate_DBL
+#define FUNCTION_scaleValuesSaturate_DBL_DBL
+#define FUNCTION_getScalefactor_DBL
+#endif /* defined(__x86_SSE4_1__) */
+
+#ifdef FUNCTION_scaleValues_DBLDBL
+/* Shift left (shift > 0) or right (shift < 0), |shift| < DFRACT_BITS */
+static FDK_X86_TARGET_SSE4_1 void scaleValues_SSE4_1(FIXP_DBL* dst, const FIXP_DBL* src, INT len,
+                                                     INT shift) {
+  INT i = 0;
+
+  if (shift > 0) {
+    const __m128i s = _mm_cvtsi32_si128(shift);
+    for (; i <= len - 4; i += 4) {
+      __m128i x = _mm_loadu_si128((const __m128i*)&src[i]);
+      _mm_storeu_si128((__m128i*)&dst[i], _mm_sll_epi32(x, s));
+    }
+  } else {
+    const __m128i s = _mm_cvtsi32_si128(-shift);
+    for (; i <= len - 4; i += 4) {
+      __m128i x = _mm_loadu_si128((const __m128i*)&src[i]);
+      _mm_storeu_si128((__m128i*)&dst[i], _mm_sra_epi32(x, s));
+    }
+  }
+  for (; i < len; i++) {
+    dst[i] = scaleValue(src[i], shift);
+  }
+}
+
+#if defined(__x86_AVX2__)
+static FDK_X86_TARGET_AVX2 void scaleValues_AVX2(FIXP_DBL* dst, const FIXP_DBL* src, INT len,
+                                                 INT shift) {
+  INT i = 0;
+
+  if (shift > 0) {
+    const __m128i s = _mm_cvtsi32_si128(shift);
+    for (; i <= len - 8; i += 8) {
+      __m256i x = _mm256_loadu_si256((const __m256i*)&src[i]);
+      _mm256_storeu_si256((__m256i*)&dst[i], _mm256_sll_epi32(x, s));
+    }
+  } else {
+    const __m128i s = _mm_cvtsi32_si128(-shift);
+    for (; i <= len - 8; i += 8) {
+      __m256i x = _mm256_loadu_si256((const __m256i*)&src[i]);
+      _mm256_storeu_si256((__m256i*)&dst[i], _mm256_sra_epi32(x, s));
+    }
+  }
+  /* The remainder is processed by legacy SSE code, clear the upper register halves first to
+   * avoid the AVX-SSE transition penalty. */
+  _mm256_zeroupper();
+  scaleValues_SSE4_1(&dst[i], &src[i], len - i, shift);
+}
+#endif /* defined(__x86_AVX2__) */
+
+SCALE_INLINE
+void scaleValues(FIXP_DBL* dst,       /*!< dst Vector */
+                 const FIXP_DBL* src, /*!< src Vector */
+                 INT len,             /*!< Length */
+                 INT scalefactor      /*!< Scalefactor */
+) {
+  /* Return if scalefactor is Zero */
+  if (scalefactor == 0) {
+    if (dst != src) FDKmemmove(dst, src, len * sizeof(FIXP_DBL));
+    return;
+  }
+
+  scalefactor = fixmax_I(fixmin_I(scalefactor, (INT)DFRACT_BITS - 1), (INT) - (DFRACT_BITS - 1));
+
+#if defined(__x86_AVX2__)
+  if (FDK_X86_HAS_AVX2) {
+    scaleValues_AVX2(dst, src, len, scalefactor);
+    return;
+  }
+#endif
+  if (FDK_X86_HAS_SSE4_1) {
+    scaleValues_SSE4_1(dst, src, len, scalefactor);
+    return;
+  }
+  for (INT i = 0; i < len; i++) {
+    dst[i] = scaleValue(src[i], scalefactor);
+  }
+}
+#endif /* FUNCTION_scaleValues_DBLDBL */
+
+#ifdef FUNCTION_scaleValues_DBL
+SCALE_INLINE
+void scaleValues(FIXP_DBL* vector, /*!< Vector */
+                 INT len,          /*!< Length */
+                 INT scalefactor   /*!< Scalefactor */
+) {
+  scaleValues(vector, vector, len, scalefactor);
+}
+#endif /* FUNCTION_scaleValues_DBL */
+
+#ifdef FUNCTION_scaleValuesSaturate_DBL_DBL
+/* scalefactor in the range -(DFRACT_BITS - 1) ... -1, 1 ... DFRACT_BITS - 1 */
+static FDK_X86_TARGET_SSE4_1 void scaleValuesSaturate_SSE4_1(FIXP_DBL* dst, const FIXP_DBL* src,
+                                                             INT len, INT scalefactor) {
+  INT i = 0;
+
+  if (scalefactor > 0) {
+    const __m128i shift = _mm_cvtsi32_si128(scalefactor);
+    const __m128i headroomShift = _mm_cvtsi32_si128(DFRACT_BITS - 1 - scalefactor);
+    for (; i <= len - 4; i += 4) {
+      __m128i x = _mm_loadu_si128((const __m128i*)&src[i]);
+      _mm_storeu_si128((__m128i*)&dst[i],
+                       FDK_mm_scaleValueSaturateLeft_epi32(x, shift, headroomShift));
+    }
+  } else {
+    const __m128i shift = _mm_cvtsi32_si128(-scalefactor);
+    const __m128i headroomShift = _mm_cvtsi32_si128(-scalefactor - 1);
+    for (; i <= len - 4; i += 4) {
+      __m128i x = _mm_loadu_si128((const __m128i*)&src[i]);
+      _mm_storeu_si128((__m128i*)&dst[i],
+                       FDK_mm_scaleValueSaturateRight_epi32(x, shift, headroomShift));
+    }
+  }
+  for (; i < len; i++) {
+    dst[i] = scaleValueSaturate(src[i], scalefactor);
+  }
+}
+
+SCALE_INLINE
+void scaleValuesSaturate(FIXP_DBL* dst,       /*!< Output */
+                         const FIXP_DBL* src, /*!< Input   */
+                         INT len,             /*!< Length */
+                         INT scalefactor      /*!< Scalefactor */
+) {
+  /* Return if scalefactor is Zero */
+  if (scalefactor == 0) {
+    if (dst != src) FDKmemmove(dst, src, len * sizeof(FIXP_DBL));
+    return;
+  }
+
+  scalefactor = fixmax_I(fixmin_I(scalefactor, (INT)DFRACT_BITS - 1), (INT) - (DFRACT_BITS - 1));
+
+  if (FDK_X86_HAS_SSE4_1) {
+    scaleValuesSaturate_SSE4_1(dst, src, len, scalefactor);
+    return;
+  }
+  for (INT i = 0; i < len; i++) {
+    dst[i] = scaleValueSaturate(src[i], scalefactor);
+  }
+}
+#endif /* FUNCTION_scaleValuesSaturate_DBL_DBL */
+
+#ifdef FUNCTION_scaleValuesSaturate_DBL
+SCALE_INLINE
+void scaleValuesSaturate(FIXP_DBL* vector, /*!< Vector */
+                         INT len,          /*!< Length */
+                         INT scalefactor   /*!< Scalefactor */
+) {
+  scaleValuesSaturate(vector, vector, len, scalefactor);
+}
+#endif /* FUNCTION_scaleValuesSaturate_DBL */
+
+#ifdef FUNCTION_getScalefactor_DBL
+/* OR of (x ^ (x >> 31)) over all values, see getScalefactor() */
+static FDK_X86_TARGET_SSE4_1 LONG getScalefactor_SSE4_1(const FIXP_DBL* vector, INT len) {
+  INT i = 0;
+  __m128i maxVal = _mm_setzero_si128();
+
+  for (; i <= len - 4; i += 4) {
+    __m128i x = _mm_loadu_si128((const __m128i*)&vector[i]);
+    maxVal = _mm_or_si128(maxVal, FDK_mm_headroom_epi32(x));
+  }
+
+  LONG maxValScalar = FDK_mm_hor_epi32(maxVal);
+  for (; i < len; i++) {
+    maxValScalar |= (LONG)vector[i] ^ (LONG)(vector[i] >> (DFRACT_BITS - 1));
+  }
+  return maxValScalar;
+}
+
+#if defined(__x86_AVX2__)
+static FDK_X86_TARGET_AVX2 LONG getScalefactor_AVX2(const FIXP_DBL* vector, INT len) {
+  INT i = 0;
+  __m256i maxVal8 = _mm256_setzero_si256();
+
+  for (; i <= len - 8; i += 8) {
+    __m256i x = _mm256_loadu_si256((const __m256i*)&vector[i]);
+    maxVal8 = _mm256_or_si256(maxVal8, FDK_mm256_headroom_epi32(x));
+  }
+
+  __m128i maxVal =
+      _mm_or_si128(_mm256_castsi256_si128(maxVal8), _mm256_extracti128_si256(maxVal8, 1));
+  return FDK_mm_hor_epi32(maxVal) | getScalefactor_SSE4_1(&vector[i], len - i);
+}
+#endif /* defined(__x86_AVX2__) */
+
+static inline LONG getScalefactor_x86(const FIXP_DBL* vector, INT len) {
+#if defined(__x86_AVX2__)
+  if (FDK_X86_HAS_AVX2) {
+    return getScalefactor_AVX2(vector, len);
+  }
+#endif
+  if (FDK_X86_HAS_SSE4_1) {
+    return getScalefactor_SSE4_1(vector, len);
+  }
+
+  LONG maxVal = 0;
+  for (INT i = 0; i < len; i++) {
+    maxVal |= (LONG)vector[i] ^ (LONG)(vector[i] >> (DFRACT_BITS - 1));
+  }
+  return maxVal;
+}
+
+SCALE_INLINE
+INT getScalefactor(const FIXP_DBL* vector, /*!< Pointer to input vector */
+                   INT len)                /*!< Length of input vector */
+{
+  return fixmax_I((INT)0, (INT)(fixnormz_D(getScalefactor_x86(vector, len)) - 1));
+}
+#endif /* FUNCTION_getScalefactor_DBL */
@@ -333,6 +333,11 @@ typedef struct T_FORMAT_CONVERTER_PARAMS {
 
   INT chOut_count[NCHANOUT_MAX];
   INT chOut_exp[NCHANOUT_MAX];
+  /* Nonzero coefficients of dmxMtx_sorted and their input channels, listed per output channel
+   * for the passive time domain downmix. */
+  INT dmxSparse_count[NCHANOUT_MAX];
+  UCHAR dmxSparse_inCh[NCHANOUT_MAX][NCHANIN_MAX];
+  FIXP_DMX_H dmxSparse_coef[NCHANOUT_MAX][NCHANIN_MAX];
   INT dmx_iterations;
 
   FIXP_DMX_H* dmxMatrixL_FDK;
@@ -746,7 +746,7 @@ static INT gVBAPRenderer_GetStaticGains(CICP2GEOMETRY_CHANNEL_GEOMETRY* inGeomet
   /* Initialization of the renderization parameters in order to create a new downmix matrix. */
 
   if (gVBAPRenderer_Open(&hgVBAPRenderer, numObjects, 1, 1, outGeometryInfo, outChannels,
-                         outCICPIndex, 1, 1)) {
+                         outCICPIndex, 1, 1, 0, NULL, 0)) {
     err = 1; /* memory allocation error */
     goto bail;
   }
@@ -287,6 +287,8 @@ FDK_INLINE FIXP_DBL computeEQAndClip(FIXP_DBL targetEne, FIXP_DBL realizedEne, I
 
 #if defined(__arm__)
 #include "arm/FDK_formatConverter_activeDmx_stft_arm.cpp"
+#elif defined(__x86__)
+#include "x86/FDK_formatConverter_activeDmx_stft_x86.cpp"
 #endif
 
 FDK_INLINE INT get1xScalefactor(FIXP_DBL* buf) {
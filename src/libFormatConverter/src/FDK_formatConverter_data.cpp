@@ -609,7 +609,8 @@ int formatConverterDmxMatrixControl(IIS_FORMATCONVERTER_INTERNAL_HANDLE fcInt) {
 
 int formatConverterDmxMatrixExponent(IIS_FORMATCONVERTER_INTERNAL_HANDLE fcInt) {
   /* This function calculate how many input channels have an impact in each output channel and its
-   * exponential term in order to accumulate results. */
+   * exponential term in order to accumulate results. It also collects the nonzero coefficients of
+   * dmxMtx_sorted per output channel for the passive time domain downmix. */
 
   UINT chIn, chOut;
 
@@ -619,6 +620,7 @@ int formatConverterDmxMatrixExponent(IIS_FORMATCONVERTER_INTERNAL_HANDLE fcInt)
 
   for (chOut = 0; chOut < fcInt->numOutputChannels; chOut++) {
     fcInt->fcParams->chOut_count[chOut] = 0;
+    fcInt->fcParams->dmxSparse_count[chOut] = 0;
   }
 
   for (chIn = 0; chIn < fcInt->numTotalInputChannels; chIn++) {
@@ -627,6 +629,11 @@ int formatConverterDmxMatrixExponent(IIS_FORMATCONVERTER_INTERNAL_HANDLE fcInt)
           (dmxMtxL[chOut] != (FIXP_DMX_H)0)) {
         fcInt->fcParams->chOut_count[chOut] += 1;
       }
+      if (dmxMtx[chOut] != (FIXP_DMX_H)0) {
+        INT k = fcInt->fcParams->dmxSparse_count[chOut]++;
+        fcInt->fcParams->dmxSparse_inCh[chOut][k] = (UCHAR)chIn;
+        fcInt->fcParams->dmxSparse_coef[chOut][k] = dmxMtx[chOut];
+      }
     }
     dmxMtx += fcInt->numOutputChannels;
     dmxMtx2 += fcInt->numOutputChannels;
@@ -123,6 +123,36 @@ amm-info@iis.fraunhofer.de
 
 /**********************************************************************************************************************************/
 
+#if defined(__x86__)
+#include "x86/FDK_formatConverter_process_x86.cpp"
+#endif
+
+/**********************************************************************************************************************************/
+
+#ifndef FUNCTION_formatConverterDmxAccumulate
+/*!
+ *
+ * \brief Accumulate the weighted input channels into one output channel.
+ *
+ * \param pOut                [i/o] Pointer to output channel, length=frameLength
+ * \param pIn                   [i] Pointers to the contributing input channels
+ * \param dmxCoef               [i] Downmix coefficient of each input channel
+ * \param numIn                 [i] Number of contributing input channels
+ * \param frameLength           [i] Length of frame in samples, e.g. 1024
+ *
+ */
+static void formatConverterDmxAccumulate(DMXH_PCM* pOut, const DMXH_PCM* const* pIn,
+                                         const FIXP_DMX_H* dmxCoef, INT numIn, UINT frameLength) {
+  for (INT k = 0; k < numIn; k++) {
+    const DMXH_PCM* in = pIn[k];
+    FIXP_DMX_H dmx_coef = dmxCoef[k];
+    for (UINT sample = 0; sample < frameLength; sample++) {
+      pOut[sample] += (DMXH_PCM)FX_DBL2FX_DMXH(fMult((DMXH_PCMF)in[sample], dmx_coef));
+    }
+  }
+}
+#endif /* FUNCTION_formatConverterDmxAccumulate */
+
 /*!
  *
  * \brief .
@@ -146,25 +176,30 @@ void formatConverterProcess_passive_timeDomain_frameLength(
   Accumulation output buffer:
     - Blockwise:
         Blockwise accumulated frames with samples from 0 to frameSize-1 in pOut
+
+  The nonzero downmix coefficients are listed per output channel (see
+  formatConverterDmxMatrixExponent()), so each output channel is read and written once.
   */
 
   UINT numOutChannels = fcInt->numOutputChannels;
-  UINT numInChannels = fcInt->numTotalInputChannels;
   UINT frameLength = fcInt->frameSize;
-  FIXP_DMX_H* dmx_mtx = fcInt->fcParams->dmxMtx_sorted;
-
-  for (UINT inCh = 0; inCh < numInChannels; inCh += 1) {
-    if (pIn[inCh] == NULL) continue;
-
-    /* Reset output buffer pointer */
-    for (UINT outCh = 0; outCh < numOutChannels; outCh += 1) {
-      FIXP_DMX_H dmx_coef = *dmx_mtx++;
-      if (dmx_coef != (FIXP_DMX_H)0) {
-        for (UINT sample = 0; sample < frameLength; sample++) {
-          pOut[outCh][sample] +=
-              (DMXH_PCM)FX_DBL2FX_DMXH(fMult((DMXH_PCMF)pIn[inCh][sample], dmx_coef));
-        }
-      }
+  HANDLE_FORMAT_CONVERTER_PARAMS fcParams = fcInt->fcParams;
+
+  const DMXH_PCM* in[NCHANIN_MAX];
+  FIXP_DMX_H dmxCoef[NCHANIN_MAX];
+
+  for (UINT outCh = 0; outCh < numOutChannels; outCh += 1) {
+    INT numIn = 0;
+
+    for (INT k = 0; k < fcParams->dmxSparse_count[outCh]; k++) {
+      const DMXH_PCM* p = pIn[fcParams->dmxSparse_inCh[outCh][k]];
+      if (p == NULL) continue;
+      in[numIn] = p;
+      dmxCoef[numIn++] = fcParams->dmxSparse_coef[outCh][k];
+    }
+
+    if (numIn > 0) {
+      formatConverterDmxAccumulate(pOut[outCh], in, dmxCoef, numIn, frameLength);
     }
   }
 }
@@ -0,0 +1,239 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2018 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+/******************** MPEG-H 3DA channel rendering library *********************
+
+   Author(s):
+
+   Description: (x86 SSE4.1/AVX2 optimized) STFT active downmix
+
+*******************************************************************************/
+
+#if defined(__x86_SSE4_1__)
+#include "x86/FDK_x86_funcs.h"
+
+#define FUNCTION_activeDmxProcess_STFT_func1
+#endif
+
+#ifdef FUNCTION_activeDmxProcess_STFT_func1
+/* Mix the complex band in[0..1] with dmxCoeff into out[0..1] and return its energy shifted right by
+ * targetExp, see activeDmxProcess_STFT(). */
+static inline FIXP_DBL activeDmxMixBand(const FIXP_DBL* in, FIXP_DBL* out, FIXP_DBL dmxCoeff,
+                                        INT hdr, INT targetExp) {
+  FIXP_DBL tmpRe = fMult(dmxCoeff, in[0] << hdr);
+  FIXP_DBL tmpIm = fMult(dmxCoeff, in[1] << hdr);
+
+  out[0] = fAddSaturate(out[0], tmpRe >> hdr);
+  out[1] = fAddSaturate(out[1], tmpIm >> hdr);
+
+  return (fPow2Div2(tmpIm) + fPow2Div2(tmpRe)) >> targetExp;
+}
+
+/* activeDmxMixBand() for the n complex bands in[0 .. 2*n-1], returns the sum of the energies. */
+static inline FDK_X86_TARGET_SSE4_1 FIXP_DBL activeDmxMixBands_SSE4_1(const FIXP_DBL* in,
+                                                                      FIXP_DBL* out, UINT n,
+                                                                      FIXP_DBL dmxCoeff, INT hdr,
+                                                                      INT targetExp) {
+  const __m128i coeff = _mm_set1_epi32(dmxCoeff);
+  const __m128i shiftHdr = _mm_cvtsi32_si128(hdr);
+  const __m128i shiftExp = _mm_cvtsi32_si128(targetExp);
+  __m128i ene = _mm_setzero_si128();
+  FIXP_DBL energy;
+
+  for (; n >= 2; n -= 2) {
+    __m128i x = FDK_mm_fMult_epi32(coeff, _mm_sll_epi32(_mm_loadu_si128((const __m128i*)in),
+                                                        shiftHdr));
+    _mm_storeu_si128((__m128i*)out,
+                     FDK_mm_addSaturate_epi32(_mm_loadu_si128((const __m128i*)out),
+                                              _mm_sra_epi32(x, shiftHdr)));
+    /* lanes 0 and 2 hold the energy of the two bands */
+    x = FDK_mm_fMultDiv2_epi32(x, x);
+    x = _mm_add_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)));
+    ene = _mm_add_epi32(ene, _mm_sra_epi32(x, shiftExp));
+    in += 4;
+    out += 4;
+  }
+  energy = (FIXP_DBL)(_mm_cvtsi128_si32(ene) + _mm_extract_epi32(ene, 2));
+  if (n != 0) {
+    energy += activeDmxMixBand(in, out, dmxCoeff, hdr, targetExp);
+  }
+  return energy;
+}
+
+#if defined(__x86_AVX2__)
+static FDK_X86_TARGET_AVX2 FIXP_DBL activeDmxMixBands_AVX2(const FIXP_DBL* in, FIXP_DBL* out,
+                                                           UINT n, FIXP_DBL dmxCoeff, INT hdr,
+                                                           INT targetExp) {
+  const __m256i coeff = _mm256_set1_epi32(dmxCoeff);
+  const __m128i shiftHdr = _mm_cvtsi32_si128(hdr);
+  const __m128i shiftExp = _mm_cvtsi32_si128(targetExp);
+  __m256i ene = _mm256_setzero_si256();
+  __m128i ene128;
+
+  for (; n >= 4; n -= 4) {
+    __m256i x = FDK_mm256_fMultDiv2_epi32(
+        coeff, _mm256_sll_epi32(_mm256_loadu_si256((const __m256i*)in), shiftHdr));
+    x = _mm256_slli_epi32(x, 1);
+    _mm256_storeu_si256((__m256i*)out,
+                        FDK_mm256_addSaturate_epi32(_mm256_loadu_si256((const __m256i*)out),
+                                                    _mm256_sra_epi32(x, shiftHdr)));
+    x = FDK_mm256_fMultDiv2_epi32(x, x);
+    x = _mm256_add_epi32(x, _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)));
+    ene = _mm256_add_epi32(ene, _mm256_sra_epi32(x, shiftExp));
+    in += 8;
+    out += 8;
+  }
+  ene128 = _mm_add_epi32(_mm256_castsi256_si128(ene), _mm256_extracti128_si256(ene, 1));
+  return (FIXP_DBL)(_mm_cvtsi128_si32(ene128) + _mm_extract_epi32(ene128, 2)) +
+         activeDmxMixBands_SSE4_1(in, out, n, dmxCoeff, hdr, targetExp);
+}
+#endif /* defined(__x86_AVX2__) */
+
+static inline FIXP_DBL activeDmxMixBands(const FIXP_DBL* in, FIXP_DBL* out, UINT n,
+                                         FIXP_DBL dmxCoeff, INT hdr, INT targetExp) {
+  FIXP_DBL energy = (FIXP_DBL)0;
+#if defined(__x86_AVX2__)
+  if (FDK_X86_HAS_AVX2) {
+    return activeDmxMixBands_AVX2(in, out, n, dmxCoeff, hdr, targetExp);
+  }
+#endif
+  if (FDK_X86_HAS_SSE4_1) {
+    return activeDmxMixBands_SSE4_1(in, out, n, dmxCoeff, hdr, targetExp);
+  }
+  for (UINT i = 0; i < n; i++) {
+    energy += activeDmxMixBand(&in[2 * i], &out[2 * i], dmxCoeff, hdr, targetExp);
+  }
+  return energy;
+}
+
+/* The bands of the ERBs 33..57 share the headroom and downmix coefficient of their ERB and are
+ * processed vectorized, the remaining ERBs consist of a single band. */
+static void activeDmxProcess_STFT_func1(FIXP_DBL* RESTRICT inputBuffer,
+                                        FIXP_DBL* RESTRICT realizedSig,
+                                        FIXP_DBL* RESTRICT targetEnergy, const UINT* erbFreqIdx,
+                                        const FIXP_DBL* eq_ptr, const FIXP_DMX_H dmxMatrixL_FDK,
+                                        const FIXP_DMX_H dmxMatrixH_FDK, const UINT erb_is4GVH_L,
+                                        const UINT erb_is4GVH_H, const INT chOut_exp,
+                                        const INT dmx_iterations, const INT* inBufStftHeadroom) {
+  FIXP_DBL savIm0 = inputBuffer[1];
+  FIXP_DBL dmx_coeff = (FIXP_DBL)0;
+  FIXP_DMX_H dmx_coeff_mtx = dmxMatrixL_FDK;
+  INT target_exp = 0;
+  UINT fftBand = 0;
+  UINT max_erb = erb_is4GVH_L;
+  UINT erb = 0;
+
+  inputBuffer[1] = FIXP_DBL(0);
+
+  for (INT it = 0; it < dmx_iterations; it++) {
+    for (; erb < max_erb; erb++) {
+      const UINT maxfftBand = erbFreqIdx[erb];
+      const INT hdr = inBufStftHeadroom[erb];
+
+      target_exp = erb_freq_idx_256_58_exp[erb] + chOut_exp;
+      dmx_coeff = fMult(dmx_coeff_mtx, eq_ptr[erb]);
+
+      if (maxfftBand - fftBand == 1) {
+        targetEnergy[erb] += activeDmxMixBand(&inputBuffer[fftBand * 2], &realizedSig[fftBand * 2],
+                                              dmx_coeff, hdr, target_exp);
+      } else {
+        targetEnergy[erb] +=
+            activeDmxMixBands(&inputBuffer[fftBand * 2], &realizedSig[fftBand * 2],
+                              maxfftBand - fftBand, dmx_coeff, hdr, target_exp);
+      }
+      fftBand = maxfftBand;
+    }
+    if (it == 0) {
+      max_erb = erb_is4GVH_H;
+      dmx_coeff_mtx = dmxMatrixH_FDK;
+    } else if (it == 1) {
+      max_erb = 58;
+      dmx_coeff_mtx = dmxMatrixL_FDK;
+    }
+  }
+  erb--; /* switch back to last erb */
+  inputBuffer[1] = savIm0;
+  FIXP_DBL tmpIm = fMult(dmx_coeff, savIm0 << inBufStftHeadroom[erb]);
+  realizedSig[1] = fAddSaturate(realizedSig[1], (tmpIm >> inBufStftHeadroom[erb]));
+  targetEnergy[erb] += (fPow2Div2(tmpIm) >> target_exp);
+}
+#endif /* FUNCTION_activeDmxProcess_STFT_func1 */
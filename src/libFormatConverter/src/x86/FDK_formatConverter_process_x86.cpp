@@ -0,0 +1,181 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2018 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+/******************** MPEG-H 3DA channel rendering library *********************
+
+   Author(s):
+
+   Description: (x86 SSE4.1/AVX2 optimized) passive time domain downmix
+
+*******************************************************************************/
+
+#if defined(__x86_SSE4_1__)
+#include "x86/FDK_x86_funcs.h"
+
+#define FUNCTION_formatConverterDmxAccumulate
+#endif
+
+#if defined(FUNCTION_formatConverterDmxAccumulate)
+/* The output samples are accumulated in registers over all contributing input channels. The
+ * coefficients are converted to FIXP_DBL (FX_SGL2FX_DBL), which yields the same result as
+ * fMult(FIXP_DBL, FIXP_SGL). */
+static FDK_X86_TARGET_SSE4_1 void formatConverterDmxAccumulate_SSE4_1(
+    DMXH_PCM* pOut, const DMXH_PCM* const* pIn, const FIXP_DMX_H* dmxCoef, INT numIn,
+    UINT frameLength) {
+  __m128i coef[NCHANIN_MAX];
+  UINT sample = 0;
+
+  for (INT k = 0; k < numIn; k++) {
+    coef[k] = _mm_set1_epi32((INT)FX_SGL2FX_DBL(dmxCoef[k]));
+  }
+
+  for (; sample + 4 <= frameLength; sample += 4) {
+    __m128i acc = _mm_loadu_si128((__m128i*)&pOut[sample]);
+    for (INT k = 0; k < numIn; k++) {
+      __m128i x = _mm_loadu_si128((__m128i*)&pIn[k][sample]);
+      acc = _mm_add_epi32(acc, FDK_mm_fMult_epi32(x, coef[k]));
+    }
+    _mm_storeu_si128((__m128i*)&pOut[sample], acc);
+  }
+  for (; sample < frameLength; sample++) {
+    for (INT k = 0; k < numIn; k++) {
+      pOut[sample] += (DMXH_PCM)FX_DBL2FX_DMXH(fMult((DMXH_PCMF)pIn[k][sample], dmxCoef[k]));
+    }
+  }
+}
+
+#if defined(__x86_AVX2__)
+static FDK_X86_TARGET_AVX2 void formatConverterDmxAccumulate_AVX2(DMXH_PCM* pOut,
+                                                                  const DMXH_PCM* const* pIn,
+                                                                  const FIXP_DMX_H* dmxCoef,
+                                                                  INT numIn, UINT frameLength) {
+  __m256i coef[NCHANIN_MAX];
+  UINT sample = 0;
+
+  for (INT k = 0; k < numIn; k++) {
+    coef[k] = _mm256_set1_epi32((INT)FX_SGL2FX_DBL(dmxCoef[k]));
+  }
+
+  /* Two vectors per pass to hide the multiply latency */
+  for (; sample + 16 <= frameLength; sample += 16) {
+    __m256i acc0 = _mm256_loadu_si256((__m256i*)&pOut[sample]);
+    __m256i acc1 = _mm256_loadu_si256((__m256i*)&pOut[sample + 8]);
+    for (INT k = 0; k < numIn; k++) {
+      __m256i x0 = _mm256_loadu_si256((__m256i*)&pIn[k][sample]);
+      __m256i x1 = _mm256_loadu_si256((__m256i*)&pIn[k][sample + 8]);
+      acc0 = _mm256_add_epi32(acc0, _mm256_slli_epi32(FDK_mm256_fMultDiv2_epi32(x0, coef[k]), 1));
+      acc1 = _mm256_add_epi32(acc1, _mm256_slli_epi32(FDK_mm256_fMultDiv2_epi32(x1, coef[k]), 1));
+    }
+    _mm256_storeu_si256((__m256i*)&pOut[sample], acc0);
+    _mm256_storeu_si256((__m256i*)&pOut[sample + 8], acc1);
+  }
+  if (sample < frameLength) {
+    const DMXH_PCM* in[NCHANIN_MAX];
+    for (INT k = 0; k < numIn; k++) {
+      in[k] = &pIn[k][sample];
+    }
+    formatConverterDmxAccumulate_SSE4_1(&pOut[sample], in, dmxCoef, numIn, frameLength - sample);
+  }
+}
+#endif /* defined(__x86_AVX2__) */
+
+static void formatConverterDmxAccumulate(DMXH_PCM* pOut, const DMXH_PCM* const* pIn,
+                                         const FIXP_DMX_H* dmxCoef, INT numIn, UINT frameLength) {
+#if defined(__x86_AVX2__)
+  if (FDK_X86_HAS_AVX2) {
+    formatConverterDmxAccumulate_AVX2(pOut, pIn, dmxCoef, numIn, frameLength);
+    return;
+  }
+#endif
+  if (FDK_X86_HAS_SSE4_1) {
+    formatConverterDmxAccumulate_SSE4_1(pOut, pIn, dmxCoef, numIn, frameLength);
+    return;
+  }
+  for (INT k = 0; k < numIn; k++) {
+    const DMXH_PCM* in = pIn[k];
+    FIXP_DMX_H dmx_coef = dmxCoef[k];
+    for (UINT sample = 0; sample < frameLength; sample++) {
+      pOut[sample] += (DMXH_PCM)FX_DBL2FX_DMXH(fMult((DMXH_PCMF)in[sample], dmx_coef));
+    }
+  }
+}
+#endif /* defined(FUNCTION_formatConverterDmxAccumulate) */
@@ -477,6 +477,33 @@ int transportDec_SetAsiParsing(HANDLE_TRANSPORTDEC hTpDec, AUDIO_SCENE_INFO* pAS
 TRANSPORTDEC_ERROR transportDec_FillData(const HANDLE_TRANSPORTDEC hTp, const UCHAR* pBuffer,
                                          const UINT bufferSize, UINT* pBytesValid, const INT layer);
 
+/**
+ * \brief Read bitstream data directly from the external input buffer instead of copying it into
+ *  the internal input buffer. Same arguments as transportDec_FillData(), but all valid bytes are
+ *  taken at once. The external data is only bound if the internal buffer holds no pending data and
+ *  the data fits into it; otherwise the function falls back to transportDec_FillData().
+ *  Bound data must stay valid until transportDec_ReleaseData() or the next fill call.
+ *
+ * \param hTp         Handle of transportDec.
+ * \param pBuffer     Pointer to external input buffer.
+ * \param bufferSize  Size of external input buffer.
+ * \param bytesValid  Number of bitstream bytes in the external bitstream buffer. The value is
+ * updated according to the amount of bound or copied bytes.
+ * \param layer       The layer the bitstream belongs to.
+ * \return            Error code.
+ */
+TRANSPORTDEC_ERROR transportDec_BindData(const HANDLE_TRANSPORTDEC hTp, const UCHAR* pBuffer,
+                                         const UINT bufferSize, UINT* pBytesValid, const INT layer);
+
+/**
+ * \brief Stop reading from external data bound with transportDec_BindData(). Bytes which have not
+ *  been consumed yet are copied into the internal input buffer. Does nothing if no data is bound.
+ *
+ * \param hTp  Handle of transportDec.
+ * \return     void
+ */
+void transportDec_ReleaseData(const HANDLE_TRANSPORTDEC hTp);
+
 /**
  * \brief      Get transportDec bitstream handle.
  * \param hTp  Pointer to a transport decoder handle.
@@ -545,6 +572,17 @@ TRANSPORTDEC_ERROR transportDec_EndAccessUnit(const HANDLE_TRANSPORTDEC hTp);
 TRANSPORTDEC_ERROR transportDec_GetMissingAccessUnitCount(INT* pNAccessUnits,
                                                           HANDLE_TRANSPORTDEC hTp);
 
+/**
+ * \brief      Obtain the number of bytes which the last call of transportDec_ReadAccessUnit()
+ *             skipped while searching for the synchronization of a stream format, including the
+ *             bytes dropped to recover from a full buffer without sync packet. Only ::TT_MHAS is
+ *             searched, for its sync packet; other formats always report 0.
+ * \param hTp  Transport Handle.
+ * \param pNBytes pointer to a memory location where the skipped byte count will be stored into.
+ * \return     Error code.
+ */
+TRANSPORTDEC_ERROR transportDec_GetSkippedByteCount(INT* pNBytes, HANDLE_TRANSPORTDEC hTp);
+
 /**
  * \brief        Set a given setting.
  * \param hTp    Transport Handle.
@@ -96,6 +96,7 @@ amm-info@iis.fraunhofer.de
 #include "tp_data.h"
 
 #include "FDK_crc.h"
+#include "common_fix.h"
 
 #define MODULE_NAME "transportDec"
 
@@ -146,6 +147,8 @@ struct TRANSPORTDEC {
   UINT lastValidBufferFullness; /* Last valid buffer fullness value for frame loss estimation */
   INT remainder;                /* Reminder in division during lost access unit estimation. */
   INT missingAccessUnits;       /* Estimated missing access units. */
+  INT skippedBytes;             /* Bytes skipped by the synchronization of the last
+                                   transportDec_ReadAccessUnit() call. */
   UINT burstPeriod;             /* Data burst period in mili seconds. */
   UINT holdOffFrames; /* Amount of frames that were already hold off due to buffer fullness
                          condition not being met. */
@@ -613,6 +616,9 @@ TRANSPORTDEC_ERROR transportDec_FillData(const HANDLE_TRANSPORTDEC hTp, const UC
     return TRANSPORTDEC_INVALID_PARAMETER;
   }
 
+  /* the bound caller data must not be written */
+  transportDec_ReleaseData(hTp);
+
   /* set bitbuffer shortcut */
   hBs = &hTp->bitStream[layer];
 
@@ -647,6 +653,40 @@ TRANSPORTDEC_ERROR transportDec_FillData(const HANDLE_TRANSPORTDEC hTp, const UC
   return TRANSPORTDEC_OK;
 }
 
+TRANSPORTDEC_ERROR transportDec_BindData(const HANDLE_TRANSPORTDEC hTp, const UCHAR* pBuffer,
+                                         const UINT bufferSize, UINT* pBytesValid,
+                                         const INT layer) {
+  HANDLE_FDK_BITSTREAM hBs;
+
+  if ((hTp == NULL) || (layer >= TPDEC_MAX_LAYERS)) {
+    return TRANSPORTDEC_INVALID_PARAMETER;
+  }
+
+  transportDec_ReleaseData(hTp);
+
+  /* set bitbuffer shortcut */
+  hBs = &hTp->bitStream[layer];
+
+  /* Bind only if the internal buffer would hold nothing but the new data. Pending data of an
+   * unfinished transport frame or of a previous partial input is appended as usual. */
+  if ((layer != 0) || (*pBytesValid == 0) || (*pBytesValid > (65536 * 1)) ||
+      (hTp->numberOfRawDataBlocks != 0) ||
+      (!TT_IS_PACKET(hTp->transportFmt) && (FDKgetValidBits(hBs) != 0))) {
+    return transportDec_FillData(hTp, pBuffer, bufferSize, pBytesValid, layer);
+  }
+
+  FDKbindBuffer(hBs, &pBuffer[bufferSize - *pBytesValid], (65536 * 1), *pBytesValid);
+  *pBytesValid = 0;
+
+  return TRANSPORTDEC_OK;
+}
+
+void transportDec_ReleaseData(const HANDLE_TRANSPORTDEC hTp) {
+  if ((hTp != NULL) && (hTp->bitStream[0].hBitBuf.Buffer != hTp->bsBuffer)) {
+    FDKunbindBuffer(&hTp->bitStream[0], hTp->bsBuffer, (65536 * 1));
+  }
+}
+
 HANDLE_FDK_BITSTREAM transportDec_GetBitstream(const HANDLE_TRANSPORTDEC hTp, const UINT layer) {
   return &hTp->bitStream[layer];
 }
@@ -1684,6 +1724,68 @@ bail:
 /* How many bits to advance for synchronization search. */
 #define TPDEC_SYNCSKIP 8
 
+#if defined(__x86__)
+#include "x86/tpdec_lib_x86.cpp"
+#endif
+
+#ifndef FUNCTION_mhasFindSyncPacket
+/**
+ * \brief Find the MHAS sync packet (MHASPacketType PACTYP_SYNC, MHASPacketLabel 0,
+ *        MHASPacketLength 1, syncword 0xA5), i.e. the bytes 0xC0 0x01 0xA5, in a byte array.
+ * \param p    Byte array.
+ * \param len  Length of the byte array.
+ * \return     Offset of the first sync packet completely within the array, or -1 if there is none.
+ */
+static INT mhasFindSyncPacket(const UCHAR* p, INT len) {
+  for (INT i = 0; i + 3 <= len; i++) {
+    if ((p[i] == 0xC0) && (p[i + 1] == 0x01) && (p[i + 2] == 0xA5)) {
+      return i;
+    }
+  }
+  return -1;
+}
+#endif /* FUNCTION_mhasFindSyncPacket */
+
+/**
+ * \brief Byte aligned search for the MHAS sync packet in the next bytes of the bit buffer, which
+ *        may wrap around. The read position has to be byte aligned and the cache synchronized.
+ * \param hBs       Bitstream handle.
+ * \param numBytes  Number of bytes to search, at least 3.
+ * \return          Number of bytes in front of the first sync packet, or numBytes - 3 if there is
+ *                  none.
+ */
+static INT mhasSkipToSyncPacket(HANDLE_FDK_BITSTREAM hBs, INT numBytes) {
+  const UCHAR* pBuf = hBs->hBitBuf.Buffer;
+  const UINT byteMask = hBs->hBitBuf.bufSize - 1;
+  const UINT pos = hBs->hBitBuf.BitNdx >> 3;
+  INT i = 0;
+
+  while (i <= numBytes - 3) {
+    UINT start = (pos + i) & byteMask;
+    INT run = (INT)(byteMask + 1 - start);
+    if (run > numBytes - i) {
+      run = numBytes - i;
+    }
+
+    if (run >= 3) {
+      INT k = mhasFindSyncPacket(&pBuf[start], run);
+      if (k >= 0) {
+        return i + k;
+      }
+      i += run - 2;
+    }
+    /* sync packets crossing the end of the ring buffer */
+    for (; (i <= numBytes - 3) && (((pos + i) & byteMask) + 3 > byteMask + 1); i++) {
+      if ((pBuf[(pos + i) & byteMask] == 0xC0) && (pBuf[(pos + i + 1) & byteMask] == 0x01) &&
+          (pBuf[(pos + i + 2) & byteMask] == 0xA5)) {
+        return i;
+      }
+    }
+  }
+
+  return numBytes - 3;
+}
+
 static TRANSPORTDEC_ERROR synchronization(HANDLE_TRANSPORTDEC hTp, INT* pHeaderBits) {
   TRANSPORTDEC_ERROR err = TRANSPORTDEC_OK, errFirstFrame = TRANSPORTDEC_OK;
   HANDLE_FDK_BITSTREAM hBs = &hTp->bitStream[0];
@@ -1753,6 +1855,15 @@ static TRANSPORTDEC_ERROR synchronization(HANDLE_TRANSPORTDEC hTp, INT* pHeaderB
         err = TRANSPORTDEC_NOT_ENOUGH_BITS;
         headerBits = 0;
       } else {
+        if (!(hTp->flags & TPDEC_SYNCOK) && (hTp->transportFmt == TT_MHAS) &&
+            !(hBs->hBitBuf.BitNdx & 7)) {
+          /* Skip all bytes in front of the next sync packet at once; the bitwise search below
+           * then finds it at the current position. */
+          INT skipBytes = mhasSkipToSyncPacket(hBs, bitsAvail >> 3);
+          FDKpushFor(hBs, skipBytes << 3);
+          bitsAvail -= skipBytes << 3;
+        }
+
         synch = FDKreadBits(hBs, syncLength);
 
         if (!(hTp->flags & TPDEC_SYNCOK)) {
@@ -1942,6 +2053,16 @@ bail:
     err = TRANSPORTDEC_SYNC_ERROR;
   }
 
+  /* Count the bytes dropped in front of the transport frame by the sync packet search, including
+     the recovery above. Only TT_MHAS is searched. */
+  if (hTp->transportFmt == TT_MHAS) {
+    INT skippedBits = totalBits - (INT)FDKgetValidBits(hBs);
+    if (err == TRANSPORTDEC_OK) {
+      skippedBits -= headerBits;
+    }
+    hTp->skippedBytes = (skippedBits > 0) ? (skippedBits >> 3) : 0;
+  }
+
   if (err == TRANSPORTDEC_OK) {
     hTp->flags |= TPDEC_SYNCOK;
   }
@@ -1987,6 +2108,7 @@ TRANSPORTDEC_ERROR transportDec_ReadAccessUnit(const HANDLE_TRANSPORTDEC hTp, co
   }
 
   hBs = &hTp->bitStream[layer];
+  hTp->skippedBytes = 0;
 
   if ((INT)FDKgetValidBits(hBs) <= 0) {
     /* This is only relevant for RAW and ADIF cases.
@@ -2059,6 +2181,12 @@ TRANSPORTDEC_ERROR transportDec_GetMissingAccessUnitCount(INT* pNAccessUnits,
   return TRANSPORTDEC_OK;
 }
 
+TRANSPORTDEC_ERROR transportDec_GetSkippedByteCount(INT* pNBytes, HANDLE_TRANSPORTDEC hTp) {
+  *pNBytes = hTp->skippedBytes;
+
+  return TRANSPORTDEC_OK;
+}
+
 /* Inform the transportDec layer that reading of access unit has finished. */
 TRANSPORTDEC_ERROR transportDec_EndAccessUnit(HANDLE_TRANSPORTDEC hTp) {
   TRANSPORTDEC_ERROR err = TRANSPORTDEC_OK;
@@ -2122,6 +2250,7 @@ TRANSPORTDEC_ERROR transportDec_SetParam(const HANDLE_TRANSPORTDEC hTp, const TP
       hTp->remainder = 0;
       hTp->avgBitRate = 0;
       hTp->missingAccessUnits = 0;
+      hTp->skippedBytes = 0;
       hTp->numberOfRawDataBlocks = 0;
       hTp->globalFramePos = 0;
       hTp->holdOffFrames = 0;
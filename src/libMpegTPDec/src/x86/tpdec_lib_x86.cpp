@@ -0,0 +1,158 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2018 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+/******************* MPEG transport format decoder library *********************
+
+   Author(s):
+
+   Description: (x86 SSE4.1/AVX2 optimized) MHAS sync packet search
+
+*******************************************************************************/
+
+#if defined(__x86_SSE4_1__)
+#include "x86/FDK_x86_funcs.h"
+
+#define FUNCTION_mhasFindSyncPacket
+#endif
+
+#if defined(FUNCTION_mhasFindSyncPacket)
+/* The three bytes of the sync packet are compared at 16 (32) consecutive start positions at once.
+ * A block containing a match is left to the scalar loop, which returns the first match. */
+static FDK_X86_TARGET_SSE4_1 INT mhasFindSyncPacket_SSE4_1(const UCHAR* p, INT len) {
+  const __m128i sync0 = _mm_set1_epi8((char)0xC0);
+  const __m128i sync1 = _mm_set1_epi8((char)0x01);
+  const __m128i sync2 = _mm_set1_epi8((char)0xA5);
+  INT i = 0;
+
+  for (; i + 18 <= len; i += 16) {
+    __m128i m0 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)&p[i]), sync0);
+    __m128i m1 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)&p[i + 1]), sync1);
+    __m128i m2 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)&p[i + 2]), sync2);
+    if (_mm_movemask_epi8(_mm_and_si128(m0, _mm_and_si128(m1, m2))) != 0) {
+      break;
+    }
+  }
+  for (; i + 3 <= len; i++) {
+    if ((p[i] == 0xC0) && (p[i + 1] == 0x01) && (p[i + 2] == 0xA5)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+#if defined(__x86_AVX2__)
+static FDK_X86_TARGET_AVX2 INT mhasFindSyncPacket_AVX2(const UCHAR* p, INT len) {
+  const __m256i sync0 = _mm256_set1_epi8((char)0xC0);
+  const __m256i sync1 = _mm256_set1_epi8((char)0x01);
+  const __m256i sync2 = _mm256_set1_epi8((char)0xA5);
+  INT i = 0;
+
+  for (; i + 34 <= len; i += 32) {
+    __m256i m0 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)&p[i]), sync0);
+    __m256i m1 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)&p[i + 1]), sync1);
+    __m256i m2 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)&p[i + 2]), sync2);
+    if (_mm256_movemask_epi8(_mm256_and_si256(m0, _mm256_and_si256(m1, m2))) != 0) {
+      break;
+    }
+  }
+  INT k = mhasFindSyncPacket_SSE4_1(&p[i], len - i);
+  return (k < 0) ? -1 : i + k;
+}
+#endif /* defined(__x86_AVX2__) */
+
+static INT mhasFindSyncPacket(const UCHAR* p, INT len) {
+#if defined(__x86_AVX2__)
+  if (FDK_X86_HAS_AVX2) {
+    return mhasFindSyncPacket_AVX2(p, len);
+  }
+#endif
+  if (FDK_X86_HAS_SSE4_1) {
+    return mhasFindSyncPacket_SSE4_1(p, len);
+  }
+  for (INT i = 0; i + 3 <= len; i++) {
+    if ((p[i] == 0xC0) && (p[i + 1] == 0x01) && (p[i + 2] == 0xA5)) {
+      return i;
+    }
+  }
+  return -1;
+}
+#endif /* defined(FUNCTION_mhasFindSyncPacket) */
@@ -991,12 +991,25 @@ typedef enum {
   AAC_ADDITIONAL_STEREO_DMX =
       0x0908, /*!<  Additional stereo downmix. 0: Disabled (default), 1: Enabled */
   AAC_MPEGH_GOA_ENABLE = 0x0909, /*!<  Export object meta data for 3D post processing */
+  AAC_VBAP_GAIN_GRID =
+      0x090A, /*!< Object rendering of point sources with the enhanced renderer: 0: Search the
+                 speaker triplet for each object position (default). 1: Interpolate a gain grid
+                 precomputed for the target layout. Saves most of the object rendering time, the
+                 panning gains deviate slightly from the search. Applies to the object renderers
+                 opened at the next configuration. */
 
   AAC_EQ_FILTER_ATTENUATION_VECTOR =
-      0x0A00 /*!< One-dimensional vector of the length 32 where every 32bit value is in Q31 format.
-                Each value represents an attenuation factor which will be applied to the according
-                subband in frequency domain. Note that the whole frequency range (f_s/2) is divided
-                in 32 equidistant subbands. */
+      0x0A00, /*!< One-dimensional vector of the length 32 where every 32bit value is in Q31
+                 format. Each value represents an attenuation factor which will be applied to the
+                 according subband in frequency domain. Note that the whole frequency range (f_s/2)
+                 is divided in 32 equidistant subbands. */
+
+  AAC_DECODER_THREADS =
+      0x0B00 /*!< Number of threads used for the inverse transforms of the core channels including
+                the calling thread. 0 or 1: Single-threaded decoding (default). 2..28: The
+                filterbanks of the channels are distributed on an internal worker pool, which is
+                joined before the rendering stages. The output is bit-exact to
+                the single-threaded mode. Fails if the platform provides no thread support. */
 
 } AACDEC_PARAM;
 
@@ -1078,6 +1091,9 @@ typedef struct {
                                 the decoder. */
   INT64 numBadAccessUnits;   /*!< This is the number of total access units that were considered with
                                 errors from numTotalBytes. */
+  INT64 numSkippedBytes;     /*!< This is the number of total bytes that were skipped while
+                                searching for the sync packet of an MHAS stream (::TT_MHAS). It
+                                stays 0 for ::TT_MHAS_PACKETIZED, which is not searched. */
 
   /* Metadata */
   SCHAR drcProgRefLev; /*!< DRC program reference level. Defines the reference level below
@@ -1111,6 +1127,10 @@ typedef struct {
 
 typedef struct AAC_DECODER_INSTANCE* HANDLE_AACDECODER; /*!< Pointer to a AAC decoder instance. */
 
+typedef struct AAC_DECODER_SCRATCH_POOL*
+    HANDLE_AAC_DECODER_SCRATCH_POOL; /*!< Pointer to scratch memory shared by AAC decoder
+                                          instances. */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -1217,6 +1237,36 @@ LINKSPEC_H AAC_DECODER_ERROR aacDecoder_ConfigRaw(HANDLE_AACDECODER self, UCHAR*
 LINKSPEC_H AAC_DECODER_ERROR aacDecoder_Fill(HANDLE_AACDECODER self, const UCHAR* const pBuffer[],
                                              const UINT bufferSize[], UINT* bytesValid);
 
+/**
+ * \brief Provide bitstream data like aacDecoder_Fill(), but let the decoder read it directly from
+ * the external input buffer instead of copying it into the decoder-internal input buffer. All valid
+ * bytes are taken at once. If the internal buffer still holds pending data, or the data does not
+ * fit into it, the data is copied as with aacDecoder_Fill().
+ *
+ * The external input buffer must stay valid and unchanged until aacDecoder_ReleaseInput() or the
+ * next aacDecoder_Fill() or aacDecoder_BindInput() call. Call aacDecoder_ReleaseInput() once
+ * aacDecoder_DecodeFrame() signals that it needs more data.
+ *
+ * \param self        AAC decoder handle.
+ * \param pBuffer     Pointer to external input buffer.
+ * \param bufferSize  Size of external input buffer.
+ * \param bytesValid  Number of bitstream bytes in the external bitstream buffer. The value is
+ * updated according to the amount of taken bytes.
+ * \return            Error code.
+ */
+LINKSPEC_H AAC_DECODER_ERROR aacDecoder_BindInput(HANDLE_AACDECODER self,
+                                                  const UCHAR* const pBuffer[],
+                                                  const UINT bufferSize[], UINT* bytesValid);
+
+/**
+ * \brief Release the external input buffer provided with aacDecoder_BindInput(). Bytes which have
+ * not been decoded yet are copied into the decoder-internal input buffer.
+ *
+ * \param self  AAC decoder handle.
+ * \return      Error code.
+ */
+LINKSPEC_H AAC_DECODER_ERROR aacDecoder_ReleaseInput(HANDLE_AACDECODER self);
+
 #define AACDEC_CONCEAL                                                                    \
   1 /*!< Flag for aacDecoder_DecodeFrame(): Trigger the built-in error concealment module \
            to generate a substitute signal for one lost frame. New input data will not be \
@@ -1265,6 +1315,67 @@ LINKSPEC_H void aacDecoder_Close(HANDLE_AACDECODER self);
  */
 LINKSPEC_H CStreamInfo* aacDecoder_GetStreamInfo(HANDLE_AACDECODER self);
 
+/**
+ * \brief  Allocate the scratch memory of an AAC decoder instance, so that it can be shared by
+ *         several instances with aacDecoder_SetScratchPool(). The scratch memory only holds data
+ *         during a single aacDecoder_ConfigRaw() or aacDecoder_DecodeFrame() call. Therefore
+ *         instances sharing one pool must not be used concurrently, e.g. they must be used by the
+ *         same thread.
+ *
+ * \return  Scratch pool handle, or NULL on failure.
+ */
+LINKSPEC_H HANDLE_AAC_DECODER_SCRATCH_POOL aacDecoder_OpenScratchPool(void);
+
+/**
+ * \brief        De-allocate a scratch pool. All AAC decoder instances using the pool must have been
+ *               closed before.
+ *
+ * \param hPool  Scratch pool handle.
+ * \return       void.
+ */
+LINKSPEC_H void aacDecoder_CloseScratchPool(HANDLE_AAC_DECODER_SCRATCH_POOL hPool);
+
+/**
+ * \brief        Use the scratch memory of a scratch pool instead of private scratch memory. Must be
+ *               called before the decoder received its first configuration.
+ *
+ * \param self   AAC decoder handle.
+ * \param hPool  Scratch pool handle, or NULL to switch back to private scratch memory.
+ * \return       Error code.
+ */
+LINKSPEC_H AAC_DECODER_ERROR aacDecoder_SetScratchPool(HANDLE_AACDECODER self,
+                                                       HANDLE_AAC_DECODER_SCRATCH_POOL hPool);
+
+/**
+ * \brief            Provide renderer setup data retrieved with aacDecoder_GetRendererSetup().
+ *                   Object renderers opened for an output layout contained in the data take the
+ *                   speaker triangulation, spread gains and gain grid from it instead of computing
+ *                   them.
+ *                   The data is referenced, not copied, and must stay valid until it is replaced or
+ *                   the decoder is closed. Entries which do not match the library build or fail the
+ *                   consistency checks are ignored.
+ *
+ * \param self       AAC decoder handle.
+ * \param setup      Renderer setup data, or NULL to remove it.
+ * \param setupSize  Size of the renderer setup data in bytes.
+ * \return           Error code.
+ */
+LINKSPEC_H AAC_DECODER_ERROR aacDecoder_SetRendererSetup(HANDLE_AACDECODER self, const UCHAR* setup,
+                                                         const UINT setupSize);
+
+/**
+ * \brief            Serialize the derived setup of the currently opened object renderers, one entry
+ *                   per output layout. The data is only valid for the library build which wrote it.
+ *
+ * \param self       AAC decoder handle.
+ * \param setup      Destination buffer, or NULL to query the required size.
+ * \param setupSize  Size of the destination buffer in bytes.
+ * \param setupUsed  Returns the number of bytes written, or the required size if setup is NULL.
+ * \return           Error code. ::AAC_DEC_OUTPUT_BUFFER_TOO_SMALL if the buffer is too small.
+ */
+LINKSPEC_H AAC_DECODER_ERROR aacDecoder_GetRendererSetup(HANDLE_AACDECODER self, UCHAR* setup,
+                                                         const UINT setupSize, UINT* setupUsed);
+
 #ifdef __cplusplus
 }
 #endif
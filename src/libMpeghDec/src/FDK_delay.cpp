@@ -122,3 +122,11 @@ void FDK_Delay_Destroy(FDK_SignalDelay* data) {
 
   return;
 }
+
+void FDK_Delay_Clear(FDK_SignalDelay* data) {
+  if (data->delay_line != NULL) {
+    FDKmemclear(data->delay_line, data->num_channels * data->delay * sizeof(PCM_DEC));
+  }
+
+  return;
+}
@@ -122,4 +122,13 @@ INT FDK_Delay_Create(FDK_SignalDelay* data, const USHORT delay, const UCHAR num_
  */
 void FDK_Delay_Destroy(FDK_SignalDelay* data);
 
+/**
+ * \brief Clear the delayed samples of all channels.
+ *
+ * \param data Pointer delay element structure.
+ *
+ * \return void
+ */
+void FDK_Delay_Clear(FDK_SignalDelay* data);
+
 #endif /* #ifndef FDK_DELAY_H */
@@ -498,6 +498,105 @@ static void CStreamInfoInit(CStreamInfo* pStreamInfo) {
   pStreamInfo->fBsRestartOk = 0;
 }
 
+/* Move a pointer into a reallocated work buffer. */
+static void CAacDecoder_RebaseWorkBufferPtr(FIXP_DBL** ptr, const FIXP_DBL* oldBuffer,
+                                            const INT oldSize, FIXP_DBL* newBuffer) {
+  if ((*ptr != NULL) && (*ptr >= oldBuffer) &&
+      (*ptr < oldBuffer + oldSize / (INT)sizeof(FIXP_DBL))) {
+    *ptr = newBuffer + (*ptr - oldBuffer);
+  }
+}
+
+/*!
+  \brief Reallocate WorkBufferCore2 and WorkBufferCore5 for a given number of channels
+
+  The buffer content is preserved as far as it fits, and the pointers into the work buffers which
+  were set up during configuration are moved to the new buffers. Shared scratch memory of a scratch
+  pool always has the worst case size and is never reallocated.
+
+  \param self         decoder handle
+  \param numChannels  number of channels, or -1 for the worst case size required during
+                      configuration
+
+  \return  error code; the previous buffers are kept in case of an error
+*/
+static AAC_DECODER_ERROR CAacDecoder_ResizeWorkBuffers(HANDLE_AACDECODER self,
+                                                       const INT numChannels) {
+  FIXP_DBL* workBufferCore2;
+  PCM_DEC* pTimeData2;
+  INT workBufferCore2Size, timeData2Size;
+  int i;
+
+  if (self->hScratchPool != NULL) {
+    return AAC_DEC_OK;
+  }
+
+  workBufferCore2Size = (INT)GetRequiredMemWorkBufferCore2();
+  timeData2Size = (INT)GetRequiredMemWorkBufferCore5();
+  if (numChannels >= 0) {
+    /* Each channel needs one upsampled output frame plus the renderer delay. The transmitted
+     * downmix matrices are stored in WorkBufferCore5 while the config is parsed. */
+    INT channelSize = ((1024 * 3) + 256) * (INT)sizeof(FIXP_DBL);
+    workBufferCore2Size = fMin(workBufferCore2Size, fMax(numChannels, 1) * channelSize);
+    timeData2Size =
+        fMin(timeData2Size, fMax(fMax(numChannels, 1) * channelSize,
+                                 (INT)sizeof(FDK_DOWNMIX_GROUPS_MATRIX_SET)));
+  }
+
+  if ((workBufferCore2Size == self->workBufferCore2Size) &&
+      (timeData2Size == self->timeData2Size)) {
+    return AAC_DEC_OK;
+  }
+
+  workBufferCore2 = (FIXP_DBL*)FDKaalloc(workBufferCore2Size, ALIGNMENT_DEFAULT);
+  pTimeData2 = (PCM_DEC*)FDKaalloc(timeData2Size, ALIGNMENT_DEFAULT);
+  if ((workBufferCore2 == NULL) || (pTimeData2 == NULL)) {
+    if (workBufferCore2 != NULL) {
+      FDKafree(workBufferCore2);
+    }
+    if (pTimeData2 != NULL) {
+      FDKafree(pTimeData2);
+    }
+    return AAC_DEC_OUT_OF_MEMORY;
+  }
+
+  if (self->workBufferCore2 != NULL) {
+    FDKmemcpy(workBufferCore2, self->workBufferCore2,
+              fMin(workBufferCore2Size, self->workBufferCore2Size));
+    for (i = 0; i < (28); i++) {
+      if (self->pAacDecoderChannelInfo[i] != NULL) {
+        CAacDecoder_RebaseWorkBufferPtr(&self->pAacDecoderChannelInfo[i]->pSpectralCoefficient,
+                                        self->workBufferCore2, self->workBufferCore2Size,
+                                        workBufferCore2);
+      }
+    }
+    FDKafree(self->workBufferCore2);
+  }
+
+  if (self->pTimeData2 != NULL) {
+    FDKmemcpy(pTimeData2, self->pTimeData2, fMin(timeData2Size, self->timeData2Size));
+    for (i = 0; i < 2; i++) {
+      CAacDecoder_RebaseWorkBufferPtr(&self->igf_private_data_common[i].virtualSpec,
+                                      self->pTimeData2, self->timeData2Size, pTimeData2);
+    }
+    for (i = 0; i < (INT)(sizeof(self->cpeStaticData) / sizeof(self->cpeStaticData[0])); i++) {
+      if (self->cpeStaticData[i] != NULL) {
+        CAacDecoder_RebaseWorkBufferPtr(
+            &self->cpeStaticData[i]->jointStereoPersistentData.scratchBuffer2, self->pTimeData2,
+            self->timeData2Size, pTimeData2);
+      }
+    }
+    FDKafree(self->pTimeData2);
+  }
+
+  self->workBufferCore2 = workBufferCore2;
+  self->workBufferCore2Size = workBufferCore2Size;
+  self->pTimeData2 = pTimeData2;
+  self->timeData2Size = timeData2Size;
+
+  return AAC_DEC_OK;
+}
+
 /*!
   \brief Initialization of AacDecoderChannelInfo
 
@@ -539,13 +638,9 @@ CAacDecoder_Open(TRANSPORT_TYPE bsFormat) /*!< bitstream format (adif,adts,loas,
   CConcealment_InitCommonData(&self->concealCommonData);
   self->concealMethodUser = ConcealMethodNone; /* undefined -> auto mode */
 
-  self->workBufferCore2 = GetWorkBufferCore2();
-  if (self->workBufferCore2 == NULL) goto bail;
-
-  /* When MPEG-H is active use dedicated memory for core decoding */
-  self->pTimeData2 = GetWorkBufferCore5();
-  self->timeData2Size = GetRequiredMemWorkBufferCore5();
-  if (self->pTimeData2 == NULL) {
+  /* When MPEG-H is active use dedicated memory for core decoding. The work buffers are enlarged
+   * as soon as a config with more channels is received. */
+  if (CAacDecoder_ResizeWorkBuffers(self, 1) != AAC_DEC_OK) {
     goto bail;
   }
 
@@ -1036,7 +1131,8 @@ static AAC_DECODER_ERROR CAacDecoder_InitRenderer(HANDLE_AACDECODER self, const
                   self->pUsacConfig[streamIndex]
                       ->element[_el]
                       .extElement.extConfig.oam.hasUniformSpread,
-                  prodMetadataPresent ? GVBAP_ENHANCED : GVBAP_LEGACY) != 0) {
+                  prodMetadataPresent ? GVBAP_ENHANCED : GVBAP_LEGACY, self->vbapGainGrid,
+                  self->pRendererSetup, self->rendererSetupSize) != 0) {
             err = AAC_DEC_DECODE_FRAME_ERROR;
             /* save the amount of object signal groups for propper closing of object renderer
              * instances */
@@ -1091,7 +1187,7 @@ static void CAacDecoder_DeInit(HANDLE_AACDECODER self, const int subStreamIndex,
         }
         if (self->pAacDecoderChannelInfo[ch]->pComStaticData != NULL) {
           if (self->pAacDecoderChannelInfo[ch]->pComStaticData->pWorkBufferCore1 != NULL) {
-            if (ch == 0) {
+            if ((ch == 0) && (self->hScratchPool == NULL)) {
               FreeWorkBufferCore1(
                   &self->pAacDecoderChannelInfo[ch]->pComStaticData->pWorkBufferCore1);
             }
@@ -1125,7 +1221,9 @@ static void CAacDecoder_DeInit(HANDLE_AACDECODER self, const int subStreamIndex,
             }
           }
           if (ch == 0) {
-            FreeWorkBufferCore6((FIXP_DBL**)&self->pAacDecoderChannelInfo[ch]->pComData);
+            if (self->hScratchPool == NULL) {
+              FreeWorkBufferCore6((FIXP_DBL**)&self->pAacDecoderChannelInfo[ch]->pComData);
+            }
           } else {
             FDKafree(self->pAacDecoderChannelInfo[ch]->pComData);
           }
@@ -1285,16 +1383,140 @@ LINKSPEC_CPP void CAacDecoder_Close(HANDLE_AACDECODER self) {
   CAacDecoder_DeInit(self, 0, 0);
 
   /* Free WorkBufferCore2 */
-  if (self->workBufferCore2 != NULL) {
-    FreeWorkBufferCore2(&self->workBufferCore2);
-  }
-  if (self->pTimeData2 != NULL) {
-    FreeWorkBufferCore5(&self->pTimeData2);
+  if (self->hScratchPool == NULL) {
+    if (self->workBufferCore2 != NULL) {
+      FDKafree(self->workBufferCore2);
+      self->workBufferCore2 = NULL;
+    }
+    if (self->pTimeData2 != NULL) {
+      FDKafree(self->pTimeData2);
+      self->pTimeData2 = NULL;
+    }
   }
 
+  CAacDecoder_SetNumThreads(self, 1);
+
   FreeAacDecoder(&self);
 }
 
+LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_SetNumThreads(HANDLE_AACDECODER self,
+                                                        const INT numThreads) {
+  if (self == NULL) return AAC_DEC_INVALID_HANDLE;
+
+  if ((numThreads < 0) || (numThreads > (28))) {
+    return AAC_DEC_SET_PARAM_FAIL;
+  }
+
+  FDK_workerPoolClose(&self->hWorkerPool);
+  if (self->pWorkerMdctOutTemp != NULL) {
+    FDKafree(self->pWorkerMdctOutTemp);
+    self->pWorkerMdctOutTemp = NULL;
+  }
+
+  if (numThreads > 1) {
+    /* Worker 0 is the calling thread and uses the IMDCT scratch of WorkBufferCore1. */
+    self->pWorkerMdctOutTemp =
+        (FIXP_DBL*)FDKaalloc((numThreads - 1) * 1024 * sizeof(FIXP_DBL), ALIGNMENT_DEFAULT);
+    self->hWorkerPool = FDK_workerPoolOpen(numThreads);
+    if ((self->pWorkerMdctOutTemp == NULL) || (self->hWorkerPool == NULL)) {
+      CAacDecoder_SetNumThreads(self, 1);
+      return AAC_DEC_SET_PARAM_FAIL;
+    }
+  }
+
+  return AAC_DEC_OK;
+}
+
+LINKSPEC_CPP HANDLE_AAC_DECODER_SCRATCH_POOL CAacDecoder_OpenScratchPool(void) {
+  HANDLE_AAC_DECODER_SCRATCH_POOL hPool;
+
+  hPool = (HANDLE_AAC_DECODER_SCRATCH_POOL)FDKcalloc(1, sizeof(struct AAC_DECODER_SCRATCH_POOL));
+  if (hPool == NULL) {
+    return NULL;
+  }
+
+  hPool->pWorkBufferCore1 = GetWorkBufferCore1();
+  hPool->pWorkBufferCore2 = GetWorkBufferCore2();
+  hPool->pWorkBufferCore5 = GetWorkBufferCore5();
+  hPool->pWorkBufferCore6 = GetWorkBufferCore6();
+  if ((hPool->pWorkBufferCore1 == NULL) || (hPool->pWorkBufferCore2 == NULL) ||
+      (hPool->pWorkBufferCore5 == NULL) || (hPool->pWorkBufferCore6 == NULL)) {
+    CAacDecoder_CloseScratchPool(hPool);
+    return NULL;
+  }
+
+  return hPool;
+}
+
+LINKSPEC_CPP void CAacDecoder_CloseScratchPool(HANDLE_AAC_DECODER_SCRATCH_POOL hPool) {
+  if (hPool == NULL) return;
+
+  if (hPool->pWorkBufferCore1 != NULL) {
+    FreeWorkBufferCore1(&hPool->pWorkBufferCore1);
+  }
+  if (hPool->pWorkBufferCore2 != NULL) {
+    FreeWorkBufferCore2(&hPool->pWorkBufferCore2);
+  }
+  if (hPool->pWorkBufferCore5 != NULL) {
+    FreeWorkBufferCore5(&hPool->pWorkBufferCore5);
+  }
+  if (hPool->pWorkBufferCore6 != NULL) {
+    FreeWorkBufferCore6(&hPool->pWorkBufferCore6);
+  }
+  FDKfree(hPool);
+}
+
+LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_SetScratchPool(HANDLE_AACDECODER self,
+                                                         HANDLE_AAC_DECODER_SCRATCH_POOL hPool) {
+  if (self == NULL) return AAC_DEC_INVALID_HANDLE;
+
+  /* Pointers into the scratch memory are spread across the channel data during configuration. */
+  if (self->pAacDecoderChannelInfo[0] != NULL) {
+    return AAC_DEC_SET_PARAM_FAIL;
+  }
+  if (hPool == self->hScratchPool) {
+    return AAC_DEC_OK;
+  }
+
+  if (hPool == NULL) {
+    /* Allocate private work buffers, the pool buffers stay untouched. */
+    HANDLE_AAC_DECODER_SCRATCH_POOL hPrevPool = self->hScratchPool;
+    AAC_DECODER_ERROR err;
+
+    self->hScratchPool = NULL;
+    self->workBufferCore2 = NULL;
+    self->workBufferCore2Size = 0;
+    self->pTimeData2 = NULL;
+    self->timeData2Size = 0;
+    err = CAacDecoder_ResizeWorkBuffers(self, 1);
+    if (err != AAC_DEC_OK) {
+      self->hScratchPool = hPrevPool;
+      self->workBufferCore2 = hPrevPool->pWorkBufferCore2;
+      self->workBufferCore2Size = (INT)GetRequiredMemWorkBufferCore2();
+      self->pTimeData2 = hPrevPool->pWorkBufferCore5;
+      self->timeData2Size = (INT)GetRequiredMemWorkBufferCore5();
+    }
+    return err;
+  }
+
+  if (self->hScratchPool == NULL) {
+    if (self->workBufferCore2 != NULL) {
+      FDKafree(self->workBufferCore2);
+    }
+    if (self->pTimeData2 != NULL) {
+      FDKafree(self->pTimeData2);
+    }
+  }
+
+  self->hScratchPool = hPool;
+  self->workBufferCore2 = hPool->pWorkBufferCore2;
+  self->workBufferCore2Size = (INT)GetRequiredMemWorkBufferCore2();
+  self->pTimeData2 = hPool->pWorkBufferCore5;
+  self->timeData2Size = (INT)GetRequiredMemWorkBufferCore5();
+
+  return AAC_DEC_OK;
+}
+
 /*!
   \brief Initialization of decoder instance
 
@@ -1673,6 +1895,12 @@ LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_Init(HANDLE_AACDECODER self,
   }
 
   if (*configChanged) {
+    /* The configuration needs the worst case work buffers as scratch memory. They are fitted to the
+     * new channel count once the last substream has been configured. */
+    if (CAacDecoder_ResizeWorkBuffers(self, -1) != AAC_DEC_OK) {
+      goto bail;
+    }
+
     /* Allocate all memory structures for each channel */
     {
       int ch = aacChannelsOffset;
@@ -1742,7 +1970,12 @@ LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_Init(HANDLE_AACDECODER self,
               if (self->pAacDecoderChannelInfo[ch]->pComStaticData == NULL) {
                 goto bail;
               }
-              if (ch == 0) {
+              if ((ch == 0) && (self->hScratchPool != NULL)) {
+                self->pAacDecoderChannelInfo[ch]->pComData =
+                    (CAacDecoderCommonData*)self->hScratchPool->pWorkBufferCore6;
+                self->pAacDecoderChannelInfo[ch]->pComStaticData->pWorkBufferCore1 =
+                    self->hScratchPool->pWorkBufferCore1;
+              } else if (ch == 0) {
                 self->pAacDecoderChannelInfo[ch]->pComData =
                     (CAacDecoderCommonData*)GetWorkBufferCore6();
                 self->pAacDecoderChannelInfo[ch]->pComStaticData->pWorkBufferCore1 =
@@ -2093,6 +2326,24 @@ LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_Init(HANDLE_AACDECODER self,
         goto bail;
       }
     }
+
+    if (configMode & AC_CM_LAST_SUBSTREAM) {
+      /* Fit the work buffers to all transmitted signals and the rendered output channels. The
+       * worst case buffers are kept if the smaller ones cannot be allocated. */
+      INT numSignals = 0, numChannels;
+      for (int i = 0; i < TPDEC_MAX_TRACKS; i++) {
+        if (self->pUsacConfig[i] == NULL) break;
+        for (int grp = 0; grp < self->pUsacConfig[i]->bsNumSignalGroups; grp++) {
+          numSignals += self->pUsacConfig[i]->m_signalGroupType[grp].count;
+        }
+      }
+      numChannels = fMax(self->aacChannels, numSignals);
+      if (asc->m_aot == AOT_MPEGH3DA) {
+        numChannels =
+            fMax(numChannels, cicp2geometry_get_numChannels_from_cicp(self->targetLayout_config));
+      }
+      CAacDecoder_ResizeWorkBuffers(self, numChannels);
+    }
   }
 
   CAacDecoder_AcceptFlags(self, asc, flags, elFlags, streamIndex, elementOffset);
@@ -2107,6 +2358,86 @@ bail:
   return AAC_DEC_OUT_OF_MEMORY;
 }
 
+/* Pending inverse transform and time domain fading of one channel. */
+typedef struct {
+  CAacDecoderChannelInfo* pAacDecoderChannelInfo;
+  CAacDecoderStaticChannelInfo* pAacDecoderStaticChannelInfo;
+  PCM_DEC* pTimeData;
+  UINT elFlags;
+  INT elCh;
+  INT channel;
+  UCHAR frameOk;
+  UCHAR applyImdct;
+  UCHAR applyLtpPost;
+} CAacDecoder_ChannelJob;
+
+typedef struct {
+  HANDLE_AACDECODER self;
+  INT numJobs;
+  UINT usedChannelMask; /*!< Bit mask of the output channels written by the pending jobs. */
+  CAacDecoder_ChannelJob job[(28)];
+} CAacDecoder_ChannelJobList;
+
+/* Inverse transform of one channel. Only touches the channel's own memory and the IMDCT scratch
+ * of the executing worker, thus jobs of different channels can run concurrently. */
+static void CAacDecoder_ChannelJobFunc(void* pContext, INT job, INT worker) {
+  CAacDecoder_ChannelJobList* pJobList = (CAacDecoder_ChannelJobList*)pContext;
+  CAacDecoder_ChannelJob* pJob = &pJobList->job[job];
+  HANDLE_AACDECODER self = pJobList->self;
+  CAacDecoderStaticChannelInfo* pAacDecoderStaticChannelInfo = pJob->pAacDecoderStaticChannelInfo;
+  FIXP_DBL* pMdctOutTemp;
+
+  if (!pJob->applyImdct) {
+    return;
+  }
+
+  if (worker == 0) {
+    pMdctOutTemp = pJob->pAacDecoderChannelInfo->pComStaticData->pWorkBufferCore1->mdctOutTemp;
+  } else {
+    pMdctOutTemp = &self->pWorkerMdctOutTemp[(worker - 1) * 1024];
+  }
+
+  CBlock_FrequencyToTime(pAacDecoderStaticChannelInfo, pJob->pAacDecoderChannelInfo,
+                         pJob->pTimeData, self->streamInfo.aacSamplesPerFrame, pJob->frameOk,
+                         pMdctOutTemp, self->aacOutDataHeadroom, pJob->elFlags, pJob->elCh);
+  if (pJob->applyLtpPost) {
+    ltp_post(pJob->pTimeData, self->streamInfo.aacSamplesPerFrame, self->streamInfo.aacSampleRate,
+             pAacDecoderStaticChannelInfo->ltp_param,
+             &(pAacDecoderStaticChannelInfo->ltp_pitch_int_past),
+             &(pAacDecoderStaticChannelInfo->ltp_pitch_fr_past),
+             &(pAacDecoderStaticChannelInfo->ltp_gain_past),
+             &(pAacDecoderStaticChannelInfo->ltp_gainIdx_past),
+             pAacDecoderStaticChannelInfo->ltp_mem_in, pAacDecoderStaticChannelInfo->ltp_mem_out);
+  }
+}
+
+/* Run the pending inverse transforms (on the worker pool if enabled) followed by the time domain
+ * fading in channel order, which has to stay sequential because of the noise seed propagation. */
+static void CAacDecoder_RunChannelJobs(HANDLE_AACDECODER self, CAacDecoder_ChannelJobList* pJobList,
+                                       INT* CConceal_TDFading_Applied, const int aacChannels) {
+  FDK_workerPoolRun(self->hWorkerPool, CAacDecoder_ChannelJobFunc, pJobList, pJobList->numJobs);
+
+  for (int i = 0; i < pJobList->numJobs; i++) {
+    CAacDecoder_ChannelJob* pJob = &pJobList->job[i];
+    int c = pJob->channel;
+
+    /* TimeDomainFading */
+    if (!CConceal_TDFading_Applied[c]) {
+      CConceal_TDFading_Applied[c] = CConcealment_TDFading(
+          self->streamInfo.aacSamplesPerFrame, &self->pAacDecoderStaticChannelInfo[c],
+          self->aacOutDataHeadroom, pJob->pTimeData, 0);
+      if (c + 1 < (28) && c < aacChannels - 1) {
+        /* update next TDNoise Seed to avoid muting in case of Parametric Stereo */
+        self->pAacDecoderStaticChannelInfo[c + 1]->concealmentInfo.TDNoiseSeed =
+            self->pAacDecoderStaticChannelInfo[c]->concealmentInfo.TDNoiseSeed;
+      }
+    }
+  }
+
+  pJobList->numJobs = 0;
+  pJobList->usedChannelMask = 0;
+}
+
 LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_DecodeFrame(HANDLE_AACDECODER self, const UINT flags,
                                                        PCM_DEC* pTimeData, const INT timeDataSize,
                                                        const int timeDataChannelOffset) {
@@ -2976,6 +3307,15 @@ LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_DecodeFrame(HANDLE_AACDECODER self, c
       Reverse_chMapping[c] = d;
     }
 
+    /* The inverse transforms are collected in a job list and executed after all channels have
+     * been prepared. This allows to distribute them on the worker pool (see AAC_DECODER_THREADS).
+     */
+    CAacDecoder_ChannelJobList jobList;
+    int robustnessFail = 0;
+    jobList.self = self;
+    jobList.numJobs = 0;
+    jobList.usedChannelMask = 0;
+
     int el;
     int el_channels;
     streamIndex = 0;
@@ -3030,7 +3370,8 @@ LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_DecodeFrame(HANDLE_AACDECODER self, c
         }
         /* Robustness check */
         if (c >= aacChannels) {
-          return AAC_DEC_UNKNOWN;
+          robustnessFail = 1;
+          break;
         }
 
         CAacDecoderChannelInfo* pAacDecoderChannelInfo = self->pAacDecoderChannelInfo[c];
@@ -3040,6 +3381,11 @@ LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_DecodeFrame(HANDLE_AACDECODER self, c
         /* Setup offset for time buffer traversal. */
         offset = Reverse_chMapping[c] * timeDataChannelOffset;
 
+        /* Keep the write order if an output channel is addressed more than once. */
+        if (jobList.usedChannelMask & ((UINT)1 << Reverse_chMapping[c])) {
+          CAacDecoder_RunChannelJobs(self, &jobList, CConceal_TDFading_Applied, aacChannels);
+        }
+
         if (self->flags[streamIndex] & AC_MPEGH3DA) {
           /* Clear audio data for sub streams which are currently not available. */
           if (transportDec_GetAuBitsTotal(self->hInput, streamIndex) <= 0 &&
@@ -3097,46 +3443,40 @@ LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_DecodeFrame(HANDLE_AACDECODER self, c
           ErrorStatus = AAC_DEC_OUTPUT_BUFFER_TOO_SMALL;
           break;
         }
+        CAacDecoder_ChannelJob* pJob = &jobList.job[jobList.numJobs++];
+        jobList.usedChannelMask |= (UINT)1 << Reverse_chMapping[c];
+        pJob->pAacDecoderChannelInfo = pAacDecoderChannelInfo;
+        pJob->pAacDecoderStaticChannelInfo = pAacDecoderStaticChannelInfo;
+        pJob->pTimeData = pTimeData + offset;
+        pJob->elFlags = self->elFlags[el];
+        pJob->elCh = elCh;
+        pJob->channel = c;
+        pJob->frameOk = (self->frameOK && !(flags & AACDEC_CONCEAL) && !frameOk_butConceal);
+        pJob->applyImdct = 0;
+        pJob->applyLtpPost = 0;
+
         if (self->flushStatus && (self->flushCnt > 0) && !(flags & AACDEC_CONCEAL)) {
           FDKmemclear(pTimeData + offset, sizeof(PCM_DEC) * self->streamInfo.aacSamplesPerFrame);
         } else
           switch (pAacDecoderChannelInfo->renderMode) {
             case AACDEC_RENDER_IMDCT:
-
-              CBlock_FrequencyToTime(
-                  pAacDecoderStaticChannelInfo, pAacDecoderChannelInfo, pTimeData + offset,
-                  self->streamInfo.aacSamplesPerFrame,
-                  (self->frameOK && !(flags & AACDEC_CONCEAL) && !frameOk_butConceal),
-                  pAacDecoderChannelInfo->pComStaticData->pWorkBufferCore1->mdctOutTemp,
-                  self->aacOutDataHeadroom, self->elFlags[el], elCh);
-              if (self->flags[streamIndex] & AC_MPEGH3DA) {
-                ltp_post(pTimeData + offset, self->streamInfo.aacSamplesPerFrame,
-                         self->streamInfo.aacSampleRate, pAacDecoderStaticChannelInfo->ltp_param,
-                         &(pAacDecoderStaticChannelInfo->ltp_pitch_int_past),
-                         &(pAacDecoderStaticChannelInfo->ltp_pitch_fr_past),
-                         &(pAacDecoderStaticChannelInfo->ltp_gain_past),
-                         &(pAacDecoderStaticChannelInfo->ltp_gainIdx_past),
-                         pAacDecoderStaticChannelInfo->ltp_mem_in,
-                         pAacDecoderStaticChannelInfo->ltp_mem_out);
-              }
-
+              pJob->applyImdct = 1;
+              pJob->applyLtpPost = (self->flags[streamIndex] & AC_MPEGH3DA) ? 1 : 0;
               break;
             default:
               ErrorStatus = AAC_DEC_UNKNOWN;
               break;
           }
-        /* TimeDomainFading */
-        if (!CConceal_TDFading_Applied[c]) {
-          CConceal_TDFading_Applied[c] = CConcealment_TDFading(
-              self->streamInfo.aacSamplesPerFrame, &self->pAacDecoderStaticChannelInfo[c],
-              self->aacOutDataHeadroom, pTimeData + offset, 0);
-          if (c + 1 < (28) && c < aacChannels - 1) {
-            /* update next TDNoise Seed to avoid muting in case of Parametric Stereo */
-            self->pAacDecoderStaticChannelInfo[c + 1]->concealmentInfo.TDNoiseSeed =
-                self->pAacDecoderStaticChannelInfo[c]->concealmentInfo.TDNoiseSeed;
-          }
-        }
       }
+      if (robustnessFail) {
+        break;
+      }
+    }
+
+    CAacDecoder_RunChannelJobs(self, &jobList, CConceal_TDFading_Applied, aacChannels);
+
+    if (robustnessFail) {
+      return AAC_DEC_UNKNOWN;
     }
   }
 
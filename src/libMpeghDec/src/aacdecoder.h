@@ -122,6 +122,8 @@ amm-info@iis.fraunhofer.de
 
 #include "uiManager.h"
 
+#include "FDK_workerPool.h"
+
 #define TIME_DATA_FLUSH_SIZE (128)
 #define TIME_DATA_FLUSH_SIZE_SF (7)
 #define AACDEC_MAX_NUM_PREROLL_AU_MPEGH (1)
@@ -260,6 +262,7 @@ struct AAC_DECODER_INSTANCE {
       pAacDecoderStaticChannelInfo[(28)]; /*!< Persistent channel memory */
 
   FIXP_DBL* workBufferCore2;
+  INT workBufferCore2Size; /*!< Size of workBufferCore2 in bytes. */
   PCM_DEC* pTimeData2;
   INT timeData2Size;
 
@@ -308,6 +311,10 @@ struct AAC_DECODER_INSTANCE {
                        Value 0 means no rendering process. See table 95 for indexes from 1 to 19. */
   INT targetLayout_config; /*!< Applied Target layout index which can be either equal targetLayout
                               or referenceLayout (if targetLayout is 0). */
+  UCHAR vbapGainGrid; /*!< Pan point sources of the enhanced object renderer with a precomputed
+                         gain grid (see ::AAC_VBAP_GAIN_GRID). */
+  const UCHAR* pRendererSetup; /*!< Renderer setup data provided by the user, or NULL. */
+  UINT rendererSetupSize;      /*!< Size of the renderer setup data in bytes. */
   IIS_FORMATCONVERTER_HANDLE pFormatConverter[TPDEC_MAX_TRACKS]; /*!< Format converter instances. */
   INT downmixId;
 
@@ -365,6 +372,21 @@ struct AAC_DECODER_INSTANCE {
       24)][TD_STATES_MEM_SIZE]; /*!< MPEG-H sample rate converter for upsampling to output sample
                                    rate */
   EarconDecoder earconDecoder;
+
+  HANDLE_FDK_WORKER_POOL hWorkerPool; /*!< Worker pool for parallel inverse transforms, NULL in
+                                           single-threaded mode. */
+  FIXP_DBL* pWorkerMdctOutTemp; /*!< IMDCT scratch of 1024 samples for each additional worker. */
+
+  HANDLE_AAC_DECODER_SCRATCH_POOL hScratchPool; /*!< Shared scratch memory, NULL if the instance
+                                                     owns its scratch memory. */
+};
+
+/* Scratch memory which can be shared by several decoder instances */
+struct AAC_DECODER_SCRATCH_POOL {
+  CWorkBufferCore1* pWorkBufferCore1;
+  FIXP_DBL* pWorkBufferCore2;
+  PCM_DEC* pWorkBufferCore5;
+  FIXP_DBL* pWorkBufferCore6;
 };
 
 #define AAC_DEBUG_EXTHLP \
@@ -469,6 +491,20 @@ LINKSPEC_H AAC_DECODER_ERROR CAacDecoder_PreRollExtensionPayloadParse(HANDLE_AAC
 /* Destroy aac decoder */
 LINKSPEC_H void CAacDecoder_Close(HANDLE_AACDECODER self);
 
+/* Set number of threads used for the inverse transforms (0 or 1: single-threaded) */
+LINKSPEC_H AAC_DECODER_ERROR CAacDecoder_SetNumThreads(HANDLE_AACDECODER self,
+                                                      const INT numThreads);
+
+/* Allocate scratch memory to be shared by several decoder instances */
+LINKSPEC_H HANDLE_AAC_DECODER_SCRATCH_POOL CAacDecoder_OpenScratchPool(void);
+
+/* Free shared scratch memory */
+LINKSPEC_H void CAacDecoder_CloseScratchPool(HANDLE_AAC_DECODER_SCRATCH_POOL hPool);
+
+/* Switch between shared (hPool != NULL) and private scratch memory before the first config */
+LINKSPEC_H AAC_DECODER_ERROR CAacDecoder_SetScratchPool(HANDLE_AACDECODER self,
+                                                       HANDLE_AAC_DECODER_SCRATCH_POOL hPool);
+
 /* get streaminfo handle from decoder */
 LINKSPEC_H CStreamInfo* CAacDecoder_GetStreamInfo(HANDLE_AACDECODER self);
 
@@ -876,6 +876,7 @@ aacDecoder_SetParam(const HANDLE_AACDECODER self, /*!< Handle of the decoder ins
       self->streamInfo.numLostAccessUnits = 0;
       self->streamInfo.numBadBytes = 0;
       self->streamInfo.numTotalBytes = 0;
+      self->streamInfo.numSkippedBytes = 0;
       /* aacDecoder_SignalInterruption(self); */
       break;
     case AAC_TPDEC_PARAM_SET_BITRATE:
@@ -942,6 +943,17 @@ aacDecoder_SetParam(const HANDLE_AACDECODER self, /*!< Handle of the decoder ins
           );
       break;
 
+    case AAC_DECODER_THREADS:
+      errorStatus = CAacDecoder_SetNumThreads(self, value);
+      break;
+
+    case AAC_VBAP_GAIN_GRID:
+      if (value < 0 || value > 1) {
+        return AAC_DEC_SET_PARAM_FAIL;
+      }
+      self->vbapGainGrid = (UCHAR)value;
+      break;
+
     default:
       return AAC_DEC_SET_PARAM_FAIL;
   } /* switch(param) */
@@ -1129,6 +1141,37 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_Fill(HANDLE_AACDECODER self, const UCH
   return errorStatus;
 }
 
+LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_BindInput(HANDLE_AACDECODER self,
+                                                    const UCHAR* const pBuffer[],
+                                                    const UINT bufferSize[], UINT* pBytesValid) {
+  if (self == NULL) {
+    return AAC_DEC_INVALID_HANDLE;
+  }
+  if ((pBuffer == NULL) || (bufferSize == NULL) || (pBytesValid == NULL)) {
+    return AAC_DEC_INVALID_PARAM;
+  }
+  if (self->nrOfLayers != 1) {
+    return aacDecoder_Fill(self, pBuffer, bufferSize, pBytesValid);
+  }
+
+  if (transportDec_BindData(self->hInput, pBuffer[0], bufferSize[0], &pBytesValid[0], 0) !=
+      TRANSPORTDEC_OK) {
+    return AAC_DEC_UNKNOWN; /* Must be an internal error */
+  }
+
+  return AAC_DEC_OK;
+}
+
+LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_ReleaseInput(HANDLE_AACDECODER self) {
+  if (self == NULL) {
+    return AAC_DEC_INVALID_HANDLE;
+  }
+
+  transportDec_ReleaseData(self->hInput);
+
+  return AAC_DEC_OK;
+}
+
 static void aacDecoder_SignalInterruption(HANDLE_AACDECODER self) {
   CAacDecoder_SignalInterruption(self);
 
@@ -1225,6 +1268,11 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER self, IN
 
     for (layer = 0; layer < self->nrOfLayers; layer++) {
       err = transportDec_ReadAccessUnit(self->hInput, layer);
+      {
+        INT nSkipped;
+        transportDec_GetSkippedByteCount(&nSkipped, self->hInput);
+        self->streamInfo.numSkippedBytes += nSkipped;
+      }
       if (err != TRANSPORTDEC_OK) {
         switch (err) {
           case TRANSPORTDEC_NOT_ENOUGH_BITS:
@@ -1327,8 +1375,17 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER self, IN
     }
 
     /* Clearing core data will be done in CAacDecoder_DecodeFrame() below.
-       Tell other modules to clear states if required. */
+       Tell other modules to clear states if required. The history is cleared before the first
+       access unit only, the pre-roll access units of an IPF rebuild it. */
+    UINT auFlags = flags;
     if (flags & AACDEC_CLRHIST) {
+      if (accessUnit == 0) {
+        FDK_Delay_Clear(&self->mpegH_rendered_delay);
+        FDKmemclear(self->mpegH_sampleRateConverter_filterStates,
+                    sizeof(self->mpegH_sampleRateConverter_filterStates));
+      } else {
+        auFlags &= ~AACDEC_CLRHIST;
+      }
     }
 
     /* Empty bit buffer in case of flush request. */
@@ -1338,6 +1395,7 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER self, IN
         self->streamInfo.numLostAccessUnits = 0;
         self->streamInfo.numBadBytes = 0;
         self->streamInfo.numTotalBytes = 0;
+        self->streamInfo.numSkippedBytes = 0;
       }
     }
     /* Reset the output delay field. The modules will add their figures one after another. */
@@ -1360,7 +1418,7 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER self, IN
 
     ErrorStatus = CAacDecoder_DecodeFrame(
         self,
-        flags | (fTpConceal ? AACDEC_CONCEAL : 0) |
+        auFlags | (fTpConceal ? AACDEC_CONCEAL : 0) |
             ((self->flushStatus && !(flags & AACDEC_CONCEAL)) ? AACDEC_FLUSH : 0),
         pTimeData2 + 256, timeData2Size - 256, self->streamInfo.aacSamplesPerFrame + 256);
 
@@ -1628,9 +1686,13 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER self, IN
           /* Apply object rendering on the object signal group */
           if (self->pUsacConfig[streamIndex]->m_signalGroupType[grp].type == 1 &&
               self->hgVBAPRenderer[numObjGroup] != NULL) {
-            gVBAPRenderer_RenderFrame_Time(self->hgVBAPRenderer[numObjGroup],
-                                           pTimeData_in + signalOffset, self->workBufferCore2, 256,
-                                           self->streamInfo.frameSize + 256);
+            /* Individual objects of the group may be switched off */
+            gVBAPRenderer_RenderFrame_Time(
+                self->hgVBAPRenderer[numObjGroup], pTimeData_in + signalOffset,
+                self->workBufferCore2, 256, self->streamInfo.frameSize + 256,
+                &self->signalSkipped[self->pUsacConfig[streamIndex]->m_signalGroupType[grp]
+                                         .firstSigIdx +
+                                     signalsPrevStreams]);
             numObjGroup++;
           }
           /* Increment for active signals */
@@ -2146,3 +2208,47 @@ LINKSPEC_CPP void aacDecoder_Close(HANDLE_AACDECODER self) {
 LINKSPEC_CPP CStreamInfo* aacDecoder_GetStreamInfo(HANDLE_AACDECODER self) {
   return CAacDecoder_GetStreamInfo(self);
 }
+
+LINKSPEC_CPP HANDLE_AAC_DECODER_SCRATCH_POOL aacDecoder_OpenScratchPool(void) {
+  return CAacDecoder_OpenScratchPool();
+}
+
+LINKSPEC_CPP void aacDecoder_CloseScratchPool(HANDLE_AAC_DECODER_SCRATCH_POOL hPool) {
+  CAacDecoder_CloseScratchPool(hPool);
+}
+
+LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_SetScratchPool(HANDLE_AACDECODER self,
+                                                        HANDLE_AAC_DECODER_SCRATCH_POOL hPool) {
+  return CAacDecoder_SetScratchPool(self, hPool);
+}
+
+LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_SetRendererSetup(HANDLE_AACDECODER self,
+                                                          const UCHAR* setup,
+                                                          const UINT setupSize) {
+  if (self == NULL) {
+    return AAC_DEC_INVALID_HANDLE;
+  }
+
+  self->pRendererSetup = setup;
+  self->rendererSetupSize = (setup != NULL) ? setupSize : 0;
+
+  return AAC_DEC_OK;
+}
+
+LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_GetRendererSetup(HANDLE_AACDECODER self, UCHAR* setup,
+                                                          const UINT setupSize, UINT* setupUsed) {
+  if (self == NULL || setupUsed == NULL) {
+    return AAC_DEC_INVALID_HANDLE;
+  }
+
+  *setupUsed = 0;
+  for (int i = 0; i < TP_MPEGH_MAX_SIGNAL_GROUPS; i++) {
+    if (self->hgVBAPRenderer[i] != NULL) {
+      if (gVBAPRenderer_AppendSetup(self->hgVBAPRenderer[i], setup, setupSize, setupUsed) != 0) {
+        return AAC_DEC_OUTPUT_BUFFER_TOO_SMALL;
+      }
+    }
+  }
+
+  return AAC_DEC_OK;
+}
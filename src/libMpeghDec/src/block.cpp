@@ -1324,7 +1324,7 @@ void CBlock_FrequencyToTime(CAacDecoderStaticChannelInfo* pAacDecoderStaticChann
 
   {
     {
-      FIXP_DBL* tmp = pAacDecoderChannelInfo->pComStaticData->pWorkBufferCore1->mdctOutTemp;
+      FIXP_DBL* tmp = pWorkBuffer1;
 #if defined(FDK_ASSERT_ENABLE)
       nSamples =
 #endif
@@ -92,7 +92,16 @@ amm-info@iis.fraunhofer.de
 #include "genericStds.h"
 
 int deque_alloc(deque* q, unsigned int length, unsigned int block_size) {
-  q->data = (void*)FDKcalloc(length, block_size);
+  return deque_alloc_linear(q, length, block_size, 0);
+}
+
+int deque_alloc_linear(deque* q, unsigned int length, unsigned int block_size,
+                       unsigned int maxLinear) {
+  if (maxLinear > length) {
+    return -1;
+  }
+  /* The elements behind the end of the ring mirror the wrapped around part of linear accesses. */
+  q->data = (void*)FDKcalloc(length + maxLinear, block_size);
   if (q->data == NULL) {
     return -1;
   }
@@ -102,6 +111,7 @@ int deque_alloc(deque* q, unsigned int length, unsigned int block_size) {
   q->last = 0;
   q->size = 0;
   q->max = length;
+  q->maxLinear = maxLinear;
   q->full = 0;
   return 0;
 }
@@ -196,6 +206,61 @@ int deque_bulk_push_back_zeros(deque* q, unsigned int numZeros) {
   return 0;
 }
 
+void* deque_bulk_push_back_reserve(deque* q, unsigned int numData) {
+  if (numData > q->maxLinear || q->size + numData > q->max) {
+    return NULL;
+  }
+  return (unsigned char*)q->data + q->last * q->block_size;
+}
+
+int deque_bulk_push_back_commit(deque* q, unsigned int numData) {
+  if (numData > q->maxLinear || q->size + numData > q->max) {
+    return -1;
+  }
+
+  if (q->last + numData > q->max) {
+    /* move the part written behind the end of the ring to its start */
+    FDKmemcpy(q->data, (unsigned char*)q->data + q->max * q->block_size,
+              (q->last + numData - q->max) * q->block_size);
+  }
+  q->last = (q->last + numData) % q->max;
+  q->size += numData;
+  if (q->size == q->max) {
+    q->full = true;
+  }
+  return 0;
+}
+
+int deque_bulk_move(deque* dst, deque* src, unsigned int numData) {
+  if (src->size < numData || dst->size + numData > dst->max ||
+      src->block_size != dst->block_size) {
+    return -1;
+  }
+
+  unsigned int left = numData;
+  while (left > 0) {
+    unsigned int toCopy = left;
+    if (toCopy > src->max - src->first) {
+      toCopy = src->max - src->first;
+    }
+    if (toCopy > dst->max - dst->last) {
+      toCopy = dst->max - dst->last;
+    }
+    FDKmemcpy((unsigned char*)dst->data + dst->last * dst->block_size,
+              (unsigned char*)src->data + src->first * src->block_size, toCopy * src->block_size);
+    src->first = (src->first + toCopy) % src->max;
+    dst->last = (dst->last + toCopy) % dst->max;
+    left -= toCopy;
+  }
+  src->size -= numData;
+  src->full = false;
+  dst->size += numData;
+  if (dst->size == dst->max) {
+    dst->full = true;
+  }
+  return 0;
+}
+
 void* deque_pop_back(deque* q) {
   if (q->size == 0) {
     return NULL;
@@ -258,6 +323,19 @@ int deque_bulk_pop_front(deque* q, unsigned int numData) {
   return 0;
 }
 
+void* deque_bulk_front_linear(deque* q, unsigned int numData) {
+  if (q->size < numData || numData > q->maxLinear) {
+    return NULL;
+  }
+
+  if (q->first + numData > q->max) {
+    /* mirror the wrapped around part behind the end of the ring */
+    FDKmemcpy((unsigned char*)q->data + q->max * q->block_size, q->data,
+              (q->first + numData - q->max) * q->block_size);
+  }
+  return (unsigned char*)q->data + q->first * q->block_size;
+}
+
 bool deque_full(const deque* q) {
   return (q->full) ? true : false;
 }
@@ -291,6 +369,20 @@ void* deque_at(const deque* q, unsigned int index) {
   return data;
 }
 
+void* deque_at_linear(const deque* q, unsigned int index, unsigned int* numLinear) {
+  if (index >= q->size) {
+    *numLinear = 0;
+    return NULL;
+  }
+
+  const unsigned int pos = (q->first + index) % q->max;
+  *numLinear = q->size - index;
+  if (*numLinear > q->max - pos) {
+    *numLinear = q->max - pos;
+  }
+  return (unsigned char*)q->data + pos * q->block_size;
+}
+
 void* deque_front(const deque* q) {
   return deque_at(q, 0);
 }
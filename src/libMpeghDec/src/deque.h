@@ -104,11 +104,18 @@ typedef struct ring_buf {
   unsigned int last;
   unsigned int size;
   unsigned int max;
+  unsigned int maxLinear; /* max. number of elements which can be accessed linearly */
   bool full;
 } deque;
 
 int deque_alloc(deque* queue, unsigned int length, unsigned int block_size);
 
+/* Allocate a queue which additionally supports linear access to up to maxLinear elements at its
+ * front (deque_bulk_front_linear) and back (deque_bulk_push_back_reserve) without copying the
+ * data out of the ring. */
+int deque_alloc_linear(deque* queue, unsigned int length, unsigned int block_size,
+                       unsigned int maxLinear);
+
 void deque_free(deque* queue);
 
 int deque_push_back(deque* queue, void* data);
@@ -117,6 +124,15 @@ int deque_bulk_push_back(deque* q, void* data, unsigned int numData);
 
 int deque_bulk_push_back_zeros(deque* q, unsigned int numZeros);
 
+/* Return a linear write buffer for up to numData elements at the back of the queue. The elements
+ * are appended by deque_bulk_push_back_commit(). Returns NULL if not enough space is left. */
+void* deque_bulk_push_back_reserve(deque* q, unsigned int numData);
+
+int deque_bulk_push_back_commit(deque* q, unsigned int numData);
+
+/* Move numData elements from the front of src to the back of dst. */
+int deque_bulk_move(deque* dst, deque* src, unsigned int numData);
+
 void* deque_pop_back(deque* queue);
 
 void* deque_pop_front(deque* queue);
@@ -125,6 +141,10 @@ int deque_bulk_pop_front_copy(deque* q, void* destination, unsigned int numData)
 
 int deque_bulk_pop_front(deque* q, unsigned int numData);
 
+/* Return a linear read pointer to the first numData elements. The pointer is valid until the
+ * queue is modified. Returns NULL if less than numData elements are available. */
+void* deque_bulk_front_linear(deque* q, unsigned int numData);
+
 bool deque_full(const deque* queue);
 
 bool deque_empty(const deque* queue);
@@ -137,6 +157,11 @@ void deque_clear(deque* queue);
 
 void* deque_at(const deque* queue, unsigned int index);
 
+/* Return a pointer to the element at index and the number of elements from index on which are
+ * stored linearly, i.e. up to the back of the queue or the end of the ring. Returns NULL if index
+ * is out of range. */
+void* deque_at_linear(const deque* queue, unsigned int index, unsigned int* numLinear);
+
 void* deque_front(const deque* queue);
 
 void* deque_back(const deque* queue);
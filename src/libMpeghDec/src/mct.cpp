@@ -200,6 +200,13 @@ static const FIXP_SPK tabIndexToCosSinAlpha[CODE_BOOK_BETA_LAV] = {
 /* Include platform specific implementations */
 #if defined(__arm__)
 #include "arm/mct_arm.cpp"
+#elif defined(__x86__)
+#include "x86/mct_x86.cpp"
+#endif
+
+#ifndef mct_func_enabled
+/* Platform specific functions may depend on CPU features detected at runtime */
+#define mct_func_enabled() 1
 #endif
 
 static inline WHITENING_LEVEL GetTileWhiteningLevel(IGF_PRIVATE_DATA_HANDLE hPrivateData,
@@ -805,27 +812,29 @@ static void applyMctRotationIdx(FIXP_DBL* dmx, SHORT* dmxExp, FIXP_DBL* res, SHO
     /*Do nothing*/
   } else {
 #ifdef FUNCTION_applyMctRotationIdx_func1
-    applyMctRotationIdx_func1(dmx, dmxExp, res, resExp, (INT)OutExp, nSamples, SinAlpha, CosAlpha,
-                              (INT)lScale, (INT)rScale);
-#else
-
-    for (int n = 0; n < nSamples; n++) {
-      FIXP_DBL temp_dmx = dmx[n];
-      FIXP_DBL temp_res = res[n];
-      dmx[n] =
-          (fMultDiv2(temp_dmx, CosAlpha) >> lScale) - (fMultDiv2(temp_res, SinAlpha) >> rScale);
-      res[n] =
-          (fMultDiv2(temp_dmx, SinAlpha) >> lScale) + (fMultDiv2(temp_res, CosAlpha) >> rScale);
-    }
+    if (mct_func_enabled()) {
+      applyMctRotationIdx_func1(dmx, dmxExp, res, resExp, (INT)OutExp, nSamples, SinAlpha,
+                                CosAlpha, (INT)lScale, (INT)rScale);
+    } else
+#endif
+    {
+      for (int n = 0; n < nSamples; n++) {
+        FIXP_DBL temp_dmx = dmx[n];
+        FIXP_DBL temp_res = res[n];
+        dmx[n] =
+            (fMultDiv2(temp_dmx, CosAlpha) >> lScale) - (fMultDiv2(temp_res, SinAlpha) >> rScale);
+        res[n] =
+            (fMultDiv2(temp_dmx, SinAlpha) >> lScale) + (fMultDiv2(temp_res, CosAlpha) >> rScale);
+      }
 
-    int headroom = getScalefactor(dmx, nSamples) - 1;
-    scaleValues(dmx, nSamples, headroom);
-    *dmxExp = OutExp - headroom;
+      int headroom = getScalefactor(dmx, nSamples) - 1;
+      scaleValues(dmx, nSamples, headroom);
+      *dmxExp = OutExp - headroom;
 
-    headroom = getScalefactor(res, nSamples) - 1;
-    scaleValues(res, nSamples, headroom);
-    *resExp = OutExp - headroom;
-#endif
+      headroom = getScalefactor(res, nSamples) - 1;
+      scaleValues(res, nSamples, headroom);
+      *resExp = OutExp - headroom;
+    }
   }
 }
 #endif /* #ifndef FUNCTION_applyMctRotationIdx */
@@ -90,24 +90,43 @@ amm-info@iis.fraunhofer.de
 
 #include <math.h>
 
+#include <atomic>
+#include <new>
+#if defined(FDK_HAVE_THREADS)
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
 #include "FDK_cicp2geometry.h"
 #include "aacdecoder_lib.h"
 #include "deque.h"
 #include "mpeghdecoder.h"
+#include "pcm_utils.h"
 
 // The following threshold determines the maximally allowed time difference (in milliseconds) of
 // two consecutively provided MPEG-H frames. If this threshold is exceeded the decoding process
 // will be restarted, i.e. the decoding core will be reset to its initial start-up state.
-#define THRESHOLD 200000000  // 200 milliseconds ~ 9.375 frames of 1024 samples at 48kHz
+#define DEFAULT_DISCONTINUITY_THRESHOLD (200)  // ~ 9.375 frames of 1024 samples at 48kHz
+#define MAX_DISCONTINUITY_THRESHOLD (60000)
 
 #define TIMESTAMP_ARRAY_SIZE (10)
 #define FADE_ARRAY_SIZE (10)
 #define NUM_FADE_SAMPLES_PER_CHANNEL (128)
 
 #define MAX_NUM_FRAME_SAMPLES (3072)
-#define MAX_NUM_OUTPUT_CHANNELS (24)
 
-#define TOLERANCE (5)
+#define DEFAULT_TIMING_TOLERANCE (5)
+
+// threaded mode: the input data is queued in chunks of THREADED_INPUT_SLOT_BYTES, larger access
+// units occupy several consecutive slots
+#define THREADED_NUM_INPUT_SLOTS (TIMESTAMP_ARRAY_SIZE)
+#define THREADED_INPUT_SLOT_BYTES (16384)
+#define THREADED_NUM_OUTPUT_SLOTS (TIMESTAMP_ARRAY_SIZE)
+// upper bound for the wait of the worker on a full frame ring; the consumer wakes it without the
+// worker lock, so its wakeup can be lost while the worker goes to sleep
+#define THREADED_WORKER_SLOT_WAIT_MS (5)
 
 #define DEFAULT_DRC_SETTING_TARGET_REFERENCE_LEVEL (96)
 #define DEFAULT_DRC_SETTING_EFFECT_TYPE (0)
@@ -127,11 +146,61 @@ typedef struct OutputInfo {
   int outputLoudness;
 } OutputInfo;
 
+typedef struct FadeIndexes {
+  int idx[FADE_ARRAY_SIZE]; /* Start indexes of pending fades within the output samples queue. */
+  int num;
+} FadeIndexes;
+
+typedef struct ThreadedInput {
+  uint8_t* data;
+  uint32_t length;  // 0 requests a flush of the decoder
+  uint64_t timestamp;
+} ThreadedInput;
+
+typedef struct ThreadedOutput {
+  INT_PCM* samples;
+  MPEGH_DECODER_OUTPUT_INFO info;
+} ThreadedOutput;
+
+// State of the threaded mode. The input ring and the frame ring are single-producer/single-
+// consumer rings indexed by free-running counters; a slot is owned by the producer until the write
+// counter is advanced past it and by the consumer until the read counter is advanced past it.
+typedef struct MPEGH_DECODER_THREADED {
+  int mode;
+
+  // written by mpeghdecoder_process()
+  ThreadedInput input[THREADED_NUM_INPUT_SLOTS];
+  std::atomic<unsigned int> inputWrite;
+
+  // written by the worker
+  std::atomic<unsigned int> inputRead;
+  std::atomic<int> error; /* First error of the asynchronous decoding. */
+  ThreadedOutput output[THREADED_NUM_OUTPUT_SLOTS];
+  std::atomic<unsigned int> outputWrite;
+
+  uint8_t* inputData;
+  INT_PCM* outputData;
+
+#if defined(FDK_HAVE_THREADS)
+  std::thread worker;
+  std::mutex lock;
+  std::condition_variable cvWork; /* Signals new input, a free frame slot or shutdown to the
+                                     internal worker. */
+  bool shutdown;
+  std::atomic<bool> workerWaitsForSlot; /* The worker sleeps on a full frame ring. */
+#endif
+
+  // written by the getSamples functions
+  std::atomic<unsigned int> outputRead;
+  bool outputBorrowed; /* The front frame is borrowed by mpeghdecoder_getSamplesView(). */
+} MPEGH_DECODER_THREADED;
+
 typedef struct MPEGH_DECODER_CONTEXT {
   int sampleRate;
   int numberOfChannels;
   int32_t cicpIndex;
   bool zeroSignal;
+  bool clearHistory; /* Clear the core decoder history with the next decoded frame. */
 
   HANDLE_AACDECODER mpeghdec;
   INT_PCM* tmpSamples;
@@ -139,6 +208,9 @@ typedef struct MPEGH_DECODER_CONTEXT {
   uint8_t* mhaConfig;
   uint32_t mhaConfigLength;
 
+  uint8_t* rendererSetup; /* Renderer setup data (set by user), or NULL. */
+  uint32_t rendererSetupLength;
+
   deque timestampInQueue;
   deque timestampOutQueue;
 
@@ -148,12 +220,17 @@ typedef struct MPEGH_DECODER_CONTEXT {
   deque outputInfoQueue;
   deque outputSamplesQueue;
 
-  deque fadeoutIdxQueue;
-  deque fadeinIdxQueue;
+  FadeIndexes fadeoutIdx;
+  FadeIndexes fadeinIdx;
+
+  float* fadeRamps;      /* Fade-in ramp followed by fade-out ramp of fadeRampLength each. */
+  int fadeRampLength;    /* Number of interleaved samples of each ramp, or 0 if not computed. */
+  int fadeRampCapacity;  /* Allocated length of each ramp. */
 
   uint64_t frameNumber;
 
   unsigned int maxDecoderOutputSamples;
+  unsigned int viewNumSamples; /* Size of the frame borrowed by mpeghdecoder_getSamplesView(). */
 
   bool drcUpdate;
   /* Desired DRC values (set by user). */
@@ -169,13 +246,45 @@ typedef struct MPEGH_DECODER_CONTEXT {
   int lastDrcBoostFactor;
   int lastDrcAttFactor;
   int lastDrcAlbumMode;
+
+  uint64_t discontinuityThreshold; /* Timestamp difference in ns causing a restart (set by user). */
+  int timingTolerance;             /* Accepted length difference in samples (set by user). */
+  int gapFillMode;                 /* MPEGH_DECODER_GAP_FILL_MODE (set by user). */
+  int lastAuSize; /* Samples per channel of the last decoded access unit, or 0. */
+
+  int decoderThreads; /* Number of core decoder threads (set by user). */
+  int outputFormat;   /* Output format of mpeghdecoder_getSamplesFormatted() (set by user). */
+  int vbapGainGrid;   /* Gain grid panning of point source objects (set by user). */
+
+  FDK_MEM_ARENA* arena; /* Memory arena holding the instance, or NULL. */
+
+  HANDLE_AAC_DECODER_SCRATCH_POOL scratchPool; /* Shared core decoder scratch memory, or NULL. */
+
+  MPEGH_DECODER_THREADED* threaded; /* State of the threaded mode, or NULL if it is off. */
 } MPEGH_DECODER_CONTEXT;
 
+typedef struct MPEGH_DECODER_SCRATCH_POOL {
+  HANDLE_AAC_DECODER_SCRATCH_POOL hAacPool;
+} MPEGH_DECODER_SCRATCH_POOL;
+
 /*
  * Method:    fade
- * called to fadein/fadeout a signal
+ * called to multiply a contiguous block of samples with a fadein/fadeout ramp
+ */
+static void fade(int32_t* samples, const float* ramp, int length);
+
+/*
+ * Method:    updateFadeRamps
+ * called to compute the fadein/fadeout ramps for the current number of channels
  */
-static void fade(int32_t* sample, int index, int fadelen, bool fadein);
+static MPEGH_DECODER_ERROR updateFadeRamps(HANDLE_MPEGH_DECODER_CONTEXT hCtx, int fadelen);
+
+/*
+ * Method:    applyFades
+ * called to apply all pending fades whose samples are completely available
+ */
+static void applyFades(HANDLE_MPEGH_DECODER_CONTEXT hCtx, FadeIndexes* fades, const float* ramp,
+                       int fadelen);
 
 /*
  * Method:    clearQueues
@@ -189,12 +298,140 @@ static void clearQueues(HANDLE_MPEGH_DECODER_CONTEXT hCtx);
  */
 static MPEGH_DECODER_ERROR restartDecoder(HANDLE_MPEGH_DECODER_CONTEXT hCtx);
 
+/*
+ * Method:    reopenDecoder
+ * called by restartDecoder with the memory arena of the instance activated
+ */
+static MPEGH_DECODER_ERROR reopenDecoder(HANDLE_MPEGH_DECODER_CONTEXT hCtx);
+
 static void updateDrcSettings(HANDLE_MPEGH_DECODER_CONTEXT hCtx);
 
+/*
+ * Method:    concealGap
+ * called to fill the gap between two timestamps with concealed frames of the core decoder
+ */
+static void concealGap(HANDLE_MPEGH_DECODER_CONTEXT hCtx, uint64_t lastTimestamp,
+                       uint64_t timestamp);
+
+/*
+ * Method:    prepareOutputFrame
+ * called to apply the timing correction and fading for the next output frame
+ */
+static MPEGH_DECODER_ERROR prepareOutputFrame(HANDLE_MPEGH_DECODER_CONTEXT hCtx,
+                                              MPEGH_DECODER_OUTPUT_INFO* outInfo,
+                                              unsigned int* outNumSamples);
+
+/*
+ * Method:    adjustFadeIndexes
+ * called after an output frame was removed from the output samples queue
+ */
+static void adjustFadeIndexes(HANDLE_MPEGH_DECODER_CONTEXT hCtx, int outNumSamples);
+
+static inline void pushFadeIndex(FadeIndexes* fades, int idx) {
+  if (fades->num < FADE_ARRAY_SIZE) {
+    fades->idx[fades->num++] = idx;
+  }
+}
+
+/*
+ * Method:    decodeAccessUnit
+ * called to feed and decode input data and to queue the decoded samples
+ */
+static MPEGH_DECODER_ERROR decodeAccessUnit(HANDLE_MPEGH_DECODER_CONTEXT hCtx,
+                                            const uint8_t* inData, uint32_t inLength,
+                                            uint64_t timestamp);
+
+/*
+ * Method:    decodeAccessUnitFrames
+ * called by decodeAccessUnit() and for every access unit of mpeghdecoder_processBatch() after the
+ * DRC settings were applied; *pStreamInfo is updated if the decoder is restarted
+ */
+static MPEGH_DECODER_ERROR decodeAccessUnitFrames(HANDLE_MPEGH_DECODER_CONTEXT hCtx,
+                                                  const uint8_t* inData, uint32_t inLength,
+                                                  uint64_t timestamp, CStreamInfo** pStreamInfo);
+
+/*
+ * Method:    decodeFlush
+ * called to flush the decoder and to queue the flushed samples
+ */
+static MPEGH_DECODER_ERROR decodeFlush(HANDLE_MPEGH_DECODER_CONTEXT hCtx);
+
+/*
+ * Method:    convertSamples
+ * called to copy an output frame in the format selected with MPEGH_DEC_PARAM_OUTPUT_FORMAT
+ */
+static void convertSamples(HANDLE_MPEGH_DECODER_CONTEXT hCtx, const INT_PCM* pIn, void* outData,
+                           unsigned int outNumSamples, const MPEGH_DECODER_OUTPUT_INFO* outInfo);
+
+/*
+ * Method:    startThreadedMode
+ * called to allocate the rings of the threaded mode and to start the internal worker
+ */
+static MPEGH_DECODER_ERROR startThreadedMode(HANDLE_MPEGH_DECODER_CONTEXT hCtx, int mode);
+
+/*
+ * Method:    stopThreadedMode
+ * called to stop the internal worker and to free the rings of the threaded mode
+ */
+static void stopThreadedMode(HANDLE_MPEGH_DECODER_CONTEXT hCtx);
+
+/*
+ * Method:    threadedQueueInput
+ * called by the feeding thread to queue input data or a flush request (inLength 0)
+ */
+static MPEGH_DECODER_ERROR threadedQueueInput(HANDLE_MPEGH_DECODER_CONTEXT hCtx,
+                                              const uint8_t* inData, uint32_t inLength,
+                                              uint64_t timestamp);
+
+/*
+ * Method:    threadedStep
+ * called by the worker to fill the frame ring and to decode the next queued input chunk
+ */
+static bool threadedStep(HANDLE_MPEGH_DECODER_CONTEXT hCtx);
+
+/*
+ * Method:    threadedFrontFrame
+ * called by the consumer to get the oldest frame of the frame ring, or NULL if it is empty
+ */
+static const INT_PCM* threadedFrontFrame(MPEGH_DECODER_THREADED* th,
+                                         MPEGH_DECODER_OUTPUT_INFO* outInfo,
+                                         unsigned int* pNumSamples);
+
+/*
+ * Method:    threadedPopFrame
+ * called by the consumer to hand the oldest frame of the frame ring back to the worker
+ */
+static void threadedPopFrame(MPEGH_DECODER_THREADED* th);
+
+MPEGH_DECODER_ERROR mpeghdecoder_setAllocator(const MPEGH_DECODER_ALLOCATOR* allocator) {
+  FDK_ALLOCATOR fdkAllocator;
+
+  if (allocator == NULL) {
+    FDKsetAllocator(NULL);
+    return MPEGH_DEC_OK;
+  }
+  if (allocator->alloc == NULL || allocator->free == NULL) {
+    return MPEGH_DEC_NULLPTR_ERROR;
+  }
+
+  fdkAllocator.pAlloc = allocator->alloc;
+  fdkAllocator.pFree = allocator->free;
+  fdkAllocator.pUserData = allocator->userData;
+  FDKsetAllocator(&fdkAllocator);
+
+  return MPEGH_DEC_OK;
+}
+
 HANDLE_MPEGH_DECODER_CONTEXT mpeghdecoder_init(int32_t cicpSetup) {
+  return mpeghdecoder_initWithArena(cicpSetup, NULL, 0);
+}
+
+HANDLE_MPEGH_DECODER_CONTEXT mpeghdecoder_initWithArena(int32_t cicpSetup, void* arena,
+                                                        size_t arenaSize) {
   int dequeError = 0;
   AAC_DECODER_ERROR ErrorStatus;
   int numOutChannels = cicp2geometry_get_numChannels_from_cicp(cicpSetup);
+  FDK_MEM_ARENA* pArena = NULL;
 
   /* Check for allowed target layouts */
   if ((cicpSetup <= 0) || (cicpSetup == 8) || ((cicpSetup > 20) && (cicpSetup < 100)) ||
@@ -202,11 +439,21 @@ HANDLE_MPEGH_DECODER_CONTEXT mpeghdecoder_init(int32_t cicpSetup) {
     return NULL;
   }
 
+  if (arena != NULL) {
+    pArena = FDKinitArena(arena, (arenaSize < (size_t)(UINT)-1) ? (UINT)arenaSize : (UINT)-1);
+    if (pArena == NULL) {
+      return NULL;
+    }
+  }
+  // all memory of the instance, including the context itself, is taken from the arena
+  FDK_MEM_ARENA* pPrevArena = FDKsetThreadArena(pArena);
+
   MPEGH_DECODER_CONTEXT* ctx = (MPEGH_DECODER_CONTEXT*)FDKcalloc(1, sizeof(MPEGH_DECODER_CONTEXT));
   if (ctx == NULL) {
     goto bail;
   }
 
+  ctx->arena = pArena;
   ctx->maxDecoderOutputSamples = numOutChannels * MAX_NUM_FRAME_SAMPLES;
   ctx->tmpSamples = (INT_PCM*)FDKcalloc(ctx->maxDecoderOutputSamples, sizeof(INT_PCM));
   if (ctx->tmpSamples == NULL) {
@@ -241,8 +488,11 @@ HANDLE_MPEGH_DECODER_CONTEXT mpeghdecoder_init(int32_t cicpSetup) {
   if (dequeError < 0) {
     goto bail;
   }
-  dequeError = deque_alloc(&ctx->decodedSamplesQueue,
-                           TIMESTAMP_ARRAY_SIZE * ctx->maxDecoderOutputSamples, sizeof(INT_PCM));
+  // the decoder writes directly into the decoded samples queue and the output frames are handed
+  // out directly from the output samples queue, so both need linear access of one frame
+  dequeError = deque_alloc_linear(&ctx->decodedSamplesQueue,
+                                  TIMESTAMP_ARRAY_SIZE * ctx->maxDecoderOutputSamples,
+                                  sizeof(INT_PCM), ctx->maxDecoderOutputSamples);
   if (dequeError < 0) {
     goto bail;
   }
@@ -250,17 +500,15 @@ HANDLE_MPEGH_DECODER_CONTEXT mpeghdecoder_init(int32_t cicpSetup) {
   if (dequeError < 0) {
     goto bail;
   }
-  dequeError = deque_alloc(&ctx->outputSamplesQueue,
-                           TIMESTAMP_ARRAY_SIZE * ctx->maxDecoderOutputSamples, sizeof(INT_PCM));
-  if (dequeError < 0) {
-    goto bail;
-  }
-  dequeError = deque_alloc(&ctx->fadeoutIdxQueue, FADE_ARRAY_SIZE, sizeof(int));
+  dequeError = deque_alloc_linear(&ctx->outputSamplesQueue,
+                                  TIMESTAMP_ARRAY_SIZE * ctx->maxDecoderOutputSamples,
+                                  sizeof(INT_PCM), ctx->maxDecoderOutputSamples);
   if (dequeError < 0) {
     goto bail;
   }
-  dequeError = deque_alloc(&ctx->fadeinIdxQueue, FADE_ARRAY_SIZE, sizeof(int));
-  if (dequeError < 0) {
+  ctx->fadeRampCapacity = NUM_FADE_SAMPLES_PER_CHANNEL * numOutChannels;
+  ctx->fadeRamps = (float*)FDKaalloc(2 * ctx->fadeRampCapacity * sizeof(float), ALIGNMENT_DEFAULT);
+  if (ctx->fadeRamps == NULL) {
     goto bail;
   }
 
@@ -268,9 +516,14 @@ HANDLE_MPEGH_DECODER_CONTEXT mpeghdecoder_init(int32_t cicpSetup) {
   ctx->numberOfChannels = -1;
 
   ctx->zeroSignal = false;
+  ctx->clearHistory = false;
 
   ctx->frameNumber = 0;
 
+  ctx->discontinuityThreshold = (uint64_t)DEFAULT_DISCONTINUITY_THRESHOLD * 1000000;
+  ctx->timingTolerance = DEFAULT_TIMING_TOLERANCE;
+  ctx->gapFillMode = MPEGH_DEC_GAP_FILL_ZEROS;
+
   ctx->drcUpdate = true;
   /* Desired DRC values (set by user). Initialized to default values to be
    * applied at first processing step. */
@@ -288,19 +541,77 @@ HANDLE_MPEGH_DECODER_CONTEXT mpeghdecoder_init(int32_t cicpSetup) {
   ctx->lastDrcAttFactor = -1;
   ctx->lastDrcAlbumMode = -1;
 
+  FDKsetThreadArena(pPrevArena);
   return ctx;
 
 bail:
   mpeghdecoder_destroy(ctx);
+  FDKsetThreadArena(pPrevArena);
   return NULL;
 }
 
+size_t mpeghdecoder_getArenaUsage(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
+  if (hCtx == NULL) {
+    return 0;
+  }
+
+  return FDKgetArenaPeak(hCtx->arena);
+}
+
+HANDLE_MPEGH_DECODER_SCRATCH_POOL mpeghdecoder_initScratchPool(void) {
+  MPEGH_DECODER_SCRATCH_POOL* pool =
+      (MPEGH_DECODER_SCRATCH_POOL*)FDKcalloc(1, sizeof(MPEGH_DECODER_SCRATCH_POOL));
+  if (pool == NULL) {
+    return NULL;
+  }
+
+  pool->hAacPool = aacDecoder_OpenScratchPool();
+  if (pool->hAacPool == NULL) {
+    FDKfree(pool);
+    return NULL;
+  }
+
+  return pool;
+}
+
+void mpeghdecoder_destroyScratchPool(HANDLE_MPEGH_DECODER_SCRATCH_POOL hPool) {
+  if (hPool == NULL) {
+    return;
+  }
+
+  aacDecoder_CloseScratchPool(hPool->hAacPool);
+  FDKfree(hPool);
+}
+
+MPEGH_DECODER_ERROR mpeghdecoder_setScratchPool(HANDLE_MPEGH_DECODER_CONTEXT hCtx,
+                                                HANDLE_MPEGH_DECODER_SCRATCH_POOL hPool) {
+  if (hCtx == NULL) {
+    return MPEGH_DEC_NULLPTR_ERROR;
+  }
+  if (hCtx->threaded != NULL) {
+    return MPEGH_DEC_UNSUPPORTED_PARAM;
+  }
+
+  hCtx->scratchPool = (hPool != NULL) ? hPool->hAacPool : NULL;
+
+  FDK_MEM_ARENA* pPrevArena = FDKsetThreadArena(hCtx->arena);
+  AAC_DECODER_ERROR err = aacDecoder_SetScratchPool(hCtx->mpeghdec, hCtx->scratchPool);
+  FDKsetThreadArena(pPrevArena);
+
+  if (err != AAC_DEC_OK) {
+    // the decoder is already configured and has to be reopened with the new scratch memory
+    return restartDecoder(hCtx);
+  }
+
+  return MPEGH_DEC_OK;
+}
+
 MPEGH_DECODER_ERROR mpeghdecoder_setMhaConfig(HANDLE_MPEGH_DECODER_CONTEXT hCtx,
                                               const uint8_t* config, uint32_t configSize) {
   if (hCtx == NULL || config == NULL) {
     return MPEGH_DEC_NULLPTR_ERROR;
   }
-  if (configSize == 0) {
+  if (configSize == 0 || hCtx->threaded != NULL) {
     return MPEGH_DEC_UNSUPPORTED_PARAM;
   }
   if (hCtx->mhaConfig != NULL) {
@@ -309,7 +620,9 @@ MPEGH_DECODER_ERROR mpeghdecoder_setMhaConfig(HANDLE_MPEGH_DECODER_CONTEXT hCtx,
   }
   MPEGH_DECODER_ERROR retval = MPEGH_DEC_OK;
   hCtx->mhaConfigLength = configSize;
+  FDK_MEM_ARENA* pPrevArena = FDKsetThreadArena(hCtx->arena);
   hCtx->mhaConfig = (uint8_t*)FDKcalloc(hCtx->mhaConfigLength, sizeof(uint8_t));
+  FDKsetThreadArena(pPrevArena);
   if (hCtx->mhaConfig == NULL) {
     return MPEGH_DEC_OUT_OF_MEMORY;
   }
@@ -319,16 +632,72 @@ MPEGH_DECODER_ERROR mpeghdecoder_setMhaConfig(HANDLE_MPEGH_DECODER_CONTEXT hCtx,
   return retval;
 }
 
+MPEGH_DECODER_ERROR mpeghdecoder_setRendererSetup(HANDLE_MPEGH_DECODER_CONTEXT hCtx,
+                                                  const uint8_t* setup, uint32_t setupSize) {
+  if (hCtx == NULL || setup == NULL) {
+    return MPEGH_DEC_NULLPTR_ERROR;
+  }
+  if (setupSize == 0 || hCtx->threaded != NULL) {
+    return MPEGH_DEC_UNSUPPORTED_PARAM;
+  }
+  aacDecoder_SetRendererSetup(hCtx->mpeghdec, NULL, 0);
+  if (hCtx->rendererSetup != NULL) {
+    FDKfree(hCtx->rendererSetup);
+    hCtx->rendererSetup = NULL;
+    hCtx->rendererSetupLength = 0;
+  }
+  FDK_MEM_ARENA* pPrevArena = FDKsetThreadArena(hCtx->arena);
+  hCtx->rendererSetup = (uint8_t*)FDKmalloc(setupSize);
+  FDKsetThreadArena(pPrevArena);
+  if (hCtx->rendererSetup == NULL) {
+    return MPEGH_DEC_OUT_OF_MEMORY;
+  }
+  FDKmemcpy(hCtx->rendererSetup, setup, setupSize);
+  hCtx->rendererSetupLength = setupSize;
+
+  if (aacDecoder_SetRendererSetup(hCtx->mpeghdec, hCtx->rendererSetup,
+                                  hCtx->rendererSetupLength) != AAC_DEC_OK) {
+    return MPEGH_DEC_UNSUPPORTED_PARAM;
+  }
+  return MPEGH_DEC_OK;
+}
+
+MPEGH_DECODER_ERROR mpeghdecoder_getRendererSetup(HANDLE_MPEGH_DECODER_CONTEXT hCtx,
+                                                  uint8_t* setup, uint32_t setupSize,
+                                                  uint32_t* setupUsed) {
+  if (hCtx == NULL || setupUsed == NULL) {
+    return MPEGH_DEC_NULLPTR_ERROR;
+  }
+  if (hCtx->threaded != NULL) {
+    return MPEGH_DEC_UNSUPPORTED_PARAM;
+  }
+  UINT used = 0;
+  AAC_DECODER_ERROR ErrorStatus =
+      aacDecoder_GetRendererSetup(hCtx->mpeghdec, setup, setupSize, &used);
+  *setupUsed = used;
+  if (ErrorStatus == AAC_DEC_OUTPUT_BUFFER_TOO_SMALL) {
+    return MPEGH_DEC_BUFFER_ERROR;
+  }
+  return (ErrorStatus == AAC_DEC_OK) ? MPEGH_DEC_OK : MPEGH_DEC_PROCESS_ERROR;
+}
+
 void mpeghdecoder_destroy(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
   if (hCtx == NULL) {
     return;
   }
 
+  stopThreadedMode(hCtx);
+
   if (hCtx->mhaConfig != NULL) {
     FDKfree(hCtx->mhaConfig);
     hCtx->mhaConfig = NULL;
   }
 
+  if (hCtx->rendererSetup != NULL) {
+    FDKfree(hCtx->rendererSetup);
+    hCtx->rendererSetup = NULL;
+  }
+
   if (hCtx->tmpSamples != NULL) {
     FDKfree(hCtx->tmpSamples);
     hCtx->tmpSamples = NULL;
@@ -347,8 +716,11 @@ void mpeghdecoder_destroy(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
   deque_free(&hCtx->decodedSamplesQueue);
   deque_free(&hCtx->outputInfoQueue);
   deque_free(&hCtx->outputSamplesQueue);
-  deque_free(&hCtx->fadeoutIdxQueue);
-  deque_free(&hCtx->fadeinIdxQueue);
+
+  if (hCtx->fadeRamps != NULL) {
+    FDKafree(hCtx->fadeRamps);
+    hCtx->fadeRamps = NULL;
+  }
 
   FDKfree(hCtx);
   hCtx = NULL;
@@ -362,6 +734,26 @@ MPEGH_DECODER_ERROR mpeghdecoder_process(HANDLE_MPEGH_DECODER_CONTEXT hCtx, cons
   if (inLength == 0) {
     return MPEGH_DEC_UNSUPPORTED_PARAM;
   }
+  if (hCtx->threaded != NULL) {
+    // the worker decodes the data
+    return threadedQueueInput(hCtx, inData, inLength, timestamp);
+  }
+
+  return decodeAccessUnit(hCtx, inData, inLength, timestamp);
+}
+
+MPEGH_DECODER_ERROR decodeAccessUnit(HANDLE_MPEGH_DECODER_CONTEXT hCtx, const uint8_t* inData,
+                                     uint32_t inLength, uint64_t timestamp) {
+  // update the DRC settings if necessary
+  updateDrcSettings(hCtx);
+
+  CStreamInfo* p_si = aacDecoder_GetStreamInfo(hCtx->mpeghdec);
+  return decodeAccessUnitFrames(hCtx, inData, inLength, timestamp, &p_si);
+}
+
+MPEGH_DECODER_ERROR decodeAccessUnitFrames(HANDLE_MPEGH_DECODER_CONTEXT hCtx,
+                                           const uint8_t* inData, uint32_t inLength,
+                                           uint64_t timestamp, CStreamInfo** pStreamInfo) {
   if (deque_full(&hCtx->timestampInQueue)) {
     return MPEGH_DEC_BUFFER_ERROR;
   }
@@ -373,11 +765,15 @@ MPEGH_DECODER_ERROR mpeghdecoder_process(HANDLE_MPEGH_DECODER_CONTEXT hCtx, cons
   unsigned int validBytes = inLength;
   bool decodingSuccessful = false;
   bool doConceal = false;
+  CStreamInfo* p_si = *pStreamInfo;
 
-  // update the DRC settings if necessary
-  updateDrcSettings(hCtx);
-
-  CStreamInfo* p_si = aacDecoder_GetStreamInfo(hCtx->mpeghdec);
+  // fill a gap to the previous access unit with concealed frames; larger gaps restart the decoder
+  if (hCtx->gapFillMode == MPEGH_DEC_GAP_FILL_CONCEAL && !deque_empty(&hCtx->timestampInQueue)) {
+    uint64_t lastTimestamp = *(uint64_t*)deque_back(&hCtx->timestampInQueue);
+    if (timestamp > lastTimestamp && timestamp - lastTimestamp <= hCtx->discontinuityThreshold) {
+      concealGap(hCtx, lastTimestamp, timestamp);
+    }
+  }
 
   // store the presentation timestamp associated with this MHAS frame; two
   // consecutive timestamps have to differ!
@@ -393,12 +789,15 @@ MPEGH_DECODER_ERROR mpeghdecoder_process(HANDLE_MPEGH_DECODER_CONTEXT hCtx, cons
         *(uint64_t*)deque_at(&hCtx->timestampInQueue, deque_size(&hCtx->timestampInQueue) - 2);
     uint64_t duration = b - a;
 
-    if (duration > THRESHOLD) {
+    if (duration > hCtx->discontinuityThreshold) {
       MPEGH_DECODER_ERROR retval = restartDecoder(hCtx);
       if (retval != MPEGH_DEC_OK) {
         return retval;
       }
+      // the new decoder instance needs the DRC settings before decoding this access unit
+      updateDrcSettings(hCtx);
       p_si = aacDecoder_GetStreamInfo(hCtx->mpeghdec);
+      *pStreamInfo = p_si;
 
       // store the presentation timestamp associated with this MHAS frame; two
       // consecutive timestamps have to differ! restartDecoder also cleared all
@@ -411,11 +810,12 @@ MPEGH_DECODER_ERROR mpeghdecoder_process(HANDLE_MPEGH_DECODER_CONTEXT hCtx, cons
     bool concealed = false;
     isDone = false;
 
-    // pass the MHAS frame to the MPEG-H decoder
+    // pass the MHAS frame to the MPEG-H decoder; it is read in place for the rest of this call
     AAC_DECODER_ERROR err =
-        aacDecoder_Fill(hCtx->mpeghdec, &inData, (uint32_t*)&inLength, &validBytes);
+        aacDecoder_BindInput(hCtx->mpeghdec, &inData, (uint32_t*)&inLength, &validBytes);
 
     if (err != AAC_DEC_OK) {
+      aacDecoder_ReleaseInput(hCtx->mpeghdec);
       deque_pop_back(&hCtx->timestampInQueue);  // remove timestamp as it was not
                                                 // possible to fill in current AU
       return MPEGH_DEC_PROCESS_ERROR;
@@ -424,12 +824,23 @@ MPEGH_DECODER_ERROR mpeghdecoder_process(HANDLE_MPEGH_DECODER_CONTEXT hCtx, cons
     while (!isDone) {
       // run FDK decoding process
       UINT flags = 0;
+      if (hCtx->clearHistory) {  // start from silence after a soft flush
+        flags |= AACDEC_CLRHIST | AACDEC_INTR;
+      }
       if (doConceal) {  // force conceal of the decoder
         concealed = true;
         flags |= AACDEC_CONCEAL;
       }
-      err = aacDecoder_DecodeFrame(hCtx->mpeghdec, hCtx->tmpSamples, hCtx->maxDecoderOutputSamples,
-                                   flags);
+      // decode directly into the sample queue if there is enough space left
+      INT_PCM* pTimeData = (INT_PCM*)deque_bulk_push_back_reserve(&hCtx->decodedSamplesQueue,
+                                                                  hCtx->maxDecoderOutputSamples);
+      if (pTimeData == NULL) {
+        pTimeData = hCtx->tmpSamples;
+      }
+      // a new config allocates the core decoder memory within aacDecoder_DecodeFrame()
+      FDK_MEM_ARENA* pPrevArena = FDKsetThreadArena(hCtx->arena);
+      err = aacDecoder_DecodeFrame(hCtx->mpeghdec, pTimeData, hCtx->maxDecoderOutputSamples, flags);
+      FDKsetThreadArena(pPrevArena);
       doConceal = false;  // do not conceal anymore
 
       switch (err) {
@@ -443,6 +854,7 @@ MPEGH_DECODER_ERROR mpeghdecoder_process(HANDLE_MPEGH_DECODER_CONTEXT hCtx, cons
               hCtx->numberOfChannels = p_si->numChannels;
             } else if (hCtx->sampleRate != p_si->sampleRate ||
                        hCtx->numberOfChannels != p_si->numChannels) {
+              aacDecoder_ReleaseInput(hCtx->mpeghdec);
               return MPEGH_DEC_NEEDS_RESTART;
             }
           }
@@ -500,11 +912,17 @@ MPEGH_DECODER_ERROR mpeghdecoder_process(HANDLE_MPEGH_DECODER_CONTEXT hCtx, cons
 
       // if the output is valid, add the PCM samples to the sample queue
       if (IS_OUTPUT_VALID(err)) {
+        hCtx->clearHistory = false;
         if (p_si != NULL) {
           // add decoded PCM samples to the sample queue
           if (p_si->frameSize > 0) {
-            deque_bulk_push_back(&hCtx->decodedSamplesQueue, hCtx->tmpSamples,
-                                 p_si->frameSize * p_si->numChannels);
+            if (pTimeData == hCtx->tmpSamples) {
+              deque_bulk_push_back(&hCtx->decodedSamplesQueue, hCtx->tmpSamples,
+                                   p_si->frameSize * p_si->numChannels);
+            } else {
+              deque_bulk_push_back_commit(&hCtx->decodedSamplesQueue,
+                                          p_si->frameSize * p_si->numChannels);
+            }
           }
           // add the MPEG-H AU size info received from decoder
           if (p_si->mpeghAUSize > 0) {
@@ -514,11 +932,15 @@ MPEGH_DECODER_ERROR mpeghdecoder_process(HANDLE_MPEGH_DECODER_CONTEXT hCtx, cons
             auInfo.outputLoudness = p_si->outputLoudness;
 
             deque_push_back(&hCtx->auInfoQueue, &auInfo);
+            hCtx->lastAuSize = auInfo.auSize;
           }
         }
       }
     }  // end of while(!isDone)
   }    // end of while(validBytes != 0)
+
+  // the caller owns inData only for the duration of this call
+  aacDecoder_ReleaseInput(hCtx->mpeghdec);
   return MPEGH_DEC_OK;
 }
 
@@ -529,21 +951,86 @@ MPEGH_DECODER_ERROR mpeghdecoder_processTimescale(HANDLE_MPEGH_DECODER_CONTEXT h
   return mpeghdecoder_process(hCtx, inData, inLength, timestampNs);
 }
 
-MPEGH_DECODER_ERROR
-mpeghdecoder_getSamples(HANDLE_MPEGH_DECODER_CONTEXT hCtx, int32_t* outData, uint32_t outLength,
-                        MPEGH_DECODER_OUTPUT_INFO* outInfo) {
-  if (hCtx == NULL || outData == NULL || outInfo == NULL) {
+MPEGH_DECODER_ERROR mpeghdecoder_processBatch(HANDLE_MPEGH_DECODER_CONTEXT hCtx,
+                                              const MPEGH_DECODER_ACCESS_UNIT* accessUnits,
+                                              uint32_t numAccessUnits, int32_t* outData,
+                                              uint32_t outLength,
+                                              MPEGH_DECODER_OUTPUT_INFO* outInfo,
+                                              uint32_t maxNumFrames, uint32_t* numProcessed,
+                                              uint32_t* numFrames) {
+  if (hCtx == NULL || (accessUnits == NULL && numAccessUnits > 0) || outData == NULL ||
+      outInfo == NULL || numProcessed == NULL || numFrames == NULL) {
     return MPEGH_DEC_NULLPTR_ERROR;
   }
-  if (outLength < hCtx->maxDecoderOutputSamples) {
+  *numProcessed = 0;
+  *numFrames = 0;
+  if (hCtx->threaded != NULL) {
+    return MPEGH_DEC_UNSUPPORTED_PARAM;
+  }
+  if (hCtx->viewNumSamples > 0) {
     return MPEGH_DEC_BUFFER_ERROR;
   }
+
+  // the parameters cannot change within the batch, apply them once; a restart of the decoder
+  // re-applies them and updates the stream info
+  updateDrcSettings(hCtx);
+  CStreamInfo* p_si = aacDecoder_GetStreamInfo(hCtx->mpeghdec);
+
+  MPEGH_DECODER_ERROR retVal = MPEGH_DEC_OK;
+  uint32_t outUsed = 0;
+  uint32_t au = 0;
+  for (;;) {
+    // move all available frames into the arena; this keeps the internal queues at the fill level
+    // of a single mpeghdecoder_process() call
+    while (*numFrames < maxNumFrames && outLength - outUsed >= hCtx->maxDecoderOutputSamples) {
+      MPEGH_DECODER_OUTPUT_INFO* info = &outInfo[*numFrames];
+      unsigned int outNumSamples = 0;
+      MPEGH_DECODER_ERROR err = prepareOutputFrame(hCtx, info, &outNumSamples);
+      if (err == MPEGH_DEC_FEED_DATA) {
+        break;
+      }
+      if (err != MPEGH_DEC_OK) {
+        return err;
+      }
+      deque_bulk_pop_front_copy(&hCtx->outputSamplesQueue, &outData[outUsed], outNumSamples);
+      adjustFadeIndexes(hCtx, outNumSamples);
+      outUsed += outNumSamples;
+      (*numFrames)++;
+    }
+
+    // stop if all access units are consumed or the arena is full
+    if (au == numAccessUnits || *numFrames == maxNumFrames ||
+        outLength - outUsed < hCtx->maxDecoderOutputSamples) {
+      break;
+    }
+
+    if (accessUnits[au].data == NULL) {
+      retVal = MPEGH_DEC_NULLPTR_ERROR;
+      break;
+    }
+    if (accessUnits[au].length == 0) {
+      retVal = MPEGH_DEC_UNSUPPORTED_PARAM;
+      break;
+    }
+    retVal = decodeAccessUnitFrames(hCtx, accessUnits[au].data, accessUnits[au].length,
+                                    accessUnits[au].timestamp, &p_si);
+    if (retVal != MPEGH_DEC_OK) {
+      break;
+    }
+    au++;
+    *numProcessed = au;
+  }
+
+  return retVal;
+}
+
+MPEGH_DECODER_ERROR prepareOutputFrame(HANDLE_MPEGH_DECODER_CONTEXT hCtx,
+                                       MPEGH_DECODER_OUTPUT_INFO* outInfo,
+                                       unsigned int* pNumSamples) {
   int durationSamples;
   int outNumSamples = 0;
   uint64_t duration = 0;
   MPEGH_DECODER_ERROR retVal = MPEGH_DEC_FEED_DATA;
-  int i;
-  unsigned int k;
 
   outInfo->numChannels = hCtx->numberOfChannels;
   outInfo->sampleRate = hCtx->sampleRate;
@@ -582,10 +1069,11 @@ mpeghdecoder_getSamples(HANDLE_MPEGH_DECODER_CONTEXT hCtx, int32_t* outData, uin
 
       int numSamplesToRemove = 0;
       int numSamplesToAdd = 0;
-      if (AUSize <= durationSamples + TOLERANCE && AUSize >= durationSamples - TOLERANCE) {
+      int tolerance = hCtx->timingTolerance;
+      if (AUSize <= durationSamples + tolerance && AUSize >= durationSamples - tolerance) {
         // do nothing
       } else {
-        if (AUSize > durationSamples + TOLERANCE) {
+        if (AUSize > durationSamples + tolerance) {
           // remove samples from queue
           numSamplesToRemove = (AUSize - durationSamples) * hCtx->numberOfChannels;
         } else {
@@ -597,8 +1085,7 @@ mpeghdecoder_getSamples(HANDLE_MPEGH_DECODER_CONTEXT hCtx, int32_t* outData, uin
       if (hCtx->zeroSignal && !concealed) {
         // the previous samples were zero and now there is an unconcealed signal
         // available -> fade in set fadein start index
-        unsigned int fadeInLength = deque_size(&hCtx->outputSamplesQueue);
-        deque_push_back(&hCtx->fadeinIdxQueue, &fadeInLength);
+        pushFadeIndex(&hCtx->fadeinIdx, (int)deque_size(&hCtx->outputSamplesQueue));
         hCtx->zeroSignal = false;
       }
 
@@ -610,7 +1097,7 @@ mpeghdecoder_getSamples(HANDLE_MPEGH_DECODER_CONTEXT hCtx, int32_t* outData, uin
           int idx = (int)deque_size(&hCtx->outputSamplesQueue) + numDecodedSamples - fadelen;
           hCtx->zeroSignal = true;
           if (idx >= 0) {
-            deque_push_back(&hCtx->fadeoutIdxQueue, &idx);
+            pushFadeIndex(&hCtx->fadeoutIdx, idx);
           }
         }
         if (numSamplesToRemove > 0) {
@@ -619,22 +1106,24 @@ mpeghdecoder_getSamples(HANDLE_MPEGH_DECODER_CONTEXT hCtx, int32_t* outData, uin
           int idx = (int)deque_size(&hCtx->outputSamplesQueue) - 1 + numDecodedSamples -
                     numSamplesToRemove - fadelen;
           if (idx >= 0) {
-            deque_push_back(&hCtx->fadeoutIdxQueue, &idx);
+            pushFadeIndex(&hCtx->fadeoutIdx, idx);
           }
         }
       }
 
-      // copy from sample queue to outputSamplesQueue
+      // move from sample queue to outputSamplesQueue; the removed samples are dropped in place
       if (numDecodedSamples > 0) {
         unsigned int samplesToCopy = numDecodedSamples - numSamplesToRemove;
-        deque_bulk_pop_front_copy(&hCtx->decodedSamplesQueue, hCtx->tmpSamples, numDecodedSamples);
+        unsigned int samplesMoved = 0;
         if (concealed && hCtx->zeroSignal) {
           // the previous samples were zero and the current signal is concealed
           // -> replace samples with zero samples
           deque_bulk_push_back_zeros(&hCtx->outputSamplesQueue, samplesToCopy);
-        } else {
-          deque_bulk_push_back(&hCtx->outputSamplesQueue, hCtx->tmpSamples, samplesToCopy);
+        } else if (deque_bulk_move(&hCtx->outputSamplesQueue, &hCtx->decodedSamplesQueue,
+                                   samplesToCopy) == 0) {
+          samplesMoved = samplesToCopy;
         }
+        deque_bulk_pop_front(&hCtx->decodedSamplesQueue, numDecodedSamples - samplesMoved);
       }
 
       // adjust the number of decoded samples after removing samples
@@ -666,35 +1155,23 @@ mpeghdecoder_getSamples(HANDLE_MPEGH_DECODER_CONTEXT hCtx, int32_t* outData, uin
       return MPEGH_DEC_FEED_DATA;
     }
 
-    outNumSamples = info->size;
-
-    // apply fadeout
-    int numIndexesToRemove = 0;
-    for (k = 0; k < deque_size(&hCtx->fadeoutIdxQueue); k++) {
-      unsigned int index = *(unsigned int*)deque_front(&hCtx->fadeoutIdxQueue);
-      if (index + fadelen < deque_size(&hCtx->outputSamplesQueue)) {
-        for (i = 0; i < fadelen; i++) {
-          fade((int32_t*)deque_at(&hCtx->outputSamplesQueue, index + i), i, fadelen, false);
-        }
-        numIndexesToRemove++;
-      }
+    // the output paths access the frame linearly in the queue; reject it before anything is
+    // dequeued so that the frame is not lost
+    if (fMin(info->size, MAX_NUM_FRAME_SAMPLES * hCtx->numberOfChannels) >
+        (int)hCtx->maxDecoderOutputSamples) {
+      return MPEGH_DEC_BUFFER_ERROR;
     }
-    // remove used indexes from fadeoutIdxQueue
-    deque_bulk_pop_front(&hCtx->fadeoutIdxQueue, numIndexesToRemove);
 
-    // apply fadein
-    numIndexesToRemove = 0;
-    for (k = 0; k < deque_size(&hCtx->fadeinIdxQueue); k++) {
-      unsigned int index = *(unsigned int*)deque_front(&hCtx->fadeinIdxQueue);
-      if (index + fadelen < deque_size(&hCtx->outputSamplesQueue)) {
-        for (i = 0; i < fadelen; i++) {
-          fade((int32_t*)deque_at(&hCtx->outputSamplesQueue, index + i), i, fadelen, true);
-        }
-        numIndexesToRemove++;
+    outNumSamples = info->size;
+
+    // apply fadeout and fadein
+    if (hCtx->fadeoutIdx.num > 0 || hCtx->fadeinIdx.num > 0) {
+      if (updateFadeRamps(hCtx, fadelen) != MPEGH_DEC_OK) {
+        return MPEGH_DEC_OUT_OF_MEMORY;
       }
+      applyFades(hCtx, &hCtx->fadeoutIdx, &hCtx->fadeRamps[hCtx->fadeRampCapacity], fadelen);
+      applyFades(hCtx, &hCtx->fadeinIdx, hCtx->fadeRamps, fadelen);
     }
-    // remove used indexes from fadeinIdxQueue
-    deque_bulk_pop_front(&hCtx->fadeinIdxQueue, numIndexesToRemove);
 
     uint64_t pts;
     int tmpFrameSize = outNumSamples / hCtx->numberOfChannels;
@@ -714,28 +1191,7 @@ mpeghdecoder_getSamples(HANDLE_MPEGH_DECODER_CONTEXT hCtx, int32_t* outData, uin
       info = (OutputInfo*)deque_pop_front(&hCtx->outputInfoQueue);
     }
 
-    // copy samples to outData
-    deque_bulk_pop_front_copy(&hCtx->outputSamplesQueue, outData, outNumSamples);
-
-    // adjust fadein indexes
-    int size = deque_size(&hCtx->fadeinIdxQueue);
-    for (i = 0; i < size; i++) {
-      int idx = *(int*)deque_pop_front(&hCtx->fadeinIdxQueue);
-      idx -= outNumSamples;
-      if (idx >= 0) {
-        deque_push_back(&hCtx->fadeinIdxQueue, &idx);
-      }
-    }
-
-    // adjust fadeout indexes
-    size = deque_size(&hCtx->fadeoutIdxQueue);
-    for (i = 0; i < size; i++) {
-      int idx = *(int*)deque_pop_front(&hCtx->fadeoutIdxQueue);
-      idx -= outNumSamples;
-      if (idx >= 0) {
-        deque_push_back(&hCtx->fadeoutIdxQueue, &idx);
-      }
-    }
+    *pNumSamples = outNumSamples;
 
     outInfo->numSamplesPerChannel = outNumSamples / outInfo->numChannels;
     outInfo->pts = pts;
@@ -749,20 +1205,218 @@ mpeghdecoder_getSamples(HANDLE_MPEGH_DECODER_CONTEXT hCtx, int32_t* outData, uin
   return retVal;
 }
 
+static void shiftFadeIndexes(FadeIndexes* fades, int outNumSamples) {
+  int i, num = 0;
+
+  // drop the fades whose start has already been output
+  for (i = 0; i < fades->num; i++) {
+    int idx = fades->idx[i] - outNumSamples;
+    if (idx >= 0) {
+      fades->idx[num++] = idx;
+    }
+  }
+  fades->num = num;
+}
+
+void adjustFadeIndexes(HANDLE_MPEGH_DECODER_CONTEXT hCtx, int outNumSamples) {
+  shiftFadeIndexes(&hCtx->fadeinIdx, outNumSamples);
+  shiftFadeIndexes(&hCtx->fadeoutIdx, outNumSamples);
+}
+
+MPEGH_DECODER_ERROR
+mpeghdecoder_getSamples(HANDLE_MPEGH_DECODER_CONTEXT hCtx, int32_t* outData, uint32_t outLength,
+                        MPEGH_DECODER_OUTPUT_INFO* outInfo) {
+  if (hCtx == NULL || outData == NULL || outInfo == NULL) {
+    return MPEGH_DEC_NULLPTR_ERROR;
+  }
+
+  unsigned int outNumSamples = 0;
+  if (hCtx->threaded != NULL) {
+    // take the frame from the frame ring without waiting on the worker
+    if (outLength < hCtx->maxDecoderOutputSamples || hCtx->threaded->outputBorrowed) {
+      return MPEGH_DEC_BUFFER_ERROR;
+    }
+    const INT_PCM* pIn = threadedFrontFrame(hCtx->threaded, outInfo, &outNumSamples);
+    if (pIn == NULL) {
+      return MPEGH_DEC_FEED_DATA;
+    }
+    FDKmemcpy(outData, pIn, outNumSamples * sizeof(INT_PCM));
+    threadedPopFrame(hCtx->threaded);
+    return MPEGH_DEC_OK;
+  }
+
+  if (outLength < hCtx->maxDecoderOutputSamples || hCtx->viewNumSamples > 0) {
+    return MPEGH_DEC_BUFFER_ERROR;
+  }
+
+  MPEGH_DECODER_ERROR retVal = prepareOutputFrame(hCtx, outInfo, &outNumSamples);
+  if (retVal == MPEGH_DEC_OK) {
+    // copy samples to outData
+    deque_bulk_pop_front_copy(&hCtx->outputSamplesQueue, outData, outNumSamples);
+    adjustFadeIndexes(hCtx, outNumSamples);
+  }
+
+  return retVal;
+}
+
+MPEGH_DECODER_ERROR
+mpeghdecoder_getSamplesFormatted(HANDLE_MPEGH_DECODER_CONTEXT hCtx, void* outData,
+                                 uint32_t outLength, MPEGH_DECODER_OUTPUT_INFO* outInfo) {
+  if (hCtx == NULL || outData == NULL || outInfo == NULL) {
+    return MPEGH_DEC_NULLPTR_ERROR;
+  }
+
+  unsigned int outNumSamples = 0;
+  if (hCtx->threaded != NULL) {
+    // convert the frame while copying it out of the frame ring
+    if (outLength < hCtx->maxDecoderOutputSamples || hCtx->threaded->outputBorrowed) {
+      return MPEGH_DEC_BUFFER_ERROR;
+    }
+    const INT_PCM* pIn = threadedFrontFrame(hCtx->threaded, outInfo, &outNumSamples);
+    if (pIn == NULL) {
+      return MPEGH_DEC_FEED_DATA;
+    }
+    convertSamples(hCtx, pIn, outData, outNumSamples, outInfo);
+    threadedPopFrame(hCtx->threaded);
+    return MPEGH_DEC_OK;
+  }
+
+  if (outLength < hCtx->maxDecoderOutputSamples || hCtx->viewNumSamples > 0) {
+    return MPEGH_DEC_BUFFER_ERROR;
+  }
+
+  MPEGH_DECODER_ERROR retVal = prepareOutputFrame(hCtx, outInfo, &outNumSamples);
+  if (retVal == MPEGH_DEC_OK) {
+    const INT_PCM* pIn =
+        (const INT_PCM*)deque_bulk_front_linear(&hCtx->outputSamplesQueue, outNumSamples);
+    if (pIn != NULL) {
+      // convert the samples while copying them out of the queue
+      convertSamples(hCtx, pIn, outData, outNumSamples, outInfo);
+      deque_bulk_pop_front(&hCtx->outputSamplesQueue, outNumSamples);
+    } else {
+      // the frame is already dequeued, fall back to copying it out of the queue
+      deque_bulk_pop_front_copy(&hCtx->outputSamplesQueue, hCtx->tmpSamples, outNumSamples);
+      convertSamples(hCtx, hCtx->tmpSamples, outData, outNumSamples, outInfo);
+    }
+    adjustFadeIndexes(hCtx, outNumSamples);
+  }
+
+  return retVal;
+}
+
+void convertSamples(HANDLE_MPEGH_DECODER_CONTEXT hCtx, const INT_PCM* pIn, void* outData,
+                    unsigned int outNumSamples, const MPEGH_DECODER_OUTPUT_INFO* outInfo) {
+  // interleaved output is converted as a single channel
+  UINT channels = outInfo->numChannels;
+  UINT length = outInfo->numSamplesPerChannel;
+  if (!(hCtx->outputFormat & MPEGH_DEC_OUTPUT_FORMAT_PLANAR)) {
+    channels = 1;
+    length = outNumSamples;
+  }
+  switch (hCtx->outputFormat & ~MPEGH_DEC_OUTPUT_FORMAT_PLANAR) {
+    case MPEGH_DEC_OUTPUT_FORMAT_INT24:
+      FDK_deinterleave(pIn, (LONG*)outData, channels, length, length, 8);
+      break;
+    case MPEGH_DEC_OUTPUT_FORMAT_INT16:
+      FDK_deinterleave(pIn, (SHORT*)outData, channels, length, length);
+      break;
+    case MPEGH_DEC_OUTPUT_FORMAT_FLOAT32:
+      FDK_deinterleave(pIn, (float*)outData, channels, length, length);
+      break;
+    default:
+      if (channels == 1) {
+        FDKmemcpy(outData, pIn, outNumSamples * sizeof(LONG));
+      } else {
+        FDK_deinterleave(pIn, (LONG*)outData, channels, length, length, 0);
+      }
+      break;
+  }
+}
+
+MPEGH_DECODER_ERROR
+mpeghdecoder_getSamplesView(HANDLE_MPEGH_DECODER_CONTEXT hCtx, const int32_t** outData,
+                            MPEGH_DECODER_OUTPUT_INFO* outInfo) {
+  if (hCtx == NULL || outData == NULL || outInfo == NULL) {
+    return MPEGH_DEC_NULLPTR_ERROR;
+  }
+  *outData = NULL;
+
+  unsigned int outNumSamples = 0;
+  if (hCtx->threaded != NULL) {
+    // hand out the frame in the frame ring; the worker does not reuse it before it is released
+    if (hCtx->threaded->outputBorrowed) {
+      return MPEGH_DEC_BUFFER_ERROR;
+    }
+    *outData = (const int32_t*)threadedFrontFrame(hCtx->threaded, outInfo, &outNumSamples);
+    if (*outData == NULL) {
+      return MPEGH_DEC_FEED_DATA;
+    }
+    hCtx->threaded->outputBorrowed = true;
+    return MPEGH_DEC_OK;
+  }
+
+  if (hCtx->viewNumSamples > 0) {
+    return MPEGH_DEC_BUFFER_ERROR;
+  }
+
+  MPEGH_DECODER_ERROR retVal = prepareOutputFrame(hCtx, outInfo, &outNumSamples);
+  if (retVal == MPEGH_DEC_OK) {
+    // hand out the samples in place; they are removed by mpeghdecoder_releaseSamples().
+    // prepareOutputFrame() only returns frames that fit the linear part of the queue.
+    *outData = (const int32_t*)deque_bulk_front_linear(&hCtx->outputSamplesQueue, outNumSamples);
+    hCtx->viewNumSamples = outNumSamples;
+  }
+
+  return retVal;
+}
+
+MPEGH_DECODER_ERROR
+mpeghdecoder_releaseSamples(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
+  if (hCtx == NULL) {
+    return MPEGH_DEC_NULLPTR_ERROR;
+  }
+  if (hCtx->threaded != NULL) {
+    if (hCtx->threaded->outputBorrowed) {
+      threadedPopFrame(hCtx->threaded);
+      hCtx->threaded->outputBorrowed = false;
+    }
+    return MPEGH_DEC_OK;
+  }
+  if (hCtx->viewNumSamples > 0) {
+    deque_bulk_pop_front(&hCtx->outputSamplesQueue, hCtx->viewNumSamples);
+    adjustFadeIndexes(hCtx, hCtx->viewNumSamples);
+    hCtx->viewNumSamples = 0;
+  }
+  return MPEGH_DEC_OK;
+}
+
 MPEGH_DECODER_ERROR
 mpeghdecoder_flushAndGet(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
   if (hCtx == NULL) {
     return MPEGH_DEC_NULLPTR_ERROR;
   }
+  if (hCtx->threaded != NULL) {
+    // the worker flushes the decoder after the queued input data
+    return threadedQueueInput(hCtx, NULL, 0, 0);
+  }
+
+  return decodeFlush(hCtx);
+}
+
+MPEGH_DECODER_ERROR decodeFlush(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
   if (deque_full(&hCtx->timestampInQueue)) {
     return MPEGH_DEC_BUFFER_ERROR;
   }
   if (deque_space(&hCtx->decodedSamplesQueue) < hCtx->maxDecoderOutputSamples) {
     return MPEGH_DEC_BUFFER_ERROR;
   }
-  // flush the decoder
-  AAC_DECODER_ERROR err = aacDecoder_DecodeFrame(hCtx->mpeghdec, hCtx->tmpSamples,
+  // flush the decoder directly into the sample queue
+  INT_PCM* pTimeData = (INT_PCM*)deque_bulk_push_back_reserve(&hCtx->decodedSamplesQueue,
+                                                              hCtx->maxDecoderOutputSamples);
+  FDK_MEM_ARENA* pPrevArena = FDKsetThreadArena(hCtx->arena);
+  AAC_DECODER_ERROR err = aacDecoder_DecodeFrame(hCtx->mpeghdec, pTimeData,
                                                  hCtx->maxDecoderOutputSamples, AACDEC_FLUSH);
+  FDKsetThreadArena(pPrevArena);
   CStreamInfo* p_si = aacDecoder_GetStreamInfo(hCtx->mpeghdec);
   if (IS_OUTPUT_VALID(err) && p_si != NULL) {
     if (hCtx->sampleRate == -1 && hCtx->numberOfChannels == -1) {
@@ -774,8 +1428,7 @@ mpeghdecoder_flushAndGet(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
     }
     // add decoded PCM samples to the sample queue
     if (p_si->frameSize > 0) {
-      deque_bulk_push_back(&hCtx->decodedSamplesQueue, hCtx->tmpSamples,
-                           p_si->frameSize * p_si->numChannels);
+      deque_bulk_push_back_commit(&hCtx->decodedSamplesQueue, p_si->frameSize * p_si->numChannels);
     }
     // add the MPEG-H AU size info received from decoder
     if (p_si->mpeghAUSize > 0) {
@@ -784,6 +1437,7 @@ mpeghdecoder_flushAndGet(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
       auInfo.concealed = false;
       auInfo.outputLoudness = p_si->outputLoudness;
       deque_push_back(&hCtx->auInfoQueue, &auInfo);
+      hCtx->lastAuSize = auInfo.auSize;
     }
 
     // add the ending pts
@@ -805,14 +1459,65 @@ MPEGH_DECODER_ERROR mpeghdecoder_flush(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
   if (hCtx == NULL) {
     return MPEGH_DEC_NULLPTR_ERROR;
   }
+  if (hCtx->threaded != NULL) {
+    return MPEGH_DEC_UNSUPPORTED_PARAM;
+  }
   return restartDecoder(hCtx);
 }
 
+MPEGH_DECODER_ERROR mpeghdecoder_softFlush(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
+  if (hCtx == NULL) {
+    return MPEGH_DEC_NULLPTR_ERROR;
+  }
+  if (hCtx->threaded != NULL) {
+    return MPEGH_DEC_UNSUPPORTED_PARAM;
+  }
+
+  // drop the buffered bitstream; the configuration found at the new position is compared with the
+  // current one and only a changed configuration re-initializes the decoder
+  FDK_MEM_ARENA* pPrevArena = FDKsetThreadArena(hCtx->arena);
+  AAC_DECODER_ERROR ErrorStatus = aacDecoder_SetParam(hCtx->mpeghdec, AAC_TPDEC_CLEAR_BUFFER, 1);
+  if (ErrorStatus == AAC_DEC_OK && hCtx->mhaConfigLength > 0 && hCtx->mhaConfig != NULL) {
+    ErrorStatus = aacDecoder_ConfigRaw(hCtx->mpeghdec, &hCtx->mhaConfig, &hCtx->mhaConfigLength);
+  }
+  FDKsetThreadArena(pPrevArena);
+  if (ErrorStatus != AAC_DEC_OK) {
+    return restartDecoder(hCtx);
+  }
+
+  clearQueues(hCtx);
+  hCtx->lastAuSize = 0;
+  // clear overlap, concealment and delay line history with the next frame and fade it in
+  hCtx->clearHistory = true;
+  hCtx->zeroSignal = true;
+
+  return MPEGH_DEC_OK;
+}
+
+MPEGH_DECODER_ERROR mpeghdecoder_runWorker(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
+  if (hCtx == NULL) {
+    return MPEGH_DEC_NULLPTR_ERROR;
+  }
+  if (hCtx->threaded == NULL || hCtx->threaded->mode != MPEGH_DEC_THREADED_MODE_EXTERNAL) {
+    return MPEGH_DEC_UNSUPPORTED_PARAM;
+  }
+
+  bool progress = false;
+  while (threadedStep(hCtx)) {
+    progress = true;
+  }
+  return progress ? MPEGH_DEC_OK : MPEGH_DEC_FEED_DATA;
+}
+
 MPEGH_DECODER_ERROR mpeghdecoder_setParam(HANDLE_MPEGH_DECODER_CONTEXT hCtx,
                                           MPEGH_DECODER_PARAMETER param, int value) {
   if (hCtx == NULL) {
     return MPEGH_DEC_NULLPTR_ERROR;
   }
+  if (hCtx->threaded != NULL && param != MPEGH_DEC_PARAM_THREADED_MODE) {
+    // the worker uses the settings without synchronization
+    return MPEGH_DEC_UNSUPPORTED_PARAM;
+  }
   MPEGH_DECODER_ERROR result = MPEGH_DEC_OK;
   switch (param) {
     case MPEGH_DEC_PARAM_TARGET_REFERENCE_LEVEL:
@@ -850,6 +1555,69 @@ MPEGH_DECODER_ERROR mpeghdecoder_setParam(HANDLE_MPEGH_DECODER_CONTEXT hCtx,
         result = MPEGH_DEC_UNSUPPORTED_PARAM;
       }
       break;
+    case MPEGH_DEC_PARAM_OUTPUT_FORMAT:
+      if ((value & ~MPEGH_DEC_OUTPUT_FORMAT_PLANAR) >= MPEGH_DEC_OUTPUT_FORMAT_INT32 &&
+          (value & ~MPEGH_DEC_OUTPUT_FORMAT_PLANAR) <= MPEGH_DEC_OUTPUT_FORMAT_FLOAT32) {
+        hCtx->outputFormat = value;
+      } else {
+        result = MPEGH_DEC_UNSUPPORTED_PARAM;
+      }
+      break;
+    case MPEGH_DEC_PARAM_DECODER_THREADS: {
+      FDK_MEM_ARENA* pPrevArena = FDKsetThreadArena(hCtx->arena);
+      if (aacDecoder_SetParam(hCtx->mpeghdec, AAC_DECODER_THREADS, value) == AAC_DEC_OK) {
+        hCtx->decoderThreads = value;
+      } else {
+        result = MPEGH_DEC_UNSUPPORTED_PARAM;
+      }
+      FDKsetThreadArena(pPrevArena);
+    } break;
+    case MPEGH_DEC_PARAM_DISCONTINUITY_THRESHOLD:
+      if (value >= 1 && value <= MAX_DISCONTINUITY_THRESHOLD) {
+        hCtx->discontinuityThreshold = (uint64_t)value * 1000000;
+      } else {
+        result = MPEGH_DEC_UNSUPPORTED_PARAM;
+      }
+      break;
+    case MPEGH_DEC_PARAM_TIMING_TOLERANCE:
+      if (value >= 0 && value <= MAX_NUM_FRAME_SAMPLES) {
+        hCtx->timingTolerance = value;
+      } else {
+        result = MPEGH_DEC_UNSUPPORTED_PARAM;
+      }
+      break;
+    case MPEGH_DEC_PARAM_GAP_FILL_MODE:
+      if (value == MPEGH_DEC_GAP_FILL_ZEROS || value == MPEGH_DEC_GAP_FILL_CONCEAL) {
+        hCtx->gapFillMode = value;
+      } else {
+        result = MPEGH_DEC_UNSUPPORTED_PARAM;
+      }
+      break;
+    case MPEGH_DEC_PARAM_VBAP_GAIN_GRID:
+      if (aacDecoder_SetParam(hCtx->mpeghdec, AAC_VBAP_GAIN_GRID, value) == AAC_DEC_OK) {
+        hCtx->vbapGainGrid = value;
+      } else {
+        result = MPEGH_DEC_UNSUPPORTED_PARAM;
+      }
+      break;
+    case MPEGH_DEC_PARAM_THREADED_MODE:
+      if (value == MPEGH_DEC_THREADED_MODE_OFF) {
+        if (hCtx->threaded != NULL) {
+          // the queued input data and the frames in the frame ring are discarded
+          stopThreadedMode(hCtx);
+          return restartDecoder(hCtx);
+        }
+      } else if (value == MPEGH_DEC_THREADED_MODE_INTERNAL ||
+                 value == MPEGH_DEC_THREADED_MODE_EXTERNAL) {
+        // the worker may already run, so the context must not be touched afterwards
+        if (hCtx->threaded == NULL) {
+          return startThreadedMode(hCtx, value);
+        }
+        return (hCtx->threaded->mode == value) ? MPEGH_DEC_OK : MPEGH_DEC_UNSUPPORTED_PARAM;
+      } else {
+        result = MPEGH_DEC_UNSUPPORTED_PARAM;
+      }
+      break;
     default:
       result = MPEGH_DEC_UNSUPPORTED_PARAM;
       break;
@@ -861,26 +1629,81 @@ MPEGH_DECODER_ERROR mpeghdecoder_setParam(HANDLE_MPEGH_DECODER_CONTEXT hCtx,
   return result;
 }
 
-void fade(int32_t* sample, int index, int fadelen, bool fadein) {
-  float factor = 0;
-  if (fadein) {
-    factor = (float)(-cos(M_PI * (float)index / (float)fadelen) + 1.0f) / 2.0f;
-  } else {
-    factor = (float)(cos(M_PI * (float)(index + 1) / (float)fadelen) + 1) / 2.0f;
+void fade(int32_t* samples, const float* ramp, int length) {
+  for (int i = 0; i < length; i++) {
+    samples[i] = (int32_t)(samples[i] * ramp[i]);
   }
+}
+
+MPEGH_DECODER_ERROR updateFadeRamps(HANDLE_MPEGH_DECODER_CONTEXT hCtx, int fadelen) {
+  int i;
 
-  *sample = (int32_t)(*sample * factor);
+  if (fadelen == hCtx->fadeRampLength) {
+    return MPEGH_DEC_OK;
+  }
+  if (fadelen > hCtx->fadeRampCapacity) {
+    // more channels than the target layout
+    FDK_MEM_ARENA* pPrevArena = FDKsetThreadArena(hCtx->arena);
+    FDKafree(hCtx->fadeRamps);
+    hCtx->fadeRamps = (float*)FDKaalloc(2 * fadelen * sizeof(float), ALIGNMENT_DEFAULT);
+    FDKsetThreadArena(pPrevArena);
+    hCtx->fadeRampLength = 0;
+    hCtx->fadeRampCapacity = (hCtx->fadeRamps != NULL) ? fadelen : 0;
+    if (hCtx->fadeRamps == NULL) {
+      return MPEGH_DEC_OUT_OF_MEMORY;
+    }
+  }
+
+  // the ramps run over the interleaved samples of all channels
+  float* fadeinRamp = hCtx->fadeRamps;
+  float* fadeoutRamp = &hCtx->fadeRamps[hCtx->fadeRampCapacity];
+  for (i = 0; i < fadelen; i++) {
+    fadeinRamp[i] = (float)(-cos(M_PI * (float)i / (float)fadelen) + 1.0f) / 2.0f;
+    fadeoutRamp[i] = (float)(cos(M_PI * (float)(i + 1) / (float)fadelen) + 1) / 2.0f;
+  }
+  hCtx->fadeRampLength = fadelen;
+
+  return MPEGH_DEC_OK;
+}
+
+void applyFades(HANDLE_MPEGH_DECODER_CONTEXT hCtx, FadeIndexes* fades, const float* ramp,
+                int fadelen) {
+  int i, num = 0;
+
+  for (i = 0; i < fades->num; i++) {
+    unsigned int index = (unsigned int)fades->idx[i];
+    if (index + fadelen >= deque_size(&hCtx->outputSamplesQueue)) {
+      // not all samples of the fade are available yet
+      fades->idx[num++] = fades->idx[i];
+      continue;
+    }
+    // apply the ramp to the (at most two) linear segments of the ring
+    int done = 0;
+    while (done < fadelen) {
+      unsigned int numLinear = 0;
+      int32_t* pSamples =
+          (int32_t*)deque_at_linear(&hCtx->outputSamplesQueue, index + done, &numLinear);
+      int length = fadelen - done;
+      if ((unsigned int)length > numLinear) {
+        length = (int)numLinear;
+      }
+      fade(pSamples, &ramp[done], length);
+      done += length;
+    }
+  }
+  fades->num = num;
 }
 
 void clearQueues(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
+  hCtx->viewNumSamples = 0;
   deque_clear(&hCtx->timestampInQueue);
   deque_clear(&hCtx->auInfoQueue);
   deque_clear(&hCtx->timestampOutQueue);
   deque_clear(&hCtx->decodedSamplesQueue);
   deque_clear(&hCtx->outputSamplesQueue);
   deque_clear(&hCtx->outputInfoQueue);
-  deque_clear(&hCtx->fadeinIdxQueue);
-  deque_clear(&hCtx->fadeoutIdxQueue);
+  hCtx->fadeinIdx.num = 0;
+  hCtx->fadeoutIdx.num = 0;
 }
 
 MPEGH_DECODER_ERROR restartDecoder(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
@@ -888,6 +1711,14 @@ MPEGH_DECODER_ERROR restartDecoder(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
     return MPEGH_DEC_NULLPTR_ERROR;
   }
 
+  FDK_MEM_ARENA* pPrevArena = FDKsetThreadArena(hCtx->arena);
+  MPEGH_DECODER_ERROR retval = reopenDecoder(hCtx);
+  FDKsetThreadArena(pPrevArena);
+
+  return retval;
+}
+
+MPEGH_DECODER_ERROR reopenDecoder(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
   if (hCtx->mpeghdec != NULL) {
     aacDecoder_Close(hCtx->mpeghdec);
     hCtx->mpeghdec = NULL;
@@ -909,6 +1740,39 @@ MPEGH_DECODER_ERROR restartDecoder(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
     return MPEGH_DEC_UNSUPPORTED_PARAM;
   }
 
+  // keep using the shared scratch memory
+  if (hCtx->scratchPool != NULL) {
+    ErrorStatus = aacDecoder_SetScratchPool(hCtx->mpeghdec, hCtx->scratchPool);
+    if (ErrorStatus != AAC_DEC_OK) {
+      return MPEGH_DEC_OUT_OF_MEMORY;
+    }
+  }
+
+  // keep the core decoder threading configuration
+  if (hCtx->decoderThreads > 1) {
+    ErrorStatus = aacDecoder_SetParam(hCtx->mpeghdec, AAC_DECODER_THREADS, hCtx->decoderThreads);
+    if (ErrorStatus != AAC_DEC_OK) {
+      return MPEGH_DEC_UNSUPPORTED_PARAM;
+    }
+  }
+
+  // keep the object rendering mode
+  if (hCtx->vbapGainGrid) {
+    ErrorStatus = aacDecoder_SetParam(hCtx->mpeghdec, AAC_VBAP_GAIN_GRID, hCtx->vbapGainGrid);
+    if (ErrorStatus != AAC_DEC_OK) {
+      return MPEGH_DEC_UNSUPPORTED_PARAM;
+    }
+  }
+
+  // keep using the renderer setup data
+  if (hCtx->rendererSetup != NULL) {
+    ErrorStatus = aacDecoder_SetRendererSetup(hCtx->mpeghdec, hCtx->rendererSetup,
+                                              hCtx->rendererSetupLength);
+    if (ErrorStatus != AAC_DEC_OK) {
+      return MPEGH_DEC_UNSUPPORTED_PARAM;
+    }
+  }
+
   // set an out-of-band config if it was provided
   if (hCtx->mhaConfigLength > 0 && hCtx->mhaConfig != NULL) {
     ErrorStatus = aacDecoder_ConfigRaw(hCtx->mpeghdec, &hCtx->mhaConfig, &hCtx->mhaConfigLength);
@@ -919,6 +1783,8 @@ MPEGH_DECODER_ERROR restartDecoder(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
 
   clearQueues(hCtx);
   hCtx->zeroSignal = false;
+  hCtx->clearHistory = false;
+  hCtx->lastAuSize = 0;
 
   hCtx->sampleRate = -1;
   hCtx->numberOfChannels = -1;
@@ -988,3 +1854,277 @@ void updateDrcSettings(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
     hCtx->drcUpdate = false;
   }
 }
+
+void concealGap(HANDLE_MPEGH_DECODER_CONTEXT hCtx, uint64_t lastTimestamp, uint64_t timestamp) {
+  int k;
+
+  // the length of the missing access units is taken from the last decoded one
+  if (hCtx->lastAuSize <= 0 || hCtx->sampleRate <= 0) {
+    return;
+  }
+  int durationSamples = (int)(((double)(timestamp - lastTimestamp) * hCtx->sampleRate / 1e9) + 0.5);
+  int gapSamples = durationSamples - hCtx->lastAuSize;
+  if (gapSamples <= hCtx->timingTolerance) {
+    return;
+  }
+  // a remainder of less than half an access unit is left to the timing correction
+  int numFrames = (gapSamples + hCtx->lastAuSize / 2) / hCtx->lastAuSize;
+  uint64_t frameDuration = (uint64_t)((double)hCtx->lastAuSize * 1e9 / hCtx->sampleRate + 0.5);
+
+  for (k = 1; k <= numFrames; k++) {
+    // keep space for the timestamp of the next access unit
+    if (deque_space(&hCtx->timestampInQueue) < 2 ||
+        deque_space(&hCtx->decodedSamplesQueue) < hCtx->maxDecoderOutputSamples) {
+      break;
+    }
+    INT_PCM* pTimeData = (INT_PCM*)deque_bulk_push_back_reserve(&hCtx->decodedSamplesQueue,
+                                                                hCtx->maxDecoderOutputSamples);
+    FDK_MEM_ARENA* pPrevArena = FDKsetThreadArena(hCtx->arena);
+    AAC_DECODER_ERROR err = aacDecoder_DecodeFrame(hCtx->mpeghdec, pTimeData,
+                                                   hCtx->maxDecoderOutputSamples, AACDEC_CONCEAL);
+    FDKsetThreadArena(pPrevArena);
+    CStreamInfo* p_si = aacDecoder_GetStreamInfo(hCtx->mpeghdec);
+    if (!IS_OUTPUT_VALID(err) || p_si == NULL || p_si->frameSize <= 0 || p_si->mpeghAUSize <= 0 ||
+        hCtx->sampleRate != p_si->sampleRate || hCtx->numberOfChannels != p_si->numChannels) {
+      break;
+    }
+
+    uint64_t pts = lastTimestamp + k * frameDuration;
+    deque_push_back(&hCtx->timestampInQueue, &pts);
+    deque_bulk_push_back_commit(&hCtx->decodedSamplesQueue, p_si->frameSize * p_si->numChannels);
+
+    AUInfo auInfo;
+    auInfo.auSize = p_si->mpeghAUSize;
+    auInfo.concealed = true;
+    auInfo.outputLoudness = p_si->outputLoudness;
+    deque_push_back(&hCtx->auInfoQueue, &auInfo);
+  }
+}
+
+#if defined(FDK_HAVE_THREADS)
+static void threadedWorker(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
+  MPEGH_DECODER_THREADED* th = hCtx->threaded;
+  std::unique_lock<std::mutex> guard(th->lock);
+
+  while (!th->shutdown) {
+    unsigned int inputWrite = th->inputWrite.load(std::memory_order_acquire);
+    unsigned int outputRead = th->outputRead.load(std::memory_order_acquire);
+    guard.unlock();
+    while (threadedStep(hCtx)) {
+    }
+    guard.lock();
+    auto wakeUp = [&] {
+      return th->shutdown || th->inputWrite.load(std::memory_order_acquire) != inputWrite ||
+             th->outputRead.load() != outputRead;
+    };
+    if (th->outputWrite.load(std::memory_order_relaxed) - outputRead < THREADED_NUM_OUTPUT_SLOTS) {
+      // wait for new input data
+      th->cvWork.wait(guard, wakeUp);
+    } else {
+      // wait for the consumer to free a slot of the full frame ring. The flag is published before
+      // outputRead is checked again and the consumer advances outputRead before it reads the
+      // flag, so either the worker sees the freed slot or the consumer notifies it.
+      th->workerWaitsForSlot.store(true);
+      th->cvWork.wait_for(guard, std::chrono::milliseconds(THREADED_WORKER_SLOT_WAIT_MS), wakeUp);
+      th->workerWaitsForSlot.store(false, std::memory_order_relaxed);
+    }
+  }
+}
+#endif
+
+static void freeThreaded(MPEGH_DECODER_THREADED* th) {
+  if (th == NULL) {
+    return;
+  }
+  if (th->outputData != NULL) {
+    FDKafree(th->outputData);
+  }
+  if (th->inputData != NULL) {
+    FDKfree(th->inputData);
+  }
+  th->~MPEGH_DECODER_THREADED();
+  FDKfree(th);
+}
+
+MPEGH_DECODER_ERROR startThreadedMode(HANDLE_MPEGH_DECODER_CONTEXT hCtx, int mode) {
+  int i;
+
+#if !defined(FDK_HAVE_THREADS)
+  if (mode == MPEGH_DEC_THREADED_MODE_INTERNAL) {
+    return MPEGH_DEC_UNSUPPORTED_PARAM;
+  }
+#endif
+  if (hCtx->viewNumSamples > 0) {
+    return MPEGH_DEC_BUFFER_ERROR;
+  }
+
+  FDK_MEM_ARENA* pPrevArena = FDKsetThreadArena(hCtx->arena);
+  void* pMem = FDKcalloc(1, sizeof(MPEGH_DECODER_THREADED));
+  MPEGH_DECODER_THREADED* th = (pMem != NULL) ? new (pMem) MPEGH_DECODER_THREADED() : NULL;
+  if (th != NULL) {
+    th->inputData =
+        (uint8_t*)FDKcalloc(THREADED_NUM_INPUT_SLOTS * THREADED_INPUT_SLOT_BYTES, sizeof(uint8_t));
+    th->outputData = (INT_PCM*)FDKaalloc(
+        THREADED_NUM_OUTPUT_SLOTS * hCtx->maxDecoderOutputSamples * sizeof(INT_PCM),
+        ALIGNMENT_DEFAULT);
+  }
+  FDKsetThreadArena(pPrevArena);
+  if (th == NULL || th->inputData == NULL || th->outputData == NULL) {
+    freeThreaded(th);
+    return MPEGH_DEC_OUT_OF_MEMORY;
+  }
+
+  th->mode = mode;
+  for (i = 0; i < THREADED_NUM_INPUT_SLOTS; i++) {
+    th->input[i].data = &th->inputData[i * THREADED_INPUT_SLOT_BYTES];
+  }
+  for (i = 0; i < THREADED_NUM_OUTPUT_SLOTS; i++) {
+    th->output[i].samples = &th->outputData[i * hCtx->maxDecoderOutputSamples];
+  }
+  th->error.store(MPEGH_DEC_OK);
+  hCtx->threaded = th;
+
+#if defined(FDK_HAVE_THREADS)
+  if (mode == MPEGH_DEC_THREADED_MODE_INTERNAL) {
+    try {
+      th->worker = std::thread(threadedWorker, hCtx);
+    } catch (...) {
+      hCtx->threaded = NULL;
+      freeThreaded(th);
+      return MPEGH_DEC_OUT_OF_MEMORY;
+    }
+  }
+#endif
+
+  return MPEGH_DEC_OK;
+}
+
+void stopThreadedMode(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
+  MPEGH_DECODER_THREADED* th = hCtx->threaded;
+  if (th == NULL) {
+    return;
+  }
+
+#if defined(FDK_HAVE_THREADS)
+  if (th->worker.joinable()) {
+    {
+      std::lock_guard<std::mutex> guard(th->lock);
+      th->shutdown = true;
+    }
+    th->cvWork.notify_one();
+    th->worker.join();
+  }
+#endif
+
+  hCtx->threaded = NULL;
+  freeThreaded(th);
+}
+
+MPEGH_DECODER_ERROR threadedQueueInput(HANDLE_MPEGH_DECODER_CONTEXT hCtx, const uint8_t* inData,
+                                       uint32_t inLength, uint64_t timestamp) {
+  MPEGH_DECODER_THREADED* th = hCtx->threaded;
+  unsigned int write = th->inputWrite.load(std::memory_order_relaxed);
+  unsigned int read = th->inputRead.load(std::memory_order_acquire);
+
+  // queue all chunks of the access unit or none of them
+  unsigned int numSlots = (inLength + THREADED_INPUT_SLOT_BYTES - 1) / THREADED_INPUT_SLOT_BYTES;
+  if (numSlots == 0) {
+    numSlots = 1;  // flush request
+  }
+  if (THREADED_NUM_INPUT_SLOTS - (write - read) < numSlots) {
+    return MPEGH_DEC_BUFFER_ERROR;
+  }
+
+  // consecutive chunks carry the same timestamp, which is stored only once by decodeAccessUnit()
+  do {
+    ThreadedInput* slot = &th->input[write % THREADED_NUM_INPUT_SLOTS];
+    slot->length = (inLength < THREADED_INPUT_SLOT_BYTES) ? inLength : THREADED_INPUT_SLOT_BYTES;
+    slot->timestamp = timestamp;
+    if (slot->length > 0) {
+      FDKmemcpy(slot->data, inData, slot->length);
+      inData += slot->length;
+      inLength -= slot->length;
+    }
+    write++;
+  } while (inLength > 0);
+  th->inputWrite.store(write, std::memory_order_release);
+
+#if defined(FDK_HAVE_THREADS)
+  if (th->mode == MPEGH_DEC_THREADED_MODE_INTERNAL) {
+    // taking the lock ensures that the worker is either waiting or sees the new input
+    { std::lock_guard<std::mutex> guard(th->lock); }
+    th->cvWork.notify_one();
+  }
+#endif
+
+  // report an error of the asynchronous decoding once
+  return (MPEGH_DECODER_ERROR)th->error.exchange(MPEGH_DEC_OK);
+}
+
+bool threadedStep(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
+  MPEGH_DECODER_THREADED* th = hCtx->threaded;
+  bool progress = false;
+
+  // move the ready frames into the frame ring
+  unsigned int write = th->outputWrite.load(std::memory_order_relaxed);
+  while (write - th->outputRead.load(std::memory_order_acquire) < THREADED_NUM_OUTPUT_SLOTS) {
+    ThreadedOutput* slot = &th->output[write % THREADED_NUM_OUTPUT_SLOTS];
+    unsigned int outNumSamples = 0;
+    if (prepareOutputFrame(hCtx, &slot->info, &outNumSamples) != MPEGH_DEC_OK) {
+      break;
+    }
+    deque_bulk_pop_front_copy(&hCtx->outputSamplesQueue, slot->samples, outNumSamples);
+    adjustFadeIndexes(hCtx, outNumSamples);
+    th->outputWrite.store(++write, std::memory_order_release);
+    progress = true;
+  }
+
+  // decode the next input chunk; it stays queued while the internal queues are full
+  unsigned int read = th->inputRead.load(std::memory_order_relaxed);
+  if (read != th->inputWrite.load(std::memory_order_acquire)) {
+    ThreadedInput* slot = &th->input[read % THREADED_NUM_INPUT_SLOTS];
+    MPEGH_DECODER_ERROR err;
+    if (slot->length > 0) {
+      err = decodeAccessUnit(hCtx, slot->data, slot->length, slot->timestamp);
+    } else {
+      err = decodeFlush(hCtx);
+    }
+    if (err != MPEGH_DEC_BUFFER_ERROR) {
+      if (err != MPEGH_DEC_OK) {
+        int expected = MPEGH_DEC_OK;
+        th->error.compare_exchange_strong(expected, err);
+      }
+      th->inputRead.store(read + 1, std::memory_order_release);
+      progress = true;
+    }
+  }
+
+  return progress;
+}
+
+const INT_PCM* threadedFrontFrame(MPEGH_DECODER_THREADED* th, MPEGH_DECODER_OUTPUT_INFO* outInfo,
+                                  unsigned int* pNumSamples) {
+  unsigned int read = th->outputRead.load(std::memory_order_relaxed);
+  if (read == th->outputWrite.load(std::memory_order_acquire)) {
+    FDKmemclear(outInfo, sizeof(MPEGH_DECODER_OUTPUT_INFO));
+    return NULL;
+  }
+
+  ThreadedOutput* slot = &th->output[read % THREADED_NUM_OUTPUT_SLOTS];
+  *outInfo = slot->info;
+  *pNumSamples = slot->info.numSamplesPerChannel * slot->info.numChannels;
+  return slot->samples;
+}
+
+void threadedPopFrame(MPEGH_DECODER_THREADED* th) {
+  th->outputRead.store(th->outputRead.load(std::memory_order_relaxed) + 1);
+
+#if defined(FDK_HAVE_THREADS)
+  // the freed slot lets a worker sleeping on a full frame ring continue. The consumer must not
+  // wait for the worker lock, so the notification can be lost if the worker is just about to
+  // sleep; its wait is bounded by THREADED_WORKER_SLOT_WAIT_MS.
+  if (th->mode == MPEGH_DEC_THREADED_MODE_INTERNAL && th->workerWaitsForSlot.load()) {
+    th->cvWork.notify_one();
+  }
+#endif
+}
@@ -97,6 +97,8 @@ amm-info@iis.fraunhofer.de
 
 #if defined(__arm__)
 #include "arm/stereo_arm.cpp"
+#elif defined(__x86__)
+#include "x86/stereo_x86.cpp"
 #endif
 
 enum { L = 0, R = 1 };
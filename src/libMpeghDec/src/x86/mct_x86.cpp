@@ -0,0 +1,149 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2018 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+/************************* MPEG-H 3DA decoder library **************************
+
+   Author(s):
+
+   Description: multi-channel tool x86 SSE4.1 optimized functions
+
+*******************************************************************************/
+
+#if defined(__x86_SSE4_1__)
+#include "x86/FDK_x86_funcs.h"
+
+#define FUNCTION_applyMctRotationIdx_func1
+
+/* applyMctRotationIdx_func1() requires SSE4.1 */
+#define mct_func_enabled() FDK_X86_HAS_SSE4_1
+#endif
+
+#ifdef FUNCTION_applyMctRotationIdx_func1
+static FDK_X86_TARGET_SSE4_1 void applyMctRotationIdx_func1(
+    FIXP_DBL* RESTRICT dmx, SHORT* RESTRICT dmxExp, FIXP_DBL* RESTRICT res, SHORT* RESTRICT resExp,
+    INT OutExp, INT nSamples, /* usually a multiple of 4 */
+    FIXP_SGL SinAlpha, FIXP_SGL CosAlpha, INT lScale, INT rScale) {
+  const __m128i sinAlpha = _mm_set1_epi32((INT)FX_SGL2FX_DBL(SinAlpha));
+  const __m128i cosAlpha = _mm_set1_epi32((INT)FX_SGL2FX_DBL(CosAlpha));
+  const __m128i lShift = _mm_cvtsi32_si128(lScale);
+  const __m128i rShift = _mm_cvtsi32_si128(rScale);
+  __m128i dmxMax = _mm_setzero_si128();
+  __m128i resMax = _mm_setzero_si128();
+  int n;
+
+  /* Rotate and collect the headroom of both outputs in the same pass */
+  for (n = 0; n <= nSamples - 4; n += 4) {
+    __m128i tmpDmx = _mm_loadu_si128((const __m128i*)&dmx[n]);
+    __m128i tmpRes = _mm_loadu_si128((const __m128i*)&res[n]);
+
+    __m128i outDmx =
+        _mm_sub_epi32(_mm_sra_epi32(FDK_mm_fMultDiv2_epi32(tmpDmx, cosAlpha), lShift),
+                      _mm_sra_epi32(FDK_mm_fMultDiv2_epi32(tmpRes, sinAlpha), rShift));
+    __m128i outRes =
+        _mm_add_epi32(_mm_sra_epi32(FDK_mm_fMultDiv2_epi32(tmpDmx, sinAlpha), lShift),
+                      _mm_sra_epi32(FDK_mm_fMultDiv2_epi32(tmpRes, cosAlpha), rShift));
+
+    _mm_storeu_si128((__m128i*)&dmx[n], outDmx);
+    _mm_storeu_si128((__m128i*)&res[n], outRes);
+
+    dmxMax = _mm_or_si128(dmxMax, FDK_mm_headroom_epi32(outDmx));
+    resMax = _mm_or_si128(resMax, FDK_mm_headroom_epi32(outRes));
+  }
+  for (; n < nSamples; n++) {
+    FIXP_DBL temp_dmx = dmx[n];
+    FIXP_DBL temp_res = res[n];
+    dmx[n] = (fMultDiv2(temp_dmx, CosAlpha) >> lScale) - (fMultDiv2(temp_res, SinAlpha) >> rScale);
+    res[n] = (fMultDiv2(temp_dmx, SinAlpha) >> lScale) + (fMultDiv2(temp_res, CosAlpha) >> rScale);
+    dmxMax = _mm_or_si128(dmxMax, FDK_mm_headroom_epi32(_mm_cvtsi32_si128(dmx[n])));
+    resMax = _mm_or_si128(resMax, FDK_mm_headroom_epi32(_mm_cvtsi32_si128(res[n])));
+  }
+
+  /* headroom = getScalefactor() - 1 */
+  int headroom = fMax(0, (INT)fixnormz_D(FDK_mm_hor_epi32(dmxMax)) - 1) - 1;
+  scaleValues(dmx, nSamples, headroom);
+  *dmxExp = OutExp - headroom;
+
+  headroom = fMax(0, (INT)fixnormz_D(FDK_mm_hor_epi32(resMax)) - 1) - 1;
+  scaleValues(res, nSamples, headroom);
+  *resExp = OutExp - headroom;
+}
+#endif /* FUNCTION_applyMctRotationIdx_func1 */
@@ -96,4 +96,30 @@ amm-info@iis.fraunhofer.de
 void FDK_interleave(const FIXP_DBL* RESTRICT pIn, LONG* RESTRICT pOut, const UINT channels,
                     const UINT frameSize, const UINT length);
 
+/**
+ * \brief Deinterleave 32 bit PCM samples and convert them to the output format.
+ *
+ * Channel ch of the interleaved input is written to pOut[ch * frameSize ... ch * frameSize +
+ * length - 1]. With channels = 1 and frameSize = length, the function only converts the format
+ * of an (interleaved) buffer.
+ *
+ * \param pIn        Interleaved full scale 32 bit input samples.
+ * \param pOut       Planar output samples.
+ * \param channels   Number of channels.
+ * \param frameSize  Distance of two channels in the output buffer in samples.
+ * \param length     Number of samples per channel.
+ * \param shift      Right shift applied to the samples (LONG output only), e.g. 8 for 24 bit
+ *                   samples in 32 bit containers.
+ */
+void FDK_deinterleave(const LONG* RESTRICT pIn, LONG* RESTRICT pOut, const UINT channels,
+                      const UINT frameSize, const UINT length, const INT shift);
+
+/** \brief Same as above, output as 16 bit samples (truncated). */
+void FDK_deinterleave(const LONG* RESTRICT pIn, SHORT* RESTRICT pOut, const UINT channels,
+                      const UINT frameSize, const UINT length);
+
+/** \brief Same as above, output as float samples in the range [-1.0, 1.0). */
+void FDK_deinterleave(const LONG* RESTRICT pIn, float* RESTRICT pOut, const UINT channels,
+                      const UINT frameSize, const UINT length);
+
 #endif /* !defined(PCM_UTILS_H) */
@@ -98,6 +98,8 @@ amm-info@iis.fraunhofer.de
 
 #if defined(__arm__)
 #include "arm/limiter_arm.cpp"
+#elif defined(__x86__)
+#include "x86/limiter_x86.cpp"
 #endif
 
 /* create limiter */
@@ -157,6 +159,112 @@ TDLimiterPtr pcmLimiter_Create(unsigned int maxAttackMs, unsigned int releaseMs,
   return limiter;
 }
 
+/* Write length delayed samples to the output. If gain is not zero, the samples are multiplied
+   with gain (downscaled by one) before the output scaling, as done by the limiter in default
+   mode. */
+static void limiterOutput(const FIXP_DBL* pIn, INT_PCM* pOut, const UINT length,
+                          const FIXP_DBL gain, const INT scaling) {
+#if defined(FUNCTION_applyLimiter_func5) && (SAMPLE_BITS == DFRACT_BITS)
+  applyLimiter_func5(pIn, pOut, length, gain, scaling);
+#else
+  UINT i;
+#if (SAMPLE_BITS != DFRACT_BITS)
+  const FIXP_DBL roundingConst = (FIXP_DBL)0x8000 >> (scaling + 1);
+  const INT roundingScaling = scaling + 1;
+#endif
+
+  if (gain == (FIXP_DBL)0) {
+    for (i = 0; i < length; i++) {
+#if (SAMPLE_BITS == DFRACT_BITS)
+      pOut[i] = (INT_PCM)FX_DBL2FX_PCM((FIXP_DBL)SATURATE_LEFT_SHIFT(pIn[i], scaling, DFRACT_BITS));
+#else
+      pOut[i] = (INT_PCM)FX_DBL2FX_PCM((FIXP_DBL)SATURATE_LEFT_SHIFT(
+          (pIn[i] >> 1) + roundingConst, roundingScaling, DFRACT_BITS));
+#endif
+    }
+  } else {
+    for (i = 0; i < length; i++) {
+      FIXP_DBL tmp = fMult(pIn[i], gain);
+#if (SAMPLE_BITS == DFRACT_BITS)
+      pOut[i] =
+          (INT_PCM)FX_DBL2FX_PCM((FIXP_DBL)SATURATE_LEFT_SHIFT(tmp, scaling + 1, DFRACT_BITS));
+#else
+      pOut[i] = (INT_PCM)FX_DBL2FX_PCM(
+          (FIXP_DBL)SATURATE_LEFT_SHIFT(tmp + roundingConst, roundingScaling, DFRACT_BITS));
+#endif
+    }
+  }
+#endif /* defined(FUNCTION_applyLimiter_func5) && (SAMPLE_BITS == DFRACT_BITS) */
+}
+
+/* Pass nSamples through the delay line with a constant gain (see limiterOutput()): output the
+   delayed signal and fill the delay line from the input. Returns the new delayBufIdx. */
+static UINT limiterProcessDelayLine(FIXP_DBL* delayBuf, UINT delayBufIdx, const UINT attack,
+                                    const UINT channels, const PCM_LIM* samplesIn,
+                                    INT_PCM* samplesOut, const UINT nSamples, const FIXP_DBL gain,
+                                    const INT scaling) {
+  /* Copy delayed signal from delay line to output */
+  UINT delayHeadLength = attack - delayBufIdx; /* delayHead: part of buffer after delayBufIdx */
+  UINT delayTailLength = delayBufIdx; /* delayTail: part of buffer from beginning to delayBufIdx */
+
+  UINT delayHeadCopyLength = fMin(delayHeadLength, nSamples);
+  UINT delayTailCopyLength = fMin(delayTailLength, nSamples - delayHeadCopyLength);
+
+  limiterOutput(delayBuf + delayBufIdx * channels, samplesOut, delayHeadCopyLength * channels,
+                gain, scaling);
+  limiterOutput(delayBuf, samplesOut + delayHeadCopyLength * channels,
+                delayTailCopyLength * channels, gain, scaling);
+
+  /* Copy delayed signal that was not contained in delay line directly from input to output */
+  INT delayDirectLength = (INT)nSamples - (INT)attack;
+  UINT delayDirectCopyLength = fMax(delayDirectLength, (INT)0);
+
+#if PCM_LIM_BITS == DFRACT_BITS
+  limiterOutput(samplesIn, samplesOut + attack * channels, delayDirectCopyLength * channels, gain,
+                scaling);
+#else
+  for (UINT i = 0; i < (delayDirectCopyLength * channels); i++) {
+    FIXP_DBL tmpSamplesIn = PCM_LIM2FIXP_DBL(samplesIn[i]);
+    limiterOutput(&tmpSamplesIn, samplesOut + attack * channels + i, 1, gain, scaling);
+  }
+#endif
+
+  /* Increment delayBufIdx to the position where delay line is to be filled */
+  delayBufIdx = (delayBufIdx + delayDirectCopyLength) % attack;
+
+  /* Fill delay line from input */
+  delayHeadLength = attack - delayBufIdx;
+  delayTailLength = delayBufIdx;
+
+  delayHeadCopyLength = fMin(delayHeadLength, nSamples);
+  delayTailCopyLength = fMin(delayTailLength, nSamples - delayHeadCopyLength);
+
+#if PCM_LIM_BITS == DFRACT_BITS
+  FDKmemcpy(delayBuf + delayBufIdx * channels, samplesIn + delayDirectCopyLength * channels,
+            delayHeadCopyLength * channels * sizeof(PCM_LIM));
+#else
+  FIXP_DBL* p2Delay = delayBuf + delayBufIdx * channels;
+  const PCM_LIM* p2Input = samplesIn + delayDirectCopyLength * channels;
+  for (UINT i = 0; i < (delayHeadCopyLength * channels); i++) {
+    *p2Delay++ = PCM_LIM2FIXP_DBL(p2Input[i]);
+  }
+#endif
+
+#if PCM_LIM_BITS == DFRACT_BITS
+  FDKmemcpy(delayBuf, samplesIn + (delayDirectCopyLength + delayHeadCopyLength) * channels,
+            delayTailCopyLength * channels * sizeof(PCM_LIM));
+#else
+  p2Delay = delayBuf;
+  p2Input = samplesIn + (delayDirectCopyLength + delayHeadCopyLength) * channels;
+  for (UINT i = 0; i < (delayTailCopyLength * channels); i++) {
+    *p2Delay++ = PCM_LIM2FIXP_DBL(p2Input[i]);
+  }
+#endif
+
+  /* Increment delayBufIdx after filling delay line */
+  return (delayBufIdx + delayHeadCopyLength + delayTailCopyLength) % attack;
+}
+
 /* apply limiter */
 TDLIMITER_ERROR pcmLimiter_Apply(TDLimiterPtr limiter, PCM_LIM* samplesIn, INT_PCM* samplesOut,
                                  PCM_LIM* workBuf, FIXP_DBL* pGainPerSample, const INT scaling,
@@ -191,10 +299,12 @@ TDLIMITER_ERROR pcmLimiter_Apply(TDLimiterPtr limiter, PCM_LIM* samplesIn, INT_P
       limiter->scaling = scaling;
     }
 
-    /* Preparatory step. Find local maxima and store them in an array. Find the global maximum. */
+    /* Preparatory step. Find the global maximum. If the additional gain is applied here, also find
+       the local maxima and store them in an array. */
     PCM_LIM global_max = (PCM_LIM)0;
     PCM_LIM* loc_max_array = workBuf;
     PCM_LIM* pIn = samplesIn;
+    int locMaxAvailable = 1;
 
 #if (PCM_LIM_BITS == 32)
     if (additionalGainAvailable) {
@@ -213,14 +323,15 @@ TDLIMITER_ERROR pcmLimiter_Apply(TDLimiterPtr limiter, PCM_LIM* samplesIn, INT_P
     } else
 #endif
     {
-      for (i = 0; i < nSamples; i++) {
-        PCM_LIM loc_max = (PCM_LIM)0;
-        for (j = 0; j < channels; j++) {
-          loc_max = fMax(loc_max, (PCM_LIM)fAbs(*pIn++));
-        }
-        loc_max_array[i] = loc_max;
-        global_max = fMax(global_max, loc_max);
+      /* The local maxima are only needed if the limiter is active, see below. */
+      locMaxAvailable = 0;
+#if defined(FUNCTION_applyLimiter_func2)
+      global_max = applyLimiter_func2(samplesIn, nSamples * channels);
+#else
+      for (i = 0; i < nSamples * channels; i++) {
+        global_max = fMax(global_max, (PCM_LIM)fAbs(samplesIn[i]));
       }
+#endif
     }
 
 #if (PCM_LIM_BITS != 32)
@@ -240,87 +351,8 @@ TDLIMITER_ERROR pcmLimiter_Apply(TDLimiterPtr limiter, PCM_LIM* samplesIn, INT_P
 
     /* Simplified mode.The limiter is not active. Just handle Circular Buffer Input/Output. */
     if (limiter->cleanSamples > TDLIMIT_FALLBACK_FACTOR * limiter->release) {
-      /* Copy delayed signal from delay line to output */
-      UINT delayHeadLength = attack - delayBufIdx; /* delayHead: part of buffer after delayBufIdx */
-      UINT delayTailLength =
-          delayBufIdx; /* delayTail: part of buffer from beginning to delayBufIdx */
-
-      UINT delayHeadCopyLength = fMin(delayHeadLength, nSamples);
-      UINT delayTailCopyLength = fMin(delayTailLength, nSamples - delayHeadCopyLength);
-
-      FIXP_DBL* p2Data = delayBuf + delayBufIdx * channels;
-      INT_PCM* p2Output = samplesOut;
-      for (i = 0; i < (delayHeadCopyLength * channels); i++) {
-#if (SAMPLE_BITS == DFRACT_BITS)
-        *p2Output++ =
-            (INT_PCM)FX_DBL2FX_PCM((FIXP_DBL)SATURATE_LEFT_SHIFT(p2Data[i], scaling, DFRACT_BITS));
-#else
-        *p2Output++ = (INT_PCM)FX_DBL2FX_PCM((FIXP_DBL)SATURATE_LEFT_SHIFT(
-            (p2Data[i] >> 1) + roundingConst, roundingScaling, DFRACT_BITS));
-#endif
-      }
-
-      p2Data = delayBuf;
-      for (i = 0; i < (delayTailCopyLength * channels); i++) {
-#if (SAMPLE_BITS == DFRACT_BITS)
-        *p2Output++ =
-            (INT_PCM)FX_DBL2FX_PCM((FIXP_DBL)SATURATE_LEFT_SHIFT(p2Data[i], scaling, DFRACT_BITS));
-#else
-        *p2Output++ = (INT_PCM)FX_DBL2FX_PCM((FIXP_DBL)SATURATE_LEFT_SHIFT(
-            (p2Data[i] >> 1) + roundingConst, roundingScaling, DFRACT_BITS));
-#endif
-      }
-
-      /* Copy delayed signal that was not contained in delay line directly from input to output */
-      INT delayDirectLength = (INT)nSamples - (INT)attack;
-      UINT delayDirectCopyLength = fMax(delayDirectLength, (INT)0);
-
-      p2Output = samplesOut + attack * channels;
-      for (i = 0; i < (delayDirectCopyLength * channels); i++) {
-        FIXP_DBL tmpSamplesIn = PCM_LIM2FIXP_DBL(samplesIn[i]);
-#if (SAMPLE_BITS == DFRACT_BITS)
-        *p2Output++ = (INT_PCM)FX_DBL2FX_PCM(
-            (FIXP_DBL)SATURATE_LEFT_SHIFT(tmpSamplesIn, scaling, DFRACT_BITS));
-#else
-        *p2Output++ = (INT_PCM)FX_DBL2FX_PCM((FIXP_DBL)SATURATE_LEFT_SHIFT(
-            (tmpSamplesIn >> 1) + roundingConst, roundingScaling, DFRACT_BITS));
-#endif
-      }
-
-      /* Increment delayBufIdx to the position where delay line is to be filled */
-      delayBufIdx = (delayBufIdx + delayDirectCopyLength) % attack;
-
-      /* Fill delay line from input */
-      delayHeadLength = attack - delayBufIdx;
-      delayTailLength = delayBufIdx;
-
-      delayHeadCopyLength = fMin(delayHeadLength, nSamples);
-      delayTailCopyLength = fMin(delayTailLength, nSamples - delayHeadCopyLength);
-
-#if PCM_LIM_BITS == DFRACT_BITS
-      FDKmemcpy(delayBuf + delayBufIdx * channels, samplesIn + delayDirectCopyLength * channels,
-                delayHeadCopyLength * channels * sizeof(PCM_LIM));
-#else
-      FIXP_DBL* p2Delay = delayBuf + delayBufIdx * channels;
-      PCM_LIM* p2Input = samplesIn + delayDirectCopyLength * channels;
-      for (i = 0; i < (delayHeadCopyLength * channels); i++) {
-        *p2Delay++ = PCM_LIM2FIXP_DBL(p2Input[i]);
-      }
-#endif
-
-#if PCM_LIM_BITS == DFRACT_BITS
-      FDKmemcpy(delayBuf, samplesIn + (delayDirectCopyLength + delayHeadCopyLength) * channels,
-                delayTailCopyLength * channels * sizeof(PCM_LIM));
-#else
-      p2Delay = delayBuf;
-      p2Input = samplesIn + (delayDirectCopyLength + delayHeadCopyLength) * channels;
-      for (i = 0; i < (delayTailCopyLength * channels); i++) {
-        *p2Delay++ = PCM_LIM2FIXP_DBL(p2Input[i]);
-      }
-#endif
-
-      /* Increment delayBufIdx after filling delay line */
-      delayBufIdx = (delayBufIdx + delayHeadCopyLength + delayTailCopyLength) % attack;
+      delayBufIdx = limiterProcessDelayLine(delayBuf, delayBufIdx, attack, channels, samplesIn,
+                                            samplesOut, nSamples, (FIXP_DBL)0, scaling);
 
       /* If we come from the default mode, then reset state */
       if (limiter->previous_mode == 1) {
@@ -338,6 +370,30 @@ TDLIMITER_ERROR pcmLimiter_Apply(TDLimiterPtr limiter, PCM_LIM* samplesIn, INT_P
 
       /* Limit cleanSamples growth */
       limiter->cleanSamples = (TDLIMIT_FALLBACK_FACTOR + 1) * limiter->release;
+    } else if ((PCM_LIM2FIXP_DBL(global_max) <= threshold) && (max <= threshold) &&
+               (limiter->smoothState0 == FL2FXCONST_DBL(1.0f / (1 << 1))) &&
+               ((PCM_LIM_BITS == 32) || !additionalGainAvailable)) {
+      /* Default mode, but the gain has already returned to 1.0 and neither the running maximum nor
+         this block exceed the threshold. The running maximum stays at the threshold and the gain
+         at 1.0 for every sample, so apply it to the whole block at once. */
+      unsigned int maxBufIdx = limiter->maxBufIdx;
+
+      delayBufIdx = limiterProcessDelayLine(delayBuf, delayBufIdx, attack, channels, samplesIn,
+                                            samplesOut, nSamples, FL2FXCONST_DBL(1.0f / (1 << 1)),
+                                            scaling);
+
+      for (i = 0; i < fMin(nSamples, attack + 1); i++) {
+        maxBuf[(maxBufIdx + i) % (attack + 1)] = threshold;
+      }
+      if (nSamples > 0) {
+        max = threshold;
+        limiter->cor = FL2FXCONST_DBL(1.0f / (1 << 1));
+      }
+      limiter->max = max;
+      limiter->maxBufIdx = (maxBufIdx + nSamples) % (attack + 1);
+      limiter->delayBufIdx = delayBufIdx;
+      limiter->minGain = FL2FXCONST_DBL(1.0f / (1 << 1));
+      limiter->previous_mode = 1; /*Set to default mode*/
     } else {
       unsigned int maxBufIdx = limiter->maxBufIdx;
       FIXP_DBL tmp, old;
@@ -348,6 +404,21 @@ TDLIMITER_ERROR pcmLimiter_Apply(TDLimiterPtr limiter, PCM_LIM* samplesIn, INT_P
       FIXP_DBL cor = limiter->cor;
       FIXP_DBL smoothState0 = limiter->smoothState0;
 
+      if (!locMaxAvailable) {
+        /* Find the local maxima across all channels */
+#if defined(FUNCTION_applyLimiter_func4)
+        applyLimiter_func4(samplesIn, loc_max_array, nSamples, channels);
+#else
+        for (i = 0; i < nSamples; i++) {
+          PCM_LIM loc_max = (PCM_LIM)0;
+          for (j = 0; j < channels; j++) {
+            loc_max = fMax(loc_max, (PCM_LIM)fAbs(*pIn++));
+          }
+          loc_max_array[i] = loc_max;
+        }
+#endif
+      }
+
       for (i = 0; i < nSamples; i++) {
         tmp = PCM_LIM2FIXP_DBL(loc_max_array[i]);
 
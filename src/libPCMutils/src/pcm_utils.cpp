@@ -92,6 +92,8 @@ amm-info@iis.fraunhofer.de
 
 #if defined(__arm__)
 #include "arm/pcm_utils_arm.cpp"
+#elif defined(__x86__)
+#include "x86/pcm_utils_x86.cpp"
 #endif
 
 #ifndef FUNCTION_FDK_interleave_DBL_LONG
@@ -107,3 +109,41 @@ void FDK_interleave(const FIXP_DBL* RESTRICT pIn, LONG* RESTRICT pOut, const UIN
   }
 }
 #endif
+
+#ifndef FUNCTION_FDK_deinterleave_LONG
+void FDK_deinterleave(const LONG* RESTRICT pIn, LONG* RESTRICT pOut, const UINT channels,
+                      const UINT frameSize, const UINT length, const INT shift) {
+  for (UINT ch = 0; ch < channels; ch++) {
+    const LONG* In = &pIn[ch];
+    LONG* Out = &pOut[ch * frameSize];
+    for (UINT sample = 0; sample < length; sample++) {
+      *Out++ = *In >> shift;
+      In += channels;
+    }
+  }
+}
+
+void FDK_deinterleave(const LONG* RESTRICT pIn, SHORT* RESTRICT pOut, const UINT channels,
+                      const UINT frameSize, const UINT length) {
+  for (UINT ch = 0; ch < channels; ch++) {
+    const LONG* In = &pIn[ch];
+    SHORT* Out = &pOut[ch * frameSize];
+    for (UINT sample = 0; sample < length; sample++) {
+      *Out++ = (SHORT)(*In >> 16);
+      In += channels;
+    }
+  }
+}
+
+void FDK_deinterleave(const LONG* RESTRICT pIn, float* RESTRICT pOut, const UINT channels,
+                      const UINT frameSize, const UINT length) {
+  for (UINT ch = 0; ch < channels; ch++) {
+    const LONG* In = &pIn[ch];
+    float* Out = &pOut[ch * frameSize];
+    for (UINT sample = 0; sample < length; sample++) {
+      *Out++ = (float)*In * (1.0f / 2147483648.0f);
+      In += channels;
+    }
+  }
+}
+#endif
@@ -0,0 +1,351 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2018 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+/**************************** PCM utility library ******************************
+
+   Author(s):
+
+   Description: x86 SSE4.1/AVX2 versions of the limiter peak detection and output scaling
+
+*******************************************************************************/
+
+#if defined(__x86_SSE4_1__)
+#include "x86/FDK_x86_funcs.h"
+
+#if (PCM_LIM_BITS == 32)
+#define FUNCTION_applyLimiter_func2
+#define FUNCTION_applyLimiter_func3
+#define FUNCTION_applyLimiter_func4
+#endif
+#if (SAMPLE_BITS == DFRACT_BITS)
+#define FUNCTION_applyLimiter_func5
+#endif
+#endif /* defined(__x86_SSE4_1__) */
+
+#if defined(FUNCTION_applyLimiter_func2) || defined(FUNCTION_applyLimiter_func4)
+/* Four times fAbs(x), identical to fixabs_D(): MINVAL_DBL yields MAXVAL_DBL. */
+static inline FDK_X86_TARGET_SSE4_1 __m128i limiterAbs_epi32(__m128i x) {
+  return FDK_mm_headroom_epi32(_mm_add_epi32(x, _mm_srai_epi32(x, 31)));
+}
+
+#if defined(__x86_AVX2__)
+/* Eight times fAbs(x), identical to fixabs_D(). */
+static inline FDK_X86_TARGET_AVX2 __m256i limiterAbs256_epi32(__m256i x) {
+  return FDK_mm256_headroom_epi32(_mm256_add_epi32(x, _mm256_srai_epi32(x, 31)));
+}
+#endif /* defined(__x86_AVX2__) */
+#endif
+
+#if defined(FUNCTION_applyLimiter_func2)
+/* Maximum of fAbs(samplesIn[i]) for i < length, at least 0. */
+static FDK_X86_TARGET_SSE4_1 PCM_LIM applyLimiter_func2_SSE4_1(const PCM_LIM* samplesIn,
+                                                               UINT length) {
+  __m128i max0 = _mm_setzero_si128(), max1 = _mm_setzero_si128();
+  UINT i = 0;
+
+  for (; i + 8 <= length; i += 8) {
+    max0 = _mm_max_epi32(max0, limiterAbs_epi32(_mm_loadu_si128((const __m128i*)&samplesIn[i])));
+    max1 = _mm_max_epi32(max1,
+                         limiterAbs_epi32(_mm_loadu_si128((const __m128i*)&samplesIn[i + 4])));
+  }
+  PCM_LIM max = (PCM_LIM)FDK_mm_hmax_epi32(_mm_max_epi32(max0, max1));
+  for (; i < length; i++) {
+    max = fMax(max, (PCM_LIM)fAbs(samplesIn[i]));
+  }
+  return max;
+}
+
+#if defined(__x86_AVX2__)
+static FDK_X86_TARGET_AVX2 PCM_LIM applyLimiter_func2_AVX2(const PCM_LIM* samplesIn,
+                                                           UINT length) {
+  __m256i max0 = _mm256_setzero_si256(), max1 = _mm256_setzero_si256();
+  UINT i = 0;
+
+  for (; i + 16 <= length; i += 16) {
+    max0 = _mm256_max_epi32(
+        max0, limiterAbs256_epi32(_mm256_loadu_si256((const __m256i*)&samplesIn[i])));
+    max1 = _mm256_max_epi32(
+        max1, limiterAbs256_epi32(_mm256_loadu_si256((const __m256i*)&samplesIn[i + 8])));
+  }
+  max0 = _mm256_max_epi32(max0, max1);
+  PCM_LIM max = (PCM_LIM)FDK_mm_hmax_epi32(
+      _mm_max_epi32(_mm256_castsi256_si128(max0), _mm256_extracti128_si256(max0, 1)));
+  return fMax(max, applyLimiter_func2_SSE4_1(&samplesIn[i], length - i));
+}
+#endif /* defined(__x86_AVX2__) */
+
+static inline PCM_LIM applyLimiter_func2(const PCM_LIM* samplesIn, UINT length) {
+  PCM_LIM max = (PCM_LIM)0;
+#if defined(__x86_AVX2__)
+  if (FDK_X86_HAS_AVX2) {
+    return applyLimiter_func2_AVX2(samplesIn, length);
+  }
+#endif
+  if (FDK_X86_HAS_SSE4_1) {
+    return applyLimiter_func2_SSE4_1(samplesIn, length);
+  }
+  for (UINT i = 0; i < length; i++) {
+    max = fMax(max, (PCM_LIM)fAbs(samplesIn[i]));
+  }
+  return max;
+}
+#endif /* defined(FUNCTION_applyLimiter_func2) */
+
+#if defined(FUNCTION_applyLimiter_func3)
+/* Maximum of maxBuf[i] for i < length, length > 0. */
+static FDK_X86_TARGET_SSE4_1 FIXP_DBL applyLimiter_func3_SSE4_1(const FIXP_DBL* maxBuf,
+                                                                UINT length) {
+  __m128i max4 = _mm_set1_epi32(maxBuf[0]);
+  UINT i = 0;
+
+  for (; i + 4 <= length; i += 4) {
+    max4 = _mm_max_epi32(max4, _mm_loadu_si128((const __m128i*)&maxBuf[i]));
+  }
+  FIXP_DBL max = (FIXP_DBL)FDK_mm_hmax_epi32(max4);
+  for (; i < length; i++) {
+    max = fMax(max, maxBuf[i]);
+  }
+  return max;
+}
+
+#if defined(__x86_AVX2__)
+static FDK_X86_TARGET_AVX2 FIXP_DBL applyLimiter_func3_AVX2(const FIXP_DBL* maxBuf, UINT length) {
+  __m256i max8 = _mm256_set1_epi32(maxBuf[0]);
+  UINT i = 0;
+
+  for (; i + 8 <= length; i += 8) {
+    max8 = _mm256_max_epi32(max8, _mm256_loadu_si256((const __m256i*)&maxBuf[i]));
+  }
+  FIXP_DBL max = (FIXP_DBL)FDK_mm_hmax_epi32(
+      _mm_max_epi32(_mm256_castsi256_si128(max8), _mm256_extracti128_si256(max8, 1)));
+  for (; i < length; i++) {
+    max = fMax(max, maxBuf[i]);
+  }
+  return max;
+}
+#endif /* defined(__x86_AVX2__) */
+
+static inline FIXP_DBL applyLimiter_func3(const FIXP_DBL* maxBuf, UINT length) {
+  FIXP_DBL max = maxBuf[0];
+#if defined(__x86_AVX2__)
+  if (FDK_X86_HAS_AVX2) {
+    return applyLimiter_func3_AVX2(maxBuf, length);
+  }
+#endif
+  if (FDK_X86_HAS_SSE4_1) {
+    return applyLimiter_func3_SSE4_1(maxBuf, length);
+  }
+  for (UINT i = 1; i < length; i++) {
+    max = fMax(max, maxBuf[i]);
+  }
+  return max;
+}
+#endif /* defined(FUNCTION_applyLimiter_func3) */
+
+#if defined(FUNCTION_applyLimiter_func4)
+/* locMax[i] = maximum of fAbs() of the channels samples of sample i, at least 0. */
+static FDK_X86_TARGET_SSE4_1 void applyLimiter_func4_SSE4_1(const PCM_LIM* samplesIn,
+                                                            PCM_LIM* locMax, UINT nSamples,
+                                                            UINT channels) {
+  UINT i = 0, j;
+
+  if (channels == 2) {
+    for (; i + 4 <= nSamples; i += 4) {
+      __m128 x0 = _mm_castsi128_ps(
+          limiterAbs_epi32(_mm_loadu_si128((const __m128i*)&samplesIn[2 * i])));
+      __m128 x1 = _mm_castsi128_ps(
+          limiterAbs_epi32(_mm_loadu_si128((const __m128i*)&samplesIn[2 * i + 4])));
+      __m128i left = _mm_castps_si128(_mm_shuffle_ps(x0, x1, _MM_SHUFFLE(2, 0, 2, 0)));
+      __m128i right = _mm_castps_si128(_mm_shuffle_ps(x0, x1, _MM_SHUFFLE(3, 1, 3, 1)));
+      _mm_storeu_si128((__m128i*)&locMax[i], _mm_max_epi32(left, right));
+    }
+  } else if (channels >= 4) {
+    for (; i < nSamples; i++) {
+      const PCM_LIM* pIn = &samplesIn[i * channels];
+      __m128i max4 = _mm_setzero_si128();
+      for (j = 0; j + 4 <= channels; j += 4) {
+        max4 = _mm_max_epi32(max4, limiterAbs_epi32(_mm_loadu_si128((const __m128i*)&pIn[j])));
+      }
+      PCM_LIM max = (PCM_LIM)FDK_mm_hmax_epi32(max4);
+      for (; j < channels; j++) {
+        max = fMax(max, (PCM_LIM)fAbs(pIn[j]));
+      }
+      locMax[i] = max;
+    }
+  }
+  for (; i < nSamples; i++) {
+    PCM_LIM max = (PCM_LIM)0;
+    for (j = 0; j < channels; j++) {
+      max = fMax(max, (PCM_LIM)fAbs(samplesIn[i * channels + j]));
+    }
+    locMax[i] = max;
+  }
+}
+
+static inline void applyLimiter_func4(const PCM_LIM* samplesIn, PCM_LIM* locMax, UINT nSamples,
+                                      UINT channels) {
+  if (FDK_X86_HAS_SSE4_1) {
+    applyLimiter_func4_SSE4_1(samplesIn, locMax, nSamples, channels);
+    return;
+  }
+  for (UINT i = 0; i < nSamples; i++) {
+    PCM_LIM max = (PCM_LIM)0;
+    for (UINT j = 0; j < channels; j++) {
+      max = fMax(max, (PCM_LIM)fAbs(samplesIn[i * channels + j]));
+    }
+    locMax[i] = max;
+  }
+}
+#endif /* defined(FUNCTION_applyLimiter_func4) */
+
+#if defined(FUNCTION_applyLimiter_func5)
+/* pOut[i] = SATURATE_LEFT_SHIFT(pIn[i], scaling), or SATURATE_LEFT_SHIFT(fMult(pIn[i], gain),
+   scaling + 1) if gain is not zero. */
+static FDK_X86_TARGET_SSE4_1 void applyLimiter_func5_SSE4_1(const FIXP_DBL* pIn, INT_PCM* pOut,
+                                                            UINT length, FIXP_DBL gain,
+                                                            INT scaling) {
+  const INT shift = (gain == (FIXP_DBL)0) ? scaling : scaling + 1;
+  const __m128i shift4 = _mm_cvtsi32_si128(shift);
+  const __m128i limit = _mm_set1_epi32((INT)MAXVAL_DBL >> shift);
+  const __m128i gain4 = _mm_set1_epi32(gain);
+  UINT i = 0;
+
+  if (gain == (FIXP_DBL)0) {
+    for (; i + 4 <= length; i += 4) {
+      __m128i x = _mm_loadu_si128((const __m128i*)&pIn[i]);
+      _mm_storeu_si128((__m128i*)&pOut[i], FDK_mm_saturateLeftShift_epi32(x, shift4, limit));
+    }
+    for (; i < length; i++) {
+      pOut[i] = (INT_PCM)SATURATE_LEFT_SHIFT(pIn[i], shift, DFRACT_BITS);
+    }
+  } else {
+    for (; i + 4 <= length; i += 4) {
+      __m128i x = FDK_mm_fMult_epi32(_mm_loadu_si128((const __m128i*)&pIn[i]), gain4);
+      _mm_storeu_si128((__m128i*)&pOut[i], FDK_mm_saturateLeftShift_epi32(x, shift4, limit));
+    }
+    for (; i < length; i++) {
+      pOut[i] = (INT_PCM)SATURATE_LEFT_SHIFT(fMult(pIn[i], gain), shift, DFRACT_BITS);
+    }
+  }
+}
+
+#if defined(__x86_AVX2__)
+static FDK_X86_TARGET_AVX2 void applyLimiter_func5_AVX2(const FIXP_DBL* pIn, INT_PCM* pOut,
+                                                        UINT length, FIXP_DBL gain, INT scaling) {
+  const __m128i shift = _mm_cvtsi32_si128((gain == (FIXP_DBL)0) ? scaling : scaling + 1);
+  const __m256i limit = _mm256_set1_epi32((INT)MAXVAL_DBL >> _mm_cvtsi128_si32(shift));
+  const __m256i gain8 = _mm256_set1_epi32(gain);
+  UINT i = 0;
+
+  for (; i + 8 <= length; i += 8) {
+    __m256i x = _mm256_loadu_si256((const __m256i*)&pIn[i]);
+    if (gain != (FIXP_DBL)0) {
+      x = _mm256_slli_epi32(FDK_mm256_fMultDiv2_epi32(x, gain8), 1);
+    }
+    _mm256_storeu_si256((__m256i*)&pOut[i], FDK_mm256_saturateLeftShift_epi32(x, shift, limit));
+  }
+  applyLimiter_func5_SSE4_1(&pIn[i], &pOut[i], length - i, gain, scaling);
+}
+#endif /* defined(__x86_AVX2__) */
+
+static inline void applyLimiter_func5(const FIXP_DBL* pIn, INT_PCM* pOut, UINT length,
+                                      FIXP_DBL gain, INT scaling) {
+#if defined(__x86_AVX2__)
+  if (FDK_X86_HAS_AVX2) {
+    applyLimiter_func5_AVX2(pIn, pOut, length, gain, scaling);
+    return;
+  }
+#endif
+  if (FDK_X86_HAS_SSE4_1) {
+    applyLimiter_func5_SSE4_1(pIn, pOut, length, gain, scaling);
+    return;
+  }
+  if (gain == (FIXP_DBL)0) {
+    for (UINT i = 0; i < length; i++) {
+      pOut[i] = (INT_PCM)SATURATE_LEFT_SHIFT(pIn[i], scaling, DFRACT_BITS);
+    }
+  } else {
+    for (UINT i = 0; i < length; i++) {
+      pOut[i] = (INT_PCM)SATURATE_LEFT_SHIFT(fMult(pIn[i], gain), scaling + 1, DFRACT_BITS);
+    }
+  }
+}
+#endif /* defined(FUNCTION_applyLimiter_func5) */
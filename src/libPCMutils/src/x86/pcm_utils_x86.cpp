@@ -0,0 +1,333 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2018 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+/**************************** PCM utility library ******************************
+
+   Author(s):
+
+   Description: x86 SSE4.1 versions of the (de)interleaving functions
+
+*******************************************************************************/
+
+#if defined(__x86_SSE4_1__)
+#include "x86/FDK_x86_funcs.h"
+
+#define FUNCTION_FDK_interleave_DBL_LONG
+#define FUNCTION_FDK_deinterleave_LONG
+#endif
+
+#ifdef FUNCTION_FDK_interleave_DBL_LONG
+static FDK_X86_TARGET_SSE4_1 void FDK_interleave_SSE4_1(const FIXP_DBL* RESTRICT pIn,
+                                                        LONG* RESTRICT pOut, const UINT channels,
+                                                        const UINT frameSize, const UINT length) {
+  UINT ch = 0;
+
+  if (channels == 2) {
+    const FIXP_DBL* In0 = &pIn[0];
+    const FIXP_DBL* In1 = &pIn[frameSize];
+    UINT sample = 0;
+    for (; sample + 4 <= length; sample += 4) {
+      __m128i x0 = _mm_loadu_si128((const __m128i*)&In0[sample]);
+      __m128i x1 = _mm_loadu_si128((const __m128i*)&In1[sample]);
+      _mm_storeu_si128((__m128i*)&pOut[2 * sample], _mm_unpacklo_epi32(x0, x1));
+      _mm_storeu_si128((__m128i*)&pOut[2 * sample + 4], _mm_unpackhi_epi32(x0, x1));
+    }
+    for (; sample < length; sample++) {
+      pOut[2 * sample] = (LONG)In0[sample];
+      pOut[2 * sample + 1] = (LONG)In1[sample];
+    }
+    return;
+  }
+
+  /* Transpose blocks of 4 channels x 4 samples */
+  for (; ch + 4 <= channels; ch += 4) {
+    const FIXP_DBL* In0 = &pIn[(ch + 0) * frameSize];
+    const FIXP_DBL* In1 = &pIn[(ch + 1) * frameSize];
+    const FIXP_DBL* In2 = &pIn[(ch + 2) * frameSize];
+    const FIXP_DBL* In3 = &pIn[(ch + 3) * frameSize];
+    LONG* Out = &pOut[ch];
+    UINT sample = 0;
+    for (; sample + 4 <= length; sample += 4) {
+      __m128i x0 = _mm_loadu_si128((const __m128i*)&In0[sample]);
+      __m128i x1 = _mm_loadu_si128((const __m128i*)&In1[sample]);
+      __m128i x2 = _mm_loadu_si128((const __m128i*)&In2[sample]);
+      __m128i x3 = _mm_loadu_si128((const __m128i*)&In3[sample]);
+      __m128i t0 = _mm_unpacklo_epi32(x0, x1);
+      __m128i t1 = _mm_unpacklo_epi32(x2, x3);
+      __m128i t2 = _mm_unpackhi_epi32(x0, x1);
+      __m128i t3 = _mm_unpackhi_epi32(x2, x3);
+      _mm_storeu_si128((__m128i*)Out, _mm_unpacklo_epi64(t0, t1));
+      Out += channels;
+      _mm_storeu_si128((__m128i*)Out, _mm_unpackhi_epi64(t0, t1));
+      Out += channels;
+      _mm_storeu_si128((__m128i*)Out, _mm_unpacklo_epi64(t2, t3));
+      Out += channels;
+      _mm_storeu_si128((__m128i*)Out, _mm_unpackhi_epi64(t2, t3));
+      Out += channels;
+    }
+    for (; sample < length; sample++) {
+      Out[0] = (LONG)In0[sample];
+      Out[1] = (LONG)In1[sample];
+      Out[2] = (LONG)In2[sample];
+      Out[3] = (LONG)In3[sample];
+      Out += channels;
+    }
+  }
+
+  /* Remaining channels */
+  for (; ch < channels; ch++) {
+    const FIXP_DBL* In = &pIn[ch * frameSize];
+    LONG* Out = &pOut[ch];
+    for (UINT sample = 0; sample < length; sample++) {
+      *Out = (LONG)(*In++);
+      Out += channels;
+    }
+  }
+}
+
+void FDK_interleave(const FIXP_DBL* RESTRICT pIn, LONG* RESTRICT pOut, const UINT channels,
+                    const UINT frameSize, const UINT length) {
+  if (FDK_X86_HAS_SSE4_1) {
+    FDK_interleave_SSE4_1(pIn, pOut, channels, frameSize, length);
+    return;
+  }
+  for (UINT ch = 0; ch < channels; ch++) {
+    const FIXP_DBL* In = &pIn[ch * frameSize];
+    LONG* Out = &pOut[ch];
+    for (UINT sample = 0; sample < length; sample++) {
+      *Out = (LONG)(*In++);
+      Out += channels;
+    }
+  }
+}
+#endif /* FUNCTION_FDK_interleave_DBL_LONG */
+
+#ifdef FUNCTION_FDK_deinterleave_LONG
+/* Format conversion of one sample, identical to the generic implementation. */
+static inline void FDK_deinterleave_conv(LONG* p, const LONG x, const INT shift) {
+  *p = x >> shift;
+}
+static inline void FDK_deinterleave_conv(SHORT* p, const LONG x, const INT) {
+  *p = (SHORT)(x >> 16);
+}
+static inline void FDK_deinterleave_conv(float* p, const LONG x, const INT) {
+  *p = (float)x * (1.0f / 2147483648.0f);
+}
+
+/* Format conversion of four consecutive samples of one channel. */
+static inline FDK_X86_TARGET_SSE4_1 void FDK_deinterleave_store4(LONG* p, __m128i x,
+                                                                 __m128i shift) {
+  _mm_storeu_si128((__m128i*)p, _mm_sra_epi32(x, shift));
+}
+static inline FDK_X86_TARGET_SSE4_1 void FDK_deinterleave_store4(SHORT* p, __m128i x, __m128i) {
+  _mm_storel_epi64((__m128i*)p, _mm_packs_epi32(_mm_srai_epi32(x, 16), _mm_setzero_si128()));
+}
+static inline FDK_X86_TARGET_SSE4_1 void FDK_deinterleave_store4(float* p, __m128i x, __m128i) {
+  _mm_storeu_ps(p, _mm_mul_ps(_mm_cvtepi32_ps(x), _mm_set1_ps(1.0f / 2147483648.0f)));
+}
+
+template <typename T>
+static void FDK_deinterleave_C(const LONG* RESTRICT pIn, T* RESTRICT pOut, const UINT channels,
+                               const UINT frameSize, const UINT length, const INT shift) {
+  for (UINT ch = 0; ch < channels; ch++) {
+    const LONG* In = &pIn[ch];
+    T* Out = &pOut[ch * frameSize];
+    for (UINT sample = 0; sample < length; sample++) {
+      FDK_deinterleave_conv(Out++, *In, shift);
+      In += channels;
+    }
+  }
+}
+
+template <typename T>
+static FDK_X86_TARGET_SSE4_1 void FDK_deinterleave_SSE4_1(const LONG* RESTRICT pIn,
+                                                          T* RESTRICT pOut, const UINT channels,
+                                                          const UINT frameSize, const UINT length,
+                                                          const INT shift) {
+  const __m128i vShift = _mm_cvtsi32_si128(shift);
+  UINT ch = 0;
+
+  if (channels == 1) {
+    UINT sample = 0;
+    for (; sample + 4 <= length; sample += 4) {
+      FDK_deinterleave_store4(&pOut[sample], _mm_loadu_si128((const __m128i*)&pIn[sample]),
+                              vShift);
+    }
+    for (; sample < length; sample++) {
+      FDK_deinterleave_conv(&pOut[sample], pIn[sample], shift);
+    }
+    return;
+  }
+
+  if (channels == 2) {
+    T* Out0 = &pOut[0];
+    T* Out1 = &pOut[frameSize];
+    UINT sample = 0;
+    for (; sample + 4 <= length; sample += 4) {
+      /* L0 R0 L1 R1 | L2 R2 L3 R3 -> L0 L1 R0 R1 | L2 L3 R2 R3 */
+      __m128i x0 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&pIn[2 * sample]),
+                                     _MM_SHUFFLE(3, 1, 2, 0));
+      __m128i x1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&pIn[2 * sample + 4]),
+                                     _MM_SHUFFLE(3, 1, 2, 0));
+      FDK_deinterleave_store4(&Out0[sample], _mm_unpacklo_epi64(x0, x1), vShift);
+      FDK_deinterleave_store4(&Out1[sample], _mm_unpackhi_epi64(x0, x1), vShift);
+    }
+    for (; sample < length; sample++) {
+      FDK_deinterleave_conv(&Out0[sample], pIn[2 * sample], shift);
+      FDK_deinterleave_conv(&Out1[sample], pIn[2 * sample + 1], shift);
+    }
+    return;
+  }
+
+  /* Transpose blocks of 4 samples x 4 channels */
+  for (; ch + 4 <= channels; ch += 4) {
+    const LONG* In = &pIn[ch];
+    T* Out0 = &pOut[(ch + 0) * frameSize];
+    T* Out1 = &pOut[(ch + 1) * frameSize];
+    T* Out2 = &pOut[(ch + 2) * frameSize];
+    T* Out3 = &pOut[(ch + 3) * frameSize];
+    UINT sample = 0;
+    for (; sample + 4 <= length; sample += 4) {
+      __m128i x0 = _mm_loadu_si128((const __m128i*)In);
+      In += channels;
+      __m128i x1 = _mm_loadu_si128((const __m128i*)In);
+      In += channels;
+      __m128i x2 = _mm_loadu_si128((const __m128i*)In);
+      In += channels;
+      __m128i x3 = _mm_loadu_si128((const __m128i*)In);
+      In += channels;
+      __m128i t0 = _mm_unpacklo_epi32(x0, x1);
+      __m128i t1 = _mm_unpacklo_epi32(x2, x3);
+      __m128i t2 = _mm_unpackhi_epi32(x0, x1);
+      __m128i t3 = _mm_unpackhi_epi32(x2, x3);
+      FDK_deinterleave_store4(&Out0[sample], _mm_unpacklo_epi64(t0, t1), vShift);
+      FDK_deinterleave_store4(&Out1[sample], _mm_unpackhi_epi64(t0, t1), vShift);
+      FDK_deinterleave_store4(&Out2[sample], _mm_unpacklo_epi64(t2, t3), vShift);
+      FDK_deinterleave_store4(&Out3[sample], _mm_unpackhi_epi64(t2, t3), vShift);
+    }
+    for (; sample < length; sample++) {
+      FDK_deinterleave_conv(&Out0[sample], In[0], shift);
+      FDK_deinterleave_conv(&Out1[sample], In[1], shift);
+      FDK_deinterleave_conv(&Out2[sample], In[2], shift);
+      FDK_deinterleave_conv(&Out3[sample], In[3], shift);
+      In += channels;
+    }
+  }
+
+  /* Remaining channels */
+  for (; ch < channels; ch++) {
+    const LONG* In = &pIn[ch];
+    T* Out = &pOut[ch * frameSize];
+    for (UINT sample = 0; sample < length; sample++) {
+      FDK_deinterleave_conv(Out++, *In, shift);
+      In += channels;
+    }
+  }
+}
+
+void FDK_deinterleave(const LONG* RESTRICT pIn, LONG* RESTRICT pOut, const UINT channels,
+                      const UINT frameSize, const UINT length, const INT shift) {
+  if (FDK_X86_HAS_SSE4_1) {
+    FDK_deinterleave_SSE4_1(pIn, pOut, channels, frameSize, length, shift);
+  } else {
+    FDK_deinterleave_C(pIn, pOut, channels, frameSize, length, shift);
+  }
+}
+
+void FDK_deinterleave(const LONG* RESTRICT pIn, SHORT* RESTRICT pOut, const UINT channels,
+                      const UINT frameSize, const UINT length) {
+  if (FDK_X86_HAS_SSE4_1) {
+    FDK_deinterleave_SSE4_1(pIn, pOut, channels, frameSize, length, 16);
+  } else {
+    FDK_deinterleave_C(pIn, pOut, channels, frameSize, length, 16);
+  }
+}
+
+void FDK_deinterleave(const LONG* RESTRICT pIn, float* RESTRICT pOut, const UINT channels,
+                      const UINT frameSize, const UINT length) {
+  if (FDK_X86_HAS_SSE4_1) {
+    FDK_deinterleave_SSE4_1(pIn, pOut, channels, frameSize, length, 0);
+  } else {
+    FDK_deinterleave_C(pIn, pOut, channels, frameSize, length, 0);
+  }
+}
+#endif /* FUNCTION_FDK_deinterleave_LONG */
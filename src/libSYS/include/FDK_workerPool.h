@@ -0,0 +1,141 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2018 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+/************************* System integration library **************************
+
+   Author(s):
+
+   Description: Small fixed-size worker pool used to run independent per-channel
+                jobs of one decoding call in parallel.
+
+*******************************************************************************/
+
+/** \file   FDK_workerPool.h
+ *  \brief  Blocking fork/join worker pool.
+ *
+ *  The pool executes numJobs calls of a job function and returns once all of them have finished.
+ *  The calling thread takes part as worker 0, so a pool with N workers owns N-1 threads. Without
+ *  thread support (FDK_HAVE_THREADS undefined) FDK_workerPoolOpen() fails and all jobs passed to
+ *  FDK_workerPoolRun() with a NULL handle are executed sequentially by the caller.
+ */
+
+#ifndef FDK_WORKERPOOL_H
+#define FDK_WORKERPOOL_H
+
+#include "machine_type.h"
+
+typedef struct FDK_WORKER_POOL* HANDLE_FDK_WORKER_POOL;
+
+/**
+ * \brief Job callback.
+ * \param pContext Context pointer passed to FDK_workerPoolRun().
+ * \param job      Index of the job to execute, 0 <= job < numJobs.
+ * \param worker   Index of the executing worker, 0 <= worker < FDK_workerPoolGetNumWorkers().
+ *                 Can be used to select per-worker scratch memory.
+ */
+typedef void (*FDK_WORKER_JOB_FUNC)(void* pContext, INT job, INT worker);
+
+/**
+ * \brief Create a worker pool.
+ * \param numWorkers Total number of workers including the calling thread (>= 2).
+ * \return Pool handle or NULL on failure or if threads are not supported.
+ */
+HANDLE_FDK_WORKER_POOL FDK_workerPoolOpen(INT numWorkers);
+
+/**
+ * \brief Stop all worker threads and free the pool. The handle is set to NULL.
+ */
+void FDK_workerPoolClose(HANDLE_FDK_WORKER_POOL* phPool);
+
+/**
+ * \brief Return the number of workers including the calling thread (1 for a NULL handle).
+ */
+INT FDK_workerPoolGetNumWorkers(HANDLE_FDK_WORKER_POOL hPool);
+
+/**
+ * \brief Execute jobs 0..numJobs-1 and wait for their completion. Jobs may run in any order and
+ *        concurrently. A NULL handle executes all jobs sequentially in the calling thread.
+ */
+void FDK_workerPoolRun(HANDLE_FDK_WORKER_POOL hPool, FDK_WORKER_JOB_FUNC func, void* pContext,
+                       INT numJobs);
+
+#endif /* FDK_WORKERPOOL_H */
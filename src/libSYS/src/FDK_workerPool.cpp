@@ -0,0 +1,256 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2018 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+/************************* System integration library **************************
+
+   Author(s):
+
+   Description: Small fixed-size worker pool used to run independent per-channel
+                jobs of one decoding call in parallel.
+
+*******************************************************************************/
+
+#include "FDK_workerPool.h"
+
+#if defined(FDK_HAVE_THREADS)
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+struct FDK_WORKER_POOL {
+  std::mutex lock;
+  std::condition_variable cvWork; /*!< Signals new work or shutdown to the worker threads. */
+  std::condition_variable cvDone; /*!< Signals completion of the last job to the caller. */
+  std::vector<std::thread> threads;
+
+  FDK_WORKER_JOB_FUNC func;
+  void* pContext;
+  INT numJobs;
+  INT nextJob;   /*!< Index of the next job to be picked up. */
+  INT jobsDone;  /*!< Number of finished jobs of the current run. */
+  UINT runCount; /*!< Incremented for every FDK_workerPoolRun() call. */
+  INT shutdown;
+};
+
+/* Pick up and execute jobs of the current run until none is left. Must be called with the lock
+ * held; returns with the lock held. */
+static void workerPoolDrain(FDK_WORKER_POOL* pool, std::unique_lock<std::mutex>& guard,
+                            INT worker) {
+  while (pool->nextJob < pool->numJobs) {
+    INT job = pool->nextJob++;
+    guard.unlock();
+    pool->func(pool->pContext, job, worker);
+    guard.lock();
+    if (++pool->jobsDone == pool->numJobs) {
+      pool->cvDone.notify_one();
+    }
+  }
+}
+
+static void workerPoolThread(FDK_WORKER_POOL* pool, INT worker) {
+  UINT lastRun = 0;
+  std::unique_lock<std::mutex> guard(pool->lock);
+
+  for (;;) {
+    pool->cvWork.wait(guard, [&] { return pool->shutdown || pool->runCount != lastRun; });
+    if (pool->shutdown) {
+      break;
+    }
+    lastRun = pool->runCount;
+    workerPoolDrain(pool, guard, worker);
+  }
+}
+
+HANDLE_FDK_WORKER_POOL FDK_workerPoolOpen(INT numWorkers) {
+  FDK_WORKER_POOL* pool;
+
+  if (numWorkers < 2) {
+    return NULL;
+  }
+
+  pool = new (std::nothrow) FDK_WORKER_POOL();
+  if (pool == NULL) {
+    return NULL;
+  }
+  pool->func = NULL;
+  pool->pContext = NULL;
+  pool->numJobs = 0;
+  pool->nextJob = 0;
+  pool->jobsDone = 0;
+  pool->runCount = 0;
+  pool->shutdown = 0;
+
+  try {
+    pool->threads.reserve(numWorkers - 1);
+    for (INT i = 1; i < numWorkers; i++) {
+      pool->threads.push_back(std::thread(workerPoolThread, pool, i));
+    }
+  } catch (...) {
+    FDK_workerPoolClose(&pool);
+    return NULL;
+  }
+
+  return pool;
+}
+
+void FDK_workerPoolClose(HANDLE_FDK_WORKER_POOL* phPool) {
+  FDK_WORKER_POOL* pool;
+
+  if (phPool == NULL || *phPool == NULL) {
+    return;
+  }
+  pool = *phPool;
+
+  {
+    std::lock_guard<std::mutex> guard(pool->lock);
+    pool->shutdown = 1;
+  }
+  pool->cvWork.notify_all();
+  for (size_t i = 0; i < pool->threads.size(); i++) {
+    pool->threads[i].join();
+  }
+
+  delete pool;
+  *phPool = NULL;
+}
+
+INT FDK_workerPoolGetNumWorkers(HANDLE_FDK_WORKER_POOL hPool) {
+  if (hPool == NULL) {
+    return 1;
+  }
+  return (INT)hPool->threads.size() + 1;
+}
+
+void FDK_workerPoolRun(HANDLE_FDK_WORKER_POOL hPool, FDK_WORKER_JOB_FUNC func, void* pContext,
+                       INT numJobs) {
+  if (hPool == NULL || numJobs < 2) {
+    for (INT job = 0; job < numJobs; job++) {
+      func(pContext, job, 0);
+    }
+    return;
+  }
+
+  std::unique_lock<std::mutex> guard(hPool->lock);
+  hPool->func = func;
+  hPool->pContext = pContext;
+  hPool->numJobs = numJobs;
+  hPool->nextJob = 0;
+  hPool->jobsDone = 0;
+  hPool->runCount++;
+  hPool->cvWork.notify_all();
+
+  /* The caller works as worker 0 and then waits for the jobs still running on other threads. */
+  workerPoolDrain(hPool, guard, 0);
+  hPool->cvDone.wait(guard, [&] { return hPool->jobsDone == hPool->numJobs; });
+
+  hPool->func = NULL;
+  hPool->pContext = NULL;
+  hPool->numJobs = 0;
+  hPool->nextJob = 0;
+}
+
+#else /* defined(FDK_HAVE_THREADS) */
+
+HANDLE_FDK_WORKER_POOL FDK_workerPoolOpen(INT numWorkers) {
+  return NULL;
+}
+
+void FDK_workerPoolClose(HANDLE_FDK_WORKER_POOL* phPool) {
+  if (phPool != NULL) {
+    *phPool = NULL;
+  }
+}
+
+INT FDK_workerPoolGetNumWorkers(HANDLE_FDK_WORKER_POOL hPool) {
+  return 1;
+}
+
+void FDK_workerPoolRun(HANDLE_FDK_WORKER_POOL hPool, FDK_WORKER_JOB_FUNC func, void* pContext,
+                       INT numJobs) {
+  for (INT job = 0; job < numJobs; job++) {
+    func(pContext, job, 0);
+  }
+}
+
+#endif /* defined(FDK_HAVE_THREADS) */
@@ -184,24 +184,224 @@ char* FDKstrncpy(char* dest, const char* src, UINT n) {
  * DYNAMIC MEMORY management (heap)
  *************************************************************************/
 
-void* FDKcalloc(const UINT n, const UINT size) {
-  void* ptr;
+/* Every block handed out by FDKcalloc()/FDKmalloc() is preceded by a header which records where
+ * the block came from, so FDKfree() works regardless of the allocator or arena active at the time
+ * of the call. The header size keeps the alignment of the underlying allocator. */
+typedef union {
+  struct {
+    FDK_MEM_ARENA* pArena; /* Owning arena, or NULL for heap blocks. */
+    UINT size;             /* Size of the block including the header. */
+  } info;
+  double alignDouble;
+  void* alignPtr;
+  INT64 alignInt64;
+  UCHAR pad[16];
+} FDK_ALLOC_HEADER;
+
+/* Freed arena blocks below the top are kept in a list sorted by address. The link to the next free
+ * block is stored in the payload of the free block, every block has room for at least one header
+ * of payload. Adjacent free blocks are merged, and free blocks reaching the top are given back to
+ * the bump pointer. */
+struct FDK_MEM_ARENA {
+  UCHAR* pBase;                /* First byte available for allocations. */
+  UINT size;                   /* Number of bytes available for allocations. */
+  UINT used;                   /* Bump pointer, number of bytes below the top. */
+  UINT peak;                   /* Highest value of used. */
+  FDK_ALLOC_HEADER* pFreeList; /* Free blocks below the top, sorted by address. */
+};
+
+#define FDK_ARENA_NEXT_FREE(pHeader) (*(FDK_ALLOC_HEADER**)((pHeader) + 1))
+
+#define FDK_ARENA_HEADER_SIZE \
+  ((UINT)((sizeof(FDK_MEM_ARENA) + sizeof(FDK_ALLOC_HEADER) - 1) / sizeof(FDK_ALLOC_HEADER) * \
+          sizeof(FDK_ALLOC_HEADER)))
+
+static FDK_ALLOCATOR fdkAllocator = {NULL, NULL, NULL};
+static thread_local FDK_MEM_ARENA* fdkThreadArena = NULL;
+
+void FDKsetAllocator(const FDK_ALLOCATOR* pAllocator) {
+  if ((pAllocator != NULL) && (pAllocator->pAlloc != NULL) && (pAllocator->pFree != NULL)) {
+    fdkAllocator = *pAllocator;
+  } else {
+    fdkAllocator.pAlloc = NULL;
+    fdkAllocator.pFree = NULL;
+    fdkAllocator.pUserData = NULL;
+  }
+}
 
-  ptr = calloc(n, size);
+FDK_MEM_ARENA* FDKinitArena(void* pMem, const UINT size) {
+  FDK_MEM_ARENA* pArena = (FDK_MEM_ARENA*)pMem;
 
-  return ptr;
+  if ((pMem == NULL) || (size <= FDK_ARENA_HEADER_SIZE)) {
+    return NULL;
+  }
+
+  pArena->pBase = (UCHAR*)pMem + FDK_ARENA_HEADER_SIZE;
+  pArena->size = (size - FDK_ARENA_HEADER_SIZE) & ~(UINT)(sizeof(FDK_ALLOC_HEADER) - 1);
+  pArena->used = 0;
+  pArena->peak = 0;
+  pArena->pFreeList = NULL;
+
+  return pArena;
 }
 
-void* FDKmalloc(const UINT size) {
-  void* ptr;
+FDK_MEM_ARENA* FDKsetThreadArena(FDK_MEM_ARENA* pArena) {
+  FDK_MEM_ARENA* pPrevArena = fdkThreadArena;
+  fdkThreadArena = pArena;
+  return pPrevArena;
+}
+
+UINT FDKgetArenaPeak(const FDK_MEM_ARENA* pArena) {
+  return (pArena != NULL) ? FDK_ARENA_HEADER_SIZE + pArena->peak : 0;
+}
 
-  ptr = malloc(size);
+/* Take a block of blockSize bytes from the arena: first fit from the free list, otherwise from the
+ * top. Returns NULL if the arena is exhausted. */
+static FDK_ALLOC_HEADER* FDKarenaAlloc(FDK_MEM_ARENA* pArena, const UINT blockSize) {
+  FDK_ALLOC_HEADER** ppFree = &pArena->pFreeList;
+  FDK_ALLOC_HEADER* pHeader;
 
-  return ptr;
+  for (pHeader = *ppFree; pHeader != NULL; pHeader = *ppFree) {
+    if (pHeader->info.size >= blockSize) {
+      UINT remainder = pHeader->info.size - blockSize;
+      if (remainder >= 2 * (UINT)sizeof(FDK_ALLOC_HEADER)) {
+        /* split, the upper part stays in the free list */
+        FDK_ALLOC_HEADER* pRest = (FDK_ALLOC_HEADER*)((UCHAR*)pHeader + blockSize);
+        pRest->info.pArena = pArena;
+        pRest->info.size = remainder;
+        FDK_ARENA_NEXT_FREE(pRest) = FDK_ARENA_NEXT_FREE(pHeader);
+        *ppFree = pRest;
+        pHeader->info.size = blockSize;
+      } else {
+        *ppFree = FDK_ARENA_NEXT_FREE(pHeader);
+      }
+      return pHeader;
+    }
+    ppFree = &FDK_ARENA_NEXT_FREE(pHeader);
+  }
+
+  if (blockSize > pArena->size - pArena->used) {
+    return NULL;
+  }
+  pHeader = (FDK_ALLOC_HEADER*)(pArena->pBase + pArena->used);
+  pHeader->info.size = blockSize;
+  pArena->used += blockSize;
+  if (pArena->used > pArena->peak) {
+    pArena->peak = pArena->used;
+  }
+  return pHeader;
+}
+
+/* Give an arena block back. No free block ends at the top of the arena. */
+static void FDKarenaFree(FDK_MEM_ARENA* pArena, FDK_ALLOC_HEADER* pHeader) {
+  FDK_ALLOC_HEADER** ppFree = &pArena->pFreeList;
+  FDK_ALLOC_HEADER* pPrev = NULL;
+
+  if ((UCHAR*)pHeader + pHeader->info.size == pArena->pBase + pArena->used) {
+    /* top block, also give back the last free block if it is now at the top */
+    pArena->used -= pHeader->info.size;
+    while ((*ppFree != NULL) && (FDK_ARENA_NEXT_FREE(*ppFree) != NULL)) {
+      ppFree = &FDK_ARENA_NEXT_FREE(*ppFree);
+    }
+    if ((*ppFree != NULL) &&
+        ((UCHAR*)*ppFree + (*ppFree)->info.size == pArena->pBase + pArena->used)) {
+      pArena->used -= (*ppFree)->info.size;
+      *ppFree = NULL;
+    }
+    return;
+  }
+
+  /* insert sorted by address, merge with the following and the preceding free block */
+  while ((*ppFree != NULL) && (*ppFree < pHeader)) {
+    pPrev = *ppFree;
+    ppFree = &FDK_ARENA_NEXT_FREE(pPrev);
+  }
+  if ((*ppFree != NULL) && ((UCHAR*)pHeader + pHeader->info.size == (UCHAR*)*ppFree)) {
+    pHeader->info.size += (*ppFree)->info.size;
+    FDK_ARENA_NEXT_FREE(pHeader) = FDK_ARENA_NEXT_FREE(*ppFree);
+  } else {
+    FDK_ARENA_NEXT_FREE(pHeader) = *ppFree;
+  }
+  if ((pPrev != NULL) && ((UCHAR*)pPrev + pPrev->info.size == (UCHAR*)pHeader)) {
+    pPrev->info.size += pHeader->info.size;
+    FDK_ARENA_NEXT_FREE(pPrev) = FDK_ARENA_NEXT_FREE(pHeader);
+  } else {
+    *ppFree = pHeader;
+  }
+}
+
+/* Allocate a block of size bytes plus header, from the thread arena if possible. */
+static void* FDKallocBlock(const UINT size, const INT clear) {
+  FDK_ALLOC_HEADER* pHeader = NULL;
+  FDK_MEM_ARENA* pArena = fdkThreadArena;
+  UINT blockSize;
+
+  if (size > (UINT)-1 - 2 * (UINT)sizeof(FDK_ALLOC_HEADER)) {
+    return NULL;
+  }
+  /* Round up to the header size, to keep the alignment of the next arena block. */
+  blockSize = (size + 2 * (UINT)sizeof(FDK_ALLOC_HEADER) - 1) &
+              ~(UINT)(sizeof(FDK_ALLOC_HEADER) - 1);
+
+  if ((pArena != NULL) && ((pHeader = FDKarenaAlloc(pArena, blockSize)) != NULL)) {
+    blockSize = pHeader->info.size;
+    if (clear) {
+      FDKmemclear(pHeader + 1, size);
+    }
+  } else {
+    pArena = NULL;
+    if (fdkAllocator.pAlloc != NULL) {
+      pHeader = (FDK_ALLOC_HEADER*)fdkAllocator.pAlloc(fdkAllocator.pUserData, blockSize);
+      if ((pHeader != NULL) && clear) {
+        FDKmemclear(pHeader + 1, size);
+      }
+    } else if (clear) {
+      pHeader = (FDK_ALLOC_HEADER*)calloc(1, blockSize);
+    } else {
+      pHeader = (FDK_ALLOC_HEADER*)malloc(blockSize);
+    }
+  }
+
+  if (pHeader == NULL) {
+    return NULL;
+  }
+
+  pHeader->info.pArena = pArena;
+  pHeader->info.size = blockSize;
+
+  return pHeader + 1;
+}
+
+void* FDKcalloc(const UINT n, const UINT size) {
+  if ((n != 0) && (size > (UINT)-1 / n)) {
+    return NULL;
+  }
+
+  return FDKallocBlock(n * size, 1);
+}
+
+void* FDKmalloc(const UINT size) {
+  return FDKallocBlock(size, 0);
 }
 
 void FDKfree(void* ptr) {
-  free((INT*)ptr);
+  FDK_ALLOC_HEADER* pHeader;
+  FDK_MEM_ARENA* pArena;
+
+  if (ptr == NULL) {
+    return;
+  }
+
+  pHeader = (FDK_ALLOC_HEADER*)ptr - 1;
+  pArena = pHeader->info.pArena;
+
+  if (pArena != NULL) {
+    FDKarenaFree(pArena, pHeader);
+  } else if (fdkAllocator.pFree != NULL) {
+    fdkAllocator.pFree(fdkAllocator.pUserData, pHeader);
+  } else {
+    free(pHeader);
+  }
 }
 
 void* FDKaalloc(const UINT size, const UINT alignment) {
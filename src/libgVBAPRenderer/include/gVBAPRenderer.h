@@ -115,10 +115,19 @@ int prodMetadataFrameGroup(HANDLE_GVBAPRENDERER hgVBAPRenderer, HANDLE_FDK_BITST
  * @param oamFrameLength        Frame length of the OAM data
  * @param outGeometryInfo       Loudspeaker geometry information for output setting
  * @param outChannels           Number of real speaker including number of LFE
+ * @param useGainGrid           If non-zero and renderMode is GVBAP_ENHANCED, point sources are
+ *                              panned by bilinear interpolation of a precomputed gain grid with a
+ *                              resolution of GVBAP_GAIN_GRID_STEP degrees instead of searching all
+ *                              speaker triplets. The output is not bit-exact to the search.
+ * @param setupCache            Setup cache written by gVBAPRenderer_AppendSetup() or NULL. If it
+ *                              contains an entry for the speaker setup, the triangulation, inverse
+ *                              matrices, spread gains and gain grid are taken from the entry.
+ * @param setupCacheSize        Size of the setup cache in bytes
  */
 int gVBAPRenderer_Open(HANDLE_GVBAPRENDERER* phgVBAPRenderer, int numObjects, int frameLength,
                        int oamFrameLength, CICP2GEOMETRY_CHANNEL_GEOMETRY* outGeometryInfo,
-                       int outChannels, int outCICPIndex, int hasUniformSpread, int renderMode);
+                       int outChannels, int outCICPIndex, int hasUniformSpread, int renderMode,
+                       int useGainGrid, const UCHAR* setupCache, UINT setupCacheSize);
 
 /*
  * @brief Render one frame with all objects from old oamStopSample to new oamStopSample.
@@ -129,10 +138,26 @@ int gVBAPRenderer_Open(HANDLE_GVBAPRENDERER* phgVBAPRenderer, int numObjects, in
  * @param outputBuffer          Output PCM samples
  * @param oamStopSample         Stop position of all objects
  * @param inputBufferChannelOffset Amount of samples for each channel in inputBuffer
+ * @param objectSkipped         One flag per object or NULL. Objects with a non-zero flag (switched
+ *                              off by user interactivity) are not mixed, their gains are updated.
  */
 int gVBAPRenderer_RenderFrame_Time(HANDLE_GVBAPRENDERER hgVBAPRenderer, VBAP_PCM* inputBuffer,
                                    VBAP_PCM* outputBuffer, const INT startSamplePosition,
-                                   const int inputBufferChannelOffset);
+                                   const int inputBufferChannelOffset,
+                                   const UCHAR* objectSkipped);
+
+/*
+ * @brief Append the derived speaker setup of the renderer to a setup cache, unless the cache
+ *        already contains an entry for the same speaker setup. The entries are only valid for the
+ *        library build which created them.
+ * @param hgVBAPRenderer        gVBAPRenderer handle
+ * @param setupCache            Setup cache or NULL to query the required size
+ * @param setupCacheSize        Size of the setup cache in bytes
+ * @param setupCacheUsed        Used bytes of the setup cache, incremented by the appended entry
+ * @return                      0 on success, -1 if the setup cache is too small
+ */
+int gVBAPRenderer_AppendSetup(HANDLE_GVBAPRENDERER hgVBAPRenderer, UCHAR* setupCache,
+                              UINT setupCacheSize, UINT* setupCacheUsed);
 
 /*
  * @brief Free memory for gVBAPRenderer Handle.
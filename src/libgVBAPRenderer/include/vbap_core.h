@@ -109,6 +109,15 @@ amm-info@iis.fraunhofer.de
 
 #define GVBAP_SPREAD_NUM_VSO (GVBAP_SPREAD_NUM_VSO_AZI * (GVBAP_SPREAD_NUM_VSO_ELE - 2) + 2)
 
+/* Precomputed gain grid (optional, GVBAP_ENHANCED only) */
+#define GVBAP_GAIN_GRID_STEP (2)                             /* grid resolution in degrees */
+#define GVBAP_GAIN_GRID_NUM_AZI (360 / GVBAP_GAIN_GRID_STEP) /* azimuth cells */
+#define GVBAP_GAIN_GRID_NUM_ELE (180 / GVBAP_GAIN_GRID_STEP) /* elevation cells */
+
+/* Renderer setup cache key: render mode, gain grid flag, CICP index, number of output channels and
+ * azimuth, elevation, LFE flag of each output channel */
+#define GVBAP_SETUP_KEY_LENGTH (4 + 3 * GVBAPRENDERER_MAX_CHANNEL_OUT)
+
 /* OAM definitions */
 #define OAM_NUMBER_COMPONENTS 5 /* number of OAM components */
 
@@ -208,6 +217,17 @@ typedef struct _SPEAKERSETUP {
 
 } SPEAKERSETUP;
 
+/*
+ * @brief VBAP panning result for one direction of the precomputed gain grid
+ * @param gain      normalized gains of the winner triplet, 0 for unused entries
+ * @param speaker   gain cache indices of the three triplet speakers
+ */
+typedef struct _GAINGRIDPOINT {
+  FIXP_SGL gain[3];
+  UCHAR speaker[3];
+
+} GAINGRIDPOINT;
+
 /*
  * @brief gVBAP Handler. Holds all information about the speaker setup, the calculated start and end
  * gains, information about the output channels and number of objects. Additional it holds some
@@ -258,6 +278,9 @@ typedef struct _GVBAPRENDERER {
 
   FIXP_DBL* gainCache; /* Dim: [real channels without LFE but with ghost speakers] */
 
+  GAINGRIDPOINT* gainGrid; /* Dim: [(GVBAP_GAIN_GRID_NUM_ELE + 1) * (GVBAP_GAIN_GRID_NUM_AZI + 1)],
+                              NULL if the triplet search is done for each source */
+
   FIXP_DBL** downmixMatrix; /* Dim: [real speakers without LFE][real speaker without LFE + ghost
                                speaker] */
   int downmixMatrixNumRows, downmixMatrixNumCols;
@@ -281,6 +304,7 @@ typedef struct _GVBAPRENDERER {
   SCHAR ghostVoiceOfHellSpeakerIndex;                /**< index of ghost voice of hell speaker */
   UCHAR renderMode; /**< 0: original rendering (MPEG standardized), 1: alternative (proprietary)
                        rendering (new spread rendering, new imaginary speaker initialization) */
+  INT setupKey[GVBAP_SETUP_KEY_LENGTH]; /**< identifies the speaker setup in the setup cache */
 } GVBAPRENDERER;
 
 /*
@@ -334,4 +358,20 @@ void calculateOneSourcePosition(HANDLE_GVBAPRENDERER hgVBAPRenderer, PointCartes
 
 void calcSpreadGains(HANDLE_GVBAPRENDERER hgVBAPRenderer, FIXP_DBL spreadAngle);
 
+/*
+ * @brief Allocates the gain grid and fills it with the VBAP panning results of all grid directions.
+ *        Requires the speaker triplets and inverse matrices to be set up.
+ * @param hgVBAPRenderer  gVBAPRenderer Handle
+ * @return                0 on success, -2 if memory allocation failed
+ */
+int createGainGrid(HANDLE_GVBAPRENDERER hgVBAPRenderer);
+
+/*
+ * @brief Adds the bilinear interpolated gains of the four grid points surrounding the source
+ *        direction to the gain cache. Replaces calculateOneSourcePosition() for point sources.
+ * @param hgVBAPRenderer  gVBAPRenderer Handle
+ * @param sph             Spherical coordinates of object position
+ */
+void interpolateGainGrid(HANDLE_GVBAPRENDERER hgVBAPRenderer, const PointSpherical* sph);
+
 #endif
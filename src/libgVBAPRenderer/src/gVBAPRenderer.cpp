@@ -107,6 +107,13 @@ amm-info@iis.fraunhofer.de
 
 #if defined(__arm__)
 #include "arm/gVBAPRenderer_arm.cpp"
+#elif defined(__x86__)
+#include "x86/gVBAPRenderer_x86.cpp"
+#endif
+
+#ifndef gVBAPRenderer_func_enabled
+/* Platform specific functions may depend on CPU features detected at runtime */
+#define gVBAPRenderer_func_enabled() 1
 #endif
 
 #define OBEJCT 0
@@ -1166,10 +1173,251 @@ static void gVBAPRenderer_Spread_initVSOPositions(FIXP_DBL* aziVSOAngles, FIXP_D
 
 /* ------ END OF SPREAD ------*/
 
+/* ------ SETUP CACHE ------*/
+
+#define GVBAP_SETUP_MAGIC 0x53425647 /* "GVBS" */
+/* format version and the sizes of the stored structures, which depend on the library build */
+#define GVBAP_SETUP_VERSION \
+  ((1 << 24) | ((UINT)sizeof(SPEAKERTRIPLET) << 12) | (UINT)sizeof(GAINGRIDPOINT))
+#define GVBAP_SETUP_MAX_TRIPLETS (1024)
+#define GVBAP_GAIN_GRID_SIZE ((GVBAP_GAIN_GRID_NUM_ELE + 1) * (GVBAP_GAIN_GRID_NUM_AZI + 1))
+
+/* Each setup cache entry consists of this header followed by the speaker triplets, the downmix
+ * matrix, the VSO gains and the gain grid. The entry size is a multiple of 4 bytes. */
+typedef struct {
+  UINT magic;
+  UINT version;
+  UINT entrySize; /* size of the entry in bytes including the header */
+  UINT checksum;  /* checksum of the entry with checksum set to 0 */
+  INT key[GVBAP_SETUP_KEY_LENGTH];
+  INT numGhosts;
+  INT speakerTripletSize;
+  INT greatestInverseMatrixExponent;
+  INT downmixMatrixNumRows; /* 0 if no downmix matrix exists */
+  INT downmixMatrixNumCols;
+  INT ghostVoiceOfGodSpeakerIndex;
+  INT ghostVoiceOfHellSpeakerIndex;
+  INT numGainsVSO;   /* GVBAP_SPREAD_NUM_VSO for GVBAP_ENHANCED, otherwise 0 */
+  INT numGridPoints; /* GVBAP_GAIN_GRID_SIZE if the gain grid is used, otherwise 0 */
+} GVBAP_SETUP_HEADER;
+
+static UINT gVBAPRenderer_Setup_checksum(const UCHAR* data, UINT size) {
+  UINT checksum = 2166136261u; /* FNV-1a */
+  for (UINT i = 0; i < size; i++) {
+    checksum = (checksum ^ data[i]) * 16777619u;
+  }
+  return checksum;
+}
+
+static UINT gVBAPRenderer_Setup_entrySize(const GVBAP_SETUP_HEADER* hdr, int gainCacheLength) {
+  UINT size = sizeof(GVBAP_SETUP_HEADER);
+  size += hdr->speakerTripletSize * sizeof(SPEAKERTRIPLET);
+  size += hdr->downmixMatrixNumRows * hdr->downmixMatrixNumCols * sizeof(FIXP_DBL);
+  size += hdr->numGainsVSO * gainCacheLength * sizeof(FIXP_DBL);
+  size += hdr->numGridPoints * sizeof(GAINGRIDPOINT);
+  return (size + 3) & ~3u;
+}
+
+static void gVBAPRenderer_Setup_createKey(INT* key, CICP2GEOMETRY_CHANNEL_GEOMETRY* outGeometryInfo,
+                                          int outChannels, int outCICPIndex, int renderMode,
+                                          int useGainGrid) {
+  FDKmemclear(key, GVBAP_SETUP_KEY_LENGTH * sizeof(INT));
+  key[0] = renderMode;
+  key[1] = (renderMode == GVBAP_ENHANCED) ? useGainGrid : 0;
+  key[2] = outCICPIndex;
+  key[3] = outChannels;
+  for (int i = 0; i < outChannels; i++) {
+    key[4 + 3 * i] = outGeometryInfo[i].Az;
+    key[5 + 3 * i] = outGeometryInfo[i].El;
+    key[6 + 3 * i] = outGeometryInfo[i].LFE;
+  }
+}
+
+/*
+ * @brief Check that all speaker indices of the triplets and the gain grid address the gain cache.
+ */
+static int gVBAPRenderer_Setup_checkIndices(const UCHAR* entry, const GVBAP_SETUP_HEADER* hdr,
+                                            int gainCacheLength) {
+  const UCHAR* data = entry + sizeof(GVBAP_SETUP_HEADER);
+  int i, j;
+
+  for (i = 0; i < hdr->speakerTripletSize; i++) {
+    SPEAKERTRIPLET triplet;
+    FDKmemcpy(&triplet, data, sizeof(SPEAKERTRIPLET));
+    data += sizeof(SPEAKERTRIPLET);
+    for (j = 0; j < 3; j++) {
+      if ((triplet.triangle[j] < 0) || (triplet.triangle[j] >= gainCacheLength)) return -1;
+    }
+  }
+
+  data += hdr->downmixMatrixNumRows * hdr->downmixMatrixNumCols * sizeof(FIXP_DBL);
+  data += hdr->numGainsVSO * gainCacheLength * sizeof(FIXP_DBL);
+
+  for (i = 0; i < hdr->numGridPoints; i++) {
+    GAINGRIDPOINT gridPoint;
+    FDKmemcpy(&gridPoint, data, sizeof(GAINGRIDPOINT));
+    data += sizeof(GAINGRIDPOINT);
+    for (j = 0; j < 3; j++) {
+      if (gridPoint.speaker[j] >= gainCacheLength) return -1;
+    }
+  }
+
+  return 0;
+}
+
+/*
+ * @brief Search the setup cache for a valid entry with the given key.
+ * @param setupCache        Setup cache
+ * @param setupCacheSize    Size of the setup cache in bytes
+ * @param key               Key of the speaker setup
+ * @param numSpeaker        Number of output speakers without LFE
+ * @param hdr               Receives the header of the entry
+ * @return                  Pointer to the entry or NULL if no valid entry was found
+ */
+static const UCHAR* gVBAPRenderer_Setup_find(const UCHAR* setupCache, UINT setupCacheSize,
+                                             const INT* key, int numSpeaker,
+                                             GVBAP_SETUP_HEADER* hdr) {
+  UINT offset = 0;
+
+  if (setupCache == NULL) return NULL;
+
+  while (setupCacheSize - offset >= sizeof(GVBAP_SETUP_HEADER)) {
+    const UCHAR* entry = setupCache + offset;
+    int gainCacheLength;
+
+    /* the cache may be unaligned */
+    FDKmemcpy(hdr, entry, sizeof(GVBAP_SETUP_HEADER));
+    if ((hdr->magic != GVBAP_SETUP_MAGIC) || (hdr->version != GVBAP_SETUP_VERSION) ||
+        (hdr->entrySize < sizeof(GVBAP_SETUP_HEADER)) ||
+        (hdr->entrySize > setupCacheSize - offset) || (hdr->entrySize & 3)) {
+      return NULL; /* no further entries */
+    }
+    offset += hdr->entrySize;
+
+    if (FDKmemcmp(hdr->key, key, sizeof(hdr->key)) != 0) continue;
+
+    /* check all counts before using them */
+    gainCacheLength = numSpeaker + hdr->numGhosts;
+    if ((hdr->numGhosts < 0) || (gainCacheLength > 127) || (hdr->speakerTripletSize <= 0) ||
+        (hdr->speakerTripletSize > GVBAP_SETUP_MAX_TRIPLETS)) {
+      continue;
+    }
+    if (!(((hdr->downmixMatrixNumRows == 0) && (hdr->downmixMatrixNumCols == 0)) ||
+          ((hdr->downmixMatrixNumRows == numSpeaker) &&
+           (hdr->downmixMatrixNumCols == gainCacheLength) && (hdr->numGhosts > 0)))) {
+      continue;
+    }
+    if ((hdr->ghostVoiceOfGodSpeakerIndex < -1) ||
+        (hdr->ghostVoiceOfGodSpeakerIndex >= gainCacheLength) ||
+        (hdr->ghostVoiceOfHellSpeakerIndex < -1) ||
+        (hdr->ghostVoiceOfHellSpeakerIndex >= gainCacheLength)) {
+      continue;
+    }
+    if ((hdr->numGainsVSO != ((key[0] == GVBAP_ENHANCED) ? GVBAP_SPREAD_NUM_VSO : 0)) ||
+        (hdr->numGridPoints != (key[1] ? GVBAP_GAIN_GRID_SIZE : 0))) {
+      continue;
+    }
+    if (gVBAPRenderer_Setup_entrySize(hdr, gainCacheLength) != hdr->entrySize) continue;
+
+    {
+      GVBAP_SETUP_HEADER tmp = *hdr;
+      UINT checksum;
+      tmp.checksum = 0;
+      checksum = gVBAPRenderer_Setup_checksum((const UCHAR*)&tmp, sizeof(GVBAP_SETUP_HEADER));
+      checksum ^= gVBAPRenderer_Setup_checksum(entry + sizeof(GVBAP_SETUP_HEADER),
+                                               hdr->entrySize - sizeof(GVBAP_SETUP_HEADER));
+      if (checksum != hdr->checksum) continue;
+    }
+
+    if (gVBAPRenderer_Setup_checkIndices(entry, hdr, gainCacheLength) != 0) continue;
+
+    return entry;
+  }
+
+  return NULL;
+}
+
+/*
+ * @brief Restore the speaker triplets, inverse matrices and downmix matrix from a setup cache entry
+ *        instead of the triangulation. The entry has been validated by gVBAPRenderer_Setup_find().
+ */
+static int gVBAPRenderer_Setup_loadSpeakerSetup(HANDLE_GVBAPRENDERER hgVBAPRenderer,
+                                                const UCHAR* entry,
+                                                const GVBAP_SETUP_HEADER* hdr) {
+  const UCHAR* data = entry + sizeof(GVBAP_SETUP_HEADER);
+  int i;
+
+  if ((hgVBAPRenderer->speakerSetup.speakerTriplet = (SPEAKERTRIPLET*)FDKmalloc(
+           hdr->speakerTripletSize * sizeof(SPEAKERTRIPLET))) == NULL) {
+    return -2; /* could not allocate memory */
+  }
+  FDKmemcpy(hgVBAPRenderer->speakerSetup.speakerTriplet, data,
+            hdr->speakerTripletSize * sizeof(SPEAKERTRIPLET));
+  data += hdr->speakerTripletSize * sizeof(SPEAKERTRIPLET);
+  hgVBAPRenderer->speakerSetup.speakerTripletSize = hdr->speakerTripletSize;
+  hgVBAPRenderer->speakerSetup.greatestInverseMatrixExponent = hdr->greatestInverseMatrixExponent;
+
+  if (hdr->downmixMatrixNumRows > 0) {
+    hgVBAPRenderer->downmixMatrix = (FIXP_DBL**)fdkCallocMatrix2D(
+        hdr->downmixMatrixNumRows, hdr->downmixMatrixNumCols, sizeof(FIXP_DBL));
+    if (hgVBAPRenderer->downmixMatrix == NULL) {
+      return -2; /* could not allocate memory */
+    }
+    for (i = 0; i < hdr->downmixMatrixNumRows; i++) {
+      FDKmemcpy(hgVBAPRenderer->downmixMatrix[i], data,
+                hdr->downmixMatrixNumCols * sizeof(FIXP_DBL));
+      data += hdr->downmixMatrixNumCols * sizeof(FIXP_DBL);
+    }
+  }
+  hgVBAPRenderer->downmixMatrixNumRows = hdr->downmixMatrixNumRows;
+  hgVBAPRenderer->downmixMatrixNumCols = hdr->downmixMatrixNumCols;
+
+  return 0;
+}
+
+/*
+ * @brief Restore the ghost speaker indices, VSO gains and gain grid of the spread rendering from a
+ *        setup cache entry. Requires the VSO gain arrays to be allocated.
+ */
+static int gVBAPRenderer_Setup_loadSpreadSetup(HANDLE_GVBAPRENDERER hgVBAPRenderer,
+                                               const UCHAR* entry,
+                                               const GVBAP_SETUP_HEADER* hdr) {
+  const UCHAR* data = entry + sizeof(GVBAP_SETUP_HEADER);
+  int i;
+
+  data += hdr->speakerTripletSize * sizeof(SPEAKERTRIPLET);
+  data += hdr->downmixMatrixNumRows * hdr->downmixMatrixNumCols * sizeof(FIXP_DBL);
+
+  hgVBAPRenderer->ghostVoiceOfGodSpeakerIndex = (SCHAR)hdr->ghostVoiceOfGodSpeakerIndex;
+  hgVBAPRenderer->ghostVoiceOfHellSpeakerIndex = (SCHAR)hdr->ghostVoiceOfHellSpeakerIndex;
+
+  for (i = 0; i < hdr->numGainsVSO; i++) {
+    FDKmemcpy(hgVBAPRenderer->spread_gainsVSO[i], data,
+              hgVBAPRenderer->gainCacheLength * sizeof(FIXP_DBL));
+    data += hgVBAPRenderer->gainCacheLength * sizeof(FIXP_DBL);
+  }
+
+  if (hdr->numGridPoints > 0) {
+    hgVBAPRenderer->gainGrid =
+        (GAINGRIDPOINT*)FDKmalloc(GVBAP_GAIN_GRID_SIZE * sizeof(GAINGRIDPOINT));
+    if (hgVBAPRenderer->gainGrid == NULL) {
+      return -2; /* could not allocate memory */
+    }
+    FDKmemcpy(hgVBAPRenderer->gainGrid, data, GVBAP_GAIN_GRID_SIZE * sizeof(GAINGRIDPOINT));
+  }
+
+  return 0;
+}
+
+/* ------ END OF SETUP CACHE ------*/
+
 int gVBAPRenderer_Open(HANDLE_GVBAPRENDERER* phgVBAPRenderer, int numObjects, int frameLength,
                        int oamFrameLength, CICP2GEOMETRY_CHANNEL_GEOMETRY* outGeometryInfo,
-                       int outChannels, int outCICPIndex, int hasUniformSpread, int renderMode) {
+                       int outChannels, int outCICPIndex, int hasUniformSpread, int renderMode,
+                       int useGainGrid, const UCHAR* setupCache, UINT setupCacheSize) {
   HANDLE_GVBAPRENDERER tmp;
+  const UCHAR* setupEntry;
+  GVBAP_SETUP_HEADER setupHdr;
   int i;
   int cnt;
   int numLFE = 0;
@@ -1269,60 +1517,74 @@ int gVBAPRenderer_Open(HANDLE_GVBAPRENDERER* phgVBAPRenderer, int numObjects, in
   }
   (*phgVBAPRenderer)->speakerSetup.speakerListSize = cnt;
 
-  /* Generate vertexList and add Ghost speakers if necessary */
-  // vL = newVertexList(outChannels - numLFE + 6);    /* Add 6 because a maximum of 6 ghost speakers
-  // could be added */
-  resetVertexList(vL);
-
-  qh_gen_VertexList(outChannels - numLFE, &azimuth[0], &elevation[0], vL);
+  /* Take the derived speaker setup from the setup cache if available */
+  gVBAPRenderer_Setup_createKey((*phgVBAPRenderer)->setupKey, outGeometryInfo, outChannels,
+                                outCICPIndex, renderMode, useGainGrid);
+  setupEntry = gVBAPRenderer_Setup_find(setupCache, setupCacheSize, (*phgVBAPRenderer)->setupKey,
+                                        outChannels - numLFE, &setupHdr);
 
-  // tL = newTriangleList((2*(outChannels - numLFE))+5);  /* The length of triangle List is a
-  // estimated value */
-  resetTriangleList(tL);
+  if (setupEntry != NULL) {
+    if (gVBAPRenderer_Setup_loadSpeakerSetup(*phgVBAPRenderer, setupEntry, &setupHdr) != 0) {
+      return -2; /* could not allocate memory */
+    }
+    numGhosts = setupHdr.numGhosts;
+  } else {
+    /* Generate vertexList and add Ghost speakers if necessary */
+    // vL = newVertexList(outChannels - numLFE + 6);    /* Add 6 because a maximum of 6 ghost
+    // speakers could be added */
+    resetVertexList(vL);
+
+    qh_gen_VertexList(outChannels - numLFE, &azimuth[0], &elevation[0], vL);
+
+    // tL = newTriangleList((2*(outChannels - numLFE))+5);  /* The length of triangle List is a
+    // estimated value */
+    resetTriangleList(tL);
+
+    /* Generate triangle List for speaker triangles and a downmixMatrix if Ghostspeaker where
+     * added */
+    if (qh_sphere_triangulation((renderMode == GVBAP_ENHANCED) ? outCICPIndex : 0, vL, tL,
+                                &(*phgVBAPRenderer)->downmixMatrix,
+                                &(*phgVBAPRenderer)->downmixMatrixNumRows,
+                                &(*phgVBAPRenderer)->downmixMatrixNumCols) != 0) {
+      return -2; /* could not allocate memory */
+    }
 
-  /* Generate triangle List for speaker triangles and a downmixMatrix if Ghostspeaker where added */
-  if (qh_sphere_triangulation((renderMode == GVBAP_ENHANCED) ? outCICPIndex : 0, vL, tL,
-                              &(*phgVBAPRenderer)->downmixMatrix,
-                              &(*phgVBAPRenderer)->downmixMatrixNumRows,
-                              &(*phgVBAPRenderer)->downmixMatrixNumCols) != 0) {
-    return -2; /* could not allocate memory */
-  }
+    if (vL->size ==
+        (outChannels -
+         numLFE)) /* if no downmixMatrix exists then free memory and set pointer to NULL */
+    {
+      if ((*phgVBAPRenderer)->downmixMatrix != NULL) {
+        fdkFreeMatrix2D((void**)(*phgVBAPRenderer)->downmixMatrix);
+        (*phgVBAPRenderer)->downmixMatrix = NULL;
+      }
+    }
 
-  if (vL->size ==
-      (outChannels -
-       numLFE)) /* if no downmixMatrix exists then free memory and set pointer to NULL */
-  {
-    if ((*phgVBAPRenderer)->downmixMatrix != NULL) {
-      fdkFreeMatrix2D((void**)(*phgVBAPRenderer)->downmixMatrix);
-      (*phgVBAPRenderer)->downmixMatrix = NULL;
+    /* allocate memory for speakerTriplet and fill it with values */
+    if (((*phgVBAPRenderer)->speakerSetup.speakerTriplet =
+             (SPEAKERTRIPLET*)FDKmalloc(tL->size * sizeof(SPEAKERTRIPLET))) == NULL) {
+      return -2; /* could not allocate memory */
     }
-  }
 
-  /* allocate memory for speakerTriplet and fill it with values */
-  if (((*phgVBAPRenderer)->speakerSetup.speakerTriplet =
-           (SPEAKERTRIPLET*)FDKmalloc(tL->size * sizeof(SPEAKERTRIPLET))) == NULL) {
-    return -2; /* could not allocate memory */
-  }
+    /* copy triangle list and fill matrices */
+    for (i = 0; i < tL->size; i++) {
+      (*phgVBAPRenderer)->speakerSetup.speakerTriplet[i].triangle[0] = tL->element[i].index[0];
+      (*phgVBAPRenderer)->speakerSetup.speakerTriplet[i].triangle[1] = tL->element[i].index[1];
+      (*phgVBAPRenderer)->speakerSetup.speakerTriplet[i].triangle[2] = tL->element[i].index[2];
+
+      (*phgVBAPRenderer)->speakerSetup.speakerTriplet[i].matrix[0] =
+          vL->element[tL->element[i].index[0]].xyz;
+      (*phgVBAPRenderer)->speakerSetup.speakerTriplet[i].matrix[1] =
+          vL->element[tL->element[i].index[1]].xyz;
+      (*phgVBAPRenderer)->speakerSetup.speakerTriplet[i].matrix[2] =
+          vL->element[tL->element[i].index[2]].xyz;
+    }
+    (*phgVBAPRenderer)->speakerSetup.speakerTripletSize = tL->size;
 
-  /* copy triangle list and fill matrices */
-  for (i = 0; i < tL->size; i++) {
-    (*phgVBAPRenderer)->speakerSetup.speakerTriplet[i].triangle[0] = tL->element[i].index[0];
-    (*phgVBAPRenderer)->speakerSetup.speakerTriplet[i].triangle[1] = tL->element[i].index[1];
-    (*phgVBAPRenderer)->speakerSetup.speakerTriplet[i].triangle[2] = tL->element[i].index[2];
+    numGhosts = vL->size - (outChannels - numLFE); /* Number of Ghostspeakers */
 
-    (*phgVBAPRenderer)->speakerSetup.speakerTriplet[i].matrix[0] =
-        vL->element[tL->element[i].index[0]].xyz;
-    (*phgVBAPRenderer)->speakerSetup.speakerTriplet[i].matrix[1] =
-        vL->element[tL->element[i].index[1]].xyz;
-    (*phgVBAPRenderer)->speakerSetup.speakerTriplet[i].matrix[2] =
-        vL->element[tL->element[i].index[2]].xyz;
+    /* Calculate inverse matrices */
+    generateInverseMatrices(*phgVBAPRenderer);
   }
-  (*phgVBAPRenderer)->speakerSetup.speakerTripletSize = tL->size;
-
-  numGhosts = vL->size - (outChannels - numLFE); /* Number of Ghostspeakers */
-
-  /* Calculate inverse matrices */
-  generateInverseMatrices(*phgVBAPRenderer);
 
   /* Set parameters */
   (*phgVBAPRenderer)->numLFE = numLFE;           /* Number of LFE speakers */
@@ -1377,23 +1639,6 @@ int gVBAPRenderer_Open(HANDLE_GVBAPRENDERER* phgVBAPRenderer, int numObjects, in
     /* initialization of spread rendering */
     int spread_numInvolvedLS = outChannels + numGhosts - numLFE;
 
-    (*phgVBAPRenderer)->ghostVoiceOfGodSpeakerIndex = -1;
-    (*phgVBAPRenderer)->ghostVoiceOfHellSpeakerIndex = -1;
-    for (i = 0; i < spread_numInvolvedLS; i++) {
-      /* Assumption: A speaker is a ghost speaker if it is not downmixed to exactly one output
-       * speaker */
-      int nOutputTargets = 0;
-      for (int j = 0; j < (*phgVBAPRenderer)->downmixMatrixNumRows; j++) {
-        if ((LONG)(*phgVBAPRenderer)->downmixMatrix[j][i] != 0) nOutputTargets++;
-      }
-
-      if (nOutputTargets != 1) {
-        FIXP_DBL el = vL->element[i].sph.ele;
-        if (el > (FIXP_DBL)(85 * 11930464)) (*phgVBAPRenderer)->ghostVoiceOfGodSpeakerIndex = i;
-        if (el < (FIXP_DBL)(-85 * 11930464)) (*phgVBAPRenderer)->ghostVoiceOfHellSpeakerIndex = i;
-      }
-    }
-
     (*phgVBAPRenderer)->spread_gainArray =
         (FIXP_DBL*)FDKcalloc(spread_numInvolvedLS, sizeof(FIXP_DBL));
     if ((*phgVBAPRenderer)->spread_gainArray == NULL) {
@@ -1408,47 +1653,77 @@ int gVBAPRenderer_Open(HANDLE_GVBAPRENDERER* phgVBAPRenderer, int numObjects, in
       }
     }
 
-    {
-      FIXP_DBL aziVSOAngles[GVBAP_SPREAD_NUM_VSO_AZI], eleVSOAngles[GVBAP_SPREAD_NUM_VSO_ELE];
-      int na, ne, objNo = 0;
-      OAM_SAMPLE oam;
-
-      /* virtual spread object positions */
-      gVBAPRenderer_Spread_initVSOPositions(aziVSOAngles, eleVSOAngles);
-
-      oam.gain = FL2FXCONST_DBL(1.0);
-      oam.spreadAngle = oam.spreadHeight = oam.spreadDepth = (FIXP_DBL)0;
-
-      /* panning of VSOs with VBAP */
-      for (ne = 1; ne < GVBAP_SPREAD_NUM_VSO_ELE - 1; ne++) {
-        for (na = 0; na < GVBAP_SPREAD_NUM_VSO_AZI; na++) {
-          oam.sph.azi = aziVSOAngles[na];
-          oam.sph.ele = eleVSOAngles[ne];
-          oam.sph.rad = FL2FXCONST_DBL(1.0);
-          oam.goa_bsObjectDistance = 0;
-          oam.cart = sphericalToCartesian(oam.sph);
-
-          /* "non-downmix" gain output including ghost speakers */
-          calculateVbap(*phgVBAPRenderer, oam, (*phgVBAPRenderer)->spread_gainsVSO[objNo], 1);
-          objNo++;
+    if (setupEntry != NULL) {
+      if (gVBAPRenderer_Setup_loadSpreadSetup(*phgVBAPRenderer, setupEntry, &setupHdr) != 0) {
+        return -2;
+      }
+    } else {
+      (*phgVBAPRenderer)->ghostVoiceOfGodSpeakerIndex = -1;
+      (*phgVBAPRenderer)->ghostVoiceOfHellSpeakerIndex = -1;
+      for (i = 0; i < spread_numInvolvedLS; i++) {
+        /* Assumption: A speaker is a ghost speaker if it is not downmixed to exactly one output
+         * speaker */
+        int nOutputTargets = 0;
+        for (int j = 0; j < (*phgVBAPRenderer)->downmixMatrixNumRows; j++) {
+          if ((LONG)(*phgVBAPRenderer)->downmixMatrix[j][i] != 0) nOutputTargets++;
+        }
+
+        if (nOutputTargets != 1) {
+          FIXP_DBL el = vL->element[i].sph.ele;
+          if (el > (FIXP_DBL)(85 * 11930464)) (*phgVBAPRenderer)->ghostVoiceOfGodSpeakerIndex = i;
+          if (el < (FIXP_DBL)(-85 * 11930464)) (*phgVBAPRenderer)->ghostVoiceOfHellSpeakerIndex = i;
         }
       }
 
-      /* vbap-panning of virtual spread objects at elevation -90 degrees */
-      oam.sph.azi = (FIXP_DBL)0;
-      oam.sph.ele = eleVSOAngles[0];
-      oam.sph.rad = FL2FXCONST_DBL(1.0);
-      oam.cart = sphericalToCartesian(oam.sph);
-      calculateVbap(*phgVBAPRenderer, oam, (*phgVBAPRenderer)->spread_gainsVSO[objNo], 1);
-      objNo++;
+      {
+        FIXP_DBL aziVSOAngles[GVBAP_SPREAD_NUM_VSO_AZI], eleVSOAngles[GVBAP_SPREAD_NUM_VSO_ELE];
+        int na, ne, objNo = 0;
+        OAM_SAMPLE oam;
+
+        /* virtual spread object positions */
+        gVBAPRenderer_Spread_initVSOPositions(aziVSOAngles, eleVSOAngles);
+
+        oam.gain = FL2FXCONST_DBL(1.0);
+        oam.spreadAngle = oam.spreadHeight = oam.spreadDepth = (FIXP_DBL)0;
+
+        /* panning of VSOs with VBAP */
+        for (ne = 1; ne < GVBAP_SPREAD_NUM_VSO_ELE - 1; ne++) {
+          for (na = 0; na < GVBAP_SPREAD_NUM_VSO_AZI; na++) {
+            oam.sph.azi = aziVSOAngles[na];
+            oam.sph.ele = eleVSOAngles[ne];
+            oam.sph.rad = FL2FXCONST_DBL(1.0);
+            oam.goa_bsObjectDistance = 0;
+            oam.cart = sphericalToCartesian(oam.sph);
+
+            /* "non-downmix" gain output including ghost speakers */
+            calculateVbap(*phgVBAPRenderer, oam, (*phgVBAPRenderer)->spread_gainsVSO[objNo], 1);
+            objNo++;
+          }
+        }
 
-      /* vbap-panning of virtual spread objects at elevation +90 degrees */
-      oam.sph.azi = (FIXP_DBL)0;
-      oam.sph.ele = eleVSOAngles[GVBAP_SPREAD_NUM_VSO_ELE - 1];
-      oam.sph.rad = FL2FXCONST_DBL(1.0);
-      oam.cart = sphericalToCartesian(oam.sph);
-      calculateVbap(*phgVBAPRenderer, oam, (*phgVBAPRenderer)->spread_gainsVSO[objNo], 1);
-      objNo++;
+        /* vbap-panning of virtual spread objects at elevation -90 degrees */
+        oam.sph.azi = (FIXP_DBL)0;
+        oam.sph.ele = eleVSOAngles[0];
+        oam.sph.rad = FL2FXCONST_DBL(1.0);
+        oam.cart = sphericalToCartesian(oam.sph);
+        calculateVbap(*phgVBAPRenderer, oam, (*phgVBAPRenderer)->spread_gainsVSO[objNo], 1);
+        objNo++;
+
+        /* vbap-panning of virtual spread objects at elevation +90 degrees */
+        oam.sph.azi = (FIXP_DBL)0;
+        oam.sph.ele = eleVSOAngles[GVBAP_SPREAD_NUM_VSO_ELE - 1];
+        oam.sph.rad = FL2FXCONST_DBL(1.0);
+        oam.cart = sphericalToCartesian(oam.sph);
+        calculateVbap(*phgVBAPRenderer, oam, (*phgVBAPRenderer)->spread_gainsVSO[objNo], 1);
+        objNo++;
+      }
+
+      /* precompute the panning of point sources, the VSO gains above are calculated exactly */
+      if (useGainGrid) {
+        if (createGainGrid(*phgVBAPRenderer) != 0) {
+          return -2;
+        }
+      }
     }
   }
 
@@ -1522,7 +1797,8 @@ int gVBAPRenderer_Open(HANDLE_GVBAPRENDERER* phgVBAPRenderer, int numObjects, in
 int gVBAPRenderer_RenderFrame_Time(HANDLE_GVBAPRENDERER RESTRICT hgVBAPRenderer,
                                    VBAP_PCM* RESTRICT inputBuffer, VBAP_PCM* RESTRICT outputBuffer,
                                    const INT startSamplePosition,
-                                   const int inputBufferChannelOffset) {
+                                   const int inputBufferChannelOffset,
+                                   const UCHAR* RESTRICT objectSkipped) {
   static const FIXP_DBL inv_length_table[] = {
     (FIXP_DBL)0x04000000,
     (FIXP_DBL)0x02000000,
@@ -1593,6 +1869,11 @@ int gVBAPRenderer_RenderFrame_Time(HANDLE_GVBAPRENDERER RESTRICT hgVBAPRenderer,
 
   FIXP_DBL endGainsMax[GVBAPRENDERER_MAX_CHANNEL_OUT];
 
+  /* gain ramps of the objects contributing to the current output channel */
+  VBAP_PCM* activeIn[GVBAPRENDERER_MAX_OBJECTS];
+  FIXP_DBL activeScale[GVBAPRENDERER_MAX_OBJECTS], activeStep[GVBAPRENDERER_MAX_OBJECTS];
+  FIXP_DBL activeScaleState[GVBAPRENDERER_MAX_OBJECTS], activeStepState[GVBAPRENDERER_MAX_OBJECTS];
+
   while (oamFrame < numOamFrames) {
     OAM_SAMPLE *oamStopSamples, oamStopSample;
 
@@ -1673,11 +1954,10 @@ int gVBAPRenderer_RenderFrame_Time(HANDLE_GVBAPRENDERER RESTRICT hgVBAPRenderer,
     /* Add object channels multiplied by gain to output buffer */
     for (channel = 0; channel < hgVBAPRenderer->numChannels; channel++) {
       int s, s1, s2;
+      int numActive;
       FIXP_DBL tmp, maxGain;
 
       mappedChannel = hgVBAPRenderer->speakerSetup.mapping[channel];
-      C_AALLOC_SCRATCH_START(outputCache, FIXP_DBL, GVBAPRENDERER_MAX_FRAMELENGTH)
-      FDKmemclear(outputCache, length * sizeof(FIXP_DBL));
 
       tmp = fMax(hgVBAPRenderer->startGainsMax[channel], endGainsMax[channel]);
       maxGain = fMax(tmp, hgVBAPRenderer->prevGainsMax[channel]);
@@ -1704,6 +1984,8 @@ int gVBAPRenderer_RenderFrame_Time(HANDLE_GVBAPRENDERER RESTRICT hgVBAPRenderer,
         s1 = -s;
       }
 
+      /* Collect the objects contributing to this channel and advance their gain ramps */
+      numActive = 0;
       for (object = 0; object < hgVBAPRenderer->numObjects; object++) {
         /* load States */
         FIXP_DBL scaleState = hgVBAPRenderer->scaleState[object][channel];
@@ -1724,29 +2006,70 @@ int gVBAPRenderer_RenderFrame_Time(HANDLE_GVBAPRENDERER RESTRICT hgVBAPRenderer,
             stepState == (FIXP_DBL)0) {
           continue;
         }
-        VBAP_PCM* pIn = &inputBuffer[(object * inputBufferChannelOffset) + startSample];
+        FDK_ASSERT(scale <= maxGain);
+        FDK_ASSERT(scaleState <= maxGain);
         FDK_ASSERT((startSamplePosition & (INT)7) ==
                    0); /* due to arm (divisible by 8) and xtensa (divisible by 4) restriction in
                           implementation */
         FDK_ASSERT((length & (INT)7) == 0); /* due to arm (divisible by 8) and xtensa (divisible by
                                                4) restriction in implementation */
 
+        /* save states */
+        hgVBAPRenderer->scaleState[object][channel] = scale + step * (length - startSamplePosition);
+        hgVBAPRenderer->stepState[object][channel] = step;
+        FDK_ASSERT(hgVBAPRenderer->scaleState[object][channel] <= maxGain);
+
+        /* Objects switched off keep their gain ramps but are not mixed */
+        if ((objectSkipped != NULL) && objectSkipped[object]) {
+          continue;
+        }
+
+        activeIn[numActive] = &inputBuffer[(object * inputBufferChannelOffset) + startSample];
+        activeScale[numActive] = scale;
+        activeStep[numActive] = step;
+        activeScaleState[numActive] = scaleState;
+        activeStepState[numActive] = stepState;
+        numActive++;
+      }
+
+      /* Adding nothing leaves the output channel unchanged */
+      if (numActive == 0) {
+        continue;
+      }
+
+      VBAP_PCM* pOut = &outputBuffer[(mappedChannel * hgVBAPRenderer->frameLength) + startSample];
+
+#if defined(FUNCTION_gVBAPRenderer_RenderFrame_Time_mix)
+      if (gVBAPRenderer_func_enabled()) {
+        gVBAPRenderer_RenderFrame_Time_mix(pOut, activeIn, activeScale, activeStep,
+                                           activeScaleState, activeStepState, numActive, length,
+                                           startSamplePosition, s, s2);
+        continue;
+      }
+#endif
+
+      C_AALLOC_SCRATCH_START(outputCache, FIXP_DBL, GVBAPRENDERER_MAX_FRAMELENGTH)
+      FDKmemclear(outputCache, length * sizeof(FIXP_DBL));
+
+      for (int k = 0; k < numActive; k++) {
+        VBAP_PCM* pIn = activeIn[k];
+        FIXP_DBL scaleState = activeScaleState[k];
+        FIXP_DBL stepState = activeStepState[k];
+
+        scale = activeScale[k];
+        step = activeStep[k];
+
 /* #define DEBUG_gVBAPRenderer_RenderFrame_Time_func1 */
 #ifdef DEBUG_gVBAPRenderer_RenderFrame_Time_func1
         INT start_clock = FDKclock();
 #endif
 #if defined(FUNCTION_gVBAPRenderer_RenderFrame_Time_func1)
-        /* save states */
-        hgVBAPRenderer->scaleState[object][channel] = scale + step * (length - startSamplePosition);
-        hgVBAPRenderer->stepState[object][channel] = step;
         gVBAPRenderer_RenderFrame_Time_func1(outputCache, pIn, length, startSamplePosition, scale,
                                              step, scaleState, stepState, s, s1);
 #else
         int sample;
 
         if (s < 0) {
-          FDK_ASSERT(scale <= maxGain);
-          FDK_ASSERT(scaleState <= maxGain);
           for (sample = 0; sample < startSamplePosition;
                sample++) /* process first startSamplePosition samples */
           {
@@ -1758,11 +2081,7 @@ int gVBAPRenderer_RenderFrame_Time(HANDLE_GVBAPRENDERER RESTRICT hgVBAPRenderer,
             scale = scale + step;
             outputCache[sample] += fMult((FIXP_DBL)pIn[sample], scale) << (s1 - 1);
           }
-          FDK_ASSERT(scale <= maxGain);
-          FDK_ASSERT(scaleState <= maxGain);
         } else {
-          FDK_ASSERT(scale <= maxGain);
-          FDK_ASSERT(scaleState <= maxGain);
           for (sample = 0; sample < startSamplePosition;
                sample++) /* process first startSamplePosition samples */
           {
@@ -1774,12 +2093,7 @@ int gVBAPRenderer_RenderFrame_Time(HANDLE_GVBAPRENDERER RESTRICT hgVBAPRenderer,
             scale = scale + step;
             outputCache[sample] += fMult((FIXP_DBL)pIn[sample], scale) >> (s1 + 1);
           }
-          FDK_ASSERT(scale <= maxGain);
-          FDK_ASSERT(scaleState <= maxGain);
         }
-        /* save states */
-        hgVBAPRenderer->scaleState[object][channel] = scale;
-        hgVBAPRenderer->stepState[object][channel] = step;
 #endif
 #ifdef DEBUG_gVBAPRenderer_RenderFrame_Time_func1
         INT stop_clock = FDKclock();
@@ -1791,14 +2105,12 @@ int gVBAPRenderer_RenderFrame_Time(HANDLE_GVBAPRENDERER RESTRICT hgVBAPRenderer,
                     outputCache[sample + 3], sample, pIn[sample + 0], pIn[sample + 1],
                     pIn[sample + 2], pIn[sample + 3]);
         }
-        FDKprintf("scale: 0x%08X\n", hgVBAPRenderer->scaleState[object][channel]);
-        FDKprintf("step:  0x%08X\n", hgVBAPRenderer->stepState[object][channel]);
+        FDKprintf("scale: 0x%08X\n", scale);
+        FDKprintf("step:  0x%08X\n", step);
         ;
 #endif
       }
 
-      VBAP_PCM* pOut = &outputBuffer[(mappedChannel * hgVBAPRenderer->frameLength) + startSample];
-
 /* #define DEBUG_gVBAPRenderer_RenderFrame_Time_func2 */
 #ifdef DEBUG_gVBAPRenderer_RenderFrame_Time_func2
       INT start_clock = FDKclock();
@@ -1840,6 +2152,90 @@ int gVBAPRenderer_RenderFrame_Time(HANDLE_GVBAPRENDERER RESTRICT hgVBAPRenderer,
   return 0;
 }
 
+int gVBAPRenderer_AppendSetup(HANDLE_GVBAPRENDERER hgVBAPRenderer, UCHAR* setupCache,
+                              UINT setupCacheSize, UINT* setupCacheUsed) {
+  GVBAP_SETUP_HEADER hdr;
+  UCHAR *entry, *data;
+  UINT checksum;
+  int numSpeaker = hgVBAPRenderer->numChannels - hgVBAPRenderer->numLFE;
+  int i;
+
+  FDKmemclear(&hdr, sizeof(GVBAP_SETUP_HEADER));
+  hdr.magic = GVBAP_SETUP_MAGIC;
+  hdr.version = GVBAP_SETUP_VERSION;
+  FDKmemcpy(hdr.key, hgVBAPRenderer->setupKey, sizeof(hdr.key));
+  hdr.numGhosts = hgVBAPRenderer->numGhosts;
+  hdr.speakerTripletSize = hgVBAPRenderer->speakerSetup.speakerTripletSize;
+  hdr.greatestInverseMatrixExponent = hgVBAPRenderer->speakerSetup.greatestInverseMatrixExponent;
+  if (hgVBAPRenderer->downmixMatrix != NULL) {
+    hdr.downmixMatrixNumRows = hgVBAPRenderer->downmixMatrixNumRows;
+    hdr.downmixMatrixNumCols = hgVBAPRenderer->downmixMatrixNumCols;
+  }
+  hdr.ghostVoiceOfGodSpeakerIndex = -1;
+  hdr.ghostVoiceOfHellSpeakerIndex = -1;
+  if (hgVBAPRenderer->renderMode == GVBAP_ENHANCED) {
+    hdr.ghostVoiceOfGodSpeakerIndex = hgVBAPRenderer->ghostVoiceOfGodSpeakerIndex;
+    hdr.ghostVoiceOfHellSpeakerIndex = hgVBAPRenderer->ghostVoiceOfHellSpeakerIndex;
+    hdr.numGainsVSO = GVBAP_SPREAD_NUM_VSO;
+  }
+  if (hgVBAPRenderer->gainGrid != NULL) {
+    hdr.numGridPoints = GVBAP_GAIN_GRID_SIZE;
+  }
+  hdr.entrySize = gVBAPRenderer_Setup_entrySize(&hdr, hgVBAPRenderer->gainCacheLength);
+
+  if (setupCache == NULL) {
+    /* size query */
+    *setupCacheUsed += hdr.entrySize;
+    return 0;
+  }
+
+  /* one entry per speaker setup */
+  {
+    GVBAP_SETUP_HEADER entryHdr;
+    if (gVBAPRenderer_Setup_find(setupCache, *setupCacheUsed, hdr.key, numSpeaker, &entryHdr) !=
+        NULL) {
+      return 0;
+    }
+  }
+
+  if (hdr.entrySize > setupCacheSize - *setupCacheUsed) {
+    return -1;
+  }
+
+  entry = setupCache + *setupCacheUsed;
+  data = entry + sizeof(GVBAP_SETUP_HEADER);
+  FDKmemclear(data, hdr.entrySize - sizeof(GVBAP_SETUP_HEADER));
+
+  FDKmemcpy(data, hgVBAPRenderer->speakerSetup.speakerTriplet,
+            hdr.speakerTripletSize * sizeof(SPEAKERTRIPLET));
+  data += hdr.speakerTripletSize * sizeof(SPEAKERTRIPLET);
+
+  for (i = 0; i < hdr.downmixMatrixNumRows; i++) {
+    FDKmemcpy(data, hgVBAPRenderer->downmixMatrix[i], hdr.downmixMatrixNumCols * sizeof(FIXP_DBL));
+    data += hdr.downmixMatrixNumCols * sizeof(FIXP_DBL);
+  }
+
+  for (i = 0; i < hdr.numGainsVSO; i++) {
+    FDKmemcpy(data, hgVBAPRenderer->spread_gainsVSO[i],
+              hgVBAPRenderer->gainCacheLength * sizeof(FIXP_DBL));
+    data += hgVBAPRenderer->gainCacheLength * sizeof(FIXP_DBL);
+  }
+
+  if (hdr.numGridPoints > 0) {
+    FDKmemcpy(data, hgVBAPRenderer->gainGrid, hdr.numGridPoints * sizeof(GAINGRIDPOINT));
+  }
+
+  checksum = gVBAPRenderer_Setup_checksum((const UCHAR*)&hdr, sizeof(GVBAP_SETUP_HEADER));
+  checksum ^= gVBAPRenderer_Setup_checksum(entry + sizeof(GVBAP_SETUP_HEADER),
+                                           hdr.entrySize - sizeof(GVBAP_SETUP_HEADER));
+  hdr.checksum = checksum;
+  FDKmemcpy(entry, &hdr, sizeof(GVBAP_SETUP_HEADER));
+
+  *setupCacheUsed += hdr.entrySize;
+
+  return 0;
+}
+
 int gVBAPRenderer_Close(HANDLE_GVBAPRENDERER hgVBAPRenderer) {
   /* free start and end gain memory */
   fdkFreeMatrix2D((void**)hgVBAPRenderer->startGains);
@@ -1897,6 +2293,11 @@ int gVBAPRenderer_Close(HANDLE_GVBAPRENDERER hgVBAPRenderer) {
     FDKfree(hgVBAPRenderer->spread_gainArray);
   }
 
+  /* free gain grid */
+  if (hgVBAPRenderer->gainGrid != NULL) {
+    FDKfree(hgVBAPRenderer->gainGrid);
+  }
+
   /* free VBAP handle */
   FDKfree(hgVBAPRenderer);
 
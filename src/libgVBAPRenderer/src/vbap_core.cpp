@@ -263,7 +263,11 @@ void calculateVbapGain(HANDLE_GVBAPRENDERER hgVBAPRenderer, OAM_SAMPLE source) {
     /* resulting gains has an exponent of 2 */
     calcSpreadGains(hgVBAPRenderer, source.spreadAngle);
   } else {
-    calculateOneSourcePosition(hgVBAPRenderer, &source.cart);
+    if (hgVBAPRenderer->gainGrid != NULL) {
+      interpolateGainGrid(hgVBAPRenderer, &source.sph);
+    } else {
+      calculateOneSourcePosition(hgVBAPRenderer, &source.cart);
+    }
 
     normalizePower(hgVBAPRenderer);
   }
@@ -587,6 +591,96 @@ void calcSpreadGains(HANDLE_GVBAPRENDERER hgVBAPRenderer, FIXP_DBL spreadAngle)
   }
 }
 
+int createGainGrid(HANDLE_GVBAPRENDERER hgVBAPRenderer) {
+  int na, ne, i;
+  GAINGRIDPOINT* gridPoint;
+
+  FDK_ASSERT(hgVBAPRenderer->renderMode == GVBAP_ENHANCED);
+
+  hgVBAPRenderer->gainGrid = (GAINGRIDPOINT*)FDKmalloc(
+      (GVBAP_GAIN_GRID_NUM_ELE + 1) * (GVBAP_GAIN_GRID_NUM_AZI + 1) * sizeof(GAINGRIDPOINT));
+  if (hgVBAPRenderer->gainGrid == NULL) {
+    return -2; /* could not allocate memory */
+  }
+
+  /* rows from -90 to 90 degrees elevation, columns from -180 to 180 degrees azimuth */
+  gridPoint = hgVBAPRenderer->gainGrid;
+  for (ne = 0; ne <= GVBAP_GAIN_GRID_NUM_ELE; ne++) {
+    for (na = 0; na <= GVBAP_GAIN_GRID_NUM_AZI; na++) {
+      PointSpherical sph;
+      PointCartesian cart;
+      int n = 0;
+
+      sph.azi = FIXP_DBL((na * GVBAP_GAIN_GRID_STEP - 180) * (INT)11930464);
+      sph.ele = FIXP_DBL((ne * GVBAP_GAIN_GRID_STEP - 90) * (INT)11930464);
+      sph.rad = FL2FXCONST_DBL(1.0 / 16);
+      cart = sphericalToCartesian(sph);
+
+      FDKmemclear(hgVBAPRenderer->gainCache,
+                  hgVBAPRenderer->gainCacheLength * sizeof(FIXP_DBL));
+      calculateOneSourcePosition(hgVBAPRenderer, &cart);
+
+      /* the winner triplet contributes the only non-zero gains, stored with an exponent of 5 */
+      FDKmemclear(gridPoint, sizeof(GAINGRIDPOINT));
+      for (i = 0; i < hgVBAPRenderer->gainCacheLength; i++) {
+        if (hgVBAPRenderer->gainCache[i] != (FIXP_DBL)0) {
+          FDK_ASSERT(n < 3);
+          gridPoint->speaker[n] = (UCHAR)i;
+          gridPoint->gain[n] = FX_DBL2FX_SGL(hgVBAPRenderer->gainCache[i] << 5);
+          n++;
+        }
+      }
+      gridPoint++;
+    }
+  }
+
+  return 0;
+}
+
+void interpolateGainGrid(HANDLE_GVBAPRENDERER hgVBAPRenderer, const PointSpherical* sph) {
+  const GAINGRIDPOINT* gridPoint[4];
+  FIXP_DBL weight[4];
+  FIXP_DBL fracAzi, fracEle;
+  FIXP_DBL ele = sph->ele;
+  UINT64 pos;
+  int na, ne, i, j;
+
+  /* azimuth -180 ... 180 degrees is mapped to 0 ... 2^32 */
+  pos = (UINT64)((UINT)sph->azi ^ 0x80000000) * GVBAP_GAIN_GRID_NUM_AZI;
+  na = (int)(pos >> 32);
+  fracAzi = (FIXP_DBL)((UINT)pos >> 1);
+
+  /* elevation -90 ... 90 degrees is mapped to 0 ... 2^31 */
+  if (ele > (FIXP_DBL)0x40000000) ele = (FIXP_DBL)0x40000000;
+  if (ele < (FIXP_DBL)-0x40000000) ele = (FIXP_DBL)-0x40000000;
+  pos = (UINT64)(UINT)((LONG)ele + 0x40000000) * GVBAP_GAIN_GRID_NUM_ELE;
+  ne = (int)(pos >> 31);
+  fracEle = (FIXP_DBL)((UINT)pos & 0x7FFFFFFF);
+  if (ne == GVBAP_GAIN_GRID_NUM_ELE) {
+    ne--;
+    fracEle = (FIXP_DBL)MAXVAL_DBL;
+  }
+
+  gridPoint[0] = &hgVBAPRenderer->gainGrid[ne * (GVBAP_GAIN_GRID_NUM_AZI + 1) + na];
+  gridPoint[1] = gridPoint[0] + 1;
+  gridPoint[2] = gridPoint[0] + (GVBAP_GAIN_GRID_NUM_AZI + 1);
+  gridPoint[3] = gridPoint[2] + 1;
+
+  weight[0] = fMult((FIXP_DBL)MAXVAL_DBL - fracAzi, (FIXP_DBL)MAXVAL_DBL - fracEle);
+  weight[1] = fMult(fracAzi, (FIXP_DBL)MAXVAL_DBL - fracEle);
+  weight[2] = fMult((FIXP_DBL)MAXVAL_DBL - fracAzi, fracEle);
+  weight[3] = fMult(fracAzi, fracEle);
+
+  /* The weights sum up to 1, so the gains keep the exponent of 5 of calculateOneSourcePosition() */
+  for (i = 0; i < 4; i++) {
+    for (j = 0; j < 3; j++) {
+      FDK_ASSERT(gridPoint[i]->speaker[j] < hgVBAPRenderer->gainCacheLength);
+      hgVBAPRenderer->gainCache[gridPoint[i]->speaker[j]] +=
+          fMult(weight[i], gridPoint[i]->gain[j]) >> 5;
+    }
+  }
+}
+
 static void normalizePower(HANDLE_GVBAPRENDERER hgVBAPRenderer) {
   int i;
   FIXP_DBL gain_norm = 0, gain_norm_inv = 0;
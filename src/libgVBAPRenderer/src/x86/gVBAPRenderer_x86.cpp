@@ -0,0 +1,227 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2018 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+/******************** MPEG-H 3DA object rendering library **********************
+
+   Author(s):
+
+   Description: (x86 SSE4.1/AVX2 optimized) object rendering
+
+*******************************************************************************/
+
+#if defined(__x86_SSE4_1__)
+#include "x86/FDK_x86_funcs.h"
+
+#define FUNCTION_gVBAPRenderer_RenderFrame_Time_mix
+#define gVBAPRenderer_func_enabled() FDK_X86_HAS_SSE4_1
+#endif
+
+#if defined(FUNCTION_gVBAPRenderer_RenderFrame_Time_mix)
+/* The objects are mixed in blocks of samples that are accumulated in registers over all objects
+ * and then added to the output channel, so no intermediate buffer is needed. The gain of object k
+ * at position n of a ramp is scale[k] + (n + 1) * step[k], computed with the same wrap-around as
+ * the repeated additions of the C code. Each product fMult(x, gain) is scaled by << shl >> shr,
+ * which equals the << (s1 - 1) resp. >> (s1 + 1) of the C code. */
+
+static inline FDK_X86_TARGET_SSE4_1 void gVBAPRenderer_mixBlock_SSE4_1(
+    __m128i* acc, const int numVec, VBAP_PCM* const* pIn, const FIXP_DBL* scale,
+    const FIXP_DBL* step, INT numIn, INT pos, INT rampPos, __m128i shl, __m128i shr) {
+  const __m128i ramp = _mm_add_epi32(_mm_setr_epi32(1, 2, 3, 4), _mm_set1_epi32(rampPos));
+
+  for (int v = 0; v < numVec; v++) {
+    acc[v] = _mm_setzero_si128();
+  }
+  for (INT k = 0; k < numIn; k++) {
+    const VBAP_PCM* in = &pIn[k][pos];
+    __m128i stepV = _mm_set1_epi32(step[k]);
+    __m128i gain = _mm_add_epi32(_mm_set1_epi32(scale[k]), _mm_mullo_epi32(ramp, stepV));
+    stepV = _mm_slli_epi32(stepV, 2);
+    for (int v = 0; v < numVec; v++) {
+      __m128i x = _mm_loadu_si128((__m128i*)&in[4 * v]);
+      x = _mm_sra_epi32(_mm_sll_epi32(FDK_mm_fMultDiv2_epi32(x, gain), shl), shr);
+      acc[v] = _mm_add_epi32(acc[v], x);
+      gain = _mm_add_epi32(gain, stepV);
+    }
+  }
+}
+
+static FDK_X86_TARGET_SSE4_1 void gVBAPRenderer_mixSegment_SSE4_1(
+    VBAP_PCM* pOut, VBAP_PCM* const* pIn, const FIXP_DBL* scale, const FIXP_DBL* step, INT numIn,
+    INT start, INT stop, INT s, INT s2) {
+  const __m128i shl = _mm_cvtsi32_si128((s < 0) ? -s : 1);
+  const __m128i shr = _mm_cvtsi32_si128((s < 0) ? 0 : s + 1);
+  const __m128i outShift = _mm_cvtsi32_si128(s2 - 1);
+  const __m128i limit = _mm_set1_epi32((INT)MAXVAL_DBL >> (s2 - 1));
+  __m128i acc[4];
+  INT pos = start;
+
+  for (; pos + 16 <= stop; pos += 16) {
+    gVBAPRenderer_mixBlock_SSE4_1(acc, 4, pIn, scale, step, numIn, pos, pos - start, shl, shr);
+    for (int v = 0; v < 4; v++) {
+      __m128i out = _mm_loadu_si128((__m128i*)&pOut[pos + 4 * v]);
+      out = FDK_mm_addSaturate_epi32(out,
+                                     FDK_mm_saturateLeftShift_epi32(acc[v], outShift, limit));
+      _mm_storeu_si128((__m128i*)&pOut[pos + 4 * v], out);
+    }
+  }
+  for (; pos < stop; pos += 4) {
+    gVBAPRenderer_mixBlock_SSE4_1(acc, 1, pIn, scale, step, numIn, pos, pos - start, shl, shr);
+    __m128i out = _mm_loadu_si128((__m128i*)&pOut[pos]);
+    out = FDK_mm_addSaturate_epi32(out, FDK_mm_saturateLeftShift_epi32(acc[0], outShift, limit));
+    _mm_storeu_si128((__m128i*)&pOut[pos], out);
+  }
+}
+
+#if defined(__x86_AVX2__)
+static inline FDK_X86_TARGET_AVX2 void gVBAPRenderer_mixBlock_AVX2(
+    __m256i* acc, const int numVec, VBAP_PCM* const* pIn, const FIXP_DBL* scale,
+    const FIXP_DBL* step, INT numIn, INT pos, INT rampPos, __m128i shl, __m128i shr) {
+  const __m256i ramp =
+      _mm256_add_epi32(_mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 8), _mm256_set1_epi32(rampPos));
+
+  for (int v = 0; v < numVec; v++) {
+    acc[v] = _mm256_setzero_si256();
+  }
+  for (INT k = 0; k < numIn; k++) {
+    const VBAP_PCM* in = &pIn[k][pos];
+    __m256i stepV = _mm256_set1_epi32(step[k]);
+    __m256i gain = _mm256_add_epi32(_mm256_set1_epi32(scale[k]), _mm256_mullo_epi32(ramp, stepV));
+    stepV = _mm256_slli_epi32(stepV, 3);
+    for (int v = 0; v < numVec; v++) {
+      __m256i x = _mm256_loadu_si256((__m256i*)&in[8 * v]);
+      x = _mm256_sra_epi32(_mm256_sll_epi32(FDK_mm256_fMultDiv2_epi32(x, gain), shl), shr);
+      acc[v] = _mm256_add_epi32(acc[v], x);
+      gain = _mm256_add_epi32(gain, stepV);
+    }
+  }
+}
+
+static FDK_X86_TARGET_AVX2 void gVBAPRenderer_mixSegment_AVX2(
+    VBAP_PCM* pOut, VBAP_PCM* const* pIn, const FIXP_DBL* scale, const FIXP_DBL* step, INT numIn,
+    INT start, INT stop, INT s, INT s2) {
+  const __m128i shl = _mm_cvtsi32_si128((s < 0) ? -s : 1);
+  const __m128i shr = _mm_cvtsi32_si128((s < 0) ? 0 : s + 1);
+  const __m128i outShift = _mm_cvtsi32_si128(s2 - 1);
+  const __m256i limit = _mm256_set1_epi32((INT)MAXVAL_DBL >> (s2 - 1));
+  __m256i acc[4];
+  INT pos = start;
+
+  for (; pos + 32 <= stop; pos += 32) {
+    gVBAPRenderer_mixBlock_AVX2(acc, 4, pIn, scale, step, numIn, pos, pos - start, shl, shr);
+    for (int v = 0; v < 4; v++) {
+      __m256i out = _mm256_loadu_si256((__m256i*)&pOut[pos + 8 * v]);
+      out = FDK_mm256_addSaturate_epi32(
+          out, FDK_mm256_saturateLeftShift_epi32(acc[v], outShift, limit));
+      _mm256_storeu_si256((__m256i*)&pOut[pos + 8 * v], out);
+    }
+  }
+  for (; pos < stop; pos += 8) {
+    gVBAPRenderer_mixBlock_AVX2(acc, 1, pIn, scale, step, numIn, pos, pos - start, shl, shr);
+    __m256i out = _mm256_loadu_si256((__m256i*)&pOut[pos]);
+    out = FDK_mm256_addSaturate_epi32(out,
+                                      FDK_mm256_saturateLeftShift_epi32(acc[0], outShift, limit));
+    _mm256_storeu_si256((__m256i*)&pOut[pos], out);
+  }
+}
+#endif /* defined(__x86_AVX2__) */
+
+/* length and startSamplePosition are multiples of 8 */
+static void gVBAPRenderer_RenderFrame_Time_mix(VBAP_PCM* pOut, VBAP_PCM* const* pIn,
+                                               const FIXP_DBL* scale, const FIXP_DBL* step,
+                                               const FIXP_DBL* scaleState,
+                                               const FIXP_DBL* stepState, INT numIn, INT length,
+                                               INT startSamplePosition, INT s, INT s2) {
+#if defined(__x86_AVX2__)
+  if (FDK_X86_HAS_AVX2) {
+    gVBAPRenderer_mixSegment_AVX2(pOut, pIn, scaleState, stepState, numIn, 0, startSamplePosition,
+                                  s, s2);
+    gVBAPRenderer_mixSegment_AVX2(pOut, pIn, scale, step, numIn, startSamplePosition, length, s,
+                                  s2);
+    return;
+  }
+#endif
+  gVBAPRenderer_mixSegment_SSE4_1(pOut, pIn, scaleState, stepState, numIn, 0, startSamplePosition,
+                                  s, s2);
+  gVBAPRenderer_mixSegment_SSE4_1(pOut, pIn, scale, step, numIn, startSamplePosition, length, s,
+                                  s2);
+}
+#endif /* defined(FUNCTION_gVBAPRenderer_RenderFrame_Time_mix) */
@@ -89,7 +89,7 @@ amm-info@iis.fraunhofer.de
  * Only symbols that actually appear in both libraries are renamed.
  * The public API (mpeghdecoder_*, mpeghUIManager_*, etc.) is untouched.
  *
- * Collision symbols renamed: 344
+ * Collision symbols renamed: 345
  */
 
 /* clang-format off */
@@ -157,6 +157,7 @@ amm-info@iis.fraunhofer.de
 #define FDKSEEK_CUR _mpeghdec_FDKSEEK_CUR
 #define FDKSEEK_END _mpeghdec_FDKSEEK_END
 #define FDKSEEK_SET _mpeghdec_FDKSEEK_SET
+#define FDK_Bind _mpeghdec_FDK_Bind
 #define FDK_Copy _mpeghdec_FDK_Copy
 #define FDK_CreateBitBuffer _mpeghdec_FDK_CreateBitBuffer
 #define FDK_Delay_Create _mpeghdec_FDK_Delay_Create
@@ -166,6 +167,8 @@ amm-info@iis.fraunhofer.de
 #define FDK_Fetch _mpeghdec_FDK_Fetch
 #define FDK_InitBitBuffer _mpeghdec_FDK_InitBitBuffer
 #define FDK_ResetBitBuffer _mpeghdec_FDK_ResetBitBuffer
+#define FDK_Unbind _mpeghdec_FDK_Unbind
+#define FDK_deinterleave _mpeghdec_FDK_deinterleave
 #define FDK_drcDec_ApplyDownmix _mpeghdec_FDK_drcDec_ApplyDownmix
 #define FDK_drcDec_Close _mpeghdec_FDK_drcDec_Close
 #define FDK_drcDec_GetGroupLoudness _mpeghdec_FDK_drcDec_GetGroupLoudness
@@ -189,6 +192,7 @@ amm-info@iis.fraunhofer.de
 #define FDK_drcDec_SetSelectionProcessOutput _mpeghdec_FDK_drcDec_SetSelectionProcessOutput
 #define FDK_get _mpeghdec_FDK_get
 #define FDK_get32 _mpeghdec_FDK_get32
+#define FDK_getBound32 _mpeghdec_FDK_getBound32
 #define FDK_getBwd _mpeghdec_FDK_getBwd
 #define FDK_getFreeBits _mpeghdec_FDK_getFreeBits
 #define FDK_getValidBits _mpeghdec_FDK_getValidBits
@@ -298,6 +302,7 @@ amm-info@iis.fraunhofer.de
 #define TO_LITTLE_ENDIAN _mpeghdec_TO_LITTLE_ENDIAN
 #define aacDecoder_AncDataGet _mpeghdec_aacDecoder_AncDataGet
 #define aacDecoder_AncDataInit _mpeghdec_aacDecoder_AncDataInit
+#define aacDecoder_BindInput _mpeghdec_aacDecoder_BindInput
 #define aacDecoder_Close _mpeghdec_aacDecoder_Close
 #define aacDecoder_ConfigRaw _mpeghdec_aacDecoder_ConfigRaw
 #define aacDecoder_DecodeFrame _mpeghdec_aacDecoder_DecodeFrame
@@ -305,6 +310,7 @@ amm-info@iis.fraunhofer.de
 #define aacDecoder_GetFreeBytes _mpeghdec_aacDecoder_GetFreeBytes
 #define aacDecoder_GetStreamInfo _mpeghdec_aacDecoder_GetStreamInfo
 #define aacDecoder_Open _mpeghdec_aacDecoder_Open
+#define aacDecoder_ReleaseInput _mpeghdec_aacDecoder_ReleaseInput
 #define aacDecoder_SetParam _mpeghdec_aacDecoder_SetParam
 #define approxDb2lin _mpeghdec_approxDb2lin
 #define bitstreamContainsMultibandDrc _mpeghdec_bitstreamContainsMultibandDrc
@@ -339,6 +345,7 @@ amm-info@iis.fraunhofer.de
 #define drcDec_SelectionProcess_Init _mpeghdec_drcDec_SelectionProcess_Init
 #define drcDec_SelectionProcess_Process _mpeghdec_drcDec_SelectionProcess_Process
 #define drcDec_SelectionProcess_SetCodecMode _mpeghdec_drcDec_SelectionProcess_SetCodecMode
+#define drcDec_SelectionProcess_SetConfigModified _mpeghdec_drcDec_SelectionProcess_SetConfigModified
 #define drcDec_SelectionProcess_SetParam _mpeghdec_drcDec_SelectionProcess_SetParam
 #define drcDec_readUniDrcGain _mpeghdec_drcDec_readUniDrcGain
 #define dst_III _mpeghdec_dst_III
@@ -420,6 +427,7 @@ amm-info@iis.fraunhofer.de
 #define slopeSteepness_huffman _mpeghdec_slopeSteepness_huffman
 #define sqrt_tab _mpeghdec_sqrt_tab
 #define tns_max_bands_tbl _mpeghdec_tns_max_bands_tbl
+#define transportDec_BindData _mpeghdec_transportDec_BindData
 #define transportDec_Close _mpeghdec_transportDec_Close
 #define transportDec_CrcCheck _mpeghdec_transportDec_CrcCheck
 #define transportDec_CrcEndReg _mpeghdec_transportDec_CrcEndReg
@@ -431,6 +439,7 @@ amm-info@iis.fraunhofer.de
 #define transportDec_GetBitstream _mpeghdec_transportDec_GetBitstream
 #define transportDec_GetFormat _mpeghdec_transportDec_GetFormat
 #define transportDec_GetMissingAccessUnitCount _mpeghdec_transportDec_GetMissingAccessUnitCount
+#define transportDec_GetSkippedByteCount _mpeghdec_transportDec_GetSkippedByteCount
 #define transportDec_InBandConfig _mpeghdec_transportDec_InBandConfig
 #define transportDec_Open _mpeghdec_transportDec_Open
 #define transportDec_OutOfBandConfig _mpeghdec_transportDec_OutOfBandConfig
@@ -439,6 +448,7 @@ amm-info@iis.fraunhofer.de
 #define transportDec_RegisterCtrlCFGChangeCallback _mpeghdec_transportDec_RegisterCtrlCFGChangeCallback
 #define transportDec_RegisterFreeMemCallback _mpeghdec_transportDec_RegisterFreeMemCallback
 #define transportDec_RegisterUniDrcConfigCallback _mpeghdec_transportDec_RegisterUniDrcConfigCallback
+#define transportDec_ReleaseData _mpeghdec_transportDec_ReleaseData
 #define transportDec_SetParam _mpeghdec_transportDec_SetParam
 #define windowSlopes _mpeghdec_windowSlopes
 
@@ -0,0 +1,162 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2018 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+// system includes
+#include <cstdio>
+#include <cstdlib>
+
+// project includes
+#include "mpeghdecoder.h"
+
+/*
+ * Restarts a decoder instance placed in a caller-provided memory block many times and checks that
+ * the peak usage of the block does not grow, i.e. all memory given back by the core decoder is
+ * reused for the next configuration.
+ */
+
+#define TEST_ARENA_SIZE (64 * 1024 * 1024)
+#define TEST_RESTARTS 16
+
+static int testRestart(const char* name, HANDLE_MPEGH_DECODER_CONTEXT hCtx,
+                       MPEGH_DECODER_ERROR (*restart)(HANDLE_MPEGH_DECODER_CONTEXT)) {
+  /* the first restart may still allocate memory which stays with the instance */
+  if (restart(hCtx) != MPEGH_DEC_OK) {
+    fprintf(stderr, "%s: restart failed\n", name);
+    return 1;
+  }
+  size_t peak = mpeghdecoder_getArenaUsage(hCtx);
+
+  for (int i = 0; i < TEST_RESTARTS; i++) {
+    if (restart(hCtx) != MPEGH_DEC_OK) {
+      fprintf(stderr, "%s: restart %d failed\n", name, i);
+      return 1;
+    }
+    if (mpeghdecoder_getArenaUsage(hCtx) != peak) {
+      fprintf(stderr, "%s: arena peak grew from %zu to %zu bytes after %d restarts\n", name, peak,
+              mpeghdecoder_getArenaUsage(hCtx), i + 1);
+      return 1;
+    }
+  }
+  printf("%s: arena peak %zu bytes\n", name, peak);
+  return 0;
+}
+
+static HANDLE_MPEGH_DECODER_SCRATCH_POOL testPool = NULL;
+static int testPoolAttached = 0;
+
+/* Alternate between the private and the shared scratch memory, both reopen the core decoder. */
+static MPEGH_DECODER_ERROR testSetScratchPool(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
+  testPoolAttached ^= 1;
+  return mpeghdecoder_setScratchPool(hCtx, testPoolAttached ? testPool : NULL);
+}
+
+int main() {
+  void* arena = malloc(TEST_ARENA_SIZE);
+  int err = 0;
+
+  if (arena == NULL) {
+    fprintf(stderr, "Error: out of memory\n");
+    return 1;
+  }
+
+  HANDLE_MPEGH_DECODER_CONTEXT hCtx = mpeghdecoder_initWithArena(6, arena, TEST_ARENA_SIZE);
+  if (hCtx == NULL) {
+    fprintf(stderr, "Error: mpeghdecoder_initWithArena() failed\n");
+    free(arena);
+    return 1;
+  }
+
+  err |= testRestart("flush", hCtx, mpeghdecoder_flush);
+  testPool = mpeghdecoder_initScratchPool();
+  if (testPool == NULL) {
+    fprintf(stderr, "Error: mpeghdecoder_initScratchPool() failed\n");
+    err = 1;
+  } else {
+    err |= testRestart("setScratchPool", hCtx, testSetScratchPool);
+  }
+
+  mpeghdecoder_destroy(hCtx);
+  mpeghdecoder_destroyScratchPool(testPool);
+  free(arena);
+
+  return err;
+}
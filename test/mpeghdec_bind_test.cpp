@@ -0,0 +1,290 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2018 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+// system includes
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define TEST_HAVE_GUARD_PAGE
+#endif
+
+// project includes
+#include "aacdecoder_lib.h"
+#include "mpeghdec_test_stream.h"
+
+/*
+ * Decodes the same access units once from the decoder-internal input buffer (aacDecoder_Fill())
+ * and once read in place from the caller's buffer (aacDecoder_BindInput()) and checks that both
+ * paths return the same errors and samples. Besides the regular stream, the access units are
+ * padded within the MHAS packet, followed by trailing bytes or truncated. Each access unit is
+ * placed directly in front of an inaccessible page where available, so that a read beyond the
+ * bound data faults.
+ */
+
+#define TEST_NUM_ACCESS_UNITS (12)
+#define TEST_MAX_OUTPUT_SAMPLES (3072 * 24)
+#define TEST_MAX_CALLS (4)
+
+enum { TEST_AU_REGULAR, TEST_AU_PADDED, TEST_AU_TRAILING, TEST_AU_TRUNCATED };
+
+struct TestEvent {
+  AAC_DECODER_ERROR err;
+  std::vector<INT_PCM> samples;
+};
+
+/* Caller buffer holding exactly one access unit. */
+struct TestBuffer {
+  UCHAR* data;
+  void* mem;
+  size_t memSize;
+};
+
+static bool testAllocBuffer(TestBuffer* buf, const UCHAR* data, UINT length) {
+#if defined(TEST_HAVE_GUARD_PAGE)
+  size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+  size_t dataSize = (length + pageSize - 1) / pageSize * pageSize;
+  buf->memSize = dataSize + pageSize;
+  buf->mem = mmap(NULL, buf->memSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (buf->mem == MAP_FAILED) {
+    return false;
+  }
+  if (mprotect((UCHAR*)buf->mem + dataSize, pageSize, PROT_NONE) != 0) {
+    munmap(buf->mem, buf->memSize);
+    return false;
+  }
+  buf->data = (UCHAR*)buf->mem + dataSize - length;
+#else
+  buf->memSize = length;
+  buf->mem = malloc(length);
+  if (buf->mem == NULL) {
+    return false;
+  }
+  buf->data = (UCHAR*)buf->mem;
+#endif
+  memcpy(buf->data, data, length);
+  return true;
+}
+
+static void testFreeBuffer(TestBuffer* buf) {
+#if defined(TEST_HAVE_GUARD_PAGE)
+  munmap(buf->mem, buf->memSize);
+#else
+  free(buf->mem);
+#endif
+}
+
+/* Build access unit n of the given kind. */
+static UINT testAccessUnit(UCHAR* au, unsigned int n, int kind) {
+  UINT length = testStreamAccessUnit(au, n, n == 0);
+  UCHAR padded[TEST_STREAM_MAX_AU_BYTES];
+
+  switch (kind) {
+    case TEST_AU_PADDED:
+      /* rewrite the frame packet with zero bytes after the frame payload */
+      length = (n == 0) ? testStreamWritePacket(au, TEST_MHAS_PACTYP_MPEGH3DACFG, testStreamConfig,
+                                                sizeof(testStreamConfig))
+                        : 0;
+      memset(padded, 0, sizeof(padded));
+      memcpy(padded, testStreamFrames[n % TEST_STREAM_NUM_FRAMES].data,
+             testStreamFrames[n % TEST_STREAM_NUM_FRAMES].length);
+      length += testStreamWritePacket(&au[length], TEST_MHAS_PACTYP_MPEGH3DAFRAME, padded,
+                                      testStreamFrames[n % TEST_STREAM_NUM_FRAMES].length + 5);
+      break;
+    case TEST_AU_TRAILING:
+      /* the start of the next frame packet */
+      au[length++] = 0x48;
+      au[length++] = 0x0E;
+      au[length++] = 0x8F;
+      break;
+    case TEST_AU_TRUNCATED:
+      if (n % 3 == 2) {
+        length -= 7;
+      }
+      break;
+  }
+  return length;
+}
+
+/* Decode the access unit like mpeghdecoder_process() and append the result of each decoder call
+ * to events. Decoding errors end the access unit like there. */
+static bool testDecode(HANDLE_AACDECODER hDec, const UCHAR* data, UINT length, bool bind,
+                       std::vector<TestEvent>& events) {
+  UINT bytesValid = length;
+  TestEvent event;
+  event.samples.resize(TEST_MAX_OUTPUT_SAMPLES);
+
+  for (int call = 0; call < TEST_MAX_CALLS && bytesValid != 0; call++) {
+    AAC_DECODER_ERROR err = bind ? aacDecoder_BindInput(hDec, &data, &length, &bytesValid)
+                                 : aacDecoder_Fill(hDec, &data, &length, &bytesValid);
+    if (err != AAC_DEC_OK) {
+      return false;
+    }
+    do {
+      event.err = aacDecoder_DecodeFrame(hDec, event.samples.data(), TEST_MAX_OUTPUT_SAMPLES, 0);
+      events.push_back(event);
+      CStreamInfo* info = aacDecoder_GetStreamInfo(hDec);
+      if (IS_OUTPUT_VALID(event.err) && info != NULL) {
+        events.back().samples.resize(info->frameSize * info->numChannels);
+      } else {
+        events.back().samples.clear();
+      }
+    } while (event.err == AAC_DEC_OK || event.err == AAC_DEC_INTERMEDIATE_OK);
+    if (bind) {
+      aacDecoder_ReleaseInput(hDec);
+    }
+  }
+  return true;
+}
+
+static int testBind(const char* name, int kind) {
+  HANDLE_AACDECODER hCopy = aacDecoder_Open(TT_MHAS_PACKETIZED, 1);
+  HANDLE_AACDECODER hBind = aacDecoder_Open(TT_MHAS_PACKETIZED, 1);
+  std::vector<TestEvent> copyEvents;
+  std::vector<TestEvent> bindEvents;
+  int err = 0;
+
+  if (hCopy == NULL || hBind == NULL) {
+    fprintf(stderr, "%s: aacDecoder_Open() failed\n", name);
+    err = 1;
+  }
+
+  for (unsigned int n = 0; n < TEST_NUM_ACCESS_UNITS && err == 0; n++) {
+    UCHAR au[TEST_STREAM_MAX_AU_BYTES];
+    UINT length = testAccessUnit(au, n, kind);
+    TestBuffer buf;
+
+    if (!testAllocBuffer(&buf, au, length)) {
+      fprintf(stderr, "%s: out of memory\n", name);
+      err = 1;
+      break;
+    }
+    if (!testDecode(hCopy, buf.data, length, false, copyEvents) ||
+        !testDecode(hBind, buf.data, length, true, bindEvents)) {
+      fprintf(stderr, "%s: access unit %u could not be passed to the decoder\n", name, n);
+      err = 1;
+    }
+    testFreeBuffer(&buf);
+  }
+
+  if (err == 0 && bindEvents.size() != copyEvents.size()) {
+    fprintf(stderr, "%s: %zu decoder calls with bound input, %zu with copied input\n", name,
+            bindEvents.size(), copyEvents.size());
+    err = 1;
+  }
+  int numFrames = 0;
+  for (size_t i = 0; i < bindEvents.size() && i < copyEvents.size() && err == 0; i++) {
+    if (bindEvents[i].err != copyEvents[i].err ||
+        bindEvents[i].samples != copyEvents[i].samples) {
+      fprintf(stderr, "%s: decoder call %zu differs (error 0x%x with bound input, 0x%x copied)\n",
+              name, i, bindEvents[i].err, copyEvents[i].err);
+      err = 1;
+    }
+    numFrames += (bindEvents[i].err == AAC_DEC_OK);
+  }
+  if (err == 0 && kind == TEST_AU_REGULAR && numFrames != TEST_NUM_ACCESS_UNITS) {
+    fprintf(stderr, "%s: %d of %d access units decoded\n", name, numFrames,
+            TEST_NUM_ACCESS_UNITS);
+    err = 1;
+  }
+
+  aacDecoder_Close(hCopy);
+  aacDecoder_Close(hBind);
+  if (err == 0) {
+    printf("%s: %d frames\n", name, numFrames);
+  }
+  return err;
+}
+
+int main() {
+  int err = 0;
+
+  err |= testBind("regular", TEST_AU_REGULAR);
+  err |= testBind("padded", TEST_AU_PADDED);
+  err |= testBind("trailing", TEST_AU_TRAILING);
+  err |= testBind("truncated", TEST_AU_TRUNCATED);
+
+  return err;
+}
@@ -0,0 +1,529 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2018 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+// system includes
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// project includes
+#include "mpeghdecoder.h"
+#include "mpeghdec_test_stream.h"
+
+/*
+ * Checks the output side of the decoder wrapper with the test stream: borrowing frames with
+ * mpeghdecoder_getSamplesView() yields the same frames as mpeghdecoder_getSamples() and blocks the
+ * other output functions until the frame is released, while mpeghdecoder_process() may still be
+ * called. A soft flush drops the queued frames and keeps the configuration. Short timestamp gaps
+ * are filled with concealed frames, long ones restart the decoder.
+ */
+
+#define TEST_NUM_ACCESS_UNITS (24)
+#define TEST_MAX_OUTPUT_SAMPLES (3072)
+#define TEST_SEEK_ACCESS_UNITS (6)
+#define TEST_SEEK_POSITION (200) /* access unit index the restarted decoding continues at */
+#define TEST_GAP_THRESHOLD_MS (100)
+#define TEST_GAP_START (10) /* index of the first missing access unit */
+#define TEST_GAP_SHORT (3)  /* missing access units below the threshold */
+#define TEST_GAP_LONG (12)  /* missing access units above the threshold */
+
+struct TestFrame {
+  MPEGH_DECODER_OUTPUT_INFO info;
+  std::vector<int32_t> samples;
+};
+
+/* Feed access unit n with the timestamp of access unit pos. */
+static MPEGH_DECODER_ERROR testProcess(HANDLE_MPEGH_DECODER_CONTEXT hCtx, unsigned int n,
+                                       unsigned int pos, bool withConfig) {
+  uint8_t au[TEST_STREAM_MAX_AU_BYTES];
+  uint32_t length = testStreamAccessUnit(au, n, withConfig);
+  return mpeghdecoder_processTimescale(hCtx, au, length, (uint64_t)pos * TEST_STREAM_FRAME_SIZE,
+                                       TEST_STREAM_SAMPLE_RATE);
+}
+
+/* Append all frames available in the decoder. */
+static void testGetFrames(HANDLE_MPEGH_DECODER_CONTEXT hCtx, std::vector<TestFrame>& frames) {
+  TestFrame frame;
+  frame.samples.resize(TEST_MAX_OUTPUT_SAMPLES);
+  while (mpeghdecoder_getSamples(hCtx, frame.samples.data(), TEST_MAX_OUTPUT_SAMPLES,
+                                 &frame.info) == MPEGH_DEC_OK) {
+    frames.push_back(frame);
+    frames.back().samples.resize(frame.info.numSamplesPerChannel * frame.info.numChannels);
+  }
+}
+
+static bool testSameFrame(const MPEGH_DECODER_OUTPUT_INFO* info, const int32_t* samples,
+                          const TestFrame& ref) {
+  return info->numSamplesPerChannel == ref.info.numSamplesPerChannel &&
+         info->numChannels == ref.info.numChannels && info->pts == ref.info.pts &&
+         info->isConcealed == ref.info.isConcealed &&
+         memcmp(samples, ref.samples.data(), ref.samples.size() * sizeof(int32_t)) == 0;
+}
+
+static int testDecodeReference(std::vector<TestFrame>& frames) {
+  HANDLE_MPEGH_DECODER_CONTEXT hCtx = mpeghdecoder_init(1);
+  if (hCtx == NULL) {
+    fprintf(stderr, "reference: mpeghdecoder_init() failed\n");
+    return 1;
+  }
+
+  int err = 0;
+  for (unsigned int n = 0; n < TEST_NUM_ACCESS_UNITS; n++) {
+    if (testProcess(hCtx, n, n, n == 0) != MPEGH_DEC_OK) {
+      fprintf(stderr, "reference: access unit %u failed\n", n);
+      err = 1;
+    }
+    testGetFrames(hCtx, frames);
+  }
+  mpeghdecoder_destroy(hCtx);
+
+  if (frames.size() == 0) {
+    fprintf(stderr, "reference: no frames decoded\n");
+    err = 1;
+  }
+  return err;
+}
+
+/* Check that all output functions except mpeghdecoder_process() refuse to run while a frame is
+ * borrowed. */
+static int testBorrowed(HANDLE_MPEGH_DECODER_CONTEXT hCtx) {
+  static int32_t samples[TEST_MAX_OUTPUT_SAMPLES];
+  MPEGH_DECODER_OUTPUT_INFO info;
+  const int32_t* view = samples;
+  uint32_t numProcessed, numFrames;
+  int err = 0;
+
+  if (mpeghdecoder_getSamplesView(hCtx, &view, &info) != MPEGH_DEC_BUFFER_ERROR || view != NULL) {
+    fprintf(stderr, "view: a second frame could be borrowed\n");
+    err = 1;
+  }
+  if (mpeghdecoder_getSamples(hCtx, samples, TEST_MAX_OUTPUT_SAMPLES, &info) !=
+      MPEGH_DEC_BUFFER_ERROR) {
+    fprintf(stderr, "view: mpeghdecoder_getSamples() succeeded on a borrowed frame\n");
+    err = 1;
+  }
+  if (mpeghdecoder_getSamplesFormatted(hCtx, samples, TEST_MAX_OUTPUT_SAMPLES, &info) !=
+      MPEGH_DEC_BUFFER_ERROR) {
+    fprintf(stderr, "view: mpeghdecoder_getSamplesFormatted() succeeded on a borrowed frame\n");
+    err = 1;
+  }
+  if (mpeghdecoder_processBatch(hCtx, NULL, 0, samples, TEST_MAX_OUTPUT_SAMPLES, &info, 1,
+                                &numProcessed, &numFrames) != MPEGH_DEC_BUFFER_ERROR) {
+    fprintf(stderr, "view: mpeghdecoder_processBatch() succeeded on a borrowed frame\n");
+    err = 1;
+  }
+  if (mpeghdecoder_setParam(hCtx, MPEGH_DEC_PARAM_THREADED_MODE,
+                            MPEGH_DEC_THREADED_MODE_EXTERNAL) != MPEGH_DEC_BUFFER_ERROR) {
+    fprintf(stderr, "view: threaded mode started on a borrowed frame\n");
+    err = 1;
+  }
+  return err;
+}
+
+/* Borrow every frame and compare it with the reference. Every other access unit is fed while the
+ * first frame of the previous one is still borrowed. */
+static int testView(const std::vector<TestFrame>& reference) {
+  HANDLE_MPEGH_DECODER_CONTEXT hCtx = mpeghdecoder_init(1);
+  if (hCtx == NULL) {
+    fprintf(stderr, "view: mpeghdecoder_init() failed\n");
+    return 1;
+  }
+
+  const int32_t* held = NULL;
+  MPEGH_DECODER_OUTPUT_INFO heldInfo;
+  size_t numFrames = 0;
+  int err = 0;
+  for (unsigned int n = 0; n < TEST_NUM_ACCESS_UNITS && err == 0; n++) {
+    const int32_t* view = NULL;
+    MPEGH_DECODER_OUTPUT_INFO info;
+    MPEGH_DECODER_ERROR result;
+
+    if (testProcess(hCtx, n, n, n == 0) != MPEGH_DEC_OK) {
+      fprintf(stderr, "view: access unit %u failed\n", n);
+      err = 1;
+    }
+    if (held != NULL) {
+      if (!testSameFrame(&heldInfo, held, reference[numFrames])) {
+        fprintf(stderr, "view: borrowed frame %zu changed while decoding\n", numFrames);
+        err = 1;
+      }
+      mpeghdecoder_releaseSamples(hCtx);
+      numFrames++;
+      held = NULL;
+    }
+
+    while ((result = mpeghdecoder_getSamplesView(hCtx, &view, &info)) == MPEGH_DEC_OK) {
+      if (view == NULL || numFrames >= reference.size()) {
+        fprintf(stderr, "view: unexpected frame %zu\n", numFrames);
+        err = 1;
+        break;
+      }
+      err |= testBorrowed(hCtx);
+      if (n % 2 == 0) {
+        // keep the frame over the next mpeghdecoder_process() call
+        held = view;
+        heldInfo = info;
+        break;
+      }
+      if (!testSameFrame(&info, view, reference[numFrames])) {
+        fprintf(stderr, "view: frame %zu differs from mpeghdecoder_getSamples()\n", numFrames);
+        err = 1;
+      }
+      if (mpeghdecoder_releaseSamples(hCtx) != MPEGH_DEC_OK ||
+          mpeghdecoder_releaseSamples(hCtx) != MPEGH_DEC_OK) {
+        fprintf(stderr, "view: releasing frame %zu failed\n", numFrames);
+        err = 1;
+      }
+      numFrames++;
+    }
+    if (held == NULL && (result != MPEGH_DEC_FEED_DATA || view != NULL)) {
+      fprintf(stderr, "view: no clean end of the output after access unit %u\n", n);
+      err = 1;
+    }
+  }
+  if (err == 0 && numFrames != reference.size()) {
+    fprintf(stderr, "view: got %zu of %zu frames\n", numFrames, reference.size());
+    err = 1;
+  }
+
+  mpeghdecoder_destroy(hCtx);
+  if (err == 0) {
+    printf("view: %zu frames\n", numFrames);
+  }
+  return err;
+}
+
+/* Same with the frame ring of the threaded mode driven by mpeghdecoder_runWorker(). */
+static int testViewThreaded(const std::vector<TestFrame>& reference) {
+  static int32_t samples[TEST_MAX_OUTPUT_SAMPLES];
+  HANDLE_MPEGH_DECODER_CONTEXT hCtx = mpeghdecoder_init(1);
+  if (hCtx == NULL) {
+    fprintf(stderr, "view threaded: mpeghdecoder_init() failed\n");
+    return 1;
+  }
+
+  int err = 0;
+  if (mpeghdecoder_setParam(hCtx, MPEGH_DEC_PARAM_THREADED_MODE,
+                            MPEGH_DEC_THREADED_MODE_EXTERNAL) != MPEGH_DEC_OK) {
+    fprintf(stderr, "view threaded: threaded mode not supported\n");
+    err = 1;
+  }
+
+  size_t numFrames = 0;
+  for (unsigned int n = 0; n < TEST_NUM_ACCESS_UNITS && err == 0; n++) {
+    const int32_t* view = NULL;
+    MPEGH_DECODER_OUTPUT_INFO info;
+
+    if (testProcess(hCtx, n, n, n == 0) != MPEGH_DEC_OK) {
+      fprintf(stderr, "view threaded: access unit %u failed\n", n);
+      err = 1;
+    }
+    mpeghdecoder_runWorker(hCtx);
+    while (mpeghdecoder_getSamplesView(hCtx, &view, &info) == MPEGH_DEC_OK) {
+      const int32_t* second = samples;
+      if (numFrames >= reference.size() || !testSameFrame(&info, view, reference[numFrames])) {
+        fprintf(stderr, "view threaded: frame %zu differs from the reference\n", numFrames);
+        err = 1;
+        break;
+      }
+      if (mpeghdecoder_getSamplesView(hCtx, &second, &info) != MPEGH_DEC_BUFFER_ERROR ||
+          second != NULL ||
+          mpeghdecoder_getSamples(hCtx, samples, TEST_MAX_OUTPUT_SAMPLES, &info) !=
+              MPEGH_DEC_BUFFER_ERROR ||
+          mpeghdecoder_getSamplesFormatted(hCtx, samples, TEST_MAX_OUTPUT_SAMPLES, &info) !=
+              MPEGH_DEC_BUFFER_ERROR) {
+        fprintf(stderr, "view threaded: frame %zu could be fetched twice\n", numFrames);
+        err = 1;
+      }
+      mpeghdecoder_releaseSamples(hCtx);
+      mpeghdecoder_runWorker(hCtx);
+      numFrames++;
+    }
+  }
+  if (err == 0 && numFrames != reference.size()) {
+    fprintf(stderr, "view threaded: got %zu of %zu frames\n", numFrames, reference.size());
+    err = 1;
+  }
+
+  mpeghdecoder_destroy(hCtx);
+  if (err == 0) {
+    printf("view threaded: %zu frames\n", numFrames);
+  }
+  return err;
+}
+
+/* Decode the first access units of the test stream, leave some frames queued and restart at a
+ * later position with access units without configuration. Returns the frames after the restart. */
+static int testSeek(const char* name, MPEGH_DECODER_ERROR (*restart)(HANDLE_MPEGH_DECODER_CONTEXT),
+                    std::vector<TestFrame>& frames) {
+  HANDLE_MPEGH_DECODER_CONTEXT hCtx = mpeghdecoder_init(1);
+  if (hCtx == NULL) {
+    fprintf(stderr, "%s: mpeghdecoder_init() failed\n", name);
+    return 1;
+  }
+
+  int err = 0;
+  for (unsigned int n = 0; n < TEST_SEEK_ACCESS_UNITS; n++) {
+    if (testProcess(hCtx, n, n, n == 0) != MPEGH_DEC_OK) {
+      fprintf(stderr, "%s: access unit %u failed\n", name, n);
+      err = 1;
+    }
+  }
+  const int32_t* view = NULL;
+  MPEGH_DECODER_OUTPUT_INFO info;
+  if (mpeghdecoder_getSamplesView(hCtx, &view, &info) != MPEGH_DEC_OK) {
+    fprintf(stderr, "%s: no frames queued before the restart\n", name);
+    err = 1;
+  }
+  mpeghdecoder_releaseSamples(hCtx);
+
+  if (restart(hCtx) != MPEGH_DEC_OK) {
+    fprintf(stderr, "%s: restart failed\n", name);
+    err = 1;
+  }
+  testGetFrames(hCtx, frames);
+  if (frames.size() != 0) {
+    fprintf(stderr, "%s: %zu queued frames were kept\n", name, frames.size());
+    err = 1;
+  }
+
+  for (unsigned int n = 0; n < TEST_SEEK_ACCESS_UNITS; n++) {
+    if (testProcess(hCtx, n, TEST_SEEK_POSITION + n, false) != MPEGH_DEC_OK) {
+      fprintf(stderr, "%s: access unit %u after the restart failed\n", name, n);
+      err = 1;
+    }
+    testGetFrames(hCtx, frames);
+  }
+
+  mpeghdecoder_destroy(hCtx);
+  return err;
+}
+
+/* mpeghdecoder_softFlush() drops the queued frames but keeps the configuration, so the decoding
+ * continues without a new configuration. mpeghdecoder_flush() forgets it. */
+static int testSoftFlush() {
+  std::vector<TestFrame> frames;
+  int err = testSeek("softFlush", mpeghdecoder_softFlush, frames);
+
+  uint64_t pts =
+      (uint64_t)(TEST_SEEK_POSITION * TEST_STREAM_FRAME_SIZE * 1e9 / TEST_STREAM_SAMPLE_RATE + 0.5);
+  bool silent = true;
+  if (frames.size() < TEST_SEEK_ACCESS_UNITS - 1) {
+    fprintf(stderr, "softFlush: %zu frames decoded after the restart\n", frames.size());
+    err = 1;
+  } else if (frames[0].info.pts != pts) {
+    fprintf(stderr, "softFlush: first frame at %llu ns instead of %llu ns\n",
+            (unsigned long long)frames[0].info.pts, (unsigned long long)pts);
+    err = 1;
+  }
+  for (size_t i = 0; i < frames.size(); i++) {
+    if (frames[i].info.sampleRate != TEST_STREAM_SAMPLE_RATE || frames[i].info.numChannels != 1 ||
+        frames[i].info.isConcealed) {
+      fprintf(stderr, "softFlush: frame %zu does not match the configuration\n", i);
+      err = 1;
+    }
+    for (size_t k = 0; k < frames[i].samples.size(); k++) {
+      silent &= (frames[i].samples[k] == 0);
+    }
+  }
+  if (silent) {
+    fprintf(stderr, "softFlush: the output after the restart is silent\n");
+    err = 1;
+  }
+
+  std::vector<TestFrame> flushFrames;
+  err |= testSeek("flush", mpeghdecoder_flush, flushFrames);
+  if (flushFrames.size() != 0) {
+    fprintf(stderr, "flush: %zu frames decoded without configuration\n", flushFrames.size());
+    err = 1;
+  }
+
+  if (err == 0) {
+    printf("softFlush: %zu frames after the restart\n", frames.size());
+  }
+  return err;
+}
+
+/* Decode the test stream with missing access units after TEST_GAP_START and a random access
+ * point at the end of the gap. */
+static int testGap(const char* name, unsigned int numMissing, std::vector<TestFrame>& frames) {
+  HANDLE_MPEGH_DECODER_CONTEXT hCtx = mpeghdecoder_init(1);
+  if (hCtx == NULL) {
+    fprintf(stderr, "%s: mpeghdecoder_init() failed\n", name);
+    return 1;
+  }
+
+  int err = 0;
+  if (mpeghdecoder_setParam(hCtx, MPEGH_DEC_PARAM_GAP_FILL_MODE, MPEGH_DEC_GAP_FILL_CONCEAL) !=
+          MPEGH_DEC_OK ||
+      mpeghdecoder_setParam(hCtx, MPEGH_DEC_PARAM_DISCONTINUITY_THRESHOLD,
+                            TEST_GAP_THRESHOLD_MS) != MPEGH_DEC_OK) {
+    fprintf(stderr, "%s: setting the gap parameters failed\n", name);
+    err = 1;
+  }
+  for (unsigned int n = 0; n < TEST_NUM_ACCESS_UNITS; n++) {
+    unsigned int pos = (n < TEST_GAP_START) ? n : n + numMissing;
+    if (testProcess(hCtx, n, pos, n == 0 || n == TEST_GAP_START) != MPEGH_DEC_OK) {
+      fprintf(stderr, "%s: access unit %u failed\n", name, n);
+      err = 1;
+    }
+    testGetFrames(hCtx, frames);
+  }
+
+  mpeghdecoder_destroy(hCtx);
+  return err;
+}
+
+/* Position of a frame in access units. */
+static double testFramePosition(const TestFrame& frame) {
+  return (double)frame.info.pts * TEST_STREAM_SAMPLE_RATE / 1e9 / TEST_STREAM_FRAME_SIZE;
+}
+
+/* A gap below MPEGH_DEC_PARAM_DISCONTINUITY_THRESHOLD is filled with one concealed frame per
+ * missing access unit, a larger gap restarts the decoder without concealment. */
+static int testGapFill() {
+  std::vector<TestFrame> frames;
+  int err = testGap("gap", TEST_GAP_SHORT, frames);
+
+  unsigned int numConcealed = 0;
+  for (size_t i = 0; i < frames.size(); i++) {
+    // each frame follows its predecessor, the concealed ones included
+    if (testFramePosition(frames[i]) < i - 0.01 || testFramePosition(frames[i]) > i + 0.01) {
+      fprintf(stderr, "gap: frame %zu at position %.2f\n", i, testFramePosition(frames[i]));
+      err = 1;
+      break;
+    }
+    bool missing = (i >= TEST_GAP_START && i < TEST_GAP_START + TEST_GAP_SHORT);
+    if (frames[i].info.isConcealed != missing) {
+      fprintf(stderr, "gap: frame %zu is %sconcealed\n", i, missing ? "not " : "");
+      err = 1;
+    }
+    numConcealed += frames[i].info.isConcealed;
+  }
+  if (frames.size() < TEST_GAP_START + TEST_GAP_SHORT + 1) {
+    fprintf(stderr, "gap: only %zu frames decoded\n", frames.size());
+    err = 1;
+  }
+
+  std::vector<TestFrame> restartFrames;
+  err |= testGap("restart", TEST_GAP_LONG, restartFrames);
+
+  // the frames before the gap are followed by the first access unit after it
+  size_t numAfterGap = 0;
+  for (size_t i = 0; i < restartFrames.size(); i++) {
+    double pos = testFramePosition(restartFrames[i]);
+    if (restartFrames[i].info.isConcealed) {
+      fprintf(stderr, "restart: frame %zu at position %.2f is concealed\n", i, pos);
+      err = 1;
+    }
+    if (pos > TEST_GAP_START - 1 + 0.01 && numAfterGap++ == 0 &&
+        (pos < TEST_GAP_START + TEST_GAP_LONG - 0.01 ||
+         pos > TEST_GAP_START + TEST_GAP_LONG + 0.01)) {
+      fprintf(stderr, "restart: output continues at position %.2f\n", pos);
+      err = 1;
+    }
+  }
+  if (numAfterGap == 0) {
+    fprintf(stderr, "restart: no frames decoded after the gap\n");
+    err = 1;
+  }
+
+  if (err == 0) {
+    printf("gap: %u concealed frames, restart: %zu frames after the gap\n", numConcealed,
+           numAfterGap);
+  }
+  return err;
+}
+
+int main() {
+  std::vector<TestFrame> reference;
+  int err = testDecodeReference(reference);
+
+  if (err == 0) {
+    err |= testView(reference);
+    err |= testViewThreaded(reference);
+    err |= testSoftFlush();
+    err |= testGapFill();
+  }
+
+  return err;
+}
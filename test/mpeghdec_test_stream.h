@@ -0,0 +1,163 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2018 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+#ifndef MPEGHDEC_TEST_STREAM_H
+#define MPEGHDEC_TEST_STREAM_H
+
+// system includes
+#include <cstdint>
+#include <cstring>
+
+/*
+ * Synthetic MPEG-H stream shared by the tests, so they do not depend on external test vectors.
+ * It consists of a single channel configuration (48 kHz, CICP setup 1, 1024 samples per frame)
+ * and a set of independently decodable frames with non-zero spectral data. An access unit is an
+ * MHAS frame packet, which is preceded by the configuration packet at random access points.
+ */
+
+#define TEST_STREAM_SAMPLE_RATE (48000)
+#define TEST_STREAM_FRAME_SIZE (1024)
+#define TEST_STREAM_MAX_AU_BYTES (128) /* upper bound of an access unit including the config */
+
+#define TEST_MHAS_PACTYP_MPEGH3DACFG (1)
+#define TEST_MHAS_PACTYP_MPEGH3DAFRAME (2)
+
+static const uint8_t testStreamConfig[] = {0x0B, 0x19, 0x00, 0x40, 0x00, 0x00, 0x40};
+
+static const uint8_t testStreamFrame0[] = {0x8F, 0x0C, 0x61, 0x80, 0x00, 0x00, 0x01,
+                                           0x66, 0x14, 0x04, 0xE9, 0xB7, 0x07, 0x55};
+static const uint8_t testStreamFrame1[] = {
+    0x8F, 0x0C, 0x61, 0x80, 0x00, 0x00, 0x02, 0xFF, 0x88, 0x30, 0x8B, 0xD6, 0xED, 0x39, 0x7C, 0x3A,
+    0x4B, 0xBB, 0x30, 0x36, 0x6A, 0x36, 0xF0, 0xD9, 0x1C, 0x47, 0x10, 0x35, 0x3A, 0x76, 0xD9, 0x58};
+static const uint8_t testStreamFrame2[] = {
+    0x8F, 0x0C, 0x61, 0x80, 0x00, 0x00, 0x03, 0xC7, 0xE0, 0xAF, 0x66, 0x3A, 0xB2, 0x8D, 0x82,
+    0x15, 0xA0, 0x15, 0x67, 0x22, 0x41, 0x9F, 0x26, 0x37, 0x20, 0x73, 0xCD, 0x23, 0xD6, 0xE1,
+    0x6E, 0xAC, 0xE8, 0x43, 0x1A, 0xB3, 0xEC, 0xDC, 0xDD, 0xFB, 0x72, 0x07, 0xCA, 0x53};
+static const uint8_t testStreamFrame3[] = {0x8F, 0x0C, 0x61, 0x80, 0x00, 0x00, 0x02, 0xF6,
+                                           0xC5, 0x02, 0xA2, 0x7E, 0x86, 0x15, 0x83, 0x51,
+                                           0x2F, 0x00, 0x37, 0xC0, 0xCE, 0x8F, 0x49};
+static const uint8_t testStreamFrame4[] = {
+    0x8F, 0x0C, 0x61, 0x80, 0x00, 0x00, 0x03, 0xBF, 0x1D, 0x81, 0x78, 0xE2, 0x47,
+    0x69, 0x81, 0x2C, 0x83, 0x5E, 0x6A, 0xB0, 0xA5, 0xF7, 0x78, 0x82, 0x7C, 0xBD,
+    0x0A, 0xAA, 0xDA, 0x48, 0x66, 0x3B, 0x8A, 0x23, 0xE1, 0x43, 0x5C, 0xDE, 0xC6};
+static const uint8_t testStreamFrame5[] = {
+    0x8F, 0x0C, 0x61, 0x80, 0x00, 0x00, 0x01, 0x54, 0x91, 0xAD, 0x1B, 0x06, 0x31,
+    0x2D, 0x85, 0xCC, 0x48, 0xD1, 0xCD, 0x01, 0xEC, 0x6F, 0x8C, 0xF7, 0x28, 0xCD,
+    0x4A, 0xF5, 0x0F, 0xC2, 0x99, 0x55, 0xA8, 0x1C, 0x0B, 0x5C, 0x0D, 0xAB, 0x29,
+    0x64, 0x4D, 0x3E, 0x88, 0xBB, 0x74, 0xA9, 0xBF, 0xAB, 0x96, 0xB5};
+
+static const struct {
+  const uint8_t* data;
+  uint32_t length;
+} testStreamFrames[] = {{testStreamFrame0, sizeof(testStreamFrame0)},
+                        {testStreamFrame1, sizeof(testStreamFrame1)},
+                        {testStreamFrame2, sizeof(testStreamFrame2)},
+                        {testStreamFrame3, sizeof(testStreamFrame3)},
+                        {testStreamFrame4, sizeof(testStreamFrame4)},
+                        {testStreamFrame5, sizeof(testStreamFrame5)}};
+
+#define TEST_STREAM_NUM_FRAMES (sizeof(testStreamFrames) / sizeof(testStreamFrames[0]))
+
+/* Write an MHAS packet with packet label 1 and a payload shorter than 2047 bytes. */
+static uint32_t testStreamWritePacket(uint8_t* out, int type, const uint8_t* payload,
+                                      uint32_t length) {
+  out[0] = (uint8_t)((type << 5) | (1 << 3) | (length >> 8));
+  out[1] = (uint8_t)(length & 0xFF);
+  memcpy(&out[2], payload, length);
+  return length + 2;
+}
+
+/* Write access unit n of the test stream into out, which has to hold TEST_STREAM_MAX_AU_BYTES.
+ * Returns the length of the access unit in bytes. */
+static uint32_t testStreamAccessUnit(uint8_t* out, unsigned int n, bool withConfig) {
+  uint32_t length = 0;
+  if (withConfig) {
+    length += testStreamWritePacket(&out[length], TEST_MHAS_PACTYP_MPEGH3DACFG, testStreamConfig,
+                                    sizeof(testStreamConfig));
+  }
+  length += testStreamWritePacket(&out[length], TEST_MHAS_PACTYP_MPEGH3DAFRAME,
+                                  testStreamFrames[n % TEST_STREAM_NUM_FRAMES].data,
+                                  testStreamFrames[n % TEST_STREAM_NUM_FRAMES].length);
+  return length;
+}
+
+#endif /* MPEGHDEC_TEST_STREAM_H */
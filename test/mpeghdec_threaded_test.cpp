@@ -0,0 +1,276 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2018 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+// system includes
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// project includes
+#include "mpeghdecoder.h"
+#include "mpeghdec_test_stream.h"
+
+/*
+ * Feeds the test stream from a producer thread while the main thread fetches the decoded frames
+ * in threaded mode, once with the internal worker and once with the producer driving the worker
+ * via mpeghdecoder_runWorker(). The consumer only starts after the producer found the input
+ * queue full, i.e. the frame ring is full as well. The frames have to match the single-threaded
+ * decoding in order, timestamps and content.
+ */
+
+#define TEST_NUM_ACCESS_UNITS (48)
+#define TEST_MAX_OUTPUT_SAMPLES (3072)
+#define TEST_TIMEOUT_MS (20000)
+
+struct TestFrame {
+  MPEGH_DECODER_OUTPUT_INFO info;
+  std::vector<int32_t> samples;
+};
+
+static MPEGH_DECODER_ERROR testProcess(HANDLE_MPEGH_DECODER_CONTEXT hCtx, unsigned int n) {
+  uint8_t au[TEST_STREAM_MAX_AU_BYTES];
+  uint32_t length = testStreamAccessUnit(au, n, n == 0);
+  return mpeghdecoder_processTimescale(hCtx, au, length, (uint64_t)n * TEST_STREAM_FRAME_SIZE,
+                                       TEST_STREAM_SAMPLE_RATE);
+}
+
+/* Append all frames available in the decoder. */
+static void testGetFrames(HANDLE_MPEGH_DECODER_CONTEXT hCtx, std::vector<TestFrame>& frames) {
+  TestFrame frame;
+  frame.samples.resize(TEST_MAX_OUTPUT_SAMPLES);
+  while (mpeghdecoder_getSamples(hCtx, frame.samples.data(), TEST_MAX_OUTPUT_SAMPLES,
+                                 &frame.info) == MPEGH_DEC_OK) {
+    frames.push_back(frame);
+    frames.back().samples.resize(frame.info.numSamplesPerChannel * frame.info.numChannels);
+  }
+}
+
+static int testDecodeReference(std::vector<TestFrame>& frames) {
+  HANDLE_MPEGH_DECODER_CONTEXT hCtx = mpeghdecoder_init(1);
+  if (hCtx == NULL) {
+    fprintf(stderr, "reference: mpeghdecoder_init() failed\n");
+    return 1;
+  }
+
+  int err = 0;
+  for (unsigned int n = 0; n < TEST_NUM_ACCESS_UNITS; n++) {
+    if (testProcess(hCtx, n) != MPEGH_DEC_OK) {
+      fprintf(stderr, "reference: access unit %u failed\n", n);
+      err = 1;
+    }
+    testGetFrames(hCtx, frames);
+  }
+  if (mpeghdecoder_flushAndGet(hCtx) != MPEGH_DEC_OK) {
+    fprintf(stderr, "reference: mpeghdecoder_flushAndGet() failed\n");
+    err = 1;
+  }
+  testGetFrames(hCtx, frames);
+  mpeghdecoder_destroy(hCtx);
+
+  if (frames.size() < TEST_NUM_ACCESS_UNITS) {
+    fprintf(stderr, "reference: only %zu frames decoded\n", frames.size());
+    err = 1;
+  }
+  bool silent = true;
+  for (size_t i = 0; i < frames.size(); i++) {
+    for (size_t k = 0; k < frames[i].samples.size(); k++) {
+      silent &= (frames[i].samples[k] == 0);
+    }
+  }
+  if (silent) {
+    fprintf(stderr, "reference: decoded frames are silent\n");
+    err = 1;
+  }
+  return err;
+}
+
+static void testProducer(HANDLE_MPEGH_DECODER_CONTEXT hCtx, int mode,
+                         std::atomic<bool>* inputFull, std::atomic<bool>* done,
+                         std::atomic<int>* err) {
+  for (unsigned int n = 0; n <= TEST_NUM_ACCESS_UNITS; n++) {
+    MPEGH_DECODER_ERROR result;
+    while ((result = (n < TEST_NUM_ACCESS_UNITS) ? testProcess(hCtx, n)
+                                                 : mpeghdecoder_flushAndGet(hCtx)) ==
+           MPEGH_DEC_BUFFER_ERROR) {
+      inputFull->store(true);
+      if (mode == MPEGH_DEC_THREADED_MODE_EXTERNAL) {
+        mpeghdecoder_runWorker(hCtx);
+      }
+      std::this_thread::yield();
+    }
+    if (result != MPEGH_DEC_OK) {
+      err->store(1);
+    }
+    if (mode == MPEGH_DEC_THREADED_MODE_EXTERNAL) {
+      mpeghdecoder_runWorker(hCtx);
+    }
+  }
+
+  // keep the worker running until the consumer got all frames
+  while (!done->load()) {
+    if (mode == MPEGH_DEC_THREADED_MODE_EXTERNAL) {
+      mpeghdecoder_runWorker(hCtx);
+    }
+    std::this_thread::yield();
+  }
+}
+
+static int testThreaded(const char* name, int mode, const std::vector<TestFrame>& reference) {
+  HANDLE_MPEGH_DECODER_CONTEXT hCtx = mpeghdecoder_init(1);
+  if (hCtx == NULL) {
+    fprintf(stderr, "%s: mpeghdecoder_init() failed\n", name);
+    return 1;
+  }
+  if (mpeghdecoder_setParam(hCtx, MPEGH_DEC_PARAM_THREADED_MODE, mode) != MPEGH_DEC_OK) {
+    fprintf(stderr, "%s: threaded mode not supported\n", name);
+    mpeghdecoder_destroy(hCtx);
+    return 1;
+  }
+
+  std::atomic<bool> inputFull(false);
+  std::atomic<bool> done(false);
+  std::atomic<int> producerErr(0);
+  std::thread producer(testProducer, hCtx, mode, &inputFull, &done, &producerErr);
+
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(TEST_TIMEOUT_MS);
+  int err = 0;
+  while (!inputFull.load() && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+  if (!inputFull.load()) {
+    fprintf(stderr, "%s: input queue never filled up\n", name);
+    err = 1;
+  }
+
+  std::vector<TestFrame> frames;
+  while (frames.size() < reference.size() && std::chrono::steady_clock::now() < deadline) {
+    size_t numFrames = frames.size();
+    testGetFrames(hCtx, frames);
+    if (frames.size() == numFrames) {
+      std::this_thread::yield();
+    }
+  }
+  done.store(true);
+  producer.join();
+
+  if (producerErr.load() != 0) {
+    fprintf(stderr, "%s: feeding the decoder failed\n", name);
+    err = 1;
+  }
+  if (frames.size() != reference.size()) {
+    fprintf(stderr, "%s: got %zu of %zu frames\n", name, frames.size(), reference.size());
+    err = 1;
+  }
+  for (size_t i = 0; i < frames.size() && i < reference.size(); i++) {
+    const MPEGH_DECODER_OUTPUT_INFO* info = &frames[i].info;
+    const MPEGH_DECODER_OUTPUT_INFO* ref = &reference[i].info;
+    if (info->numSamplesPerChannel != ref->numSamplesPerChannel ||
+        info->numChannels != ref->numChannels || info->sampleRate != ref->sampleRate ||
+        info->pts != ref->pts || info->isConcealed != ref->isConcealed ||
+        frames[i].samples != reference[i].samples) {
+      fprintf(stderr, "%s: frame %zu differs from the single-threaded decoding\n", name, i);
+      err = 1;
+      break;
+    }
+  }
+
+  mpeghdecoder_destroy(hCtx);
+  if (err == 0) {
+    printf("%s: %zu frames\n", name, frames.size());
+  }
+  return err;
+}
+
+int main() {
+  std::vector<TestFrame> reference;
+  int err = testDecodeReference(reference);
+
+  if (err == 0) {
+    err |= testThreaded("internal", MPEGH_DEC_THREADED_MODE_INTERNAL, reference);
+    err |= testThreaded("runWorker", MPEGH_DEC_THREADED_MODE_EXTERNAL, reference);
+  }
+
+  return err;
+}